@@ -137,6 +137,53 @@ if (MongoDB_FOUND)
     SET(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -DMONGODB=1")
 endif()
 
+# CPU BLAS backend for the Frame cells
+SET(N2D2_BLAS "Builtin" CACHE STRING
+    "CPU BLAS backend for the Frame cells (Builtin, OpenBLAS, MKL or BLIS)")
+SET_PROPERTY(CACHE N2D2_BLAS PROPERTY STRINGS Builtin OpenBLAS MKL BLIS)
+
+if (N2D2_BLAS STREQUAL "OpenBLAS")
+    FIND_PATH(N2D2_BLAS_INCLUDE_DIR cblas.h
+        PATH_SUFFIXES openblas
+        DOC "Path to OpenBLAS include directory.")
+    FIND_LIBRARY(N2D2_BLAS_LIBRARIES NAMES openblas
+        DOC "Path to OpenBLAS library.")
+    SET(N2D2_BLAS_FLAGS "-DOPENBLAS=1")
+elseif (N2D2_BLAS STREQUAL "MKL")
+    FIND_PATH(N2D2_BLAS_INCLUDE_DIR mkl.h
+        PATHS $ENV{MKLROOT}/include
+        DOC "Path to MKL include directory.")
+    FIND_LIBRARY(N2D2_BLAS_LIBRARIES NAMES mkl_rt
+        PATHS $ENV{MKLROOT}/lib/intel64 $ENV{MKLROOT}/lib
+        DOC "Path to MKL single dynamic library.")
+    SET(N2D2_BLAS_FLAGS "-DMKL=1")
+elseif (N2D2_BLAS STREQUAL "BLIS")
+    FIND_PATH(N2D2_BLAS_INCLUDE_DIR blis.h
+        PATH_SUFFIXES blis
+        DOC "Path to BLIS include directory.")
+    FIND_LIBRARY(N2D2_BLAS_LIBRARIES NAMES blis
+        DOC "Path to BLIS library.")
+    SET(N2D2_BLAS_FLAGS "-DBLIS=1")
+elseif (NOT N2D2_BLAS STREQUAL "Builtin")
+    MESSAGE(FATAL_ERROR "Unknown N2D2_BLAS backend: ${N2D2_BLAS}"
+        " (should be Builtin, OpenBLAS, MKL or BLIS)")
+endif()
+
+if (NOT N2D2_BLAS STREQUAL "Builtin")
+    if (NOT N2D2_BLAS_INCLUDE_DIR OR NOT N2D2_BLAS_LIBRARIES)
+        MESSAGE(FATAL_ERROR "${N2D2_BLAS} not found - set N2D2_BLAS to"
+            " Builtin to use the built-in GEMM")
+    endif()
+
+    message(STATUS "CPU BLAS library status:")
+    message(STATUS "    backend: ${N2D2_BLAS}")
+    message(STATUS "    include path: ${N2D2_BLAS_INCLUDE_DIR}")
+    message(STATUS "    libraries: ${N2D2_BLAS_LIBRARIES}")
+
+    INCLUDE_DIRECTORIES(SYSTEM ${N2D2_BLAS_INCLUDE_DIR})
+    SET(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} ${N2D2_BLAS_FLAGS}")
+endif()
+
 # Compiler flags
 if(MSVC)
     SET(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} /W3")
@@ -221,6 +268,10 @@ MACRO(N2D2_MAKE_LIBRARY name)
         TARGET_LINK_LIBRARIES(${name} ${PUGIXML_LIBRARIES})
     endif()
 
+    if (NOT N2D2_BLAS STREQUAL "Builtin")
+        TARGET_LINK_LIBRARIES(${name} ${N2D2_BLAS_LIBRARIES})
+    endif()
+
     if (MongoDB_FOUND)
         TARGET_LINK_LIBRARIES(${name} ${MongoDB_LIBRARIES})
         TARGET_LINK_LIBRARIES(${name} ${Boost_THREAD_LIBRARY}
@@ -55,6 +55,8 @@
 #include "Generator/DeepNetGenerator.hpp"
 #include "Target/TargetROIs.hpp"
 #include "Target/TargetScore.hpp"
+#include "containers/PoolAllocator.hpp"
+#include "utils/Gemm.hpp"
 
 #ifdef CUDA
 #include "CudaContext.hpp"
@@ -66,24 +68,186 @@ using namespace N2D2;
 unsigned int cudaDevice = 0;
 #endif
 
-void learnThreadWrapper(const std::shared_ptr<DeepNet>& deepNet,
-                        std::vector<std::pair<std::string, double> >* timings
-                            = NULL)
+/// Persistent compute thread, fed with one batch at a time by the data
+/// (main) thread. The network reads its inputs from the StimuliProvider
+/// current batch, so a single batch can be handed off while the data thread
+/// gets the next one. Deeper read-ahead is done by the StimuliProvider
+/// prefetch workers (PrefetchDepth), whose ready batches are only swapped
+/// in by the data thread.
+class ComputeThread {
+public:
+    enum Job {
+        None,
+        Learn,
+        Validation,
+        Stop
+    };
+
+    ComputeThread(const std::shared_ptr<DeepNet>& deepNet);
+    void submit(Job job,
+                std::vector<std::pair<std::string, double> >* timings = NULL);
+    void wait();
+    /// Time spent by the compute thread waiting for data, and by the data
+    /// thread waiting for the compute thread, since the last reset. A wait in
+    /// progress at the reset only counts from the reset.
+    void getWaitTimes(double& computeWait, double& dataWait) const;
+    void resetWaitTimes();
+    ~ComputeThread();
+
+private:
+    void run();
+
+    const std::shared_ptr<DeepNet> mDeepNet;
+    Job mJob;
+    std::vector<std::pair<std::string, double> >* mTimings;
+    bool mBusy;
+    std::exception_ptr mError;
+    double mComputeWait;
+    double mDataWait;
+    /// Start of the current compute thread wait
+    std::chrono::high_resolution_clock::time_point mIdleSince;
+    mutable std::mutex mMutex;
+    std::condition_variable mJobCond;
+    std::condition_variable mDoneCond;
+    std::thread mThread;
+};
+
+ComputeThread::ComputeThread(const std::shared_ptr<DeepNet>& deepNet)
+    : mDeepNet(deepNet),
+      mJob(None),
+      mTimings(NULL),
+      mBusy(false),
+      mComputeWait(0.0),
+      mDataWait(0.0),
+      mIdleSince(std::chrono::high_resolution_clock::now()),
+      mThread(&ComputeThread::run, this)
 {
-#ifdef CUDA
-    CudaContext::setDevice(cudaDevice);
-#endif
+    // ctor
+}
 
-    deepNet->learn(timings);
+void ComputeThread::submit(Job job,
+                           std::vector<std::pair<std::string, double> >*
+                               timings)
+{
+    wait();
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mJob = job;
+        mTimings = timings;
+        mBusy = true;
+    }
+
+    mJobCond.notify_one();
 }
 
-void validationThreadWrapper(const std::shared_ptr<DeepNet>& deepNet)
+void ComputeThread::wait()
+{
+    std::exception_ptr error;
+
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+
+        if (mBusy) {
+            const std::chrono::high_resolution_clock::time_point startTime
+                = std::chrono::high_resolution_clock::now();
+
+            while (mBusy)
+                mDoneCond.wait(lock);
+
+            mDataWait += std::chrono::duration_cast
+                <std::chrono::duration<double> >(
+                    std::chrono::high_resolution_clock::now() - startTime)
+                    .count();
+        }
+
+        std::swap(error, mError);
+    }
+
+    if (error)
+        std::rethrow_exception(error);
+}
+
+void ComputeThread::getWaitTimes(double& computeWait, double& dataWait) const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    computeWait = mComputeWait;
+    dataWait = mDataWait;
+}
+
+void ComputeThread::resetWaitTimes()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mComputeWait = 0.0;
+    mDataWait = 0.0;
+    mIdleSince = std::chrono::high_resolution_clock::now();
+}
+
+ComputeThread::~ComputeThread()
+{
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+
+        // Let the pending job finish before stopping
+        while (mBusy)
+            mDoneCond.wait(lock);
+
+        mJob = Stop;
+        mBusy = true;
+    }
+
+    mJobCond.notify_one();
+    mThread.join();
+}
+
+void ComputeThread::run()
 {
 #ifdef CUDA
     CudaContext::setDevice(cudaDevice);
 #endif
 
-    deepNet->test(Database::Validation);
+    while (true) {
+        Job job;
+        std::vector<std::pair<std::string, double> >* timings;
+
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mIdleSince = std::chrono::high_resolution_clock::now();
+
+            while (!mBusy)
+                mJobCond.wait(lock);
+
+            mComputeWait += std::chrono::duration_cast
+                <std::chrono::duration<double> >(
+                    std::chrono::high_resolution_clock::now() - mIdleSince)
+                    .count();
+
+            job = mJob;
+            timings = mTimings;
+        }
+
+        if (job == Stop)
+            return;
+
+        try {
+            if (job == Learn)
+                mDeepNet->learn(timings);
+            else if (job == Validation)
+                mDeepNet->test(Database::Validation, timings);
+        }
+        catch (...) {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mError = std::current_exception();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mJob = None;
+            mBusy = false;
+        }
+
+        mDoneCond.notify_one();
+    }
 }
 
 int main(int argc, char* argv[]) try
@@ -102,6 +266,25 @@ int main(int argc, char* argv[]) try
         "-stop-valid", 0U, "max. number of successive lower score validation");
     const bool test = opts.parse("-test", "perform testing");
     const bool bench = opts.parse("-bench", "learning speed benchmarking");
+    const double checkpointMem
+        = opts.parse("-checkpoint-mem", 0.0, "cells outputs memory budget "
+                     "(MB) for learning, the other outputs being recomputed "
+                     "during the back-propagation (0 = disabled)");
+    const bool fuse = opts.parse("-fuse", "fold the BatchNorm cells into the "
+                                          "convolutions of a copy of the "
+                                          "network for testing");
+    const unsigned int quantize
+        = opts.parse("-quantize", 0U, "quantize the convolution and fully "
+                     "connected cells on n bits for testing (0 = disabled)");
+    const unsigned int calibBatches
+        = opts.parse("-calib", 10U, "number of validation batches used to "
+                     "calibrate the quantization");
+    const Quantization::Calibration calibration
+        = opts.parse("-calib-method", Quantization::KL, "quantization "
+                     "calibration method (MaxAbs or KL)");
+    const bool memPlan = opts.parse("-mem-plan", "share the cells outputs "
+                                    "buffers according to their lifetime and "
+                                    "release the gradients for testing");
     const unsigned int learnStdp
         = opts.parse("-learn-stdp", 0U, "number of STDP learning steps");
     const unsigned int avgWindow
@@ -125,6 +308,10 @@ int main(int argc, char* argv[]) try
         = opts.parse("-uenv", "unsigned env data for exports");
     const double timeStep
         = opts.parse("-ts", 0.1, "timestep for clock-based simulations (ns)");
+    const Network::Scheduler scheduler
+        = opts.parse("-scheduler", Network::PriorityQueue, "event scheduler "
+                     "for event-based simulations (PriorityQueue or "
+                     "TimingWheel)");
     const std::string weights = opts.parse<std::string>(
         "-w",
         "",
@@ -150,7 +337,7 @@ int main(int argc, char* argv[]) try
         seed = Network::readSeed("seed.dat");
 
     // Network topology construction
-    Network net(seed);
+    Network net(seed, scheduler);
     std::shared_ptr<DeepNet> deepNet
         = DeepNetGenerator::generate(net, iniConfig);
     deepNet->initialize();
@@ -257,9 +444,35 @@ int main(int argc, char* argv[]) try
         StimuliProvider::logData(fileName.str(), sp.getData()[0]);
     }
 
+    if (bench)
+        std::cout << "CPU BLAS backend: " << Gemm::getBackend() << std::endl;
+
     if (learn > 0) {
         deepNet->exportNetworkFreeParameters("weights_init");
 
+        if (checkpointMem > 0.0) {
+            const std::size_t budget = checkpointMem * 1024.0 * 1024.0;
+            const DeepNet::CheckpointPlan plan
+                = deepNet->planCheckpoints(budget);
+
+            std::cout << "Checkpointing: " << plan.nbRecomputedCells
+                      << " cell(s) recomputed in " << plan.nbCheckpoints
+                      << " segment(s), " << plan.initialBytes / 1024.0 / 1024.0
+                      << " MB -> " << plan.peakBytes / 1024.0 / 1024.0
+                      << " MB of outputs, +"
+                      << ((plan.forwardConnections > 0)
+                          ? 100.0 * plan.recomputedConnections
+                            / plan.forwardConnections
+                          : 0.0)
+                      << "% forward connections" << std::endl;
+
+            if (plan.peakBytes > budget) {
+                std::cout << Utils::cwarning << "The outputs do not fit in "
+                          "the checkpointing memory budget" << Utils::cdef
+                          << std::endl;
+            }
+        }
+
         std::chrono::high_resolution_clock::time_point startTime
             = std::chrono::high_resolution_clock::now();
         double minTimeElapsed = 0.0;
@@ -274,18 +487,22 @@ int main(int argc, char* argv[]) try
         sp.readRandomBatch(Database::Learn);
 
         std::vector<std::pair<std::string, double> > timings, cumTimings;
+        ComputeThread computeThread(deepNet);
+        // Start of the wait times measurement, which leaves out the
+        // validation and the logs
+        std::chrono::high_resolution_clock::time_point waitStartTime
+            = std::chrono::high_resolution_clock::now();
 
         for (unsigned int b = 0; b < nbBatch; ++b) {
             const unsigned int i = b * batchSize;
 
             sp.synchronize();
-            std::thread learnThread(learnThreadWrapper,
-                                    deepNet,
-                                    (bench) ? &timings : NULL);
+            computeThread.submit(ComputeThread::Learn,
+                                 (bench) ? &timings : NULL);
 
             sp.future();
             sp.readRandomBatch(Database::Learn);
-            learnThread.join();
+            computeThread.wait();
 
             if (logOutputs && i == 0) {
                 std::cout << "First stimulus ID: " << sp.getBatch()[0]
@@ -350,7 +567,26 @@ int main(int argc, char* argv[]) try
                              " (" << std::setw(7) << std::fixed
                           << std::setprecision(0)
                           << 60.0 * (report / timeElapsed)
-                          << " p./min)         " << std::setprecision(4)
+                          << " p./min)";
+
+                double computeWait, dataWait;
+                computeThread.getWaitTimes(computeWait, dataWait);
+                computeThread.resetWaitTimes();
+
+                const double waitTimeElapsed = std::chrono::duration_cast
+                                               <std::chrono::duration<double> >
+                                               (curTime - waitStartTime)
+                                                   .count();
+                waitStartTime = curTime;
+
+                // Overlap of the compute and data threads: share of the
+                // learning time each one spent waiting for the other
+                std::cout << " wait: compute " << std::setw(5)
+                          << std::setprecision(1)
+                          << (100.0 * computeWait / waitTimeElapsed)
+                          << "%, data " << std::setw(5)
+                          << (100.0 * dataWait / waitTimeElapsed)
+                          << "%         " << std::setprecision(4)
                           << std::flush;
 
                 std::cout.flags(f);
@@ -390,6 +626,43 @@ int main(int argc, char* argv[]) try
                     Utils::createDirectories("timings");
 
                     deepNet->logTimings("timings/learning_timings.dat", cumTimings);
+
+                    const MemoryPool::Stats memStats = MemoryPool::getStats();
+                    std::cout << "Tensor allocations: "
+                              << memStats.nbAllocations << " ("
+                              << memStats.nbHeapAllocations
+                              << " from heap), pool: "
+                              << (memStats.peakBytes / 1048576.0) << " MB"
+                              << std::endl;
+                    MemoryPool::resetStats();
+
+                    if (sp.getPrefetchDepth() > 0) {
+                        const StimuliProvider::PrefetchStats prefetchStats
+                            = sp.getPrefetchStats();
+                        const double nbBatches
+                            = std::max(1ULL, prefetchStats.nbBatches);
+
+                        std::cout << "Prefetch: avg. queue depth "
+                                  << (prefetchStats.cumQueueDepth / nbBatches)
+                                  << "/" << sp.getPrefetchDepth() << ", "
+                                  << prefetchStats.nbStalls << " stalls ("
+                                  << prefetchStats.stallTime << " s)"
+                                  << std::endl;
+                        sp.resetPrefetchStats();
+                    }
+
+                    const MatCache::Stats cacheStats
+                        = database.getCacheStats();
+
+                    if (cacheStats.nbHits + cacheStats.nbMisses > 0) {
+                        std::cout << "Stimuli cache: " << cacheStats.nbHits
+                                  << " hits, " << cacheStats.nbMisses
+                                  << " misses, " << cacheStats.nbEvictions
+                                  << " evictions, "
+                                  << (cacheStats.bytes / 1048576.0) << " MB"
+                                  << std::endl;
+                        database.resetCacheStats();
+                    }
                 }
 
                 deepNet->logEstimatedLabels("learning");
@@ -411,12 +684,11 @@ int main(int argc, char* argv[]) try
                         const unsigned int k = bv * batchSize;
 
                         sp.synchronize();
-                        std::thread validationThread(validationThreadWrapper,
-                                                     deepNet);
+                        computeThread.submit(ComputeThread::Validation);
 
                         sp.future();
                         sp.readBatch(Database::Validation, k);
-                        validationThread.join();
+                        computeThread.wait();
 
                         // Progress bar
                         progress
@@ -494,6 +766,10 @@ int main(int argc, char* argv[]) try
                     deepNet->clear(Database::Validation);
                 } else
                     deepNet->exportNetworkFreeParameters("weights");
+
+                // The compute thread was idle or validating meanwhile
+                computeThread.resetWaitTimes();
+                waitStartTime = std::chrono::high_resolution_clock::now();
             }
         }
 
@@ -503,11 +779,77 @@ int main(int argc, char* argv[]) try
         sp.synchronize();
     }
 
+    // Free parameters of the tested network
+    std::string testWeights = weights;
+
     if (weights.empty() || learn > 0) {
-        if (database.getNbStimuli(Database::Validation) > 0)
-            deepNet->importNetworkFreeParameters("weights_validation");
-        else
-            deepNet->importNetworkFreeParameters("weights");
+        testWeights = (database.getNbStimuli(Database::Validation) > 0)
+                          ? "weights_validation"
+                          : "weights";
+        deepNet->importNetworkFreeParameters(testWeights);
+    }
+
+    std::shared_ptr<DeepNet> testNet = deepNet;
+
+    if (fuse) {
+        // The learned network is left untouched: a copy of it, fed by the
+        // same stimuli provider, is fused and tested instead
+        testNet = DeepNetGenerator::generate(net, iniConfig, deepNet);
+        testNet->initialize();
+        testNet->importNetworkFreeParameters(testWeights, true);
+
+        const unsigned int nbFused = testNet->fuseCells();
+        std::cout << "Fused " << nbFused << " cell(s) for inference"
+                  << std::endl;
+    }
+
+    if (quantize > 0) {
+        // The signals histograms are collected on the validation set, or on
+        // the learning set if there is none, never on the test set
+        const Database::StimuliSet calibSet
+            = (database.getNbStimuli(Database::Validation) > 0)
+                  ? Database::Validation
+                  : Database::Learn;
+        const unsigned int batchSize = sp.getBatchSize();
+        const unsigned int nbBatch = std::min(calibBatches,
+            (unsigned int)std::ceil(database.getNbStimuli(calibSet)
+                                    / (double)batchSize));
+
+        std::map<std::string, Quantization::Histogram> outputsHistogram;
+
+        for (unsigned int b = 0; b < nbBatch; ++b) {
+            sp.readBatch(calibSet, b * batchSize);
+            testNet->test(calibSet);
+            testNet->reportOutputsHistogram(outputsHistogram);
+        }
+
+        testNet->clear(calibSet);
+
+        const unsigned int nbQuantized
+            = testNet->quantize(outputsHistogram, quantize, calibration);
+        std::cout << "Quantized " << nbQuantized << " cell(s) on " << quantize
+                  << " bits (" << nbBatch << " calibration batch(es))"
+                  << std::endl;
+    }
+
+    // The planned outputs are released after each layer: the outputs range
+    // cannot be collected
+    bool outputsPlanned = false;
+
+    if (memPlan) {
+        if (logOutputs) {
+            std::cout << Utils::cwarning << "Memory planning is disabled with "
+                      "-log-outputs" << Utils::cdef << std::endl;
+        }
+        else {
+            const DeepNet::MemoryPlan plan = testNet->planMemory();
+            outputsPlanned = true;
+            std::cout << "Memory plan: " << plan.nbPlannedCells
+                      << " cell(s) outputs in " << plan.nbSlots
+                      << " slot(s), " << plan.initialBytes / 1024.0 / 1024.0
+                      << " MB -> " << plan.plannedBytes / 1024.0 / 1024.0
+                      << " MB" << std::endl;
+        }
     }
 
     if (testIdx >= 0) {
@@ -516,8 +858,8 @@ int main(int argc, char* argv[]) try
         std::cout << "Pattern label ID = " << label << std::endl;
 
         for (std::vector<std::shared_ptr<Target> >::const_iterator itTargets
-             = deepNet->getTargets().begin(),
-             itTargetsEnd = deepNet->getTargets().end();
+             = testNet->getTargets().begin(),
+             itTargetsEnd = testNet->getTargets().end();
              itTargets != itTargetsEnd;
              ++itTargets) {
             std::cout << "Output target = "
@@ -527,7 +869,7 @@ int main(int argc, char* argv[]) try
 
     try
     {
-        std::shared_ptr<Cell_Frame_Top> cellFrame = deepNet->getTargetCell
+        std::shared_ptr<Cell_Frame_Top> cellFrame = testNet->getTargetCell
                                                     <Cell_Frame_Top>();
 
         std::map<std::string, DeepNet::RangeStats> outputsRange;
@@ -549,16 +891,19 @@ int main(int argc, char* argv[]) try
                 const unsigned int idx = (testIdx >= 0) ? testIdx : i;
 
                 sp.readBatch(Database::Test, idx);
-                deepNet->test(Database::Test, &timings);
-                deepNet->reportOutputsRange(outputsRange);
-                deepNet->logEstimatedLabels("test");
+                testNet->test(Database::Test, &timings);
+
+                if (!outputsPlanned)
+                    testNet->reportOutputsRange(outputsRange);
+
+                testNet->logEstimatedLabels("test");
 
                 if (logOutputs && i == 0) {
                     std::cout << "First stimulus ID: " << sp.getBatch()[0]
                               << std::endl;
                     std::cout << "First stimulus label: "
                               << sp.getLabelsData()[0](0) << std::endl;
-                    deepNet->logOutputs("outputs_test");
+                    testNet->logOutputs("outputs_test");
                 }
 
                 if (!cumTimings.empty()) {
@@ -578,8 +923,8 @@ int main(int argc, char* argv[]) try
                     std::cout << "Testing #" << idx << "   ";
 
                     for (std::vector<std::shared_ptr<Target> >::const_iterator
-                             itTargets = deepNet->getTargets().begin(),
-                             itTargetsEnd = deepNet->getTargets().end();
+                             itTargets = testNet->getTargets().begin(),
+                             itTargetsEnd = testNet->getTargets().end();
                          itTargets != itTargetsEnd;
                          ++itTargets) {
                         std::shared_ptr<TargetScore> target
@@ -598,8 +943,8 @@ int main(int argc, char* argv[]) try
                     nextLog += report;
 
                     for (std::vector<std::shared_ptr<Target> >::const_iterator
-                             itTargets = deepNet->getTargets().begin(),
-                             itTargetsEnd = deepNet->getTargets().end();
+                             itTargets = testNet->getTargets().begin(),
+                             itTargetsEnd = testNet->getTargets().end();
                          itTargets != itTargetsEnd;
                          ++itTargets) {
                         std::shared_ptr<TargetScore> target
@@ -615,7 +960,7 @@ int main(int argc, char* argv[]) try
             }
 
             if (nbTest > 0) {
-                deepNet->log("test", Database::Test);
+                testNet->log("test", Database::Test);
                 for (std::vector<std::pair<std::string, double> >::iterator it
                      = cumTimings.begin(),
                      itEnd = cumTimings.end();
@@ -626,11 +971,11 @@ int main(int argc, char* argv[]) try
 
                 Utils::createDirectories("timings");
 
-                deepNet->logTimings("timings/inference_timings.dat", cumTimings);
+                testNet->logTimings("timings/inference_timings.dat", cumTimings);
 
                 for (std::vector<std::shared_ptr<Target> >::const_iterator
-                         itTargets = deepNet->getTargets().begin(),
-                         itTargetsEnd = deepNet->getTargets().end();
+                         itTargets = testNet->getTargets().begin(),
+                         itTargetsEnd = testNet->getTargets().end();
                      itTargets != itTargetsEnd;
                      ++itTargets) {
                     std::shared_ptr<TargetScore> target
@@ -649,9 +994,17 @@ int main(int argc, char* argv[]) try
                 }
             }
 
-            deepNet->logOutputsRange("test_outputs_range.dat", outputsRange);
-            deepNet->normalizeOutputsRange(outputsRange, 0.25);
-            deepNet->exportNetworkFreeParameters("weights_normalized");
+            if (outputsPlanned) {
+                std::cout << Utils::cwarning << "Outputs range and weights "
+                          "normalization are disabled with -mem-plan"
+                          << Utils::cdef << std::endl;
+            }
+            else {
+                testNet->logOutputsRange("test_outputs_range.dat",
+                                         outputsRange);
+                testNet->normalizeOutputsRange(outputsRange, 0.25);
+                testNet->exportNetworkFreeParameters("weights_normalized");
+            }
         }
     }
     catch (const std::exception& e)
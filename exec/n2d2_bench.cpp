@@ -0,0 +1,641 @@
+/*
+    (C) Copyright 2016 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+/**
+ * Performance benchmarks of the CPU Frame models, with JSON output.
+ *
+ * - Micro-benchmarks: the ConvCell_Frame, FcCell_Frame, PoolCell_Frame,
+ *   BatchNormCell_Frame, LRNCell_Frame and SoftmaxCell_Frame cells are swept
+ *   over typical layer shapes, batch sizes and number of OpenMP threads. The
+ *   forward (propagate()) and backward (backPropagate()) passes are timed
+ *   separately.
+ * - Macro-benchmarks (-models option): learning and inference throughput, in
+ *   images/s, of the networks described by INI files. The [database] section
+ *   is ignored and the stimuli and labels are randomly generated in memory,
+ *   so that no dataset is required and the data loading is not measured.
+ *
+ * The FLOP counts are nominal: 2 operations per multiply-accumulate for the
+ * Conv and Fc cells (the backward pass computes both the input and the
+ * weights gradients), and an approximate number of operations per element for
+ * the other cells. The bytes moved are the compulsory memory traffic, i.e.
+ * the size of the inputs, outputs and parameters read or written by a pass.
+*/
+
+#include "N2D2.hpp"
+
+#include "DeepNet.hpp"
+#include "Cell/BatchNormCell_Frame.hpp"
+#include "Cell/ConvCell_Frame.hpp"
+#include "Cell/FcCell_Frame.hpp"
+#include "Cell/LRNCell_Frame.hpp"
+#include "Cell/PoolCell_Frame.hpp"
+#include "Cell/SoftmaxCell_Frame.hpp"
+#include "Generator/DeepNetGenerator.hpp"
+#include "utils/Gemm.hpp"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace N2D2;
+
+struct CellShape {
+    /// Conv, Fc, MaxPool, AvgPool, BatchNorm, LRN or Softmax
+    const char* type;
+    const char* name;
+    unsigned int width;
+    unsigned int height;
+    unsigned int nbChannels;
+    unsigned int nbOutputs;
+    /// Kernel or pooling size
+    unsigned int size;
+    unsigned int stride;
+    unsigned int padding;
+};
+
+const CellShape cellShapes[] = {
+    // LeNet, CIFAR and ResNet/VGG-like layers
+    {"Conv", "conv5x5_1-20_28x28", 28, 28, 1, 20, 5, 1, 0},
+    {"Conv", "conv3x3_3-32_32x32", 32, 32, 3, 32, 3, 1, 1},
+    {"Conv", "conv3x3_64-64_28x28", 28, 28, 64, 64, 3, 1, 1},
+    {"Conv", "conv3x3_128-128_14x14", 14, 14, 128, 128, 3, 1, 1},
+    {"Conv", "conv1x1_256-64_14x14", 14, 14, 256, 64, 1, 1, 0},
+    {"Fc", "fc_800-500", 4, 4, 50, 500, 0, 0, 0},
+    {"Fc", "fc_2048-1000", 1, 1, 2048, 1000, 0, 0, 0},
+    {"MaxPool", "maxpool2x2_64_56x56", 56, 56, 64, 64, 2, 2, 0},
+    {"AvgPool", "avgpool3x3s2_128_28x28", 28, 28, 128, 128, 3, 2, 0},
+    {"BatchNorm", "bn_64_56x56", 56, 56, 64, 64, 0, 0, 0},
+    {"BatchNorm", "bn_256_14x14", 14, 14, 256, 256, 0, 0, 0},
+    {"LRN", "lrn_64_28x28", 28, 28, 64, 64, 0, 0, 0},
+    {"Softmax", "softmax_1000", 1, 1, 1000, 1000, 0, 0, 0},
+    {"Softmax", "softmax_21_32x32", 32, 32, 21, 21, 0, 0, 0}};
+
+struct PassStats {
+    double mean;
+    double min;
+    double flops;
+    double bytes;
+};
+
+std::vector<unsigned int> parseList(const std::string& value)
+{
+    const std::vector<std::string> items = Utils::split(value, ",", true);
+    std::vector<unsigned int> list;
+
+    for (std::vector<std::string>::const_iterator it = items.begin(),
+                                                  itEnd = items.end();
+         it != itEnd;
+         ++it) {
+        std::stringstream itemStr(*it);
+        unsigned int item;
+
+        if (!(itemStr >> item) || !itemStr.eof() || item == 0)
+            throw std::runtime_error("Invalid list item: " + (*it));
+
+        list.push_back(item);
+    }
+
+    return list;
+}
+
+/// Maximum number of OpenMP threads (1 without OpenMP)
+unsigned int getMaxThreads()
+{
+#ifdef _OPENMP
+    return omp_get_max_threads();
+#else
+    return 1;
+#endif
+}
+
+void setNbThreads(unsigned int nbThreads)
+{
+#ifdef _OPENMP
+    omp_set_num_threads(nbThreads);
+#else
+    (void)nbThreads;
+#endif
+}
+
+std::string jsonString(const std::string& str)
+{
+    std::ostringstream jsonStr;
+    jsonStr << "\"";
+
+    for (std::string::const_iterator it = str.begin(), itEnd = str.end();
+         it != itEnd;
+         ++it) {
+        if ((*it) == '"' || (*it) == '\\')
+            jsonStr << "\\" << (*it);
+        else if ((unsigned char)(*it) < 0x20)
+            jsonStr << " ";
+        else
+            jsonStr << (*it);
+    }
+
+    jsonStr << "\"";
+    return jsonStr.str();
+}
+
+std::string jsonPass(const PassStats& stats)
+{
+    std::ostringstream jsonStr;
+    jsonStr << "{\"time_ms\": " << 1.0e3 * stats.mean
+            << ", \"min_time_ms\": " << 1.0e3 * stats.min
+            << ", \"flops\": " << stats.flops
+            << ", \"gflops_s\": " << 1.0e-9 * stats.flops / stats.mean
+            << ", \"bytes\": " << stats.bytes
+            << ", \"gbytes_s\": " << 1.0e-9 * stats.bytes / stats.mean << "}";
+    return jsonStr.str();
+}
+
+std::shared_ptr<Cell_Frame> createCell(const CellShape& shape)
+{
+    const std::string type = shape.type;
+    const std::shared_ptr<Activation<Float_T> > noActivation;
+
+    if (type == "Conv") {
+        std::shared_ptr<ConvCell_Frame> cell(new ConvCell_Frame(
+            shape.name, shape.size, shape.size, shape.nbOutputs, 1, 1,
+            shape.stride, shape.stride, shape.padding, shape.padding,
+            noActivation));
+        cell->setParameter("NoBias", false);
+        return cell;
+    }
+    else if (type == "Fc") {
+        std::shared_ptr<FcCell_Frame> cell(
+            new FcCell_Frame(shape.name, shape.nbOutputs, noActivation));
+        cell->setParameter("NoBias", false);
+        return cell;
+    }
+    else if (type == "MaxPool" || type == "AvgPool") {
+        return std::make_shared<PoolCell_Frame>(
+            shape.name, shape.size, shape.size, shape.nbOutputs, shape.stride,
+            shape.stride, shape.padding, shape.padding,
+            (type == "MaxPool") ? PoolCell::Max : PoolCell::Average,
+            noActivation);
+    }
+    else if (type == "BatchNorm") {
+        return std::make_shared<BatchNormCell_Frame>(
+            shape.name, shape.nbOutputs, noActivation);
+    }
+    else if (type == "LRN")
+        return std::make_shared<LRNCell_Frame>(shape.name, shape.nbOutputs);
+    else if (type == "Softmax")
+        return std::make_shared<SoftmaxCell_Frame>(shape.name,
+                                                   shape.nbOutputs);
+    else
+        throw std::runtime_error("Unknown cell type: " + type);
+}
+
+/// Nominal number of operations of the forward (first) and backward (second)
+/// passes, for a single stimulus
+std::pair<double, double> nominalFlops(const CellShape& shape,
+                                       const Cell_Frame& cell)
+{
+    const std::string type = shape.type;
+    const double inputsSize = (double)shape.width * shape.height
+                              * shape.nbChannels;
+    const double outputsSize = (double)cell.getOutputsWidth()
+                               * cell.getOutputsHeight() * cell.getNbOutputs();
+
+    if (type == "Conv") {
+        const double macs = (double)shape.size * shape.size * shape.nbChannels
+                            * outputsSize;
+        return std::make_pair(2.0 * macs, 4.0 * macs);
+    }
+    else if (type == "Fc")
+        return std::make_pair(2.0 * inputsSize * shape.nbOutputs,
+                              4.0 * inputsSize * shape.nbOutputs);
+    else if (type == "MaxPool" || type == "AvgPool") {
+        const double ops = (double)shape.size * shape.size * outputsSize;
+        return std::make_pair(ops, ops);
+    }
+    else if (type == "BatchNorm") {
+        // Mean, variance, normalization and scale/shift
+        return std::make_pair(8.0 * inputsSize, 12.0 * inputsSize);
+    }
+    else if (type == "LRN") {
+        const double n = cell.getParameter<unsigned int>("N");
+        return std::make_pair((2.0 * n + 4.0) * inputsSize,
+                              (3.0 * n + 5.0) * inputsSize);
+    }
+    else {
+        // Softmax without loss: the gradient is a full Jacobian product
+        return std::make_pair(4.0 * inputsSize,
+                              3.0 * shape.nbOutputs * inputsSize);
+    }
+}
+
+/// Number of free parameters of the cell
+double nbParameters(const CellShape& shape)
+{
+    const std::string type = shape.type;
+
+    if (type == "Conv")
+        return (double)shape.nbOutputs
+               * (shape.size * shape.size * shape.nbChannels + 1);
+    else if (type == "Fc")
+        return (double)shape.nbOutputs
+               * (shape.width * shape.height * shape.nbChannels + 1);
+    else if (type == "BatchNorm")
+        return 4.0 * shape.nbOutputs;
+    else
+        return 0.0;
+}
+
+template <class T>
+PassStats timePass(T& cell,
+                   void (T::*pass)(),
+                   unsigned int nbIterations,
+                   unsigned int nbWarmup)
+{
+    for (unsigned int i = 0; i < nbWarmup; ++i)
+        (cell.*pass)();
+
+    PassStats stats;
+    stats.mean = 0.0;
+    stats.min = std::numeric_limits<double>::max();
+
+    for (unsigned int i = 0; i < nbIterations; ++i) {
+        const std::chrono::high_resolution_clock::time_point time1
+            = std::chrono::high_resolution_clock::now();
+        (cell.*pass)();
+        const std::chrono::high_resolution_clock::time_point time2
+            = std::chrono::high_resolution_clock::now();
+        const double elapsed = std::chrono::duration_cast
+            <std::chrono::duration<double> >(time2 - time1).count();
+
+        stats.mean += elapsed;
+        stats.min = std::min(stats.min, elapsed);
+    }
+
+    stats.mean /= nbIterations;
+    return stats;
+}
+
+class CellBench {
+public:
+    CellBench(Cell_Frame& cell) : mCell(cell) {};
+    void propagate()
+    {
+        mCell.propagate();
+    };
+    void backPropagate()
+    {
+        mCell.backPropagate();
+    };
+
+private:
+    Cell_Frame& mCell;
+};
+
+class DeepNetBench {
+public:
+    DeepNetBench(DeepNet& deepNet) : mDeepNet(deepNet) {};
+    void learn()
+    {
+        mDeepNet.learn();
+    };
+    void test()
+    {
+        mDeepNet.test(Database::Test);
+    };
+
+private:
+    DeepNet& mDeepNet;
+};
+
+void benchCells(std::ostream& json,
+                const std::vector<unsigned int>& threads,
+                const std::vector<unsigned int>& batches,
+                const std::vector<std::string>& types,
+                unsigned int nbIterations,
+                unsigned int nbWarmup)
+{
+    bool first = true;
+    json << "  \"micro\": [";
+
+    for (unsigned int s = 0; s < sizeof(cellShapes) / sizeof(cellShapes[0]);
+         ++s) {
+        const CellShape& shape = cellShapes[s];
+
+        if (!types.empty() && std::find(types.begin(), types.end(),
+                                        std::string(shape.type)) == types.end())
+            continue;
+
+        for (std::vector<unsigned int>::const_iterator itBatch
+             = batches.begin(),
+             itBatchEnd = batches.end();
+             itBatch != itBatchEnd;
+             ++itBatch) {
+            // The cell is fed by a 1x1 average pooling cell, so that the
+            // input gradient is computed like anywhere else in a network
+            StimuliProvider sp(EmptyDatabase,
+                               shape.width,
+                               shape.height,
+                               shape.nbChannels,
+                               (*itBatch));
+            Random::fillUniform(sp.getData(), -1.0, 1.0, s);
+
+            Matrix<bool> identity(shape.nbChannels, shape.nbChannels, false);
+
+            for (unsigned int channel = 0; channel < shape.nbChannels;
+                 ++channel)
+                identity(channel, channel) = true;
+
+            PoolCell_Frame input("input", 1, 1, shape.nbChannels, 1, 1, 0, 0,
+                                 PoolCell::Average);
+            input.addInput(sp, 0, 0, 0, 0, identity);
+            input.initialize();
+            input.propagate();
+
+            std::shared_ptr<Cell_Frame> cell = createCell(shape);
+            const std::string type = shape.type;
+
+            if (type == "MaxPool" || type == "AvgPool")
+                cell->addInput(&input, identity);
+            else
+                cell->addInput(&input);
+
+            cell->initialize();
+
+            const std::pair<double, double> flops = nominalFlops(shape, *cell);
+            const double inputsSize = (double)(*itBatch) * shape.width
+                                      * shape.height * shape.nbChannels;
+            const double outputsSize = (double)cell->getOutputs().size();
+            const double parametersSize = nbParameters(shape);
+
+            CellBench bench(*cell);
+            double baseline = 0.0;
+
+            for (std::vector<unsigned int>::const_iterator itThreads
+                 = threads.begin(),
+                 itThreadsEnd = threads.end();
+                 itThreads != itThreadsEnd;
+                 ++itThreads) {
+                setNbThreads(*itThreads);
+
+                PassStats forward = timePass(
+                    bench, &CellBench::propagate, nbIterations, nbWarmup);
+                forward.flops = (*itBatch) * flops.first;
+                forward.bytes = sizeof(Float_T)
+                                * (inputsSize + outputsSize + parametersSize);
+
+                // Some cells only implement the inference
+                PassStats backward;
+                backward.mean = 0.0;
+
+                try {
+                    Random::fillUniform(cell->getDiffInputs(), -1.0, 1.0, s);
+                    backward = timePass(bench, &CellBench::backPropagate,
+                                        nbIterations, nbWarmup);
+                    backward.flops = (*itBatch) * flops.second;
+                    backward.bytes = 2 * sizeof(Float_T) * (inputsSize
+                                        + outputsSize + parametersSize);
+                }
+                catch (const std::runtime_error& e)
+                {
+                    std::cout << Utils::cnotice << "Notice: " << e.what()
+                              << Utils::cdef << std::endl;
+                }
+
+                const double elapsed = forward.mean + backward.mean;
+
+                if (itThreads == threads.begin())
+                    baseline = elapsed;
+
+                std::cout << "  " << shape.name << " batch=" << (*itBatch)
+                          << " threads=" << (*itThreads) << ": fwd "
+                          << 1.0e-9 * forward.flops / forward.mean
+                          << " GFLOP/s";
+
+                if (backward.mean > 0.0) {
+                    std::cout << ", bwd "
+                              << 1.0e-9 * backward.flops / backward.mean
+                              << " GFLOP/s";
+                }
+
+                std::cout << std::endl;
+
+                json << ((first) ? "\n" : ",\n")
+                     << "    {\"cell\": " << jsonString(type == "MaxPool"
+                                                       || type == "AvgPool"
+                                                       ? "Pool" : type)
+                     << ", \"name\": " << jsonString(shape.name)
+                     << ", \"inputs\": [" << shape.nbChannels << ", "
+                     << shape.height << ", " << shape.width << "]"
+                     << ", \"outputs\": [" << cell->getNbOutputs() << ", "
+                     << cell->getOutputsHeight() << ", "
+                     << cell->getOutputsWidth() << "]"
+                     << ", \"batch\": " << (*itBatch)
+                     << ", \"threads\": " << (*itThreads)
+                     << ",\n     \"forward\": " << jsonPass(forward)
+                     << ",\n     \"backward\": "
+                     << ((backward.mean > 0.0) ? jsonPass(backward) : "null")
+                     << ",\n     \"speedup\": " << baseline / elapsed << "}";
+                first = false;
+            }
+        }
+    }
+
+    json << "\n  ]";
+}
+
+void benchModels(std::ostream& json,
+                 const std::vector<unsigned int>& threads,
+                 const std::vector<std::string>& models,
+                 unsigned int nbIterations,
+                 unsigned int nbWarmup)
+{
+    bool first = true;
+    json << "  \"macro\": [";
+
+    for (std::vector<std::string>::const_iterator it = models.begin(),
+                                                  itEnd = models.end();
+         it != itEnd;
+         ++it) {
+        json << ((first) ? "\n" : ",\n") << "    {\"model\": "
+             << jsonString(Utils::baseName(*it));
+        first = false;
+
+        try {
+            IniParser iniConfig;
+            iniConfig.load(*it);
+            iniConfig.currentSection("", false);
+            iniConfig.eraseSection("database");
+
+            Network net;
+            std::shared_ptr<DeepNet> deepNet
+                = DeepNetGenerator::generate(net, iniConfig);
+            deepNet->initialize();
+
+            // Synthetic in-memory database: random stimuli and labels
+            StimuliProvider& sp = *deepNet->getStimuliProvider();
+            Random::fillUniform(sp.getData(), -1.0, 1.0, 0);
+
+            const std::vector<std::shared_ptr<Target> >& targets
+                = deepNet->getTargets();
+            unsigned int nbLabels = std::numeric_limits<unsigned int>::max();
+
+            for (std::vector<std::shared_ptr<Target> >::const_iterator
+                 itTargets = targets.begin(),
+                 itTargetsEnd = targets.end();
+                 itTargets != itTargetsEnd;
+                 ++itTargets) {
+                nbLabels = std::min(nbLabels, std::max(2U,
+                    (*itTargets)->getCell()->getNbOutputs()));
+            }
+
+            if (targets.empty())
+                nbLabels = 1;
+
+            Tensor4d<int>& labels = sp.getLabelsData();
+
+            for (unsigned int index = 0; index < labels.size(); ++index)
+                labels(index) = Random::randUniform(0, (int)nbLabels - 1);
+
+            const unsigned int batchSize = sp.getBatchSize();
+            DeepNetBench bench(*deepNet);
+            double baseline = 0.0;
+
+            json << ", \"batch\": " << batchSize << ", \"results\": [";
+
+            for (std::vector<unsigned int>::const_iterator itThreads
+                 = threads.begin(),
+                 itThreadsEnd = threads.end();
+                 itThreads != itThreadsEnd;
+                 ++itThreads) {
+                setNbThreads(*itThreads);
+
+                const PassStats learn = timePass(
+                    bench, &DeepNetBench::learn, nbIterations, nbWarmup);
+                const PassStats test = timePass(
+                    bench, &DeepNetBench::test, nbIterations, nbWarmup);
+
+                if (itThreads == threads.begin())
+                    baseline = learn.mean;
+
+                std::cout << "  " << (*it) << " threads=" << (*itThreads)
+                          << ": learn " << batchSize / learn.mean
+                          << " images/s, test " << batchSize / test.mean
+                          << " images/s" << std::endl;
+
+                json << ((itThreads == threads.begin()) ? "\n" : ",\n")
+                     << "      {\"threads\": " << (*itThreads)
+                     << ", \"learn_images_s\": " << batchSize / learn.mean
+                     << ", \"learn_time_ms\": " << 1.0e3 * learn.mean
+                     << ", \"test_images_s\": " << batchSize / test.mean
+                     << ", \"test_time_ms\": " << 1.0e3 * test.mean
+                     << ", \"speedup\": " << baseline / learn.mean << "}";
+            }
+
+            json << "\n    ]}";
+        }
+        catch (const std::exception& e)
+        {
+            std::cout << Utils::cwarning << "Warning: " << (*it)
+                      << " skipped: " << e.what() << Utils::cdef
+                      << std::endl;
+            json << ", \"error\": " << jsonString(e.what()) << "}";
+        }
+    }
+
+    json << "\n  ]";
+}
+
+int main(int argc, char* argv[]) try
+{
+    // Program command line options
+    ProgramOptions opts(argc, argv);
+    const std::string threadsList = opts.parse<std::string>(
+        "-threads", "", "comma-separated numbers of threads (default: powers "
+                        "of 2 up to the max. number of threads)");
+    const std::string batchList = opts.parse<std::string>(
+        "-batch", "1,32", "comma-separated batch sizes (micro-benchmarks)");
+    const std::string cellsList = opts.parse<std::string>(
+        "-cells", "", "comma-separated cell types to benchmark among Conv, "
+                      "Fc, MaxPool, AvgPool, BatchNorm, LRN and Softmax "
+                      "(default: all)");
+    const std::string modelsList = opts.parse<std::string>(
+        "-models", "", "comma-separated INI files of the networks to "
+                       "benchmark end-to-end");
+    const bool noMicro = opts.parse("-no-micro", "skip the micro-benchmarks");
+    const unsigned int nbIterations
+        = opts.parse("-iter", 10U, "number of timed iterations");
+    const unsigned int nbWarmup
+        = opts.parse("-warmup", 2U, "number of warm-up iterations");
+    const std::string outputFile = opts.parse<std::string>(
+        "-o", "bench.json", "JSON output file");
+    opts.done();
+
+    if (nbIterations == 0)
+        throw std::runtime_error("The number of iterations must be > 0");
+
+    const unsigned int maxThreads = getMaxThreads();
+    std::vector<unsigned int> threads = parseList(threadsList);
+
+#ifndef _OPENMP
+    if (!threads.empty() && threads != std::vector<unsigned int>(1, 1U)) {
+        std::cout << Utils::cnotice << "Notice: built without OpenMP, "
+                  "running with 1 thread only" << Utils::cdef << std::endl;
+        threads.clear();
+    }
+#endif
+
+    if (threads.empty()) {
+        for (unsigned int nbThreads = 1; nbThreads < maxThreads;
+             nbThreads *= 2)
+            threads.push_back(nbThreads);
+
+        threads.push_back(maxThreads);
+    }
+
+    std::ofstream json(outputFile.c_str());
+
+    if (!json.good())
+        throw std::runtime_error("Could not create JSON file: " + outputFile);
+
+    json << "{\n  \"backend\": " << jsonString(Gemm::getBackend())
+         << ",\n  \"max_threads\": " << maxThreads
+         << ",\n  \"float_size\": " << sizeof(Float_T)
+         << ",\n  \"iterations\": " << nbIterations << ",\n";
+
+    if (!noMicro) {
+        std::cout << "Micro-benchmarks..." << std::endl;
+        benchCells(json, threads, parseList(batchList),
+                   Utils::split(cellsList, ",", true), nbIterations, nbWarmup);
+        json << ",\n";
+    }
+
+    std::cout << "Macro-benchmarks..." << std::endl;
+    benchModels(json, threads, Utils::split(modelsList, ",", true),
+                nbIterations, nbWarmup);
+    json << "\n}\n";
+
+    setNbThreads(maxThreads);
+    std::cout << "Results written to " << outputFile << std::endl;
+    return 0;
+}
+catch (const std::exception& e)
+{
+    std::cout << "Error: " << e.what() << std::endl;
+    return 0;
+}
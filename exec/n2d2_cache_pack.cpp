@@ -0,0 +1,152 @@
+/*
+    (C) Copyright 2012 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+/**
+ * Convert a per-stimulus StimuliProvider cache (two "*_data_*.bin" and
+ * "*_labels_*.bin" files per stimulus) to the packed shard format, used with
+ * the PackedCache=1 option of the [sp] section.
+*/
+
+#include "N2D2.hpp"
+
+#include "utils/BinaryCvMat.hpp"
+#include "utils/ShardCache.hpp"
+
+using namespace N2D2;
+
+std::vector<cv::Mat> readCacheFile(const std::string& fileName)
+{
+    std::ifstream is(fileName.c_str(), std::ios::binary);
+
+    if (!is.good())
+        throw std::runtime_error("Could not read cache file: " + fileName);
+
+    std::vector<cv::Mat> data;
+
+    do {
+        data.push_back(cv::Mat());
+        BinaryCvMat::read(is, data.back());
+    } while (is.peek() != EOF);
+
+    return data;
+}
+
+int main(int argc, char* argv[]) try
+{
+    // Program command line options
+    ProgramOptions opts(argc, argv);
+    const std::string outputPath = opts.parse<std::string>(
+        "-o", "", "output packed cache path (default: same as input)");
+    const unsigned int shardSize
+        = opts.parse("-shard-size", 1024U, "max. size of a shard (in MB)");
+    const bool remove
+        = opts.parse("-remove", "remove the converted per-stimulus files");
+    const std::string cachePath
+        = opts.grab<std::string>("<cache path>", "per-stimulus cache path");
+    opts.done();
+
+    std::vector<std::string> dataFiles;
+    std::vector<std::string> labelsFiles;
+
+    DIR* pDir = opendir(cachePath.c_str());
+
+    if (pDir == NULL)
+        throw std::runtime_error("Couldn't open the cache directory: "
+                                 + cachePath);
+
+    struct dirent* pFile;
+
+    while ((pFile = readdir(pDir)) != NULL) {
+        const std::string fileName = pFile->d_name;
+
+        if (Utils::fileExtension(fileName) != "bin")
+            continue;
+
+        if (fileName.find("_data_") != std::string::npos)
+            dataFiles.push_back(fileName);
+        else if (fileName.find("_labels_") != std::string::npos)
+            labelsFiles.push_back(fileName);
+    }
+
+    closedir(pDir);
+    std::sort(dataFiles.begin(), dataFiles.end());
+    std::sort(labelsFiles.begin(), labelsFiles.end());
+
+    ShardCache cache((!outputPath.empty()) ? outputPath : cachePath,
+                     1024ULL * 1024ULL * shardSize);
+
+    std::cout << "Packing " << dataFiles.size() << " stimuli from \""
+              << cachePath << "\" into \"" << cache.getPath() << "\""
+              << std::endl;
+
+    // A stimulus is only marked as present in the packed cache once its
+    // labels are written, which must therefore come last
+    for (std::vector<std::string>::const_iterator it = dataFiles.begin(),
+                                                  itEnd = dataFiles.end();
+         it != itEnd;
+         ++it) {
+        cache.write(Utils::fileBaseName(*it),
+                    readCacheFile(cachePath + "/" + (*it)));
+    }
+
+    unsigned int nbStimuli = 0;
+
+    for (std::vector<std::string>::const_iterator it = labelsFiles.begin(),
+                                                  itEnd = labelsFiles.end();
+         it != itEnd;
+         ++it) {
+        const std::string key = Utils::fileBaseName(*it);
+        std::string dataKey = key;
+        dataKey.replace(dataKey.find("_labels_"), 8, "_data_");
+
+        if (!cache.contains(dataKey)) {
+            std::cout << Utils::cwarning << "Warning: no data for \"" << (*it)
+                      << "\", skipped" << Utils::cdef << std::endl;
+            continue;
+        }
+
+        cache.write(key, readCacheFile(cachePath + "/" + (*it)));
+        ++nbStimuli;
+    }
+
+    if (remove) {
+        for (std::vector<std::string>::const_iterator it = dataFiles.begin(),
+                                                      itEnd = dataFiles.end();
+             it != itEnd;
+             ++it)
+            std::remove((cachePath + "/" + (*it)).c_str());
+
+        for (std::vector<std::string>::const_iterator it
+             = labelsFiles.begin(),
+             itEnd = labelsFiles.end();
+             it != itEnd;
+             ++it)
+            std::remove((cachePath + "/" + (*it)).c_str());
+    }
+
+    std::cout << nbStimuli << " stimuli packed in " << cache.getNbShards()
+              << " shard(s)" << std::endl;
+    return 0;
+}
+catch (const std::exception& e)
+{
+    std::cout << "Error: " << e.what() << std::endl;
+    return 0;
+}
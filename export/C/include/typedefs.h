@@ -49,7 +49,7 @@ typedef float DATA_T;
 typedef float UDATA_T;
 typedef float SUM_T;
 #elif NB_BITS == 8
-typedef char DATA_T;
+typedef signed char DATA_T;
 typedef unsigned char UDATA_T;
 typedef int SUM_T;
 #elif NB_BITS == 16
@@ -0,0 +1,573 @@
+/*
+    (C) Copyright 2016 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#ifndef N2D2_EXPORTCPP_H
+#define N2D2_EXPORTCPP_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "n2d2_simd.hpp"
+#include "typedefs.h"
+#include "utils.h"
+
+#if NB_BITS > 0 && NB_BITS != 8 && NB_BITS != 16 && NB_BITS != 32
+#error "The CPP export only supports NB_BITS = 8, 16, 32 or floating point"
+#endif
+
+// Every buffer is stored in HWC order (channels innermost), so that a
+// kernel row of a convolution spans a contiguous run of inputs.
+
+void getFilesList(const std::string dir, std::vector<std::string>& files);
+
+template <class T>
+void envRead(const std::string& fileName,
+             unsigned int size,
+             unsigned int channelsHeight,
+             unsigned int channelsWidth,
+             T* data,
+             unsigned int outputsSize,
+             int32_t* outputTargets);
+
+void confusion_print(unsigned int nbOutputs, unsigned int* confusion);
+
+/**** Fixed-point scaling ****/
+// Right shift bringing a weighted sum of Input_T back to the DATA_T range.
+// Unsigned environment data have one more bit of precision.
+template <class Input_T>
+inline int inputs_shift()
+{
+#if NB_BITS > 0
+    return (std::numeric_limits<Input_T>::is_signed) ? 0 : 1;
+#else
+    return 0;
+#endif
+}
+
+template <class Input_T>
+inline int weights_shift()
+{
+#if NB_BITS > 0
+    return (NB_BITS - 1) + inputs_shift<Input_T>();
+#else
+    return 0;
+#endif
+}
+
+inline SUM_T bias_scaling(WDATA_T bias, int shift)
+{
+#if NB_BITS > 0
+    return (SUM_T)bias * ((SUM_T)1 << shift);
+#else
+    (void)shift;
+    return bias;
+#endif
+}
+
+template <class Input_T>
+inline double to_real(Input_T value)
+{
+#if NB_BITS > 0
+    return value / (double)((std::numeric_limits<Input_T>::is_signed)
+                                ? DATA_T_MAX : UDATA_T_MAX);
+#else
+    return value;
+#endif
+}
+
+/**** Activation functions ****/
+template <ActivationFunction_T FUNC, class T>
+inline T activation(T x)
+{
+    switch (FUNC) {
+    case Logistic:
+    case LogisticWithLoss:
+        return 1.0 / (1.0 + std::exp(-x));
+    case FastSigmoid:
+        return x / (1.0 + std::abs(x));
+    case Tanh:
+        return std::tanh(x);
+    case TanhLeCun:
+        return 1.7159 * std::tanh(2.0 * x / 3.0);
+    case Saturation:
+        return (x < -1.0) ? -1.0 : (x > 1.0) ? 1.0 : x;
+    case Rectifier:
+        return (x > 0) ? x : 0;
+    case Softplus:
+        return std::log(1.0 + std::exp(x));
+    case Linear:
+    default:
+        return x;
+    }
+}
+
+// Scale, activate and saturate a weighted sum to the DATA_T range
+template <ActivationFunction_T FUNC>
+inline DATA_T sat(SUM_T weightedSum, int shift)
+{
+#if NB_BITS > 0
+    if (shift > 0)
+        weightedSum = (weightedSum + ((SUM_T)1 << (shift - 1))) >> shift;
+
+    if (FUNC == Rectifier) {
+        if (weightedSum < 0)
+            weightedSum = 0;
+    }
+    else if (FUNC != Linear && FUNC != Saturation) {
+        weightedSum = (SUM_T)std::floor(DATA_T_MAX * activation<FUNC>(
+            weightedSum / (double)DATA_T_MAX) + 0.5);
+    }
+
+    return (DATA_T)((weightedSum < DATA_T_MIN) ? DATA_T_MIN :
+                    (weightedSum > DATA_T_MAX) ? DATA_T_MAX : weightedSum);
+#else
+    (void)shift;
+    return activation<FUNC>(weightedSum);
+#endif
+}
+
+/**** Environment ****/
+template <class T>
+void chw_to_hwc(unsigned int nbChannels,
+                unsigned int channelsHeight,
+                unsigned int channelsWidth,
+                const T* inputs,
+                T* outputs)
+{
+    const unsigned int size = channelsHeight * channelsWidth;
+
+    for (unsigned int channel = 0; channel < nbChannels; ++channel) {
+        for (unsigned int i = 0; i < size; ++i)
+            outputs[channel + i * nbChannels] = inputs[i + channel * size];
+    }
+}
+
+// Copy the outputs of one parent cell into a channel-concatenated buffer
+void concat_channels(unsigned int size,
+                     unsigned int nbChannels,
+                     const DATA_T* inputs,
+                     unsigned int channelOffset,
+                     unsigned int nbOutputs,
+                     DATA_T* outputs);
+
+/**** Convolution Layer ****/
+// Returns the weights in [output][kernel y][kernel x][channel] order,
+// missing connections being set to 0.
+std::vector<WDATA_T> convcell_weights(
+    unsigned int nbChannels,
+    unsigned int nbOutputs,
+    unsigned int kernelHeight,
+    unsigned int kernelWidth,
+    const std::vector<std::vector<const std::vector<std::vector<WDATA_T> >*> >&
+        weights);
+
+template <ActivationFunction_T FUNC, class Input_T>
+void convcell_propagate(unsigned int nbChannels,
+                        unsigned int channelsHeight,
+                        unsigned int channelsWidth,
+                        unsigned int paddingY,
+                        unsigned int paddingX,
+                        unsigned int strideY,
+                        unsigned int strideX,
+                        const Input_T* inputs,
+                        unsigned int nbOutputs,
+                        unsigned int outputsHeight,
+                        unsigned int outputsWidth,
+                        unsigned int kernelHeight,
+                        unsigned int kernelWidth,
+                        const WDATA_T* bias,
+                        const WDATA_T* weights,
+                        DATA_T* outputs)
+{
+    const int shift = weights_shift<Input_T>();
+    const unsigned int kernelSize = kernelHeight * kernelWidth * nbChannels;
+
+    for (unsigned int oy = 0; oy < outputsHeight; ++oy) {
+        const int iy = (int)(oy * strideY) - (int)paddingY;
+        const unsigned int syMin = (unsigned int)std::max(-iy, 0);
+        const unsigned int syMax = (unsigned int)std::max(std::min(
+            (int)kernelHeight, (int)channelsHeight - iy), 0);
+
+        for (unsigned int ox = 0; ox < outputsWidth; ++ox) {
+            const int ix = (int)(ox * strideX) - (int)paddingX;
+            const unsigned int sxMin = (unsigned int)std::max(-ix, 0);
+            const unsigned int sxMax = (unsigned int)std::max(std::min(
+                (int)kernelWidth, (int)channelsWidth - ix), 0);
+            const unsigned int rowSize = (sxMax > sxMin)
+                ? (sxMax - sxMin) * nbChannels : 0;
+            DATA_T* outputsPixel = outputs
+                + (ox + oy * outputsWidth) * nbOutputs;
+
+            for (unsigned int output = 0; output < nbOutputs; ++output) {
+                const WDATA_T* kernel = weights + output * kernelSize;
+                SUM_T weightedSum = bias_scaling(bias[output], shift);
+
+                for (unsigned int sy = syMin; sy < syMax; ++sy) {
+                    weightedSum += dotProduct(inputs
+                        + (ix + sxMin + (iy + sy) * channelsWidth)
+                            * nbChannels,
+                        kernel + (sxMin + sy * kernelWidth) * nbChannels,
+                        rowSize);
+                }
+
+                outputsPixel[output] = sat<FUNC>(weightedSum, shift);
+            }
+        }
+    }
+}
+
+/**** Pooling Layer ****/
+// Returns the flattened [output][channel] mapping, or an empty vector for
+// a one-to-one mapping.
+std::vector<char> poolcell_mapping(
+    unsigned int nbChannels,
+    unsigned int nbOutputs,
+    const std::vector<std::vector<char> >& mapping);
+
+template <ActivationFunction_T FUNC, Pooling_T POOLING, class Input_T>
+void poolcell_propagate(unsigned int nbChannels,
+                        unsigned int channelsHeight,
+                        unsigned int channelsWidth,
+                        unsigned int paddingY,
+                        unsigned int paddingX,
+                        unsigned int strideY,
+                        unsigned int strideX,
+                        const Input_T* inputs,
+                        unsigned int nbOutputs,
+                        unsigned int outputsHeight,
+                        unsigned int outputsWidth,
+                        unsigned int poolHeight,
+                        unsigned int poolWidth,
+                        const std::vector<char>& mapping,
+                        DATA_T* outputs)
+{
+    const int shift = inputs_shift<Input_T>();
+    const SUM_T init = (POOLING == Average) ? (SUM_T)0
+        : (std::numeric_limits<SUM_T>::is_integer)
+            ? (SUM_T)std::numeric_limits<Input_T>::min()
+            : -std::numeric_limits<SUM_T>::max();
+    std::vector<SUM_T> poolValues(nbOutputs);
+    std::vector<unsigned int> poolCounts(nbOutputs);
+
+    for (unsigned int oy = 0; oy < outputsHeight; ++oy) {
+        const int iy = (int)(oy * strideY) - (int)paddingY;
+        const unsigned int syMin = (unsigned int)std::max(-iy, 0);
+        const unsigned int syMax = (unsigned int)std::max(std::min(
+            (int)poolHeight, (int)channelsHeight - iy), 0);
+
+        for (unsigned int ox = 0; ox < outputsWidth; ++ox) {
+            const int ix = (int)(ox * strideX) - (int)paddingX;
+            const unsigned int sxMin = (unsigned int)std::max(-ix, 0);
+            const unsigned int sxMax = (unsigned int)std::max(std::min(
+                (int)poolWidth, (int)channelsWidth - ix), 0);
+
+            std::fill(poolValues.begin(), poolValues.end(), init);
+            std::fill(poolCounts.begin(), poolCounts.end(), 0);
+
+            for (unsigned int sy = syMin; sy < syMax; ++sy) {
+                for (unsigned int sx = sxMin; sx < sxMax; ++sx) {
+                    const Input_T* inputsPixel = inputs
+                        + (ix + sx + (iy + sy) * channelsWidth) * nbChannels;
+
+                    if (mapping.empty()) {
+                        // One-to-one mapping, vectorized over the channels
+                        for (unsigned int ch = 0; ch < nbChannels; ++ch) {
+                            if (POOLING == Max) {
+                                poolValues[ch] = std::max(poolValues[ch],
+                                                (SUM_T)inputsPixel[ch]);
+                            }
+                            else
+                                poolValues[ch] += inputsPixel[ch];
+                        }
+
+                        continue;
+                    }
+
+                    for (unsigned int output = 0; output < nbOutputs;
+                         ++output)
+                    {
+                        const char* outputMapping
+                            = &mapping[output * nbChannels];
+
+                        for (unsigned int ch = 0; ch < nbChannels; ++ch) {
+                            if (!outputMapping[ch])
+                                continue;
+
+                            if (POOLING == Max) {
+                                poolValues[output] = std::max(
+                                    poolValues[output],
+                                    (SUM_T)inputsPixel[ch]);
+                            }
+                            else {
+                                poolValues[output] += inputsPixel[ch];
+                                ++poolCounts[output];
+                            }
+                        }
+                    }
+                }
+            }
+
+            DATA_T* outputsPixel = outputs
+                + (ox + oy * outputsWidth) * nbOutputs;
+
+            for (unsigned int output = 0; output < nbOutputs; ++output) {
+                SUM_T poolValue = poolValues[output];
+
+                if (POOLING == Average) {
+                    const unsigned int poolCount = (mapping.empty())
+                        ? (syMax - syMin) * (sxMax - sxMin)
+                        : poolCounts[output];
+
+                    if (poolCount > 0)
+                        poolValue /= (SUM_T)poolCount;
+                }
+
+                outputsPixel[output] = sat<FUNC>(poolValue, shift);
+            }
+        }
+    }
+}
+
+/**** Fractional Max Pooling Layer ****/
+template <ActivationFunction_T FUNC, class Input_T>
+void fmpcell_propagate(unsigned int nbChannels,
+                       unsigned int channelsHeight,
+                       unsigned int channelsWidth,
+                       const unsigned int* gridX,
+                       const unsigned int* gridY,
+                       bool overlapping,
+                       const Input_T* inputs,
+                       unsigned int outputsHeight,
+                       unsigned int outputsWidth,
+                       DATA_T* outputs)
+{
+    const int shift = inputs_shift<Input_T>();
+    std::vector<Input_T> poolValues(nbChannels);
+
+    for (unsigned int oy = 0; oy < outputsHeight; ++oy) {
+        const unsigned int iyStart = (oy > 0) ? gridY[oy - 1] : 0;
+        const unsigned int iyStop = (oy == outputsHeight - 1)
+            ? channelsHeight - 1 : (overlapping) ? gridY[oy] : gridY[oy] - 1;
+
+        for (unsigned int ox = 0; ox < outputsWidth; ++ox) {
+            const unsigned int ixStart = (ox > 0) ? gridX[ox - 1] : 0;
+            const unsigned int ixStop = (ox == outputsWidth - 1)
+                ? channelsWidth - 1 : (overlapping) ? gridX[ox]
+                                                    : gridX[ox] - 1;
+
+            std::fill(poolValues.begin(), poolValues.end(),
+                      (std::numeric_limits<Input_T>::is_integer)
+                          ? std::numeric_limits<Input_T>::min()
+                          : -std::numeric_limits<Input_T>::max());
+
+            for (unsigned int iy = iyStart; iy <= iyStop; ++iy) {
+                for (unsigned int ix = ixStart; ix <= ixStop; ++ix) {
+                    const Input_T* inputsPixel = inputs
+                        + (ix + iy * channelsWidth) * nbChannels;
+
+                    for (unsigned int ch = 0; ch < nbChannels; ++ch) {
+                        poolValues[ch] = std::max(poolValues[ch],
+                                                  inputsPixel[ch]);
+                    }
+                }
+            }
+
+            DATA_T* outputsPixel = outputs
+                + (ox + oy * outputsWidth) * nbChannels;
+
+            for (unsigned int ch = 0; ch < nbChannels; ++ch)
+                outputsPixel[ch] = sat<FUNC>((SUM_T)poolValues[ch], shift);
+        }
+    }
+}
+
+/**** FullyConnected Layer ****/
+// Returns the weights with the inputs in HWC order, from the N2D2 CHW order.
+std::vector<WDATA_T> fccell_weights(
+    unsigned int nbChannels,
+    unsigned int channelsHeight,
+    unsigned int channelsWidth,
+    unsigned int nbOutputs,
+    const std::vector<std::vector<WDATA_T> >& weights);
+
+std::vector<WDATA_T> fccell_weights(unsigned int nbChannels,
+                                    unsigned int channelsHeight,
+                                    unsigned int channelsWidth,
+                                    unsigned int nbOutputs,
+                                    unsigned int nbWeights,
+                                    const WDATA_T* weightsSparse,
+                                    const unsigned short* weightsOffsets);
+
+template <ActivationFunction_T FUNC, class Input_T>
+void fccell_propagate(unsigned int nbChannels,
+                      const Input_T* inputs,
+                      unsigned int nbOutputs,
+                      const WDATA_T* bias,
+                      const WDATA_T* weights,
+                      DATA_T* outputs)
+{
+    const int shift = weights_shift<Input_T>();
+
+    for (unsigned int output = 0; output < nbOutputs; ++output) {
+        const SUM_T weightedSum = bias_scaling(bias[output], shift)
+            + dotProduct(inputs, weights + output * nbChannels, nbChannels);
+
+        outputs[output] = sat<FUNC>(weightedSum, shift);
+    }
+}
+
+/**** BatchNorm Layer ****/
+// Folds the parameters into a per-channel scale and bias (in real units)
+std::vector<float> batchnormcell_scales(unsigned int nbChannels,
+                                        const WDATA_T* scales,
+                                        const WDATA_T* variances,
+                                        double epsilon);
+
+std::vector<float> batchnormcell_biases(unsigned int nbChannels,
+                                        const WDATA_T* biases,
+                                        const WDATA_T* means,
+                                        const float* foldedScales);
+
+template <ActivationFunction_T FUNC, class Input_T>
+void batchnormcell_propagate(unsigned int nbChannels,
+                             unsigned int channelsHeight,
+                             unsigned int channelsWidth,
+                             const Input_T* inputs,
+                             const float* scales,
+                             const float* biases,
+                             DATA_T* outputs)
+{
+    const unsigned int size = channelsHeight * channelsWidth;
+
+    for (unsigned int i = 0; i < size; ++i) {
+        const Input_T* inputsPixel = inputs + i * nbChannels;
+        DATA_T* outputsPixel = outputs + i * nbChannels;
+
+        for (unsigned int ch = 0; ch < nbChannels; ++ch) {
+            const double value = scales[ch] * to_real(inputsPixel[ch])
+                                 + biases[ch];
+#if NB_BITS > 0
+            outputsPixel[ch] = sat<FUNC>(
+                (SUM_T)std::floor(DATA_T_MAX * value + 0.5), 0);
+#else
+            outputsPixel[ch] = sat<FUNC>(value, 0);
+#endif
+        }
+    }
+}
+
+/**** Softmax Layer ****/
+template <class Input_T>
+void softmaxcell_propagate(unsigned int nbOutputs,
+                           unsigned int outputsHeight,
+                           unsigned int outputsWidth,
+                           const Input_T* inputs,
+                           DATA_T* outputs)
+{
+    const unsigned int size = outputsHeight * outputsWidth;
+    std::vector<double> values(nbOutputs);
+
+    for (unsigned int i = 0; i < size; ++i) {
+        const Input_T* inputsPixel = inputs + i * nbOutputs;
+        DATA_T* outputsPixel = outputs + i * nbOutputs;
+        const double maxValue = to_real(*std::max_element(inputsPixel,
+                                                    inputsPixel + nbOutputs));
+        double sum = 0.0;
+
+        for (unsigned int output = 0; output < nbOutputs; ++output) {
+            values[output] = std::exp(to_real(inputsPixel[output]) - maxValue);
+            sum += values[output];
+        }
+
+        for (unsigned int output = 0; output < nbOutputs; ++output) {
+#if NB_BITS > 0
+            outputsPixel[output] = sat<Linear>(
+                (SUM_T)std::floor(DATA_T_MAX * values[output] / sum + 0.5), 0);
+#else
+            outputsPixel[output] = values[output] / sum;
+#endif
+        }
+    }
+}
+
+/**** Targets Layers ****/
+void output_generation(unsigned int nbOutputs,
+                       unsigned int outputsHeight,
+                       unsigned int outputsWidth,
+                       const DATA_T* outputs,
+                       uint32_t* outputEstimated);
+
+template <class T>
+void envRead(const std::string& fileName,
+             unsigned int size,
+             unsigned int channelsHeight,
+             unsigned int channelsWidth,
+             T* data,
+             unsigned int outputsSize,
+             int32_t* outputTargets)
+{
+    std::ifstream stimuli(fileName.c_str(), std::fstream::binary);
+
+    if (!stimuli.good())
+        throw std::runtime_error("Could not open file: " + fileName);
+
+    char header[2];
+    stimuli.read(reinterpret_cast<char*>(&header[0]), sizeof(header));
+
+    if (header[0] != 'P' || header[1] != '5')
+        throw std::runtime_error("Unknown PGM file format for file: "
+                                 + fileName);
+
+    int pixelWidth;
+    int pixelHeight;
+    int maxValue;
+
+    if (!(stimuli >> pixelWidth) || !(stimuli >> pixelHeight)
+        || !(stimuli >> maxValue))
+        throw std::runtime_error("Error reading PGM image file: " + fileName);
+
+    stimuli.get();
+
+    if (pixelWidth != (int)channelsWidth || pixelHeight != (int)channelsHeight)
+        throw std::runtime_error(
+            "PGM image size does not match array size for file: " + fileName);
+
+    stimuli.read(reinterpret_cast<char*>(&data[0]), size * sizeof(data[0]));
+    stimuli.read(reinterpret_cast<char*>(&outputTargets[0]),
+                 outputsSize * sizeof(outputTargets[0]));
+
+    if (stimuli.eof())
+        throw std::runtime_error(
+            "End-of-file reached prematurely in data file: " + fileName);
+    else if (!stimuli.good())
+        throw std::runtime_error("Error while reading data file: " + fileName);
+    else if (stimuli.get() != std::fstream::traits_type::eof())
+        throw std::runtime_error("Data file size larger than expected: "
+                                 + fileName);
+}
+
+#endif // N2D2_EXPORTCPP_H
@@ -0,0 +1,267 @@
+/*
+    (C) Copyright 2016 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#ifndef N2D2_EXPORTCPP_SIMD_H
+#define N2D2_EXPORTCPP_SIMD_H
+
+#include "typedefs.h"
+
+#if !defined(NO_SIMD) && (NB_BITS == 8 || NB_BITS == 16)
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define SIMD_AVX2
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define SIMD_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define SIMD_NEON
+#endif
+#endif
+
+/**
+ * Dot product of @p size inputs and weights, accumulated in SUM_T.
+ * The generic version relies on the compiler vectorizer; the 8 and 16 bits
+ * fixed-point DATA_T get explicit AVX2, SSE2 or NEON specializations below
+ * (which can be disabled by defining NO_SIMD).
+*/
+template <class Input_T>
+inline SUM_T dotProduct(const Input_T* inputs,
+                        const WDATA_T* weights,
+                        unsigned int size)
+{
+    SUM_T sum = 0;
+
+#if defined(_OPENMP) && _OPENMP >= 201307
+#pragma omp simd reduction(+:sum)
+#endif
+    for (unsigned int i = 0; i < size; ++i)
+        sum += (SUM_T)inputs[i] * (SUM_T)weights[i];
+
+    return sum;
+}
+
+#if defined(SIMD_AVX2)
+static inline int hsum_epi32(__m256i v)
+{
+    __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(v),
+                                _mm256_extracti128_si256(v, 1));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(sum);
+}
+#elif defined(SIMD_SSE2)
+static inline int hsum_epi32(__m128i v)
+{
+    v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+    v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(v);
+}
+#endif
+
+#if NB_BITS == 8 && (defined(SIMD_AVX2) || defined(SIMD_SSE2)                  \
+                     || defined(SIMD_NEON))
+// Both operands are widened to 16 bits before the multiply-add, so that the
+// unsigned environment data (0 to 255) do not saturate the products.
+#if defined(SIMD_AVX2)
+static inline __m256i widen_epi8(const DATA_T* data)
+{
+    return _mm256_cvtepi8_epi16(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(data)));
+}
+
+static inline __m256i widen_epi8(const UDATA_T* data)
+{
+    return _mm256_cvtepu8_epi16(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(data)));
+}
+#elif defined(SIMD_SSE2)
+static inline void widen_epi8(const DATA_T* data, __m128i& lo, __m128i& hi)
+{
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+    lo = _mm_srai_epi16(_mm_unpacklo_epi8(v, v), 8);
+    hi = _mm_srai_epi16(_mm_unpackhi_epi8(v, v), 8);
+}
+
+static inline void widen_epi8(const UDATA_T* data, __m128i& lo, __m128i& hi)
+{
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+    lo = _mm_unpacklo_epi8(v, _mm_setzero_si128());
+    hi = _mm_unpackhi_epi8(v, _mm_setzero_si128());
+}
+#elif defined(SIMD_NEON)
+static inline void widen_epi8(const DATA_T* data, int16x8_t& lo, int16x8_t& hi)
+{
+    const int8x16_t v = vld1q_s8(reinterpret_cast<const int8_t*>(data));
+    lo = vmovl_s8(vget_low_s8(v));
+    hi = vmovl_s8(vget_high_s8(v));
+}
+
+static inline void widen_epi8(const UDATA_T* data, int16x8_t& lo, int16x8_t& hi)
+{
+    const uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t*>(data));
+    lo = vreinterpretq_s16_u16(vmovl_u8(vget_low_u8(v)));
+    hi = vreinterpretq_s16_u16(vmovl_u8(vget_high_u8(v)));
+}
+#endif
+
+template <class Input_T>
+inline SUM_T dotProduct_8(const Input_T* inputs,
+                          const WDATA_T* weights,
+                          unsigned int size)
+{
+    unsigned int i = 0;
+    SUM_T sum = 0;
+
+#if defined(SIMD_AVX2)
+    __m256i acc = _mm256_setzero_si256();
+
+    for (; i + 16 <= size; i += 16) {
+        const __m256i prod = _mm256_madd_epi16(widen_epi8(inputs + i),
+                                               widen_epi8(weights + i));
+        acc = _mm256_add_epi32(acc, prod);
+    }
+
+    sum = hsum_epi32(acc);
+#elif defined(SIMD_SSE2)
+    __m128i acc = _mm_setzero_si128();
+
+    for (; i + 16 <= size; i += 16) {
+        __m128i inputsLo, inputsHi, weightsLo, weightsHi;
+        widen_epi8(inputs + i, inputsLo, inputsHi);
+        widen_epi8(weights + i, weightsLo, weightsHi);
+
+        acc = _mm_add_epi32(acc, _mm_madd_epi16(inputsLo, weightsLo));
+        acc = _mm_add_epi32(acc, _mm_madd_epi16(inputsHi, weightsHi));
+    }
+
+    sum = hsum_epi32(acc);
+#elif defined(SIMD_NEON)
+    int32x4_t acc = vdupq_n_s32(0);
+
+    for (; i + 16 <= size; i += 16) {
+        int16x8_t inputsLo, inputsHi, weightsLo, weightsHi;
+        widen_epi8(inputs + i, inputsLo, inputsHi);
+        widen_epi8(weights + i, weightsLo, weightsHi);
+
+        acc = vmlal_s16(acc, vget_low_s16(inputsLo), vget_low_s16(weightsLo));
+        acc = vmlal_s16(acc, vget_high_s16(inputsLo),
+                        vget_high_s16(weightsLo));
+        acc = vmlal_s16(acc, vget_low_s16(inputsHi), vget_low_s16(weightsHi));
+        acc = vmlal_s16(acc, vget_high_s16(inputsHi),
+                        vget_high_s16(weightsHi));
+    }
+
+    const int64x2_t acc64 = vpaddlq_s32(acc);
+    sum = (SUM_T)(vgetq_lane_s64(acc64, 0) + vgetq_lane_s64(acc64, 1));
+#endif
+
+    for (; i < size; ++i)
+        sum += (SUM_T)inputs[i] * (SUM_T)weights[i];
+
+    return sum;
+}
+
+template <>
+inline SUM_T dotProduct<DATA_T>(const DATA_T* inputs,
+                                const WDATA_T* weights,
+                                unsigned int size)
+{
+    return dotProduct_8(inputs, weights, size);
+}
+
+template <>
+inline SUM_T dotProduct<UDATA_T>(const UDATA_T* inputs,
+                                 const WDATA_T* weights,
+                                 unsigned int size)
+{
+    return dotProduct_8(inputs, weights, size);
+}
+#endif
+
+#if NB_BITS == 16 && (defined(SIMD_AVX2) || defined(SIMD_SSE2)                 \
+                      || defined(SIMD_NEON))
+// The 32 bits pair sums of the multiply-add are widened to 64 bits at each
+// step, as SUM_T is 64 bits wide for 16 bits DATA_T.
+// Unsigned 16 bits inputs do not fit the signed multiply-add and keep the
+// generic version.
+template <>
+inline SUM_T dotProduct<DATA_T>(const DATA_T* inputs,
+                                const WDATA_T* weights,
+                                unsigned int size)
+{
+    unsigned int i = 0;
+    SUM_T sum = 0;
+
+#if defined(SIMD_AVX2)
+    __m256i acc = _mm256_setzero_si256();
+
+    for (; i + 16 <= size; i += 16) {
+        const __m256i prod = _mm256_madd_epi16(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(inputs + i)),
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(weights + i)));
+
+        acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(
+                                        _mm256_castsi256_si128(prod)));
+        acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(
+                                        _mm256_extracti128_si256(prod, 1)));
+    }
+
+    long long int accValues[4];
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(accValues), acc);
+    sum = accValues[0] + accValues[1] + accValues[2] + accValues[3];
+#elif defined(SIMD_SSE2)
+    __m128i acc = _mm_setzero_si128();
+
+    for (; i + 8 <= size; i += 8) {
+        const __m128i prod = _mm_madd_epi16(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(inputs + i)),
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(weights + i)));
+        const __m128i sign = _mm_srai_epi32(prod, 31);
+
+        acc = _mm_add_epi64(acc, _mm_unpacklo_epi32(prod, sign));
+        acc = _mm_add_epi64(acc, _mm_unpackhi_epi32(prod, sign));
+    }
+
+    long long int accValues[2];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(accValues), acc);
+    sum = accValues[0] + accValues[1];
+#elif defined(SIMD_NEON)
+    int64x2_t acc = vdupq_n_s64(0);
+
+    for (; i + 8 <= size; i += 8) {
+        const int16x8_t x = vld1q_s16(inputs + i);
+        const int16x8_t w = vld1q_s16(weights + i);
+
+        acc = vpadalq_s32(acc, vmull_s16(vget_low_s16(x), vget_low_s16(w)));
+        acc = vpadalq_s32(acc, vmull_s16(vget_high_s16(x), vget_high_s16(w)));
+    }
+
+    sum = vgetq_lane_s64(acc, 0) + vgetq_lane_s64(acc, 1);
+#endif
+
+    for (; i < size; ++i)
+        sum += (SUM_T)inputs[i] * (SUM_T)weights[i];
+
+    return sum;
+}
+#endif
+
+#endif // N2D2_EXPORTCPP_SIMD_H
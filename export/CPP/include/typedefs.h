@@ -0,0 +1 @@
+../../C/include/typedefs.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../C/include/utils.h
\ No newline at end of file
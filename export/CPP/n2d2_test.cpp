@@ -0,0 +1,251 @@
+/*
+    (C) Copyright 2016 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "network.hpp"
+
+int main(int argc, char* argv[])
+{
+    std::string stimulus = "";
+    unsigned int batchSize = 1;
+    double total_time = 0.0;
+    float successRate = 0.0;
+    std::cout << "Binary automatically generated by the N2D2 platform\n "
+                 "-Description: CPU inference binary export for Deep Neural "
+                 "Network.\n"
+              << " -Command list:\n"
+              << "    Stimulus selection: Use the '-stimulus "
+                 "path/to/the/stimulus' command to select a specific input "
+                 "stimulus (default value: none)\n"
+              << "    Batch size: Use the '-batch xx' to select the batch size "
+                 "(default value: 1) \n"
+              << "    Threads: Use the '-threads xx' to select the number of "
+                 "OpenMP threads processing a batch (default value: OpenMP "
+                 "default) \n\n" << std::endl;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string Arg(argv[i]);
+        if (Arg.compare("-batch") == 0 && i + 1 < argc) {
+            batchSize = (unsigned int)std::atoi(argv[++i]);
+            std::cout << "Option -batch: Set batch size to " << batchSize
+                      << std::endl;
+        } else if (Arg.compare("-stimulus") == 0 && i + 1 < argc) {
+            stimulus = argv[++i];
+            std::cout << "Option -stimulus: process the stimulus " << stimulus
+                      << std::endl;
+        } else if (Arg.compare("-threads") == 0 && i + 1 < argc) {
+            const int nbThreads = std::atoi(argv[++i]);
+#ifdef _OPENMP
+            omp_set_num_threads(nbThreads);
+#endif
+            std::cout << "Option -threads: process the batch with "
+                      << nbThreads << " threads" << std::endl;
+        }
+    }
+
+    if (batchSize == 0)
+        batchSize = 1;
+
+    unsigned int dimX = 1;
+    unsigned int dimY = 1;
+    if (OUTPUTS_WIDTH > 1 || OUTPUTS_HEIGHT > 1) {
+        dimX = ENV_SIZE_X;
+        dimY = ENV_SIZE_Y;
+    }
+
+    double yRatio = ENV_SIZE_Y / OUTPUTS_HEIGHT;
+    double xRatio = ENV_SIZE_X / OUTPUTS_WIDTH;
+
+    std::vector<ENV_DATA_T> env_data(ENV_BUFFER_SIZE * batchSize);
+    std::vector<uint32_t> outputEstimated(OUTPUTS_SIZE * batchSize);
+    std::vector<int32_t> outputTargets(dimX * dimY * batchSize, 0);
+    std::vector<unsigned int> confusion(NB_TARGETS * NB_TARGETS, 0);
+
+    if (!stimulus.empty()) {
+        std::cout << "Reading env input " << stimulus << std::endl;
+        envRead(stimulus,
+                ENV_BUFFER_SIZE,
+                ENV_SIZE_Y,
+                ENV_SIZE_X,
+                &env_data[0],
+                dimX * dimY,
+                &outputTargets[0]);
+        network(&env_data[0], &outputEstimated[0], 1);
+
+        unsigned int nbIgnored = 0;
+        unsigned int nbHits = 0;
+
+        for (unsigned int oy = 0; oy < OUTPUTS_HEIGHT; ++oy) {
+            for (unsigned int ox = 0; ox < OUTPUTS_WIDTH; ++ox) {
+                int iy = oy;
+                int ix = ox;
+                if (dimX > 1 || dimY > 1) {
+                    iy = (int)floor((oy + 0.5) * yRatio);
+                    ix = (int)floor((ox + 0.5) * xRatio);
+                }
+
+                const unsigned int oIdx = ox + oy * OUTPUTS_WIDTH;
+                const unsigned int Idx = ix + iy * dimX;
+
+                if (outputTargets[Idx] < 0)
+                    ++nbIgnored;
+                else {
+                    const unsigned int confIdx = outputEstimated[oIdx]
+                                                 + outputTargets[Idx]
+                                                   * NB_TARGETS;
+                    confusion[confIdx] += 1;
+
+                    if (outputTargets[Idx] == (int)outputEstimated[oIdx])
+                        ++nbHits;
+                }
+            }
+        }
+
+        const double success
+            = (OUTPUTS_SIZE > nbIgnored)
+                  ? (nbHits / (double)(OUTPUTS_SIZE - nbIgnored))
+                  : 1.0;
+
+        printf("Success rate = %02f%%\n", 100.0 * success);
+    } else {
+        std::vector<std::string> filesList;
+        getFilesList("stimuli", filesList);
+
+        double success = 0;
+        unsigned int total = 0;
+        double elapsed = 0.0;
+        double elapsed_total = 0.0;
+
+        for (unsigned int indexFile = 0; indexFile < filesList.size();
+             indexFile += batchSize)
+        {
+            const unsigned int n = std::min(batchSize,
+                (unsigned int)filesList.size() - indexFile);
+
+            //-------Extract data from input file---------//
+            for (unsigned int i = 0; i < n; i++) {
+                envRead(filesList[indexFile + i],
+                        ENV_BUFFER_SIZE,
+                        ENV_SIZE_Y,
+                        ENV_SIZE_X,
+                        &env_data[i * ENV_BUFFER_SIZE],
+                        dimX * dimY,
+                        &outputTargets[i * dimX * dimY]);
+            }
+
+            //-------Neural Network---------//
+            const std::chrono::high_resolution_clock::time_point start
+                = std::chrono::high_resolution_clock::now();
+            network(&env_data[0], &outputEstimated[0], n);
+            elapsed = 1.0e6 * std::chrono::duration_cast
+                              <std::chrono::duration<double> >(
+                                  std::chrono::high_resolution_clock::now()
+                                  - start).count();
+            elapsed_total += elapsed;
+            //---------------------------//
+
+            for (unsigned int i = 0; i < n; i++) {
+                unsigned int nbIgnored = 0;
+                unsigned int nbHits = 0;
+
+                for (unsigned int oy = 0; oy < OUTPUTS_HEIGHT; ++oy) {
+                    for (unsigned int ox = 0; ox < OUTPUTS_WIDTH; ++ox) {
+                        int iy = oy;
+                        int ix = ox;
+                        if (dimX > 1 || dimY > 1) {
+                            iy = (int)floor((oy + 0.5) * yRatio);
+                            ix = (int)floor((ox + 0.5) * xRatio);
+                        }
+                        const unsigned int oIdx
+                            = ox + oy * OUTPUTS_WIDTH + i * OUTPUTS_SIZE;
+                        const unsigned int Idx = ix + iy * dimX
+                                                 + i * (dimX * dimY);
+
+                        if (outputTargets[Idx] < 0)
+                            ++nbIgnored;
+                        else {
+                            const unsigned int confIdx
+                                = outputEstimated[oIdx]
+                                  + outputTargets[Idx] * NB_TARGETS;
+                            confusion[confIdx] += 1;
+
+                            if (outputTargets[Idx]
+                                == (int)outputEstimated[oIdx]) {
+                                ++nbHits;
+                            }
+                        }
+                    }
+                }
+
+                success += (OUTPUTS_SIZE > nbIgnored)
+                               ? (nbHits / (double)(OUTPUTS_SIZE - nbIgnored))
+                               : 1.0;
+                ++total;
+#ifndef NRET
+                printf(
+                    "%.02f/%d    (avg = %02f%%) Host process time =  %f us\n",
+                    success,
+                    total,
+                    100.0 * success / (float)total,
+                    elapsed / (double)n);
+#endif
+            }
+        }
+
+        if (total == 0)
+            throw std::runtime_error("No stimulus found in stimuli/");
+
+        total_time = (elapsed_total / (double)total);
+        successRate = (100.0 * success / (float)total);
+
+        std::cout << "---" << std::endl;
+        std::cout << ESC_BOLD << "Tested " << total << " stimuli" << ESC_ALL_OFF
+                  << "\n"
+                     "Success rate = " << successRate << "%\n"
+                     "Batch size used: " << batchSize << "\n"
+#ifdef _OPENMP
+                     "OpenMP threads: " << omp_get_max_threads() << "\n"
+#endif
+                     "Average elapsed host time per stimulus = " << total_time
+                  << " us\n"
+                     "Processing frequency = " << std::setprecision(9)
+                  << 1 / (total_time * 1.0e-6) << " stimuli/sec" << std::endl;
+    }
+
+#ifdef OUTXT
+    std::ofstream success_result("success_rate.txt");
+
+    if (!success_result.good())
+        throw std::runtime_error("Could not create file: success_rate.txt");
+
+    success_result << successRate;
+    success_result.close();
+#endif
+
+    confusion_print(NB_TARGETS, &confusion[0]);
+    return 0;
+}
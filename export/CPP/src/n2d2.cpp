@@ -0,0 +1,258 @@
+/*
+    (C) Copyright 2016 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include <dirent.h>
+#include <iomanip>
+
+#include "n2d2.hpp"
+
+void getFilesList(const std::string dir, std::vector<std::string>& files)
+{
+    struct dirent* pFile;
+    DIR* pDir = opendir(dir.c_str());
+    if (pDir == NULL)
+        throw std::runtime_error(
+            "Couldn't open the directory for input patterns: " + dir);
+
+    while ((pFile = readdir(pDir)) != NULL) {
+        if (pFile->d_name[0] != '.')
+            files.push_back(std::string(dir + "/" + pFile->d_name));
+    }
+    closedir(pDir);
+    std::sort(files.begin(), files.end());
+}
+
+void concat_channels(unsigned int size,
+                     unsigned int nbChannels,
+                     const DATA_T* inputs,
+                     unsigned int channelOffset,
+                     unsigned int nbOutputs,
+                     DATA_T* outputs)
+{
+    for (unsigned int i = 0; i < size; ++i) {
+        std::copy(inputs + i * nbChannels,
+                  inputs + (i + 1) * nbChannels,
+                  outputs + channelOffset + i * nbOutputs);
+    }
+}
+
+/**** Convolution Layer ****/
+std::vector<WDATA_T> convcell_weights(
+    unsigned int nbChannels,
+    unsigned int nbOutputs,
+    unsigned int kernelHeight,
+    unsigned int kernelWidth,
+    const std::vector<std::vector<const std::vector<std::vector<WDATA_T> >*> >&
+        weights)
+{
+    std::vector<WDATA_T> kernels(nbOutputs * kernelHeight * kernelWidth
+                                 * nbChannels, 0);
+
+    for (unsigned int output = 0; output < nbOutputs; ++output) {
+        for (unsigned int channel = 0; channel < nbChannels; ++channel) {
+            const std::vector<std::vector<WDATA_T> >* kernel
+                = weights[output][channel];
+
+            if (kernel == NULL)
+                continue;
+
+            for (unsigned int sy = 0; sy < kernelHeight; ++sy) {
+                for (unsigned int sx = 0; sx < kernelWidth; ++sx) {
+                    kernels[channel + nbChannels * (sx + kernelWidth
+                                    * (sy + kernelHeight * output))]
+                        = (*kernel)[sy][sx];
+                }
+            }
+        }
+    }
+
+    return kernels;
+}
+
+/**** Pooling Layer ****/
+std::vector<char> poolcell_mapping(
+    unsigned int nbChannels,
+    unsigned int nbOutputs,
+    const std::vector<std::vector<char> >& mapping)
+{
+    std::vector<char> flatMapping;
+    bool unitMap = (nbChannels == nbOutputs);
+
+    for (unsigned int output = 0; output < nbOutputs; ++output) {
+        for (unsigned int channel = 0; channel < nbChannels; ++channel) {
+            flatMapping.push_back(mapping[output][channel]);
+
+            if ((mapping[output][channel] != 0) != (channel == output))
+                unitMap = false;
+        }
+    }
+
+    if (unitMap)
+        flatMapping.clear();
+
+    return flatMapping;
+}
+
+/**** FullyConnected Layer ****/
+std::vector<WDATA_T> fccell_weights(
+    unsigned int nbChannels,
+    unsigned int channelsHeight,
+    unsigned int channelsWidth,
+    unsigned int nbOutputs,
+    const std::vector<std::vector<WDATA_T> >& weights)
+{
+    const unsigned int size = channelsHeight * channelsWidth;
+    std::vector<WDATA_T> hwcWeights(nbOutputs * nbChannels * size);
+
+    for (unsigned int output = 0; output < nbOutputs; ++output) {
+        chw_to_hwc(nbChannels,
+                   channelsHeight,
+                   channelsWidth,
+                   &weights[output][0],
+                   &hwcWeights[output * nbChannels * size]);
+    }
+
+    return hwcWeights;
+}
+
+std::vector<WDATA_T> fccell_weights(unsigned int nbChannels,
+                                    unsigned int channelsHeight,
+                                    unsigned int channelsWidth,
+                                    unsigned int nbOutputs,
+                                    unsigned int nbWeights,
+                                    const WDATA_T* weightsSparse,
+                                    const unsigned short* weightsOffsets)
+{
+    const unsigned int size = nbChannels * channelsHeight * channelsWidth;
+    std::vector<std::vector<WDATA_T> > weights(nbOutputs,
+                                               std::vector<WDATA_T>(size, 0));
+    unsigned int index = 0;
+
+    for (unsigned int i = 0; i < nbWeights; ++i) {
+        index += weightsOffsets[i];
+        weights[index / size][index % size] = weightsSparse[i];
+    }
+
+    return fccell_weights(
+        nbChannels, channelsHeight, channelsWidth, nbOutputs, weights);
+}
+
+/**** BatchNorm Layer ****/
+std::vector<float> batchnormcell_scales(unsigned int nbChannels,
+                                        const WDATA_T* scales,
+                                        const WDATA_T* variances,
+                                        double epsilon)
+{
+    std::vector<float> foldedScales(nbChannels);
+
+    for (unsigned int ch = 0; ch < nbChannels; ++ch) {
+        foldedScales[ch] = to_real(scales[ch])
+            / std::sqrt(to_real(variances[ch]) + epsilon);
+    }
+
+    return foldedScales;
+}
+
+std::vector<float> batchnormcell_biases(unsigned int nbChannels,
+                                        const WDATA_T* biases,
+                                        const WDATA_T* means,
+                                        const float* foldedScales)
+{
+    std::vector<float> foldedBiases(nbChannels);
+
+    for (unsigned int ch = 0; ch < nbChannels; ++ch) {
+        foldedBiases[ch] = to_real(biases[ch])
+            - foldedScales[ch] * to_real(means[ch]);
+    }
+
+    return foldedBiases;
+}
+
+/**** Targets Layers ****/
+void output_generation(unsigned int nbOutputs,
+                       unsigned int outputsHeight,
+                       unsigned int outputsWidth,
+                       const DATA_T* outputs,
+                       uint32_t* outputEstimated)
+{
+    const unsigned int size = outputsHeight * outputsWidth;
+
+    for (unsigned int i = 0; i < size; ++i) {
+        const DATA_T* outputsPixel = outputs + i * nbOutputs;
+
+        if (nbOutputs > 1) {
+            outputEstimated[i] = std::distance(outputsPixel,
+                std::max_element(outputsPixel, outputsPixel + nbOutputs));
+        }
+        else
+            outputEstimated[i] = (outputsPixel[0] > DATA_T_MAX / 2);
+    }
+}
+
+/**** Confusion Matrix ****/
+void confusion_print(unsigned int nbOutputs, unsigned int* confusion)
+{
+    std::cout << "\nConfusion matrix:\n";
+    std::cout << std::string(9 + 10 * nbOutputs, '-') << "\n";
+    std::cout << "| T \\ E |";
+
+    for (unsigned int estimated = 0; estimated < nbOutputs; ++estimated)
+        std::cout << " " << std::setfill(' ') << std::setw(7) << estimated
+                  << " |";
+
+    std::cout << "\n" << std::string(9 + 10 * nbOutputs, '-') << "\n";
+
+    unsigned int total = 0;
+    unsigned int totalCorrect = 0;
+
+    for (unsigned int target = 0; target < nbOutputs; ++target) {
+        unsigned int targetCount = 0;
+
+        for (unsigned int estimated = 0; estimated < nbOutputs; ++estimated)
+            targetCount += confusion[estimated + target * nbOutputs];
+
+        total += targetCount;
+        totalCorrect += confusion[target + target * nbOutputs];
+
+        std::cout << "| " << std::setfill(' ') << std::setw(5) << target
+                  << " |";
+
+        for (unsigned int estimated = 0; estimated < nbOutputs; ++estimated)
+            std::cout << " " << std::setfill(' ') << std::setw(7)
+                      << confusion[estimated + target * nbOutputs] << " |";
+
+        std::cout << "\n";
+        std::cout << "|       |";
+
+        for (unsigned int estimated = 0; estimated < nbOutputs; ++estimated) {
+            std::cout << " " << ESC_BG_LIGHT_YELLOW << std::setfill(' ')
+                      << std::setw(6) << std::fixed << std::setprecision(2)
+                      << 100.0
+                         * ((targetCount > 0)
+                                ? (confusion[estimated + target * nbOutputs]
+                                   / (double)targetCount)
+                                : 0.0) << "%" << ESC_ALL_OFF << " |";
+        }
+        std::cout << "\n";
+    }
+
+    std::cout << std::string(9 + 10 * nbOutputs, '-') << "\n"
+              << "T: Target    E: Estimated" << std::endl;
+}
@@ -50,6 +50,10 @@ public:
     virtual void propagate(bool inference = false);
     virtual void backPropagate();
     virtual void update();
+    virtual bool isChannelBlockable() const
+    {
+        return true;
+    };
     inline Float_T
     getScale(unsigned int channel, unsigned int sx, unsigned int sy) const
     {
@@ -0,0 +1,126 @@
+/*
+    (C) Copyright 2016 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#ifndef N2D2_CELL_CSPIKE_H
+#define N2D2_CELL_CSPIKE_H
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "CEnvironment.hpp"
+#include "Cell.hpp"
+#include "Cell_CSpike_Top.hpp"
+#include "controler/Interface.hpp"
+
+namespace N2D2 {
+/**
+ * Clock-driven spiking cell, running on the CPU.
+ *
+ * At each tick, the cell reads the spikes emitted during the tick by its
+ * inputs (the CEnvironment tick data or the outputs of other Cell_CSpike
+ * cells, as a tensor of char with values -1, 0 or 1) and produces its own
+ * output spikes tensor. The output neurons are integrate-and-fire neurons,
+ * whose state is kept in dense tensors (x, y, output, batch).
+*/
+class Cell_CSpike : public virtual Cell, public Cell_CSpike_Top {
+public:
+    Cell_CSpike(const std::string& name, unsigned int nbOutputs);
+    virtual unsigned int getNbChannels() const
+    {
+        return mNbChannels;
+    };
+    virtual bool isConnection(unsigned int channel, unsigned int output) const
+    {
+        return mMaps(output, channel);
+    };
+    virtual void addInput(StimuliProvider& sp,
+                          unsigned int channel,
+                          unsigned int x0,
+                          unsigned int y0,
+                          unsigned int width,
+                          unsigned int height,
+                          const std::vector<bool>& mapping = std::vector
+                          <bool>());
+    virtual void addInput(StimuliProvider& sp,
+                          unsigned int x0 = 0,
+                          unsigned int y0 = 0,
+                          unsigned int width = 0,
+                          unsigned int height = 0,
+                          const Matrix<bool>& mapping = Matrix<bool>());
+    virtual void addInput(Cell* cell,
+                          const Matrix<bool>& mapping = Matrix<bool>());
+    virtual void addInput(Cell* cell,
+                          unsigned int x0,
+                          unsigned int y0,
+                          unsigned int width = 0,
+                          unsigned int height = 0);
+    virtual void reset(Time_T timestamp);
+    virtual Tensor4d<char>& getOutputs()
+    {
+        return mOutputs;
+    };
+    virtual const Tensor4d<char>& getOutputs() const
+    {
+        return mOutputs;
+    };
+    virtual Tensor4d<Float_T>& getOutputsActivity()
+    {
+        return mOutputsActivity;
+    };
+    virtual ~Cell_CSpike() {};
+
+protected:
+    void addInput(Tensor4d<char>& inputs, const Matrix<bool>& mapping);
+    /// Update the per (channel, batch) input activity flags
+    /// @p mInputsActive and return true if at least one input spiked
+    bool updateInputsActive();
+    /// Return the leak factor to apply to the integrations since the last
+    /// tick
+    Float_T leak(Time_T timestamp);
+    /// Fire the output neurons whose integration reached the threshold
+    void fire(Time_T timestamp);
+
+    /// Threshold of the neuron \f$I_{thres}\f$
+    Parameter<double> mThreshold;
+    /// If true, the threshold is also applied to the absolute value of
+    /// negative integrations (generating negative spikes)
+    Parameter<bool> mBipolarThreshold;
+    /// Neural leak time constant \f$\tau_{leak}\f$ (if 0, no leak)
+    Parameter<Time_T> mLeak;
+    /// Neural refractory period \f$T_{refrac}\f$
+    Parameter<Time_T> mRefractory;
+
+    // Internal
+    // Forward
+    Interface<char> mInputs;
+    Tensor4d<char> mOutputs;
+    /// Non-zero if the (channel, batch) input map has at least one spike
+    /// during the current tick
+    Tensor2d<char> mInputsActive;
+    /// Number of output spikes (negative spikes are subtracted)
+    Tensor4d<Float_T> mOutputsActivity;
+    Tensor4d<Float_T> mOutputsIntegration;
+    Tensor4d<Time_T> mOutputsRefractoryEnd;
+    Time_T mLastTick;
+};
+}
+
+#endif // N2D2_CELL_CSPIKE_H
@@ -86,6 +86,15 @@ public:
                           unsigned int height = 0);
     virtual void addInput(Tensor4d<Float_T>& inputs,
                           Tensor4d<Float_T>& diffOutputs);
+    /**
+     * Read the inputs from @p newInputs instead of @p inputs (of the same
+     * dimensions) and back-propagate to @p newDiffOutputs instead of
+     * @p diffOutputs
+    */
+    void replaceInput(Tensor4d<Float_T>& inputs,
+                      Tensor4d<Float_T>& newInputs,
+                      Tensor4d<Float_T>& diffOutputs,
+                      Tensor4d<Float_T>& newDiffOutputs);
     virtual void propagate(bool inference = false);
     virtual void backPropagate();
     virtual void setOutputTarget(const Tensor4d<int>& targets,
@@ -114,6 +123,20 @@ public:
     }
     virtual unsigned int getMaxOutput(unsigned int batchPos = 0) const;
     void discretizeSignals(unsigned int nbLevels);
+    /**
+     * Return true if the cell accepts inputs and produces outputs in the
+     * channel-blocked (NCHWc) layout
+    */
+    virtual bool isChannelBlockable() const
+    {
+        return false;
+    };
+    /**
+     * Store the outputs and the output gradients in the channel-blocked
+     * (NCHWc) layout, with @p channelBlock interleaved channels (1 = plain
+     * layout). Every child cell must be channel-blockable.
+    */
+    virtual void setChannelBlock(unsigned int channelBlock);
     virtual ~Cell_Frame() {};
 
 protected:
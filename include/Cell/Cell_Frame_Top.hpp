@@ -74,6 +74,11 @@ public:
     {
         return mActivation;
     };
+    void setActivation(const std::shared_ptr<Activation<Float_T> >&
+                           activation)
+    {
+        mActivation = activation;
+    };
     virtual ~Cell_Frame_Top() {};
 
 protected:
@@ -46,6 +46,9 @@
 #pragma comment(                                                               \
     linker,                                                                    \
     "/include:?mRegistrar@ConvCell_Spike@N2D2@@0U?$Registrar@VConvCell@N2D2@@@2@A")
+#pragma comment(                                                               \
+    linker,                                                                    \
+    "/include:?mRegistrar@ConvCell_CSpike@N2D2@@0U?$Registrar@VConvCell@N2D2@@@2@A")
 #pragma comment(                                                               \
     linker,                                                                    \
     "/include:?mRegistrar@ConvCell_Spike_Analog@N2D2@@0U?$Registrar@VConvCell@N2D2@@@2@A")
@@ -180,6 +183,13 @@ public:
     void randomizeFreeParameters(double stdDev);
     void processFreeParameters(const std::function
                                <double(const double&)>& func);
+    /**
+     * Fold a per-output affine transform, y = scale * x + shift, applied on
+     * the outputs before the activation into the weights and the bias (which
+     * is enabled if needed)
+    */
+    void foldScaleShift(const std::vector<Float_T>& scale,
+                        const std::vector<Float_T>& shift);
     void getStats(Stats& stats) const;
     virtual ~ConvCell() {};
 
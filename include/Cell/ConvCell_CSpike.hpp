@@ -0,0 +1,113 @@
+/*
+    (C) Copyright 2016 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#ifndef N2D2_CONVCELL_CSPIKE_H
+#define N2D2_CONVCELL_CSPIKE_H
+
+#include "Cell_CSpike.hpp"
+#include "ConvCell.hpp"
+
+namespace N2D2 {
+/**
+ * Clock-driven spiking convolution cell. The weights and biases are stored in
+ * the same format as ConvCell_Frame, so that a network trained with the Frame
+ * model can be run directly with the CSpike model.
+*/
+class ConvCell_CSpike : public virtual ConvCell, public Cell_CSpike {
+public:
+    ConvCell_CSpike(const std::string& name,
+                    unsigned int kernelWidth,
+                    unsigned int kernelHeight,
+                    unsigned int nbOutputs,
+                    unsigned int subSampleX = 1,
+                    unsigned int subSampleY = 1,
+                    unsigned int strideX = 1,
+                    unsigned int strideY = 1,
+                    int paddingX = 0,
+                    int paddingY = 0);
+    static std::shared_ptr<ConvCell>
+    create(Network& /*net*/,
+           const std::string& name,
+           unsigned int kernelWidth,
+           unsigned int kernelHeight,
+           unsigned int nbOutputs,
+           unsigned int subSampleX = 1,
+           unsigned int subSampleY = 1,
+           unsigned int strideX = 1,
+           unsigned int strideY = 1,
+           int paddingX = 0,
+           int paddingY = 0,
+           const std::shared_ptr<Activation<Float_T> >& /*activation*/
+           = std::shared_ptr<Activation<Float_T> >())
+    {
+        return std::make_shared<ConvCell_CSpike>(name,
+                                                 kernelWidth,
+                                                 kernelHeight,
+                                                 nbOutputs,
+                                                 subSampleX,
+                                                 subSampleY,
+                                                 strideX,
+                                                 strideY,
+                                                 paddingX,
+                                                 paddingY);
+    }
+
+    virtual void initialize();
+    virtual bool tick(Time_T timestamp);
+    inline Float_T getWeight(unsigned int output,
+                             unsigned int channel,
+                             unsigned int sx,
+                             unsigned int sy) const
+    {
+        return mSharedSynapses(sx, sy, channel, output);
+    };
+    inline Float_T getBias(unsigned int output) const
+    {
+        return mBias(output);
+    };
+    void saveFreeParameters(const std::string& fileName) const;
+    void loadFreeParameters(const std::string& fileName,
+                            bool ignoreNotExists = false);
+    virtual ~ConvCell_CSpike();
+
+protected:
+    inline void setWeight(unsigned int output,
+                          unsigned int channel,
+                          unsigned int sx,
+                          unsigned int sy,
+                          Float_T value)
+    {
+        mSharedSynapses(sx, sy, channel, output) = value;
+    }
+    inline void setBias(unsigned int output, Float_T value)
+    {
+        mBias(output) = value;
+    };
+
+    // Internal
+    Interface<Float_T> mSharedSynapses;
+    Tensor4d<Float_T> mBias;
+
+private:
+    static Registrar<ConvCell> mRegistrar;
+};
+}
+
+#endif // N2D2_CONVCELL_CSPIKE_H
@@ -25,10 +25,18 @@
 #include "ConvCell.hpp"
 #include "ConvCell_Frame_Kernels.hpp"
 #include "Solver/SGDSolver_Frame.hpp"
+#include "utils/Quantization.hpp"
 
 namespace N2D2 {
 class ConvCell_Frame : public virtual ConvCell, public Cell_Frame {
 public:
+    enum Algorithm {
+        Direct,
+        GEMM,
+        Winograd,
+        Auto
+    };
+
     ConvCell_Frame(const std::string& name,
                    unsigned int kernelWidth,
                    unsigned int kernelHeight,
@@ -74,6 +82,10 @@ public:
     virtual void propagate(bool inference = false);
     virtual void backPropagate();
     virtual void update();
+    virtual bool isChannelBlockable() const
+    {
+        return true;
+    };
     inline Float_T getWeight(unsigned int output,
                              unsigned int channel,
                              unsigned int sx,
@@ -85,6 +97,21 @@ public:
     {
         return mBias(output);
     };
+    /**
+     * Switch the cell to integer inference: the weights are quantized on
+     * @p nbBits with a scale per output channel, the inputs are quantized
+     * with the @p inputs scale and the outputs are rounded to the @p outputs
+     * quantization. A @p nbBits of 0 switches back to floating point.
+    */
+    void setQuantization(unsigned int nbBits,
+                         const Quantization::Signals& inputs
+                            = Quantization::Signals(),
+                         const Quantization::Signals& outputs
+                            = Quantization::Signals());
+    unsigned int getQuantization() const
+    {
+        return mQuantizationBits;
+    };
     void checkGradient(double epsilon = 1.0e-4, double maxError = 1.0e-6);
     void saveFreeParameters(const std::string& fileName) const;
     void loadFreeParameters(const std::string& fileName,
@@ -99,12 +126,22 @@ protected:
                           Float_T value)
     {
         mSharedSynapses(sx, sy, channel, output) = value;
+        mWinogradValid = false;
     }
     inline void setBias(unsigned int output, Float_T value)
     {
         mBias(output) = value;
     };
 
+    bool isWinogradEligible() const;
+    void propagateUncached(bool inference = false);
+    void propagateQuantized();
+    void updateWinogradSynapses(bool backward);
+
+    /// Convolution algorithm: direct loops, lowered (im2col + GEMM), Winograd
+    /// or automatic selection (Winograd when eligible, direct otherwise)
+    Parameter<Algorithm> mAlgorithm;
+
     // Internal
     std::vector<std::shared_ptr<Solver<Float_T> > > mWeightsSolvers;
     Interface<Float_T> mSharedSynapses;
@@ -113,9 +150,33 @@ protected:
     Tensor4d<Float_T> mDiffBias;
     ConvCell_Frame_Kernels::Descriptor mConvDesc;
 
+    // Winograd transformed kernels for each input, for the forward and the
+    // backward data passes. They are kept until the weights are modified.
+    std::vector<std::vector<Float_T> > mWinogradSynapses;
+    std::vector<std::vector<Float_T> > mWinogradBackwardSynapses;
+    unsigned int mWinogradTileSize;
+    bool mWinogradValid;
+    bool mWinogradBackwardValid;
+
+    // Integer inference (enabled when mQuantizationBits > 0)
+    unsigned int mQuantizationBits;
+    Quantization::Signals mQuantizedInputs;
+    Quantization::Signals mQuantizedOutputs;
+    Interface<signed char> mQuantizedSynapses;
+    std::vector<float> mSynapsesScales;
+    std::vector<int> mQuantizedBias;
+    Tensor4d<short> mQuantizedInputsData;
+    Tensor4d<int> mAccumulators;
+
 private:
     static Registrar<ConvCell> mRegistrar;
 };
 }
 
+namespace {
+template <>
+const char* const EnumStrings<N2D2::ConvCell_Frame::Algorithm>::data[]
+    = {"Direct", "GEMM", "Winograd", "Auto"};
+}
+
 #endif // N2D2_CONVCELL_FRAME_H
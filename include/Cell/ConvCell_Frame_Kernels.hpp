@@ -58,6 +58,11 @@ namespace ConvCell_Frame_Kernels {
                  Tensor4d<Float_T>& outputs,
                  const Tensor2d<bool>& maps = Tensor2d<bool>());
     void forwardBias(const Tensor4d<Float_T>& bias, Tensor4d<Float_T>& outputs);
+    // Bias (if @p bias is not NULL) and rectifier activation in a single pass
+    void forwardBiasRectifier(const Tensor4d<Float_T>* bias,
+                              Float_T leakSlope,
+                              Float_T clipping,
+                              Tensor4d<Float_T>& outputs);
 
     // Backward
     void backwardData(const Float_T* alpha,
@@ -76,6 +81,101 @@ namespace ConvCell_Frame_Kernels {
                         const Tensor2d<bool>& maps = Tensor2d<bool>());
     void backwardBias(const Tensor4d<Float_T>& diffInputs,
                       Tensor4d<Float_T>& diffBias);
+
+    // Lowered convolution (im2col + GEMM)
+    void im2col(const Tensor4d<Float_T>& inputs,
+                unsigned int batchPos,
+                unsigned int kernelWidth,
+                unsigned int kernelHeight,
+                const Descriptor& desc,
+                unsigned int oxSize,
+                unsigned int oySize,
+                Float_T* col);
+    void col2im(const Float_T* col,
+                unsigned int kernelWidth,
+                unsigned int kernelHeight,
+                const Descriptor& desc,
+                unsigned int oxSize,
+                unsigned int oySize,
+                unsigned int batchPos,
+                Tensor4d<Float_T>& outputs);
+    void forwardGemm(const Float_T* alpha,
+                     const Tensor4d<Float_T>& inputs,
+                     const Tensor4d<Float_T>& sharedSynapses,
+                     const Descriptor& desc,
+                     const Float_T* beta,
+                     Tensor4d<Float_T>& outputs,
+                     const Tensor2d<bool>& maps = Tensor2d<bool>());
+    void backwardDataGemm(const Float_T* alpha,
+                          const Tensor4d<Float_T>& sharedSynapses,
+                          const Tensor4d<Float_T>& diffInputs,
+                          const Descriptor& desc,
+                          const Float_T* beta,
+                          Tensor4d<Float_T>& diffOutputs,
+                          const Tensor2d<bool>& maps = Tensor2d<bool>());
+    void backwardFilterGemm(const Float_T* alpha,
+                            const Tensor4d<Float_T>& inputs,
+                            const Tensor4d<Float_T>& diffInputs,
+                            const Descriptor& desc,
+                            const Float_T* beta,
+                            Tensor4d<Float_T>& diffSharedSynapses,
+                            const Tensor2d<bool>& maps = Tensor2d<bool>());
+
+    // Winograd F(tileSize x tileSize, 3x3) convolution (stride 1, no
+    // subsampling, dense maps)
+    void winogradFilterTransform(const Tensor4d<Float_T>& sharedSynapses,
+                                 unsigned int tileSize,
+                                 bool backward,
+                                 std::vector<Float_T>& transformed);
+    void forwardWinograd(const Float_T* alpha,
+                         const Tensor4d<Float_T>& inputs,
+                         const std::vector<Float_T>& transformedSynapses,
+                         unsigned int tileSize,
+                         const Descriptor& desc,
+                         const Float_T* beta,
+                         Tensor4d<Float_T>& outputs);
+    void backwardDataWinograd(const Float_T* alpha,
+                              const std::vector<Float_T>& transformedSynapses,
+                              unsigned int tileSize,
+                              const Tensor4d<Float_T>& diffInputs,
+                              const Descriptor& desc,
+                              const Float_T* beta,
+                              Tensor4d<Float_T>& diffOutputs);
+
+    // Channel-blocked (NCHWc) convolution (no subsampling). The result tensor
+    // (outputs, diffOutputs or diffInputs respectively) must have a channel
+    // block of 8 or 16, the other tensors may use any layout
+    void forwardBlocked(const Float_T* alpha,
+                        const Tensor4d<Float_T>& inputs,
+                        const Tensor4d<Float_T>& sharedSynapses,
+                        const Descriptor& desc,
+                        const Float_T* beta,
+                        Tensor4d<Float_T>& outputs,
+                        const Tensor2d<bool>& maps = Tensor2d<bool>());
+    void backwardDataBlocked(const Float_T* alpha,
+                             const Tensor4d<Float_T>& sharedSynapses,
+                             const Tensor4d<Float_T>& diffInputs,
+                             const Descriptor& desc,
+                             const Float_T* beta,
+                             Tensor4d<Float_T>& diffOutputs,
+                             const Tensor2d<bool>& maps = Tensor2d<bool>());
+    void backwardFilterBlocked(const Float_T* alpha,
+                               const Tensor4d<Float_T>& inputs,
+                               const Tensor4d<Float_T>& diffInputs,
+                               const Descriptor& desc,
+                               const Float_T* beta,
+                               Tensor4d<Float_T>& diffSharedSynapses,
+                               const Tensor2d<bool>& maps = Tensor2d<bool>());
+
+    // Integer convolution (no subsampling, plain layout): the products of the
+    // quantized inputs and weights are accumulated on 32 bits in @p outputs,
+    // which is overwritten unless @p accumulate is true
+    void forwardQuantized(const Tensor4d<short>& inputs,
+                          const Tensor4d<signed char>& sharedSynapses,
+                          const Descriptor& desc,
+                          bool accumulate,
+                          Tensor4d<int>& outputs,
+                          const Tensor2d<bool>& maps = Tensor2d<bool>());
 }
 }
 
@@ -29,6 +29,14 @@
 #include "NodeOut.hpp"
 
 namespace N2D2 {
+/**
+ * Event-driven spiking convolutional cell.
+ *
+ * The connections of each input position to the output positions (kernel
+ * synapse and output node) and the outputs connected to each input channel
+ * are computed once in initialize(), so that propagating a spike only walks
+ * through precomputed fan-out lists.
+*/
 class ConvCell_Spike : public virtual ConvCell, public Cell_Spike {
 public:
     ConvCell_Spike(Network& net,
@@ -118,6 +126,11 @@ protected:
                             bool negative) const;
     inline std::tuple<unsigned int, unsigned int, unsigned int, bool>
     unmaps(EventType_T type) const;
+    void integrate(Synapse_Static* synapse,
+                   unsigned int index,
+                   Time_T timestamp,
+                   bool negative);
+    double leakFactor(Time_T dt);
 
     /// Relative initial synaptic weight \f$w_{init}\f$
     ParameterWithSpread<Weight_T> mWeightsRelInit;
@@ -138,6 +151,29 @@ protected:
     Tensor4d<double> mOutputsIntegration;
     Tensor4d<Time_T> mOutputsRefractoryEnd;
 
+    /// Connection of an input position to an output position
+    struct FanOut {
+        /// Synapse position in the kernel (sx + kernelWidth * sy)
+        unsigned int synapse;
+        /// Output position, before subsampling
+        unsigned int ox;
+        unsigned int oy;
+        /// Index of the (subsampled) output node in an output map
+        unsigned int index;
+    };
+
+    /// Fan-out of each input position: the connections of the input position
+    /// i are mFanOut[mFanOutOffsets[i]] to mFanOut[mFanOutOffsets[i + 1] - 1]
+    std::vector<FanOut> mFanOut;
+    std::vector<unsigned int> mFanOutOffsets;
+    /// Outputs connected to each input channel
+    std::vector<std::vector<unsigned int> > mChannelOutputs;
+    /// Direct-mapped cache of the leak decay factor, by elapsed time since the
+    /// last integration
+    std::vector<std::pair<Time_T, double> > mLeakCache;
+    /// Leak time constant for which mLeakCache is valid
+    Time_T mLeakCacheLeak;
+
 private:
     static Registrar<ConvCell> mRegistrar;
 };
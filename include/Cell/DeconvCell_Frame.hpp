@@ -29,6 +29,11 @@
 namespace N2D2 {
 class DeconvCell_Frame : public virtual DeconvCell, public Cell_Frame {
 public:
+    enum Algorithm {
+        Direct,
+        GEMM
+    };
+
     DeconvCell_Frame(const std::string& name,
                      unsigned int kernelWidth,
                      unsigned int kernelHeight,
@@ -99,12 +104,18 @@ protected:
         mBias(output) = value;
     };
 
+    /// Convolution algorithm: direct loops or lowered (im2col + GEMM)
+    Parameter<Algorithm> mAlgorithm;
+
     // Internal
     std::vector<std::shared_ptr<Solver<Float_T> > > mWeightsSolvers;
     Interface<Float_T> mSharedSynapses;
     Tensor4d<Float_T> mBias;
     Interface<Float_T> mDiffSharedSynapses;
     Tensor4d<Float_T> mDiffBias;
+    /// Maps of each input, indexed by (input channel, output) as expected by
+    /// the convolution kernels
+    std::vector<Tensor2d<bool> > mInputsMaps;
     ConvCell_Frame_Kernels::Descriptor mConvDesc;
 
 private:
@@ -112,4 +123,10 @@ private:
 };
 }
 
+namespace {
+template <>
+const char* const EnumStrings<N2D2::DeconvCell_Frame::Algorithm>::data[]
+    = {"Direct", "GEMM"};
+}
+
 #endif // N2D2_DECONVCELL_FRAME_H
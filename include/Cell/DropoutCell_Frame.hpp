@@ -53,6 +53,8 @@ public:
 
 protected:
     Tensor4d<char> mMask;
+    /// Number of masks drawn, for the Philox key of the next one
+    unsigned long long mMaskCounter;
 
 private:
     static Registrar<DropoutCell> mRegistrar;
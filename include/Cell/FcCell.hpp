@@ -48,6 +48,9 @@
 #pragma comment(                                                               \
     linker,                                                                    \
     "/include:?mRegistrar@FcCell_Spike@N2D2@@0U?$Registrar@VFcCell@N2D2@@@2@A")
+#pragma comment(                                                               \
+    linker,                                                                    \
+    "/include:?mRegistrar@FcCell_CSpike@N2D2@@0U?$Registrar@VFcCell@N2D2@@@2@A")
 #pragma comment(                                                               \
     linker,                                                                    \
     "/include:?mRegistrar@FcCell_Spike_Analog@N2D2@@0U?$Registrar@VFcCell@N2D2@@@2@A")
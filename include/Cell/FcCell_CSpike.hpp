@@ -0,0 +1,90 @@
+/*
+    (C) Copyright 2016 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#ifndef N2D2_FCCELL_CSPIKE_H
+#define N2D2_FCCELL_CSPIKE_H
+
+#include "Cell_CSpike.hpp"
+#include "FcCell.hpp"
+
+namespace N2D2 {
+/**
+ * Clock-driven spiking fully connected cell. The weights and biases are stored
+ * in the same format as FcCell_Frame.
+ *
+ * At each tick, the list of the inputs that spiked is built first, so that the
+ * integration cost is proportional to the number of input spikes.
+*/
+class FcCell_CSpike : public virtual FcCell, public Cell_CSpike {
+public:
+    FcCell_CSpike(const std::string& name, unsigned int nbOutputs);
+    static std::shared_ptr<FcCell> create(Network& /*net*/,
+                                          const std::string& name,
+                                          unsigned int nbOutputs,
+                                          const std::shared_ptr
+                                          <Activation<Float_T> >&
+                                          /*activation*/
+                                          = std::shared_ptr
+                                          <Activation<Float_T> >())
+    {
+        return std::make_shared<FcCell_CSpike>(name, nbOutputs);
+    }
+
+    virtual void initialize();
+    virtual bool tick(Time_T timestamp);
+    inline Float_T getWeight(unsigned int output, unsigned int channel) const
+    {
+        return mSynapses(0, 0, channel, output);
+    };
+    inline Float_T getBias(unsigned int output) const
+    {
+        return mBias(output);
+    };
+    void saveFreeParameters(const std::string& fileName) const;
+    void loadFreeParameters(const std::string& fileName,
+                            bool ignoreNotExists = false);
+    virtual ~FcCell_CSpike();
+
+protected:
+    inline void
+    setWeight(unsigned int output, unsigned int channel, Float_T value)
+    {
+        mSynapses(0, 0, channel, output) = value;
+    };
+    inline void setBias(unsigned int output, Float_T value)
+    {
+        mBias(output) = value;
+    };
+
+    // Internal
+    Interface<Float_T> mSynapses;
+    Tensor4d<Float_T> mBias;
+    /// Indexes of the inputs that spiked during the current tick, for each
+    /// input and batch position
+    std::vector<std::vector<unsigned int> > mInputsSpiking;
+    /// Corresponding spikes values
+    std::vector<std::vector<char> > mInputsSpikes;
+
+private:
+    static Registrar<FcCell> mRegistrar;
+};
+}
+
+#endif // N2D2_FCCELL_CSPIKE_H
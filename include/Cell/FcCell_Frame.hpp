@@ -24,6 +24,7 @@
 #include "Cell_Frame.hpp"
 #include "FcCell.hpp"
 #include "Solver/SGDSolver_Frame.hpp"
+#include "utils/Quantization.hpp"
 
 namespace N2D2 {
 class FcCell_Frame : public virtual FcCell, public Cell_Frame {
@@ -55,6 +56,19 @@ public:
     {
         return mBias(output);
     };
+    /**
+     * Switch the cell to integer inference (see
+     * ConvCell_Frame::setQuantization())
+    */
+    void setQuantization(unsigned int nbBits,
+                         const Quantization::Signals& inputs
+                            = Quantization::Signals(),
+                         const Quantization::Signals& outputs
+                            = Quantization::Signals());
+    unsigned int getQuantization() const
+    {
+        return mQuantizationBits;
+    };
     void checkGradient(double epsilon = 1.0e-4, double maxError = 1.0e-6);
     void saveFreeParameters(const std::string& fileName) const;
     void loadFreeParameters(const std::string& fileName,
@@ -72,6 +86,9 @@ protected:
         mBias(output) = value;
     };
 
+    const Float_T* maskedSynapses(unsigned int k);
+    void propagateQuantized();
+
     Parameter<double> mDropConnect;
 
     // Internal
@@ -82,7 +99,20 @@ protected:
     Tensor4d<Float_T> mDiffBias;
 
     Interface<bool> mDropConnectMask;
+    std::vector<Float_T> mMaskedSynapses;
     bool mLockRandom;
+    /// Number of DropConnect masks drawn, for the Philox key of the next one
+    unsigned long long mMaskCounter;
+
+    // Integer inference (enabled when mQuantizationBits > 0)
+    unsigned int mQuantizationBits;
+    Quantization::Signals mQuantizedInputs;
+    Quantization::Signals mQuantizedOutputs;
+    Interface<signed char> mQuantizedSynapses;
+    std::vector<float> mSynapsesScales;
+    std::vector<int> mQuantizedBias;
+    Tensor4d<short> mQuantizedInputsData;
+    Tensor4d<int> mAccumulators;
 
 private:
     static Registrar<FcCell> mRegistrar;
@@ -48,6 +48,9 @@
 #pragma comment(                                                               \
     linker,                                                                    \
     "/include:?mRegistrar@PoolCell_Spike@N2D2@@0U?$Registrar@VPoolCell@N2D2@@@2@A")
+#pragma comment(                                                               \
+    linker,                                                                    \
+    "/include:?mRegistrar@PoolCell_CSpike@N2D2@@0U?$Registrar@VPoolCell@N2D2@@@2@A")
 #pragma comment(                                                               \
     linker,                                                                    \
     "/include:?mRegistrar@?$PoolCell_Transcode@VPoolCell_Frame@N2D2@@VPoolCell_Spike@2@@N2D2@@0U?$Registrar@VPoolCell@N2D2@@@2@A")
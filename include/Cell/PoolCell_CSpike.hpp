@@ -0,0 +1,93 @@
+/*
+    (C) Copyright 2016 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#ifndef N2D2_POOLCELL_CSPIKE_H
+#define N2D2_POOLCELL_CSPIKE_H
+
+#include "Cell_CSpike.hpp"
+#include "PoolCell.hpp"
+
+namespace N2D2 {
+/**
+ * Clock-driven spiking pooling cell.
+ *
+ * With the Max pooling, each output forwards the spikes of the input of its
+ * pooling area with the highest activity (number of spikes received since the
+ * last reset). With the Average pooling, the outputs are integrate-and-fire
+ * neurons integrating the average of the input spikes of their pooling area.
+*/
+class PoolCell_CSpike : public virtual PoolCell, public Cell_CSpike {
+public:
+    PoolCell_CSpike(const std::string& name,
+                    unsigned int poolWidth,
+                    unsigned int poolHeight,
+                    unsigned int nbOutputs,
+                    unsigned int strideX = 1,
+                    unsigned int strideY = 1,
+                    unsigned int paddingX = 0,
+                    unsigned int paddingY = 0,
+                    Pooling pooling = Max);
+    static std::shared_ptr<PoolCell> create(Network& /*net*/,
+                                            const std::string& name,
+                                            unsigned int poolWidth,
+                                            unsigned int poolHeight,
+                                            unsigned int nbOutputs,
+                                            unsigned int strideX = 1,
+                                            unsigned int strideY = 1,
+                                            unsigned int paddingX = 0,
+                                            unsigned int paddingY = 0,
+                                            Pooling pooling = Max,
+                                            const std::shared_ptr
+                                            <Activation<Float_T> >&
+                                            /*activation*/
+                                            = std::shared_ptr
+                                            <Activation<Float_T> >())
+    {
+        return std::make_shared<PoolCell_CSpike>(name,
+                                                 poolWidth,
+                                                 poolHeight,
+                                                 nbOutputs,
+                                                 strideX,
+                                                 strideY,
+                                                 paddingX,
+                                                 paddingY,
+                                                 pooling);
+    }
+
+    virtual void initialize();
+    virtual bool tick(Time_T timestamp);
+    virtual void reset(Time_T timestamp);
+    virtual ~PoolCell_CSpike();
+
+protected:
+    void tickMax();
+    void tickAverage(Float_T leakFactor);
+
+    // Internal
+    /// Activity of the inputs (number of spikes since the last reset,
+    /// negative spikes are subtracted), for the Max pooling
+    Interface<int> mInputsActivity;
+
+private:
+    static Registrar<PoolCell> mRegistrar;
+};
+}
+
+#endif // N2D2_POOLCELL_CSPIKE_H
@@ -70,6 +70,10 @@ public:
     virtual void propagate(bool inference = false);
     virtual void backPropagate();
     virtual void update();
+    virtual bool isChannelBlockable() const
+    {
+        return true;
+    };
     void checkGradient(double epsilon = 1.0e-4, double maxError = 1.0e-6);
     Interface<PoolCell_Frame_Kernels::ArgMax>* getArgMax()
     {
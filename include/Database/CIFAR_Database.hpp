@@ -22,6 +22,7 @@
 #define N2D2_CIFAR_DATABASE_H
 
 #include "Database/Database.hpp"
+#include "utils/MappedFile.hpp"
 
 namespace N2D2 {
 class CIFAR_Database : public Database {
@@ -37,7 +38,25 @@ public:
     virtual ~CIFAR_Database() {};
 
 protected:
+    struct MappedStimulus {
+        std::shared_ptr<MappedFile> file;
+        unsigned long long offset;
+    };
+
+    virtual cv::Mat readStimulusData(StimulusID id);
+    /// Convert a CIFAR image, stored as red, green and blue planes, to a
+    /// BGR matrix
+    static cv::Mat decodeImage(const unsigned char* data);
+
     double mValidation;
+    /// If true, the stimuli are read directly from the memory-mapped CIFAR
+    /// file, instead of being extracted to one image file each
+    Parameter<bool> mMemoryMapped;
+    /// Location of the stimuli data in the mapped files, by stimulus name
+    std::map<std::string, MappedStimulus> mMappedStimuli;
+
+    static const unsigned int NbRows = 32;
+    static const unsigned int NbColumns = 32;
 };
 
 class CIFAR10_Database : public CIFAR_Database {
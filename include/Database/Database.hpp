@@ -38,6 +38,7 @@
 #include "ROI/RectangularROI.hpp"
 #include "containers/Tensor2d.hpp"
 #include "utils/Gnuplot.hpp"
+#include "utils/MatCache.hpp"
 #include "utils/Parameterizable.hpp"
 #include "utils/Utils.hpp"
 
@@ -260,6 +261,20 @@ public:
     inline cv::Mat getStimulusData(StimuliSet set, unsigned int index);
     cv::Mat getStimulusLabelsData(StimulusID id);
     inline cv::Mat getStimulusLabelsData(StimuliSet set, unsigned int index);
+    /// In-memory stimuli cache statistics (when data is loaded in memory)
+    MatCache::Stats getCacheStats() const
+    {
+        return mStimuliCache.getStats();
+    };
+    void resetCacheStats()
+    {
+        mStimuliCache.resetStats();
+    };
+    /// Drop every stimulus kept in memory
+    void clearCache()
+    {
+        mStimuliCache.clear();
+    };
     std::vector<StimuliSet> getStimuliSets(StimuliSetMask setMask) const;
     StimuliSetMask getStimuliSetMask(StimuliSet set) const;
 
@@ -272,6 +287,8 @@ protected:
     getRelPathStimuli(const std::string& fileName, const std::string& relPath);
     int labelID(const std::string& labelName);
     cv::Mat loadStimulusData(StimulusID id);
+    /// Read the whole stimulus data (before the ROI and slice extraction)
+    virtual cv::Mat readStimulusData(StimulusID id);
     cv::Mat loadStimulusLabelsData(StimulusID id) const;
     std::vector<unsigned int> getLabelStimuliSetIndexes(int label,
                                                         StimuliSet set) const;
@@ -289,6 +306,10 @@ protected:
     Parameter<std::string> mDefaultLabel;
     /// Margin around the ROIs, in pixels, with no label (label ID = -1)
     Parameter<unsigned int> mROIsMargin;
+    /// Memory budget, in MB, for the stimuli loaded in memory. When the
+    /// budget is exceeded, the least recently used stimuli are evicted and
+    /// loaded again on their next use (0 = unlimited)
+    Parameter<unsigned int> mCacheMemoryBudget;
 
     /**
      * TABLES
@@ -297,10 +318,9 @@ protected:
     std::vector<Stimulus> mStimuli;
     /// Labels name
     std::vector<std::string> mLabelsName;
-    /// Stimuli data
-    std::vector<cv::Mat> mStimuliData;
-    /// Labels matrix associated to each stimulus
-    std::vector<cv::Mat> mStimuliLabelsData;
+    /// Stimuli data and labels matrix kept in memory, the key is
+    /// 2 * id for the data and 2 * id + 1 for the labels matrix
+    MatCache mStimuliCache;
     /// Stimuli sets
     StimuliSets mStimuliSets;
 
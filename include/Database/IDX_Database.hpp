@@ -22,6 +22,7 @@
 #define N2D2_IDX_DATABASE_H
 
 #include "Database/Database.hpp"
+#include "utils/MappedFile.hpp"
 
 namespace N2D2 {
 class IDX_Database : public Database {
@@ -45,6 +46,22 @@ public:
                       const std::string& labelPath = "",
                       bool /*extractROIs*/ = false);
     virtual ~IDX_Database() {};
+
+protected:
+    struct MappedStimulus {
+        std::shared_ptr<MappedFile> file;
+        unsigned long long offset;
+        int rows;
+        int cols;
+    };
+
+    virtual cv::Mat readStimulusData(StimulusID id);
+
+    /// If true, the stimuli are read directly from the memory-mapped IDX
+    /// file, instead of being extracted to one image file each
+    Parameter<bool> mMemoryMapped;
+    /// Location of the stimuli data in the mapped files, by stimulus name
+    std::map<std::string, MappedStimulus> mMappedStimuli;
 };
 }
 
@@ -21,6 +21,7 @@
 #ifndef N2D2_DEEPNET_H
 #define N2D2_DEEPNET_H
 
+#include <set>
 #include <string>
 #include <vector>
 
@@ -32,6 +33,7 @@
 #include "Monitor.hpp"
 #include "Network.hpp"
 #include "utils/IniParser.hpp"
+#include "utils/Quantization.hpp"
 #include "utils/Utils.hpp"
 
 #include "Cell/NodeIn.hpp"
@@ -68,6 +70,37 @@ public:
         void operator()(double value);
     };
 
+    struct MemoryPlan {
+        MemoryPlan();
+
+        /// Number of reusable buffers holding the planned outputs
+        unsigned int nbSlots;
+        /// Number of cells whose outputs are assigned to a slot
+        unsigned int nbPlannedCells;
+        /// Bytes of the cells outputs and gradients before planning
+        std::size_t initialBytes;
+        /// Bytes of the slots and of the outputs kept by their cell
+        std::size_t plannedBytes;
+    };
+
+    struct CheckpointPlan {
+        CheckpointPlan();
+
+        /// Number of layers keeping their outputs, ending a segment
+        unsigned int nbCheckpoints;
+        /// Number of cells whose outputs are recomputed during learn()
+        unsigned int nbRecomputedCells;
+        /// Bytes of the cells outputs without checkpointing
+        std::size_t initialBytes;
+        /// Peak bytes of the cells outputs during learn(): the outputs kept
+        /// and the largest recomputed segment
+        std::size_t peakBytes;
+        /// Connections of the forward pass, for the whole batch
+        unsigned long long int forwardConnections;
+        /// Connections of the recomputed cells, added to each learn()
+        unsigned long long int recomputedConnections;
+    };
+
     DeepNet(Network& net);
     void addCell(const std::shared_ptr<Cell>& cell,
                  const std::vector<std::shared_ptr<Cell> >& parents);
@@ -85,6 +118,48 @@ public:
     void importNetworkSolverParameters(const std::string& dirName);
     void checkGradient(double epsilon = 1.0e-4, double maxError = 1.0e-6);
     void initialize();
+    /**
+     * Graph optimization for inference: fold each BatchNorm cell into the
+     * convolution feeding it (and only it), which takes over its activation
+     * and children. The network cannot be learned anymore afterwards, so it
+     * must be applied to a network dedicated to inference.
+     * Return the number of cells removed.
+    */
+    unsigned int fuseCells();
+    /**
+     * Post-training quantization for inference: switch the convolution and
+     * fully connected cells to integer inference on @p nbBits, with a weights
+     * scale per output channel and the signals scales calibrated on the
+     * @p outputsHistogram collected with reportOutputsHistogram(). Like
+     * fuseCells(), the network cannot be learned anymore afterwards.
+     * Return the number of cells quantized.
+    */
+    unsigned int quantize(const std::map
+                          <std::string, Quantization::Histogram>&
+                          outputsHistogram,
+                          unsigned int nbBits,
+                          Quantization::Calibration calibration
+                          = Quantization::KL);
+    /**
+     * Static memory planning for inference: the outputs of the cells are
+     * assigned to a small set of reusable buffers (slots) according to their
+     * lifetime in the layers order, and the gradient buffers are released.
+     * After each test(), only the outputs of the target and monitored cells
+     * remain readable. Like fuseCells(), the network cannot be learned
+     * anymore afterwards.
+    */
+    MemoryPlan planMemory();
+    /**
+     * Gradient checkpointing for learning: only the outputs of the checkpoint
+     * layers (and of the cells which cannot be recomputed) are kept during
+     * learn(). The outputs of the other cells are released after their last
+     * use in the forward pass, and recomputed from the previous checkpoint
+     * before the back-propagation of their segment. The checkpoints are
+     * chosen to minimize the recomputations with a peak outputs memory below
+     * @p memoryBudget bytes, or to minimize the peak if no choice fits.
+     * The outputs released by learn() are allocated again by test().
+    */
+    CheckpointPlan planCheckpoints(std::size_t memoryBudget);
     void learn(std::vector<std::pair<std::string, double> >* timings = NULL);
     void test(Database::StimuliSet set = Database::Test,
               std::vector<std::pair<std::string, double> >* timings = NULL);
@@ -116,6 +191,24 @@ public:
     {
         mFreeParametersDiscretization = freeParametersDiscretization;
     }
+    /**
+     * Use the channel-blocked (NCHWc) layout, with @p channelBlock (8 or 16)
+     * interleaved channels, for the outputs of the Frame cells feeding only
+     * cells able to consume it. Applied by initialize().
+    */
+    void setChannelBlock(unsigned int channelBlock = 1)
+    {
+        mChannelBlock = channelBlock;
+    }
+    /**
+     * Run the independent cells of a layer (and the targets of different
+     * cells) concurrently in learn() and test(), the OpenMP threads being
+     * shared between the concurrent cells. Ignored with CUDA.
+    */
+    void setConcurrentCells(bool concurrentCells = true)
+    {
+        mConcurrentCells = concurrentCells;
+    }
     template <class T>
     void setCellsParameter(const std::string& name,
                            T value,
@@ -173,6 +266,14 @@ public:
     {
         return mFreeParametersDiscretization;
     }
+    unsigned int getChannelBlock() const
+    {
+        return mChannelBlock;
+    }
+    bool getConcurrentCells() const
+    {
+        return mConcurrentCells;
+    }
     void getStats(Cell::Stats& stats) const;
 
     // Clear
@@ -200,6 +301,9 @@ public:
                     <std::pair<std::string, double> >& timings) const;
     void reportOutputsRange(std::map
                             <std::string, RangeStats>& outputsRange) const;
+    void reportOutputsHistogram(std::map
+                                <std::string, Quantization::Histogram>&
+                                outputsHistogram) const;
     void logOutputsRange(const std::string& fileName,
                          const std::map
                          <std::string, RangeStats>& outputsRange) const;
@@ -207,9 +311,50 @@ public:
     virtual ~DeepNet() {};
 
 private:
+    /// Unit of work of learn() and test(): a pass on a cell, or the
+    /// processing of a target
+    struct Task {
+        enum Type {
+            Propagate,
+            Inference,
+            BackPropagate,
+            Update,
+            ProcessTarget
+        };
+
+        Task(Type type_, const std::string& cell_, const std::string& name_);
+
+        Type type;
+        std::string cell;
+        /// Name used for the timings
+        std::string name;
+        std::shared_ptr<Target> target;
+        Database::StimuliSet set;
+        /// Data shared with other tasks and modified by this one (the cells
+        /// whose diff. inputs are accumulated, or the target cell). Tasks
+        /// sharing a resource are run in order, never concurrently.
+        std::vector<std::string> resources;
+    };
+
+    void runTasks(const std::vector<Task>& tasks,
+                  std::vector<std::pair<std::string, double> >* timings);
+    void runTask(const Task& task);
     void drawHistogram(std::string title, const std::string& dataFileName,
                    unsigned int fileRow, unsigned int& maxLabelSize, bool isLog,
                    Gnuplot& p) const;
+    void applyChannelBlock();
+    void acquireOutputs(unsigned int layer);
+    void releaseOutputs(unsigned int layer);
+    std::set<std::string> getObservedCells() const;
+    void getOutputsLifetime(std::map<std::string, unsigned int>& cellLayer,
+                            std::map<std::string, unsigned int>& lastLayer)
+        const;
+    void allocateRecomputed(unsigned int layer);
+    void releaseRecomputed(unsigned int layer, bool backward);
+    void recomputeSegment(unsigned int checkpoint,
+                          std::vector<std::pair<std::string, double> >*
+                            timings);
+
     Network& mNet;
     std::shared_ptr<Database> mDatabase;
     std::shared_ptr<StimuliProvider> mStimuliProvider;
@@ -220,6 +365,29 @@ private:
     std::multimap<std::string, std::string> mParentLayers;
     unsigned int mSignalsDiscretization;
     unsigned int mFreeParametersDiscretization;
+    unsigned int mChannelBlock;
+    bool mConcurrentCells;
+    bool mCellsFused;
+    bool mQuantized;
+    /// Outputs assigned to a slot by planMemory(): the slot and the last
+    /// layer reading the outputs, after which they are given back
+    struct PlannedOutputs {
+        unsigned int slot;
+        unsigned int lastLayer;
+        std::size_t size;
+    };
+    std::map<std::string, PlannedOutputs> mPlannedOutputs;
+    std::vector<Tensor4d<Float_T>::data_type> mMemorySlots;
+    /// Cells recomputed by learn() with checkpointing: their layer and the
+    /// last layer reading their outputs in the forward pass
+    struct RecomputedOutputs {
+        unsigned int layer;
+        unsigned int lastLayer;
+        std::size_t size;
+    };
+    std::map<std::string, RecomputedOutputs> mRecomputedCells;
+    /// Checkpoint layers, in ascending order
+    std::vector<unsigned int> mCheckpoints;
     bool mFreeParametersDiscretized;
     unsigned int mStreamIdx;
     unsigned int mStreamTestIdx;
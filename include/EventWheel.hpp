@@ -0,0 +1,94 @@
+/*
+    (C) Copyright 2016 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#ifndef N2D2_EVENTWHEEL_H
+#define N2D2_EVENTWHEEL_H
+
+#include <cstddef>
+#include <queue>
+#include <vector>
+
+#include "Network.hpp"
+
+namespace N2D2 {
+class SpikeEvent;
+
+/**
+ * Hierarchical timing wheel ordering the events of the Network, as an
+ * alternative to the binary heap.
+ *
+ * The wheel has one level per byte of Time_T (8 levels of 256 slots), so the
+ * time resolution is exact and there is no overflow list. An event is stored
+ * at the level of the most significant byte where its timestamp differs from
+ * the current wheel time, in the slot given by this byte. Level 0 slots thus
+ * contain events with a single timestamp. When the lower levels are empty,
+ * the first non-empty slot of the next level is cascaded down to the lower
+ * levels, so that each event is moved at most once per level and push/pop
+ * are O(1) amortized, instead of O(log n).
+ *
+ * The events of the current timestamp are kept in a small binary heap, so that
+ * they are dequeued in the exact order specified by SpikeEvent::operator<.
+*/
+class EventWheel {
+public:
+    EventWheel();
+    void push(SpikeEvent* event);
+    /// Return the next event (the wheel must not be empty)
+    SpikeEvent* top();
+    void pop();
+    bool empty() const
+    {
+        return (mSize == 0);
+    };
+    std::size_t size() const
+    {
+        return mSize;
+    };
+
+private:
+    static const unsigned int NbLevels = sizeof(Time_T);
+    static const unsigned int NbSlots = 256;
+    static const unsigned int NbWords = NbSlots / 64;
+
+    struct Level {
+        std::vector<SpikeEvent*> slots[NbSlots];
+        /// Non-empty slots bitmap
+        unsigned long long used[NbWords];
+    };
+
+    void insert(SpikeEvent* event);
+    /// Fill the current timestamp queues with the next events
+    bool advance();
+    /// Re-insert all the events relative to an earlier time
+    void rewind(Time_T timestamp);
+    static int findSlot(const unsigned long long* used, unsigned int from);
+
+    Level mLevels[NbLevels];
+    Time_T mNow;
+    std::size_t mSize;
+    /// Events of the current timestamp
+    bool mCurrent;
+    std::priority_queue
+        <SpikeEvent*, std::vector<SpikeEvent*>, Utils::PtrLess<SpikeEvent*> >
+    mCurrentEvents;
+};
+}
+
+#endif // N2D2_EVENTWHEEL_H
@@ -31,7 +31,8 @@ namespace N2D2 {
  * Class for methods of BatchNorm for all CPP exports type
  * BatchNormCell, CPP_EXPORT
 **/
-class CPP_BatchNormCellExport : public BatchNormCellExport {
+class CPP_BatchNormCellExport : public BatchNormCellExport,
+                                public CPP_CellExport {
 public:
     static void generate(BatchNormCell& cell, const std::string& dirName);
     static void generateHeaderConstants(BatchNormCell& cell,
@@ -47,8 +48,17 @@ public:
     static void generateHeaderMean(BatchNormCell& cell, std::ofstream& header);
     static void generateHeaderScale(BatchNormCell& cell, std::ofstream& header);
 
+    static std::unique_ptr<CPP_BatchNormCellExport> getInstance(Cell& cell);
+
+    void generateCellData(Cell& cell, std::ofstream& prog);
+    void generateCellFunction(Cell& cell,
+                              const std::string& inputName,
+                              const std::string& outputName,
+                              std::ofstream& prog);
+
 private:
     static Registrar<BatchNormCellExport> mRegistrar;
+    static Registrar<CPP_CellExport> mRegistrarType;
 };
 }
 
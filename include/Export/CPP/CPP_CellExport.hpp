@@ -29,6 +29,28 @@
 #include "Cell/Cell.hpp"
 #include "utils/Registrar.hpp"
 
+#ifdef WIN32
+// For static library
+#pragma comment(                                                               \
+    linker,                                                                    \
+    "/include:?mRegistrarType@CPP_BatchNormCellExport@N2D2@@0U?$Registrar@VCPP_CellExport@N2D2@@@2@A")
+#pragma comment(                                                               \
+    linker,                                                                    \
+    "/include:?mRegistrarType@CPP_ConvCellExport@N2D2@@0U?$Registrar@VCPP_CellExport@N2D2@@@2@A")
+#pragma comment(                                                               \
+    linker,                                                                    \
+    "/include:?mRegistrarType@CPP_FMPCellExport@N2D2@@0U?$Registrar@VCPP_CellExport@N2D2@@@2@A")
+#pragma comment(                                                               \
+    linker,                                                                    \
+    "/include:?mRegistrarType@CPP_FcCellExport@N2D2@@0U?$Registrar@VCPP_CellExport@N2D2@@@2@A")
+#pragma comment(                                                               \
+    linker,                                                                    \
+    "/include:?mRegistrarType@CPP_PoolCellExport@N2D2@@0U?$Registrar@VCPP_CellExport@N2D2@@@2@A")
+#pragma comment(                                                               \
+    linker,                                                                    \
+    "/include:?mRegistrarType@CPP_SoftmaxCellExport@N2D2@@0U?$Registrar@VCPP_CellExport@N2D2@@@2@A")
+#endif
+
 namespace N2D2 {
 /**
  * Virtual base class for methods commun to every cell type for the CPP export
@@ -51,25 +73,19 @@ public:
 
     inline static std::unique_ptr<CPP_CellExport> getInstance(Cell& cell);
 
+    static void generateOutputFunction(Cell& cell,
+                                       const std::string& inputName,
+                                       const std::string& outputName,
+                                       std::ofstream& prog);
+
     // Commun methods for all cells
-    virtual void generateCellData(Cell& cell,
-                                  const std::string& outputName,
-                                  const std::string& outputSizeName,
-                                  std::ofstream& prog) = 0;
+    virtual void generateCellData(Cell& cell, std::ofstream& prog) = 0;
     virtual void generateCellFunction(Cell& cell,
-                                      const std::vector
-                                      <std::shared_ptr<Cell> >& parentCells,
                                       const std::string& inputName,
                                       const std::string& outputName,
-                                      const std::string& outputSizeName,
-                                      std::ofstream& prog,
-                                      const std::string& funcProto = "",
-                                      const std::string& memProto = "",
-                                      bool memCompact = false) = 0;
-    virtual void generateOutputFunction(Cell& cell,
-                                        const std::string& inputName,
-                                        const std::string& outputName,
-                                        std::ofstream& prog) = 0;
+                                      std::ofstream& prog) = 0;
+
+    virtual ~CPP_CellExport() {};
 };
 }
 
@@ -31,7 +31,8 @@ namespace N2D2 {
  * ConvCell, CPP_EXPORT
 **/
 
-class CPP_ConvCellExport : public ConvCellExport {
+class CPP_ConvCellExport : public ConvCellExport,
+                           public CPP_CellExport {
 public:
     static void generate(ConvCell& cell, const std::string& dirName);
     static void generateHeaderFreeParameters(ConvCell& cell,
@@ -60,8 +61,17 @@ public:
     static void generateHeaderWeightsValues(ConvCell& cell,
                                             std::ofstream& header);
 
+    static std::unique_ptr<CPP_ConvCellExport> getInstance(Cell& cell);
+
+    void generateCellData(Cell& cell, std::ofstream& prog);
+    void generateCellFunction(Cell& cell,
+                              const std::string& inputName,
+                              const std::string& outputName,
+                              std::ofstream& prog);
+
 private:
     static Registrar<ConvCellExport> mRegistrar;
+    static Registrar<CPP_CellExport> mRegistrarType;
 };
 }
 
@@ -33,6 +33,7 @@ namespace N2D2 {
 class CPP_DeepNetExport : public DeepNetExport {
 public:
     static void generate(DeepNet& deepNet, const std::string& dirName);
+    static void generateCommon(DeepNet& deepNet, const std::string& dirName);
     static void generateParamsHeader(const std::string& fileName);
     static void generateEnvironmentHeader(DeepNet& deepNet,
                                           const std::string& fileName);
@@ -43,6 +44,14 @@ public:
                                        const std::string typeStr,
                                        std::ofstream& header);
     static void generateHeaderEnd(DeepNet& deepNet, std::ofstream& header);
+
+    static void generateDeepNetHeader(DeepNet& deepNet,
+                                      const std::string& fileName);
+    static void generateDeepNetProgram(DeepNet& deepNet,
+                                       const std::string& fileName);
+    static void generateProgramData(DeepNet& deepNet, std::ofstream& prog);
+    static void generateProgramFunction(DeepNet& deepNet,
+                                        std::ofstream& prog);
 private:
     static Registrar<DeepNetExport> mRegistrar;
 };
@@ -31,15 +31,25 @@ namespace N2D2 {
  * Class for methods of FMP for all CPP exports type
  * FMPCell, CPP_EXPORT
 **/
-class CPP_FMPCellExport : public FMPCellExport {
+class CPP_FMPCellExport : public FMPCellExport,
+                          public CPP_CellExport {
 public:
     static void generate(FMPCell& cell, const std::string& dirName);
     static void generateHeaderConstants(FMPCell& cell, std::ofstream& header);
     static void generateHeaderConnections(FMPCell& cell, std::ofstream& header);
     static void generateHeaderGrid(FMPCell& cell, std::ofstream& header);
 
+    static std::unique_ptr<CPP_FMPCellExport> getInstance(Cell& cell);
+
+    void generateCellData(Cell& cell, std::ofstream& prog);
+    void generateCellFunction(Cell& cell,
+                              const std::string& inputName,
+                              const std::string& outputName,
+                              std::ofstream& prog);
+
 private:
     static Registrar<FMPCellExport> mRegistrar;
+    static Registrar<CPP_CellExport> mRegistrarType;
 };
 }
 
@@ -30,7 +30,8 @@ namespace N2D2 {
  * Class for methods of FcCell for all CPP exports type
  * FcCell, CPP EXPORT
 **/
-class CPP_FcCellExport : public FcCellExport {
+class CPP_FcCellExport : public FcCellExport,
+                         public CPP_CellExport {
 public:
     static void generate(FcCell& cell, const std::string& dirName);
     static void generateHeaderConstants(FcCell& cell, std::ofstream& header);
@@ -50,8 +51,17 @@ public:
                                               std::ofstream& header);
     static void generateHeaderWeightsValues(FcCell& cell,
                                             std::ofstream& header);
+    static std::unique_ptr<CPP_FcCellExport> getInstance(Cell& cell);
+
+    void generateCellData(Cell& cell, std::ofstream& prog);
+    void generateCellFunction(Cell& cell,
+                              const std::string& inputName,
+                              const std::string& outputName,
+                              std::ofstream& prog);
+
 private:
     static Registrar<FcCellExport> mRegistrar;
+    static Registrar<CPP_CellExport> mRegistrarType;
 };
 }
 
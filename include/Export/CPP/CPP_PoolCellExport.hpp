@@ -30,7 +30,8 @@ namespace N2D2 {
  * Class for methods of PoolCell for all CPP exports type
  * PoolCell, CPP EXPORT
 **/
-class CPP_PoolCellExport : public PoolCellExport {
+class CPP_PoolCellExport : public PoolCellExport,
+                           public CPP_CellExport {
 public:
     static void generate(PoolCell& cell, const std::string& dirName);
     static void generateHeaderConstants(PoolCell& cell,
@@ -43,8 +44,17 @@ public:
     static void generateHeaderConnectionsValues(PoolCell& cell,
                                                 std::ofstream& header);
 
+    static std::unique_ptr<CPP_PoolCellExport> getInstance(Cell& cell);
+
+    void generateCellData(Cell& cell, std::ofstream& prog);
+    void generateCellFunction(Cell& cell,
+                              const std::string& inputName,
+                              const std::string& outputName,
+                              std::ofstream& prog);
+
 private:
     static Registrar<PoolCellExport> mRegistrar;
+    static Registrar<CPP_CellExport> mRegistrarType;
 };
 }
 
@@ -31,14 +31,24 @@ namespace N2D2 {
  * Class for methods of Softmax for all CPP exports type
  * SoftmaxCell, CPP_EXPORT
 **/
-class CPP_SoftmaxCellExport : public SoftmaxCellExport {
+class CPP_SoftmaxCellExport : public SoftmaxCellExport,
+                              public CPP_CellExport {
 public:
     static void generate(SoftmaxCell& cell, const std::string& dirName);
     static void generateHeaderConstants(SoftmaxCell& cell,
                                         std::ofstream& header);
 
+    static std::unique_ptr<CPP_SoftmaxCellExport> getInstance(Cell& cell);
+
+    void generateCellData(Cell& cell, std::ofstream& prog);
+    void generateCellFunction(Cell& cell,
+                              const std::string& inputName,
+                              const std::string& outputName,
+                              std::ofstream& prog);
+
 private:
     static Registrar<SoftmaxCellExport> mRegistrar;
+    static Registrar<CPP_CellExport> mRegistrarType;
 };
 }
 
@@ -32,8 +32,21 @@
 namespace N2D2 {
 class DeepNetGenerator {
 public:
+    /**
+     * If @p inputsNet is given, its database and stimuli provider are shared
+     * by the generated network instead of being generated again, so that
+     * both networks are fed with the same stimuli.
+    */
     static std::shared_ptr<DeepNet> generate(Network& network,
-                                             const std::string& fileName);
+                                             const std::string& fileName,
+                                             const std::shared_ptr<DeepNet>&
+                                             inputsNet
+                                             = std::shared_ptr<DeepNet>());
+    static std::shared_ptr<DeepNet> generate(Network& network,
+                                             IniParser& iniConfig,
+                                             const std::shared_ptr<DeepNet>&
+                                             inputsNet
+                                             = std::shared_ptr<DeepNet>());
 };
 }
 
@@ -35,6 +35,12 @@ public:
                                                      & section);
 
 protected:
+    /**
+     * Set the _EpochSize INI property to the number of learning stimuli.
+     * It is never 0 (e.g. without database), as it is typically used as a
+     * solver learning rate step size.
+    */
+    static void setEpochSize(IniParser& iniConfig, Database& database);
     static void generateSubSections(const std::shared_ptr<StimuliProvider>& sp,
                                     IniParser& iniConfig,
                                     const std::string& section);
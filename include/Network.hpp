@@ -25,9 +25,9 @@
 #include <chrono>
 #include <fstream>
 #include <functional>
+#include <memory>
 #include <queue>
 #include <set>
-#include <stack>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -48,6 +48,7 @@
 #include "utils/Utils.hpp"
 
 namespace N2D2 {
+class EventWheel;
 class SpikeEvent;
 class Xcell;
 class Node;
@@ -118,28 +119,56 @@ protected:
  *processed, the N2D2::Node::emitSpike() method
  * is called. This method handles all the internal events created by the node
  *itself, either in the N2D2::Node::incomingSpike()
- * or any other method and create events to its child nodes.
+ * or any other method and create events to its child nodes. @n
+ * In parallel mode, the network is partitioned at the first run: the neurons of
+ * each Xcell form a partition, as long as they are partitionable (see
+ * N2D2::Node::isPartitionable()), and all the other nodes form a shared
+ * partition. Partitions connected through a link without delay, lateral
+ * inhibition or a non-partitionable node are merged, as are the partitions
+ * forming a cycle. Each partition has its own event queue and the partitions
+ * are simulated by levels, in topological order: all the partitions of a level
+ * run concurrently, on their own thread, once the partitions feeding them are
+ * done. The events towards other partitions are buffered by destination
+ * partition, without any lock, and delivered when the destination partition
+ * starts. As the STDP reads the last activation time of the input nodes, the
+ * activations of the nodes linked to other partitions are logged with the
+ * event that caused them, so that the value seen by a neuron is the one it
+ * would have seen in a sequential run. The simultaneous events being processed
+ * in a deterministic order (see N2D2::SpikeEvent::operator<()), the results
+ * are identical to the sequential simulation. This requires that no event is
+ * scheduled at the timestamp being processed, which is the case as long as the
+ * delays are not 0. The topology of the network must not change after the
+ * first run.
 */
 class Network {
 public:
+    /// Event scheduler: a binary heap (PriorityQueue, O(log n) per event) or a
+    /// hierarchical timing wheel (TimingWheel, O(1) amortized per event, see
+    /// N2D2::EventWheel). Both process the events in the same order.
+    enum Scheduler {
+        PriorityQueue,
+        TimingWheel
+    };
+
     /// Constructor.
     /// @param seed Seed for the random generator, used in any N2D2 function. If
     /// left to 0, a seed based on the system clock
     /// is produced. If the seed is set to a positive value, it is garanteed
     /// that the simulation will always produce the
     /// same results.
-    Network(unsigned int seed = 0);
+    /// @param scheduler Event scheduler used by the simulator.
+    /// @param parallel If true, the network is partitioned and the partitions
+    /// are simulated concurrently (see above).
+    Network(unsigned int seed = 0,
+            Scheduler scheduler = PriorityQueue,
+            bool parallel = false);
     /// Process all the events in the network until no further event remains in
     /// the priority queue.
     /// @param stop If not 0, stop the simulation to the specified timestamp.
     /// Usefull for debug purpose, or to stop network
     /// simulations containing oscillations.
     bool run(Time_T stop = 0, bool clearActivity = true);
-    void stop(Time_T stop = 0, bool discard = false)
-    {
-        mStop = stop;
-        mDiscard = discard;
-    };
+    void stop(Time_T stop = 0, bool discard = false);
     void reset(Time_T timestamp = 0);
     /// Save the entire network state in a given location (binary format, not
     /// portable).
@@ -169,6 +198,20 @@ public:
     {
         return mLoadSavePath;
     };
+    Scheduler getScheduler() const
+    {
+        return mScheduler;
+    };
+    bool isParallel() const
+    {
+        return mParallel;
+    };
+    /// Returns the number of partitions, available after the first run in
+    /// parallel mode (0 if the simulation is sequential)
+    unsigned int getNbPartitions() const
+    {
+        return mPartitions.size();
+    };
     /// Destructor.
     virtual ~Network();
 
@@ -184,31 +227,128 @@ public:
                          EventType_T type = 0);
     inline void
     recordSpike(NodeId_T nodeId, Time_T timestamp = 0, EventType_T type = 0);
+    /// Log the activation of a node linked to other partitions.
+    void logActivation(int log, Time_T timestamp);
+    /// Last activation time of a node linked to other partitions, as seen by
+    /// the event being processed.
+    Time_T getActivationTime(int log, Time_T lastActivationTime) const;
 
 private:
+    static const unsigned int EventsSlabSize = 4096;
+
+    struct Partition {
+        Partition(Scheduler scheduler, unsigned int nbPartitions);
+        bool empty() const;
+        SpikeEvent* top();
+        void pop();
+        void push(SpikeEvent* event);
+
+        std::priority_queue
+            <SpikeEvent*,
+             std::vector<SpikeEvent*>,
+             Utils::PtrLess<SpikeEvent*> > events;
+        std::shared_ptr<EventWheel> eventWheel;
+        std::vector<SpikeEvent*> eventsPool;
+        /// Events for the other partitions, by destination partition
+        std::vector<std::vector<SpikeEvent*> > outgoing;
+        std::unordered_map<NodeId_T, NodeEvents_T> spikeRecording;
+        /// Event being processed
+        const SpikeEvent* current;
+        Time_T lastEvent;
+        unsigned int level;
+        bool stopped;
+        bool done;
+    };
+
+    struct Activation {
+        Time_T timestamp;
+        // Event being processed when the node was activated
+        Node* origin;
+        Node* destination;
+        Time_T eventTimestamp;
+        EventType_T eventType;
+    };
+
+    struct ActivationLog {
+        Node* node;
+        unsigned int partition;
+        /// Last activation time of the node at the beginning of the run
+        Time_T initial;
+        std::vector<Activation> activations;
+    };
+
+    bool runEvents();
+    bool runPartitions();
+    void runPartition(unsigned int partition);
+    void partition();
+    SpikeEvent* allocateEvent(std::vector<SpikeEvent*>& pool);
+    static bool nodeIdLess(const Node* a, const Node* b);
+    static NodeId_T findSet(std::vector<NodeId_T>& parent, NodeId_T id);
+    static void
+    unionSets(std::vector<NodeId_T>& parent, NodeId_T id1, NodeId_T id2);
+    static std::vector<unsigned int> stronglyConnectedComponents(
+        const std::vector<std::vector<unsigned int> >& graph);
+    /// OpenMP thread number of the caller (0 without OpenMP)
+    static unsigned int threadNum();
+    bool eventsEmpty() const;
+    SpikeEvent* eventsTop();
+    void eventsPop();
+
     // Internal variables
     std::set<NetworkObserver*> mObservers;
     std::string mLoadSavePath;
+    const Scheduler mScheduler;
     /// The priority queue containing the events to be processed by the
     /// simulator.
     std::priority_queue
         <SpikeEvent*, std::vector<SpikeEvent*>, Utils::PtrLess<SpikeEvent*> >
     mEvents;
+    /// The timing wheel replacing mEvents with the TimingWheel scheduler
+    std::shared_ptr<EventWheel> mEventWheel;
     std::unordered_map<NodeId_T, NodeEvents_T> mSpikeRecording;
     bool mInitialized;
     Time_T mFirstEvent;
     Time_T mLastEvent;
     Time_T mStop;
     bool mDiscard;
-    std::stack<SpikeEvent*> mEventsPool;
+    /// Events are allocated by slabs of EventsSlabSize and never freed
+    /// before the destruction of the network, as the nodes may keep a pointer
+    /// to the events they created
+    std::vector<SpikeEvent*> mEventsSlabs;
+    /// Available events
+    std::vector<SpikeEvent*> mEventsPool;
+    const bool mParallel;
+    bool mPartitioned;
+    /// True when the partitions are being simulated
+    bool mRunning;
+    /// True when the running partition is the only one running
+    bool mRunningAlone;
+    std::vector<Partition> mPartitions;
+    /// Partition of each node, by node ID
+    std::vector<unsigned int> mNodePartition;
+    /// Partitions by level
+    std::vector<std::vector<unsigned int> > mLevels;
+    std::vector<ActivationLog> mActivationLogs;
+    /// Partition being simulated by each thread
+    std::vector<unsigned int> mThreadPartition;
     const std::chrono::high_resolution_clock::time_point mStartTime;
 };
 }
 
+namespace {
+template <>
+const char* const EnumStrings<N2D2::Network::Scheduler>::data[]
+    = {"PriorityQueue", "TimingWheel"};
+}
+
 void
 N2D2::Network::recordSpike(NodeId_T nodeId, Time_T timestamp, EventType_T type)
 {
-    mSpikeRecording[nodeId].push_back(std::make_pair(timestamp, type));
+    if (mRunning)
+        mPartitions[mNodePartition[nodeId]].spikeRecording[nodeId]
+            .push_back(std::make_pair(timestamp, type));
+    else
+        mSpikeRecording[nodeId].push_back(std::make_pair(timestamp, type));
 }
 
 #endif // N2D2_NETWORK_H
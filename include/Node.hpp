@@ -104,6 +104,27 @@ public:
 
     inline virtual void notify(Time_T timestamp, NotifyType notify);
 
+    /**
+     * Returns the delay of the events coming from @p origin, 0 if
+     *propagateSpike() directly calls incomingSpike().
+     * This is used by the parallel simulation to partition the network.
+    */
+    virtual Time_T getLinkDelay(Node* /*origin*/) const
+    {
+        return 0;
+    };
+
+    /**
+     * Returns true if the node only interacts with other nodes through delayed
+     *events, lateral inhibition and the last activation time of its input
+     *nodes, so that it can be simulated in a different partition than its
+     *inputs and branches (see Network::Network()).
+    */
+    virtual bool isPartitionable() const
+    {
+        return false;
+    };
+
     /// Enable or disable activity recording for this node (used in Monitor).
     void setActivityRecording(bool activityRecording)
     {
@@ -112,7 +133,9 @@ public:
     /// Returns last activation time of the node
     Time_T getLastActivationTime() const
     {
-        return mLastActivationTime;
+        return (mActivationLog >= 0)
+                   ? mNet.getActivationTime(mActivationLog, mLastActivationTime)
+                   : mLastActivationTime;
     };
 
     /**
@@ -188,10 +211,14 @@ protected:
     float mOrientation;
     unsigned short mLayer;
     Area mArea;
+    /// Index of the activations log of the node in the Network, -1 if none
+    int mActivationLog;
 
     static unsigned int mIdCnt;
 
 private:
+    friend class Network;
+
     // A Node has an unique ID and is therefore non-copyable.
     Node(const Node&); // non construction-copyable
     const Node& operator=(const Node&); // non-copyable
@@ -38,6 +38,10 @@ public:
             unsigned int y = 0);
     inline void
     incomingSpike(Node* origin, Time_T timestamp, EventType_T type = 0);
+    bool isPartitionable() const
+    {
+        return true;
+    };
     virtual ~NodeEnv() {};
 };
 }
@@ -159,6 +159,10 @@ public:
     {
         return mLinks.size();
     };
+    const std::vector<NodeNeuron*>& getLateralBranches() const
+    {
+        return mLateralBranches;
+    };
 
     /// Destructor.
     virtual ~NodeNeuron();
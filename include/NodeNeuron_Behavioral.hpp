@@ -23,10 +23,10 @@
 #define N2D2_NODENEURON_BEHAVIORAL_H
 
 #include <algorithm>
-#include <deque>
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "NodeNeuron.hpp"
 #include "Synapse_Behavioral.hpp"
@@ -35,15 +35,27 @@ namespace N2D2 {
 /**
  * As the name suggests it, it's a neuron (IF or LIF). It is highly customizable
  * and implements STDP and lateral inhibition.
+ *
+ * The synapses are stored contiguously, in the order of their creation with
+ * addLink(), which gives each presynaptic node a dense index. The index of an
+ * incoming spike origin is obtained from a table indexed by the node ID (or
+ * from a hash table if the IDs of the presynaptic nodes are too sparse), and
+ * the STDP iterates over the synapses array instead of the links hash table.
 */
 class NodeNeuron_Behavioral : public NodeNeuron {
 public:
     NodeNeuron_Behavioral(Network& net);
+    void addLink(Node* origin);
     void propagateSpike(Node* origin, Time_T timestamp, EventType_T type = 0);
     void incomingSpike(Node* link, Time_T timestamp, EventType_T type = 0);
     void emitSpike(Time_T timestamp, EventType_T type = 0);
     void lateralInhibition(Time_T timestamp);
     void reset(Time_T timestamp = 0);
+    Time_T getLinkDelay(Node* origin) const;
+    bool isPartitionable() const
+    {
+        return true;
+    };
     Time_T getRefractoryEnd() const
     {
         return mRefractoryEnd;
@@ -58,7 +70,7 @@ public:
     void logStdpBehavior(const std::string& fileName,
                          unsigned int nbPoints = 100,
                          bool plot = true);
-    virtual ~NodeNeuron_Behavioral() {};
+    virtual ~NodeNeuron_Behavioral();
 
     /**
      * Returns current integration (or membrane potential) of the neuron.
@@ -101,6 +113,24 @@ private:
         FireEvent = 1
     };
 
+    static const unsigned int NoInput = (unsigned int)-1;
+
+    /// Return the presynaptic index of @p origin (NoInput if not linked)
+    unsigned int getInputIndex(Node* origin) const
+    {
+        if (!mInputIndexes.empty()) {
+            const NodeId_T offset = origin->getId() - mInputIdOffset;
+            return (offset < mInputIndexes.size()) ? mInputIndexes[offset]
+                                                   : NoInput;
+        }
+
+        const std::unordered_map<Node*, unsigned int>::const_iterator it
+            = mInputIndexesMap.find(origin);
+        return (it != mInputIndexesMap.end()) ? (*it).second : NoInput;
+    };
+    void indexInput(Node* origin, unsigned int index);
+    /// Move the synapse @p index to the back of the LTP FIFO
+    void updateLtpFifo(unsigned int index);
     void initialize();
     virtual Synapse* newSynapse() const;
     virtual void saveInternal(std::ofstream& dataFile) const;
@@ -174,7 +204,28 @@ private:
     /// its activation, or lateral inhibition
     Time_T mRefractoryEnd;
     Time_T mLastStdp;
-    std::deque<Synapse_Behavioral*> mLtpFifo;
+
+    // Synapses storage
+    /// Synapses, by presynaptic index (the links point to these objects)
+    std::vector<Synapse_Behavioral> mSynapses;
+    /// Presynaptic nodes, by presynaptic index
+    std::vector<Node*> mInputs;
+    /// Presynaptic index, by node ID minus @p mInputIdOffset
+    std::vector<unsigned int> mInputIndexes;
+    NodeId_T mInputIdOffset;
+    /// Presynaptic index, by node (used instead of @p mInputIndexes if the
+    /// node IDs are too sparse)
+    std::unordered_map<Node*, unsigned int> mInputIndexesMap;
+
+    // LTP FIFO of the last @p mOrderStdp distinct synapses activated, as a
+    // doubly linked list of presynaptic indexes
+    /// FIFO membership of each synapse
+    std::vector<bool> mLtpMember;
+    std::vector<unsigned int> mLtpPrev;
+    std::vector<unsigned int> mLtpNext;
+    unsigned int mLtpHead;
+    unsigned int mLtpTail;
+    unsigned int mLtpSize;
 };
 }
 
@@ -32,6 +32,7 @@ public:
     }
 
     SGDSolver_Frame();
+    SGDSolver_Frame(const SGDSolver_Frame<T>& solver);
     void
     update(Tensor4d<T>* data, Tensor4d<T>* diffData, unsigned int batchSize);
     void exportFreeParameters(const std::string& fileName) const;
@@ -72,6 +73,15 @@ N2D2::SGDSolver_Frame<T>::SGDSolver_Frame()
     // ctor
 }
 
+template <class T>
+N2D2::SGDSolver_Frame<T>::SGDSolver_Frame(const SGDSolver_Frame<T>& solver)
+    : SGDSolver<T>::SGDSolver(solver)
+{
+    // copy-ctor
+    // mMomentumData is not copied, as Tensor4d copies share their data and
+    // each clone must have its own momentum
+}
+
 template <class T>
 void N2D2::SGDSolver_Frame<T>::update(Tensor4d<T>* data,
                                       Tensor4d<T>* diffData,
@@ -170,7 +180,7 @@ void N2D2::SGDSolver_Frame
             throw std::runtime_error("Could not create synaptic file : "
                                      + fileName);
 
-        for (std::vector<float>::const_iterator it = mMomentumData.begin();
+        for (typename Tensor4d<T>::const_iterator it = mMomentumData.begin();
              it != mMomentumData.end();
              ++it)
             syn << (*it) << " ";
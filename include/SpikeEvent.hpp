@@ -60,6 +60,18 @@ public:
     {
         return mType;
     };
+    Node* getOrigin() const
+    {
+        return mOrigin;
+    };
+    /// NULL for an internal event of the origin node
+    Node* getDestination() const
+    {
+        return mDestination;
+    };
+    /// Priority order of the events: by increasing timestamp, the incoming
+    /// spikes before the internal events, then by origin node ID, destination
+    /// node ID and type. This is a total order between distinct events.
     // We really want this function to be inlined for better performances
     inline bool operator<(const SpikeEvent& event) const;
     virtual ~SpikeEvent() {};
@@ -111,9 +123,30 @@ N2D2::Time_T N2D2::SpikeEvent::release()
 
 bool N2D2::SpikeEvent::operator<(const SpikeEvent& event) const
 {
-    return (mTimestamp > event.mTimestamp
-            || (mTimestamp == event.mTimestamp && mDestination == NULL
-                && event.mDestination != NULL));
+    if (mTimestamp != event.mTimestamp)
+        return (mTimestamp > event.mTimestamp);
+
+    if ((mDestination == NULL) != (event.mDestination == NULL))
+        return (mDestination == NULL);
+
+    // Simultaneous events are ordered by node IDs, so that the processing
+    // order does not depend on the history of the queue
+    const NodeId_T originId = (mOrigin != NULL) ? mOrigin->getId() : 0;
+    const NodeId_T eventOriginId = (event.mOrigin != NULL)
+                                       ? event.mOrigin->getId() : 0;
+
+    if (originId != eventOriginId)
+        return (originId > eventOriginId);
+
+    const NodeId_T destinationId = (mDestination != NULL)
+                                       ? mDestination->getId() : 0;
+    const NodeId_T eventDestinationId = (event.mDestination != NULL)
+                                            ? event.mDestination->getId() : 0;
+
+    if (destinationId != eventDestinationId)
+        return (destinationId > eventDestinationId);
+
+    return (mType > event.mType);
 }
 
 #endif // N2D2_SPIKEEVENT_H
@@ -22,12 +22,19 @@
 #define N2D2_STIMULIPROVIDER_H
 
 #include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
 #include <fstream>
+#include <map>
+#include <mutex>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "Database/Database.hpp"
+#include "StimuliSampler.hpp"
 #include "Transformation/CompositeTransformation.hpp"
 #include "containers/Tensor3d.hpp"
 #include "containers/Tensor4d.hpp"
@@ -35,6 +42,7 @@
 #include "utils/Gnuplot.hpp"
 #include "utils/Parameterizable.hpp"
 #include "utils/Random.hpp"
+#include "utils/ShardCache.hpp"
 
 namespace N2D2 {
 typedef float Float_T;
@@ -57,12 +65,26 @@ public:
         operator()(Database::StimuliSet set) const;
     };
 
+    struct PrefetchStats {
+        /// Number of batches requested from the prefetch queue
+        unsigned long long nbBatches;
+        /// Number of requests for which no batch was ready yet
+        unsigned long long nbStalls;
+        /// Total time spent waiting for a batch to be ready (in s)
+        double stallTime;
+        /// Sum of the number of ready batches found at each request
+        unsigned long long cumQueueDepth;
+    };
+
     StimuliProvider(Database& database,
                     unsigned int sizeX,
                     unsigned int sizeY = 1,
                     unsigned int nbChannels = 1,
                     unsigned int batchSize = 1,
                     bool compositeStimuli = false);
+    /// Copy the configuration and the current data. The prefetch workers of
+    /// the copy are not started until its first readRandomBatch()
+    StimuliProvider(const StimuliProvider& sp);
     virtual void addChannel(const CompositeTransformation& /*transformation*/);
 
     /// Add global CACHEABLE transformations, before applying any channel
@@ -132,7 +154,25 @@ public:
     void future();
     void synchronize();
 
-    /// Return a random index from the StimuliSet @p set
+    /// Enable the asynchronous prefetch of random batches: @p nbWorkers
+    /// persistent threads keep up to @p depth batches ready in advance, so
+    /// that readRandomBatch() only has to swap an already filled batch.
+    /// The workers are started on the first readRandomBatch() call and
+    /// stopped when the batch size or the number of channels changes. A
+    /// @p depth of 0 disables the prefetch.
+    void setPrefetch(unsigned int depth, unsigned int nbWorkers = 1);
+    PrefetchStats getPrefetchStats() const;
+    void resetPrefetchStats();
+
+    /// Select the order in which random stimuli are drawn (see
+    /// StimuliSampler). The default Uniform sampling draws with replacement.
+    /// @p windowSize is the number of consecutive stimuli shuffled together
+    /// with the Window sampling.
+    void setSampling(StimuliSampler::Type sampling,
+                     unsigned int windowSize = 1024);
+
+    /// Return a random index from the StimuliSet @p set, drawn by the
+    /// sampler of this set
     unsigned int getRandomIndex(Database::StimuliSet set);
 
     /// Return a random StimulusID from the StimuliSet @p set
@@ -181,7 +221,10 @@ public:
                                          unsigned int index) const;
 
     void setBatchSize(unsigned int batchSize);
-    void setCachePath(const std::string& path = "");
+    /// Set the disk cache path for pre-processed stimuli. If @p packed is
+    /// true, stimuli are stored in a few memory-mapped shard files (see
+    /// ShardCache) instead of two files per stimulus
+    void setCachePath(const std::string& path = "", bool packed = false);
 
     // Getters
     Database& getDatabase()
@@ -256,14 +299,58 @@ public:
     {
         return mCachePath;
     };
-    virtual ~StimuliProvider() {};
+    bool isPackedCache() const
+    {
+        return (mShardCache != NULL);
+    };
+    unsigned int getPrefetchDepth() const
+    {
+        return mPrefetchDepth;
+    };
+    StimuliSampler::Type getSampling() const
+    {
+        return mSampling;
+    };
+    virtual ~StimuliProvider();
 
+    /// Key (and file name without extension) of a stimulus in the disk cache
+    static std::string getCacheKey(Database::StimulusID id,
+                                   Database::StimuliSet set,
+                                   bool labels = false);
     static void logData(const std::string& fileName,
                         const Tensor2d<Float_T>& data);
     static void logData(const std::string& fileName,
                         const Tensor3d<Float_T>& data);
 
 protected:
+    struct PrefetchSlot {
+        /// Position of the batch in the sequence of random batches of the set
+        unsigned long long counter;
+        std::vector<int> batch;
+        Tensor4d<Float_T> data;
+        Tensor4d<int> labelsData;
+        std::vector<std::vector<std::shared_ptr<ROI> > > labelsROI;
+    };
+
+    void loadStimulus(Database::StimulusID id,
+                      Database::StimuliSet set,
+                      unsigned int batchPos,
+                      Tensor4d<Float_T>& dataRef,
+                      Tensor4d<int>& labelsRef,
+                      std::vector<std::shared_ptr<ROI> >& labelsROI);
+    /**
+     * Own Philox key of the provider for a batch: the random numbers drawn
+     * for a batch only depend on its position in the sequence of batches of
+     * the set, and not on the thread that reads it nor on the prefetch depth.
+    */
+    static unsigned long long getBatchSeed(Database::StimuliSet set,
+                                           bool random,
+                                           unsigned long long counter);
+    std::deque<unsigned int>::iterator
+    findPrefetchReady(unsigned long long counter);
+    void startPrefetch(Database::StimuliSet set);
+    void stopPrefetch();
+    void prefetchWorker();
     std::vector<cv::Mat> loadDataCache(const std::string& fileName) const;
     void saveDataCache(const std::string& fileName,
                        const std::vector<cv::Mat>& data) const;
@@ -277,6 +364,8 @@ protected:
     bool mCompositeStimuli;
     /// Disk cache path for pre-processed stimuli (no disk cache if empty)
     std::string mCachePath;
+    /// Packed disk cache (if enabled)
+    std::shared_ptr<ShardCache> mShardCache;
     /// Global transformations
     TransformationsSets mTransformations;
     /// Channel transformations
@@ -294,6 +383,31 @@ protected:
     std::vector<std::vector<std::shared_ptr<ROI> > > mLabelsROI;
     std::vector<std::vector<std::shared_ptr<ROI> > > mFutureLabelsROI;
     bool mFuture;
+    /// Random stimuli sampling
+    StimuliSampler::Type mSampling;
+    unsigned int mSamplingWindow;
+    std::map<Database::StimuliSet, std::shared_ptr<StimuliSampler> >
+        mSamplers;
+    /// Number of batches read, for each set (see getBatchSeed())
+    std::map<Database::StimuliSet, unsigned long long> mNbRandomBatches;
+    std::map<Database::StimuliSet, unsigned long long> mNbBatches;
+    /// Prefetch queue
+    unsigned int mPrefetchDepth;
+    unsigned int mPrefetchWorkers;
+    bool mPrefetchRunning;
+    bool mPrefetchStop;
+    Database::StimuliSet mPrefetchSet;
+    /// Position of the next batch drawn by the workers
+    unsigned long long mPrefetchCounter;
+    std::vector<PrefetchSlot> mPrefetchSlots;
+    std::deque<unsigned int> mPrefetchFree;
+    std::deque<unsigned int> mPrefetchReady;
+    std::vector<std::thread> mPrefetchThreads;
+    std::exception_ptr mPrefetchError;
+    mutable std::mutex mPrefetchMutex;
+    std::condition_variable mPrefetchFreeCond;
+    std::condition_variable mPrefetchReadyCond;
+    PrefetchStats mPrefetchStats;
 };
 }
 
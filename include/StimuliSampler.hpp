@@ -0,0 +1,141 @@
+/*
+    (C) Copyright 2016 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#ifndef N2D2_STIMULISAMPLER_H
+#define N2D2_STIMULISAMPLER_H
+
+#include <limits>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include "Database/Database.hpp"
+#include "utils/Random.hpp"
+#include "utils/ShardCache.hpp"
+
+namespace N2D2 {
+/**
+ * @class   StimuliSampler
+ * @brief   Order in which the random stimuli of a set are drawn.
+ *
+ * One sampler is used per stimuli set. The available samplers are:
+ * - Uniform: independent uniform draws (with replacement);
+ * - Epoch: a new random permutation of the set for each epoch, so that
+ *   every stimulus is drawn exactly once per epoch;
+ * - Window: like Epoch, but the set, ordered by position in the packed cache
+ *   (or by stimulus ID without packed cache), is cut into windows of
+ *   consecutive stimuli. The windows are visited in random order and the
+ *   stimuli are shuffled inside each window, so that the cache is read almost
+ *   sequentially.
+*/
+class StimuliSampler {
+public:
+    enum Type {
+        Uniform,
+        Epoch,
+        Window
+    };
+
+    static std::shared_ptr<StimuliSampler> create(Type type,
+                                                  const Database& database,
+                                                  Database::StimuliSet set,
+                                                  unsigned int windowSize
+                                                  = 1024);
+
+    StimuliSampler(const Database& database, Database::StimuliSet set);
+    /// Return the index, in the set, of the next stimulus to read
+    virtual unsigned int next() = 0;
+    virtual Type getType() const = 0;
+    /// Number of completed epochs (always 0 for the Uniform sampler)
+    unsigned int getNbEpochs() const
+    {
+        return mNbEpochs;
+    };
+    virtual ~StimuliSampler() {};
+
+protected:
+    /// Fisher-Yates shuffle using the N2D2 random number generator
+    static void shuffle(std::vector<unsigned int>::iterator first,
+                        std::vector<unsigned int>::iterator last);
+
+    const Database& mDatabase;
+    const Database::StimuliSet mSet;
+    unsigned int mNbEpochs;
+};
+
+class UniformSampler : public StimuliSampler {
+public:
+    UniformSampler(const Database& database, Database::StimuliSet set);
+    unsigned int next();
+    Type getType() const
+    {
+        return Uniform;
+    };
+};
+
+class EpochSampler : public StimuliSampler {
+public:
+    EpochSampler(const Database& database, Database::StimuliSet set);
+    unsigned int next();
+    Type getType() const
+    {
+        return Epoch;
+    };
+    virtual ~EpochSampler() {};
+
+protected:
+    /// Fill mOrder with the drawing order of a new epoch
+    virtual void newEpoch(unsigned int nbStimuli);
+
+    std::vector<unsigned int> mOrder;
+    unsigned int mPos;
+};
+
+class WindowSampler : public EpochSampler {
+public:
+    WindowSampler(const Database& database,
+                  Database::StimuliSet set,
+                  unsigned int windowSize);
+    Type getType() const
+    {
+        return Window;
+    };
+    /// Order the windows by record position in @p shardCache, starting
+    /// from the next epoch
+    void setShardCache(const std::shared_ptr<ShardCache>& shardCache)
+    {
+        mShardCache = shardCache;
+    };
+
+protected:
+    void newEpoch(unsigned int nbStimuli);
+
+    const unsigned int mWindowSize;
+    std::shared_ptr<ShardCache> mShardCache;
+};
+}
+
+namespace {
+template <>
+const char* const EnumStrings<N2D2::StimuliSampler::Type>::data[]
+    = {"Uniform", "Epoch", "Window"};
+}
+
+#endif // N2D2_STIMULISAMPLER_H
@@ -0,0 +1,160 @@
+/*
+    (C) Copyright 2016 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#ifndef N2D2_POOLALLOCATOR_H
+#define N2D2_POOLALLOCATOR_H
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace N2D2 {
+/**
+ * @class   MemoryPool
+ * @brief   Process-wide pool of 64-byte aligned buffers, grouped by size
+ * class. Released buffers are kept for reuse by any later allocation of the
+ * same size class, so that the tensors of every cell share the same storage
+ * and steady-state training does not hit the heap.
+*/
+class MemoryPool {
+public:
+    struct Stats {
+        /// Number of allocation requests
+        unsigned long long nbAllocations;
+        /// Number of requests that had to allocate from the heap
+        unsigned long long nbHeapAllocations;
+        /// Number of buffers released to the pool
+        unsigned long long nbDeallocations;
+        /// Bytes currently handed out to containers
+        std::size_t bytesInUse;
+        /// Bytes currently kept in the pool for reuse
+        std::size_t bytesCached;
+        /// Peak value of bytesInUse + bytesCached
+        std::size_t peakBytes;
+    };
+
+    static const std::size_t Alignment = 64;
+
+    static void* allocate(std::size_t size);
+    static void deallocate(void* ptr, std::size_t size);
+    /**
+     * When disabled, released buffers are returned to the heap immediately
+     * (the buffers are still aligned). Enabled by default.
+    */
+    static void setPooling(bool pooling);
+    static bool isPooling();
+    /**
+     * Upper bound of the bytes kept in the pool for reuse. Released buffers
+     * that would exceed it are returned to the heap, and lowering it trims
+     * the cache, largest size classes first. Unlimited by default.
+    */
+    static void setMaxCached(std::size_t maxCached);
+    static std::size_t getMaxCached();
+    /// Return every cached buffer to the heap
+    static void releaseCached();
+    static Stats getStats();
+    static void resetStats();
+
+private:
+    static std::size_t sizeClass(std::size_t size);
+    static void* heapAllocate(std::size_t size);
+    static void heapFree(void* ptr);
+    static MemoryPool& instance();
+
+    MemoryPool();
+    void trim();
+
+    std::mutex mLock;
+    bool mPooling;
+    std::size_t mMaxCached;
+    std::map<std::size_t, std::vector<void*> > mFree;
+    Stats mStats;
+};
+
+/**
+ * @class   PoolAllocator
+ * @brief   Standard allocator drawing its storage from the MemoryPool.
+*/
+template <class T> class PoolAllocator {
+public:
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    template <class U> struct rebind {
+        typedef PoolAllocator<U> other;
+    };
+
+    PoolAllocator() {}
+    template <class U> PoolAllocator(const PoolAllocator<U>& /*alloc*/) {}
+    T* allocate(std::size_t n)
+    {
+        if (n > static_cast<std::size_t>(-1) / sizeof(T))
+            throw std::bad_alloc();
+
+        return static_cast<T*>(MemoryPool::allocate(n * sizeof(T)));
+    }
+    void deallocate(T* ptr, std::size_t n)
+    {
+        MemoryPool::deallocate(ptr, n * sizeof(T));
+    }
+};
+
+template <class T, class U>
+bool operator==(const PoolAllocator<T>& /*a*/, const PoolAllocator<U>& /*b*/)
+{
+    return true;
+}
+
+template <class T, class U>
+bool operator!=(const PoolAllocator<T>& /*a*/, const PoolAllocator<U>& /*b*/)
+{
+    return false;
+}
+
+/**
+ * Allocator policy of the tensor containers: numeric data is stored in
+ * aligned, pooled buffers, other element types (pointers, structures) use
+ * the default allocator.
+*/
+template <class T> struct TensorAllocator {
+    typedef typename std::conditional<std::is_arithmetic<T>::value,
+                                      PoolAllocator<T>,
+                                      std::allocator<T> >::type type;
+};
+
+/**
+ * Scratch buffer of the computing kernels, drawn from the MemoryPool so that
+ * the per-batch temporaries do not hit the heap either.
+*/
+template <class T> struct PoolVector {
+    typedef std::vector<T, PoolAllocator<T> > type;
+};
+}
+
+#endif // N2D2_POOLALLOCATOR_H
@@ -36,6 +36,8 @@
 #include <stdexcept>
 #include <vector>
 
+#include "containers/PoolAllocator.hpp"
+
 #include "opencv2/core/core.hpp"
 #include "opencv2/imgproc/imgproc.hpp"
 #include "opencv2/highgui/highgui.hpp"
@@ -48,16 +50,17 @@ namespace N2D2 {
 */
 template <class T> class Tensor2d {
 public:
-    typedef typename std::vector<T>::iterator iterator;
-    typedef typename std::vector<T>::const_iterator const_iterator;
-    typedef typename std::vector<T>::reference reference;
-    typedef typename std::vector<T>::const_reference const_reference;
+    typedef std::vector<T, typename TensorAllocator<T>::type> data_type;
+    typedef typename data_type::iterator iterator;
+    typedef typename data_type::const_iterator const_iterator;
+    typedef typename data_type::reference reference;
+    typedef typename data_type::const_reference const_reference;
 
     Tensor2d();
     Tensor2d(unsigned int dimX, unsigned int dimY, const T& value = T());
     Tensor2d(unsigned int dimX,
              unsigned int dimY,
-             const std::shared_ptr<std::vector<T> >& data,
+             const std::shared_ptr<data_type>& data,
              unsigned int dataOffset = 0);
     template <typename InputIterator>
     Tensor2d(unsigned int dimX,
@@ -142,11 +145,11 @@ public:
     friend std::istream& operator>>(std::istream& is, Tensor2d<U>& tensor);
 
     inline operator cv::Mat() const;
-    inline std::vector<T>& data()
+    inline data_type& data()
     {
         return (*mData);
     };
-    inline const std::vector<T>& data() const
+    inline const data_type& data() const
     {
         return (*mData);
     };
@@ -156,18 +159,18 @@ public:
 
 protected:
     template <class CV_T>
-    static void convert(const cv::Mat& mat, std::vector<T>& data);
+    static void convert(const cv::Mat& mat, data_type& data);
 
     unsigned int mDimX;
     unsigned int mDimY;
-    const std::shared_ptr<std::vector<T> > mData;
+    const std::shared_ptr<data_type> mData;
     const unsigned int mDataOffset;
 };
 }
 
 template <class T>
 N2D2::Tensor2d<T>::Tensor2d()
-    : mDimX(0), mDimY(0), mData(new std::vector<T>()), mDataOffset(0)
+    : mDimX(0), mDimY(0), mData(new data_type()), mDataOffset(0)
 {
     // ctor
 }
@@ -177,7 +180,7 @@ N2D2::Tensor2d
     <T>::Tensor2d(unsigned int dimX, unsigned int dimY, const T& value)
     : mDimX(dimX),
       mDimY(dimY),
-      mData(new std::vector<T>(dimX * dimY, value)),
+      mData(new data_type(dimX * dimY, value)),
       mDataOffset(0)
 {
     // ctor
@@ -186,7 +189,7 @@ N2D2::Tensor2d
 template <class T>
 N2D2::Tensor2d<T>::Tensor2d(unsigned int dimX,
                             unsigned int dimY,
-                            const std::shared_ptr<std::vector<T> >& data,
+                            const std::shared_ptr<data_type>& data,
                             unsigned int dataOffset)
     : mDimX(dimX), mDimY(dimY), mData(data), mDataOffset(dataOffset)
 {
@@ -201,7 +204,7 @@ N2D2::Tensor2d<T>::Tensor2d(unsigned int dimX,
                             InputIterator last)
     : mDimX(dimX),
       mDimY(dimY),
-      mData(new std::vector<T>(first, last)),
+      mData(new data_type(first, last)),
       mDataOffset(0)
 {
     // ctor
@@ -213,7 +216,7 @@ template <class T>
 N2D2::Tensor2d<T>::Tensor2d(const cv::Mat& mat)
     : mDimX(mat.cols),
       mDimY(mat.rows),
-      mData(new std::vector<T>()),
+      mData(new data_type()),
       mDataOffset(0)
 {
     // ctor
@@ -251,7 +254,7 @@ N2D2::Tensor2d<T>::Tensor2d(const cv::Mat& mat)
 
 template <class T>
 template <class CV_T>
-void N2D2::Tensor2d<T>::convert(const cv::Mat& mat, std::vector<T>& data)
+void N2D2::Tensor2d<T>::convert(const cv::Mat& mat, data_type& data)
 {
     const CV_T srcRange = (std::numeric_limits<CV_T>::is_integer)
                               ? std::numeric_limits<CV_T>::max()
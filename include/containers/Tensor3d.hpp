@@ -46,10 +46,11 @@ namespace N2D2 {
 */
 template <class T> class Tensor3d {
 public:
-    typedef typename std::vector<T>::iterator iterator;
-    typedef typename std::vector<T>::const_iterator const_iterator;
-    typedef typename std::vector<T>::reference reference;
-    typedef typename std::vector<T>::const_reference const_reference;
+    typedef std::vector<T, typename TensorAllocator<T>::type> data_type;
+    typedef typename data_type::iterator iterator;
+    typedef typename data_type::const_iterator const_iterator;
+    typedef typename data_type::reference reference;
+    typedef typename data_type::const_reference const_reference;
 
     Tensor3d();
     Tensor3d(unsigned int dimX,
@@ -59,7 +60,7 @@ public:
     Tensor3d(unsigned int dimX,
              unsigned int dimY,
              unsigned int dimZ,
-             const std::shared_ptr<std::vector<T> >& data,
+             const std::shared_ptr<data_type>& data,
              unsigned int dataOffset);
     template <typename InputIterator>
     Tensor3d(unsigned int dimX,
@@ -145,11 +146,11 @@ public:
     Tensor3d<T>& operator=(const Tensor3d<T>& tensor);
 
     inline operator cv::Mat() const;
-    inline std::vector<T>& data()
+    inline data_type& data()
     {
         return (*mData);
     };
-    inline const std::vector<T>& data() const
+    inline const data_type& data() const
     {
         return (*mData);
     };
@@ -159,14 +160,14 @@ protected:
     unsigned int mDimX;
     unsigned int mDimY;
     unsigned int mDimZ;
-    const std::shared_ptr<std::vector<T> > mData;
+    const std::shared_ptr<data_type> mData;
     const unsigned int mDataOffset;
 };
 }
 
 template <class T>
 N2D2::Tensor3d<T>::Tensor3d()
-    : mDimX(0), mDimY(0), mDimZ(0), mData(new std::vector<T>()), mDataOffset(0)
+    : mDimX(0), mDimY(0), mDimZ(0), mData(new data_type()), mDataOffset(0)
 {
     // ctor
 }
@@ -175,7 +176,7 @@ template <class T>
 N2D2::Tensor3d<T>::Tensor3d(unsigned int dimX,
                             unsigned int dimY,
                             unsigned int dimZ,
-                            const std::shared_ptr<std::vector<T> >& data,
+                            const std::shared_ptr<data_type>& data,
                             unsigned int dataOffset)
     : mDimX(dimX),
       mDimY(dimY),
@@ -194,7 +195,7 @@ N2D2::Tensor3d<T>::Tensor3d(unsigned int dimX,
     : mDimX(dimX),
       mDimY(dimY),
       mDimZ(dimZ),
-      mData(new std::vector<T>(dimX * dimY * dimZ, value)),
+      mData(new data_type(dimX * dimY * dimZ, value)),
       mDataOffset(0)
 {
     // ctor
@@ -210,7 +211,7 @@ N2D2::Tensor3d<T>::Tensor3d(unsigned int dimX,
     : mDimX(dimX),
       mDimY(dimY),
       mDimZ(dimZ),
-      mData(new std::vector<T>(first, last)),
+      mData(new data_type(first, last)),
       mDataOffset(0)
 {
     // ctor
@@ -223,7 +224,7 @@ N2D2::Tensor3d<T>::Tensor3d(const cv::Mat& mat)
     : mDimX(mat.cols),
       mDimY(mat.rows),
       mDimZ(0), // Is incremented by push_back()
-      mData(new std::vector<T>()),
+      mData(new data_type()),
       mDataOffset(0)
 {
     // ctor
@@ -59,10 +59,11 @@ public:
             : i(i_), j(j_), k(k_), b(b_) {}
     };
 
-    typedef typename std::vector<T>::iterator iterator;
-    typedef typename std::vector<T>::const_iterator const_iterator;
-    typedef typename std::vector<T>::reference reference;
-    typedef typename std::vector<T>::const_reference const_reference;
+    typedef std::vector<T, typename TensorAllocator<T>::type> data_type;
+    typedef typename data_type::iterator iterator;
+    typedef typename data_type::const_iterator const_iterator;
+    typedef typename data_type::reference reference;
+    typedef typename data_type::const_reference const_reference;
 
     Tensor4d();
     Tensor4d(unsigned int dimX,
@@ -97,6 +98,27 @@ public:
     {
         return mDimB;
     }
+    /**
+     * Number of interleaved channels in the storage layout (1 for the plain
+     * NCHW layout, C for the channel-blocked NCHWc layout)
+    */
+    unsigned int channelBlock() const
+    {
+        return mChannelBlock;
+    }
+    /**
+     * Storage distance between two horizontally adjacent pixels of a channel
+    */
+    unsigned int pixelStride() const
+    {
+        return mChannelBlock;
+    }
+    /**
+     * Storage offset of pixel (0, 0) of channel @p k in batch @p b, valid for
+     * both layouts. Pixel (i, j) is at channelOffset(k, b)
+     * + (i + j * dimX()) * pixelStride().
+    */
+    inline unsigned int channelOffset(unsigned int k, unsigned int b) const;
     unsigned int size() const
     {
         return (*mData).size();
@@ -135,6 +157,18 @@ public:
     inline virtual void push_back(const Tensor3d<T>& frame);
     inline virtual void clear();
     inline void swap(Tensor4d<T>& tensor);
+    /**
+     * Reorder the data in place to the channel-blocked NCHWc layout, with
+     * @p channelBlock channels interleaved per pixel (the channels are padded
+     * to a multiple of @p channelBlock). A value of 1 restores the plain
+     * layout. The resize(), assign(), reserve() and clear() methods always
+     * reset the tensor to the plain layout.
+     *
+     * In the blocked layout, the (i, j, k, b) accessors remain valid, the
+     * const operator[] returns a plain copy of the frame (the non-const one
+     * throws) and the flat index accessors address the raw storage.
+    */
+    inline void setChannelBlock(unsigned int channelBlock);
     // Return type should be "reference" (not T&), in order to ensure it works
     // for std::vector<bool>, which is a special case...
     inline reference
@@ -151,14 +185,18 @@ public:
     inline const_reference operator()(unsigned int index) const;
     reference at(unsigned int i, unsigned int j, unsigned int k, unsigned int b)
     {
-        return (*mData)
-            .at(i + j * mDimX + k * mDimX * mDimY + b * mDimX * mDimY * mDimZ);
+        if (k >= mDimZ)
+            throw std::out_of_range("Tensor4d<T>::at(): channel out of range");
+
+        return (*mData).at(storageIndex(i, j, k, b));
     }
     const_reference
     at(unsigned int i, unsigned int j, unsigned int k, unsigned int b) const
     {
-        return (*mData)
-            .at(i + j * mDimX + k * mDimX * mDimY + b * mDimX * mDimY * mDimZ);
+        if (k >= mDimZ)
+            throw std::out_of_range("Tensor4d<T>::at(): channel out of range");
+
+        return (*mData).at(storageIndex(i, j, k, b));
     }
     reference at(unsigned int index)
     {
@@ -205,11 +243,11 @@ public:
                                  unsigned int /*b*/,
                                  unsigned int /*length*/) const {};
 
-    inline std::vector<T>& data()
+    inline data_type& data()
     {
         return (*mData);
     };
-    inline const std::vector<T>& data() const
+    inline const data_type& data() const
     {
         return (*mData);
     };
@@ -228,11 +266,27 @@ public:
     virtual ~Tensor4d() {};
 
 protected:
+    unsigned int storageIndex(unsigned int i,
+                       unsigned int j,
+                       unsigned int k,
+                       unsigned int b) const
+    {
+        return (mChannelBlock == 1)
+            ? i + j * mDimX + k * mDimX * mDimY + b * mDimX * mDimY * mDimZ
+            : ((b * nbChannelBlocks() + k / mChannelBlock) * mDimX * mDimY
+               + i + j * mDimX) * mChannelBlock + k % mChannelBlock;
+    }
+    unsigned int nbChannelBlocks() const
+    {
+        return (mDimZ + mChannelBlock - 1) / mChannelBlock;
+    }
+
     unsigned int mDimX;
     unsigned int mDimY;
     unsigned int mDimZ;
     unsigned int mDimB;
-    const std::shared_ptr<std::vector<T> > mData;
+    unsigned int mChannelBlock;
+    const std::shared_ptr<data_type> mData;
     const std::shared_ptr<bool> mValid;
 };
 }
@@ -243,7 +297,8 @@ N2D2::Tensor4d<T>::Tensor4d()
       mDimY(0),
       mDimZ(0),
       mDimB(0),
-      mData(new std::vector<T>()),
+      mChannelBlock(1),
+      mData(new data_type()),
       mValid(new bool(false))
 {
     // ctor
@@ -259,7 +314,8 @@ N2D2::Tensor4d<T>::Tensor4d(unsigned int dimX,
       mDimY(dimY),
       mDimZ(dimZ),
       mDimB(dimB),
-      mData(new std::vector<T>(dimX * dimY * dimZ * dimB, value)),
+      mChannelBlock(1),
+      mData(new data_type(dimX * dimY * dimZ * dimB, value)),
       mValid(new bool(false))
 {
     // ctor
@@ -277,7 +333,8 @@ N2D2::Tensor4d<T>::Tensor4d(unsigned int dimX,
       mDimY(dimY),
       mDimZ(dimZ),
       mDimB(dimB),
-      mData(new std::vector<T>(first, last)),
+      mChannelBlock(1),
+      mData(new data_type(first, last)),
       mValid(new bool(false))
 {
     // ctor
@@ -297,6 +354,7 @@ void N2D2::Tensor4d<T>::reserve(unsigned int dimX,
     mDimY = dimY;
     mDimZ = dimZ;
     mDimB = dimB;
+    mChannelBlock = 1;
     (*mData).reserve(dimX * dimY * dimZ * dimB);
 }
 
@@ -313,6 +371,7 @@ void N2D2::Tensor4d<T>::resize(unsigned int dimX,
     mDimY = dimY;
     mDimZ = dimZ;
     mDimB = dimB;
+    mChannelBlock = 1;
     (*mData).resize(dimX * dimY * dimZ * dimB, value);
 }
 
@@ -329,6 +388,7 @@ void N2D2::Tensor4d<T>::assign(unsigned int dimX,
     mDimY = dimY;
     mDimZ = dimZ;
     mDimB = dimB;
+    mChannelBlock = 1;
     (*mData).assign(dimX * dimY * dimZ * dimB, value);
 }
 
@@ -340,6 +400,7 @@ template <typename T> void N2D2::Tensor4d<T>::fill(const T& value)
 template <class T> void N2D2::Tensor4d<T>::push_back(const Tensor3d<T>& frame)
 {
     assert(mData.unique());
+    assert(mChannelBlock == 1);
 
     if (mDimX == 0 && mDimY == 0 && mDimZ == 0) {
         mDimX = frame.dimX();
@@ -364,6 +425,7 @@ template <class T> void N2D2::Tensor4d<T>::clear()
     mDimY = 0;
     mDimZ = 0;
     mDimB = 0;
+    mChannelBlock = 1;
     (*mData).clear();
 }
 
@@ -373,11 +435,61 @@ template <class T> void N2D2::Tensor4d<T>::swap(Tensor4d<T>& tensor)
     std::swap(mDimY, tensor.mDimY);
     std::swap(mDimZ, tensor.mDimZ);
     std::swap(mDimB, tensor.mDimB);
+    std::swap(mChannelBlock, tensor.mChannelBlock);
     (*mData).swap((*tensor.mData));
 
-    assert((*mData).size() == mDimX * mDimY * mDimZ * mDimB);
-    assert((*tensor.mData).size() == tensor.mDimX * tensor.mDimY * tensor.mDimZ
-                                     * tensor.mDimB);
+    assert((*mData).size() == mDimX * mDimY * nbChannelBlocks()
+                              * mChannelBlock * mDimB);
+    assert((*tensor.mData).size() == tensor.mDimX * tensor.mDimY
+                                     * tensor.nbChannelBlocks()
+                                     * tensor.mChannelBlock * tensor.mDimB);
+}
+
+template <class T>
+unsigned int N2D2::Tensor4d<T>::channelOffset(unsigned int k,
+                                              unsigned int b) const
+{
+    assert(k < mDimZ);
+    assert(b < mDimB);
+
+    return (mChannelBlock == 1)
+        ? (k + b * mDimZ) * mDimX * mDimY
+        : (b * nbChannelBlocks() + k / mChannelBlock) * mDimX * mDimY
+            * mChannelBlock + k % mChannelBlock;
+}
+
+template <class T>
+void N2D2::Tensor4d<T>::setChannelBlock(unsigned int channelBlock)
+{
+    assert(mData.unique());
+
+    if (channelBlock == 0)
+        throw std::domain_error(
+            "Tensor4d<T>::setChannelBlock(): channel block must be > 0");
+
+    if (channelBlock == mChannelBlock)
+        return;
+
+    Tensor4d<T> reordered;
+    reordered.mDimX = mDimX;
+    reordered.mDimY = mDimY;
+    reordered.mDimZ = mDimZ;
+    reordered.mDimB = mDimB;
+    reordered.mChannelBlock = channelBlock;
+    (*reordered.mData).resize(mDimX * mDimY * reordered.nbChannelBlocks()
+                              * channelBlock * mDimB, T());
+
+    for (unsigned int b = 0; b < mDimB; ++b) {
+        for (unsigned int k = 0; k < mDimZ; ++k) {
+            for (unsigned int j = 0; j < mDimY; ++j) {
+                for (unsigned int i = 0; i < mDimX; ++i)
+                    (*reordered.mData)[reordered.storageIndex(i, j, k, b)]
+                        = (*mData)[storageIndex(i, j, k, b)];
+            }
+        }
+    }
+
+    swap(reordered);
 }
 
 template <class T>
@@ -389,8 +501,7 @@ operator()(unsigned int i, unsigned int j, unsigned int k, unsigned int b)
     assert(k < mDimZ);
     assert(b < mDimB);
 
-    return (
-        *mData)[i + j * mDimX + k * mDimX * mDimY + b * mDimX * mDimY * mDimZ];
+    return (*mData)[storageIndex(i, j, k, b)];
 }
 
 template <class T>
@@ -402,8 +513,7 @@ operator()(unsigned int i, unsigned int j, unsigned int k, unsigned int b) const
     assert(k < mDimZ);
     assert(b < mDimB);
 
-    return (
-        *mData)[i + j * mDimX + k * mDimX * mDimY + b * mDimX * mDimY * mDimZ];
+    return (*mData)[storageIndex(i, j, k, b)];
 }
 
 template <class T>
@@ -415,10 +525,7 @@ operator()(const Index& index)
     assert(index.k < mDimZ);
     assert(index.b < mDimB);
 
-    return (*mData)[index.i
-                    + index.j * mDimX
-                    + index.k * mDimX * mDimY
-                    + index.b * mDimX * mDimY * mDimZ];
+    return (*mData)[storageIndex(index.i, index.j, index.k, index.b)];
 }
 
 template <class T>
@@ -430,10 +537,7 @@ operator()(const Index& index) const
     assert(index.k < mDimZ);
     assert(index.b < mDimB);
 
-    return (*mData)[index.i
-                    + index.j * mDimX
-                    + index.k * mDimX * mDimY
-                    + index.b * mDimX * mDimY * mDimZ];
+    return (*mData)[storageIndex(index.i, index.j, index.k, index.b)];
 }
 
 template <class T>
@@ -442,6 +546,7 @@ operator()(unsigned int ijk, unsigned int b)
 {
     assert(ijk < mDimX * mDimY * mDimZ);
     assert(b < mDimB);
+    assert(mChannelBlock == 1);
 
     return (*mData)[ijk + b * mDimX * mDimY * mDimZ];
 }
@@ -452,6 +557,7 @@ operator()(unsigned int ijk, unsigned int b) const
 {
     assert(ijk < mDimX * mDimY * mDimZ);
     assert(b < mDimB);
+    assert(mChannelBlock == 1);
 
     return (*mData)[ijk + b * mDimX * mDimY * mDimZ];
 }
@@ -477,12 +583,33 @@ operator()(unsigned int index) const
 template <class T>
 N2D2::Tensor3d<T> N2D2::Tensor4d<T>::operator[](unsigned int b)
 {
+    // A plain copy of the frame would silently drop the writes
+    if (mChannelBlock > 1)
+        throw std::runtime_error("Tensor4d<T>::operator[]: the frame of a "
+                                 "channel-blocked tensor is read-only");
+
     return Tensor3d<T>(mDimX, mDimY, mDimZ, mData, b * mDimX * mDimY * mDimZ);
 }
 
 template <class T>
 const N2D2::Tensor3d<T> N2D2::Tensor4d<T>::operator[](unsigned int b) const
 {
+    if (mChannelBlock > 1) {
+        // Plain copy of the frame
+        const std::shared_ptr<data_type> frame
+            = std::make_shared<data_type>(mDimX * mDimY * mDimZ);
+        unsigned int index = 0;
+
+        for (unsigned int k = 0; k < mDimZ; ++k) {
+            for (unsigned int j = 0; j < mDimY; ++j) {
+                for (unsigned int i = 0; i < mDimX; ++i)
+                    (*frame)[index++] = (*mData)[storageIndex(i, j, k, b)];
+            }
+        }
+
+        return Tensor3d<T>(mDimX, mDimY, mDimZ, frame, 0);
+    }
+
     return Tensor3d<T>(mDimX, mDimY, mDimZ, mData, b * mDimX * mDimY * mDimZ);
 }
 
@@ -21,6 +21,7 @@
 #ifndef N2D2_INTERFACE_H
 #define N2D2_INTERFACE_H
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 #include <iterator>
@@ -39,8 +40,8 @@ template <class T> class Interface {
 public:
     typedef typename std::vector<Tensor4d<T>*>::iterator iterator;
     typedef typename std::vector<Tensor4d<T>*>::const_iterator const_iterator;
-    typedef typename std::vector<T>::reference reference;
-    typedef typename std::vector<T>::const_reference const_reference;
+    typedef typename Tensor4d<T>::reference reference;
+    typedef typename Tensor4d<T>::const_reference const_reference;
 
     Interface();
     bool empty() const
@@ -78,6 +79,8 @@ public:
     }
     inline void fill(const T& value);
     inline virtual void push_back(Tensor4d<T>* tensor);
+    /// Replace @p tensor by @p newTensor, which must have the same dimensions
+    inline void replace(Tensor4d<T>* tensor, Tensor4d<T>* newTensor);
     inline void clear();
     // Return type should be "reference" (not T&), in order to ensure it works
     // for std::vector<bool>, which is a special case...
@@ -184,6 +187,26 @@ template <class T> void N2D2::Interface<T>::push_back(Tensor4d<T>* tensor)
     mData.push_back(tensor);
 }
 
+template <class T>
+void N2D2::Interface<T>::replace(Tensor4d<T>* tensor, Tensor4d<T>* newTensor)
+{
+    const typename std::vector<Tensor4d<T>*>::iterator it
+        = std::find(mData.begin(), mData.end(), tensor);
+
+    if (it == mData.end())
+        throw std::runtime_error("Interface<T>::replace(): tensor not found");
+
+    if (newTensor->dimX() != tensor->dimX()
+        || newTensor->dimY() != tensor->dimY()
+        || newTensor->dimZ() != tensor->dimZ()
+        || newTensor->dimB() != tensor->dimB()) {
+        throw std::runtime_error("Interface<T>::replace(): tensor dimensions "
+                                 "must match");
+    }
+
+    (*it) = newTensor;
+}
+
 template <class T> void N2D2::Interface<T>::clear()
 {
     mDimZ = 0;
@@ -0,0 +1,85 @@
+/*
+    (C) Copyright 2016 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#ifndef N2D2_GEMM_H
+#define N2D2_GEMM_H
+
+#include <string>
+
+namespace N2D2 {
+namespace Gemm {
+    enum Transpose {
+        NoTrans,
+        Trans
+    };
+
+    /**
+     * Cache-blocked single precision general matrix-matrix product, for
+     *row-major matrices:
+     * C = alpha * op(A) * op(B) + beta * C
+     * with op(A) a M x K matrix, op(B) a K x N matrix and C a M x N matrix.
+     *
+     * When N2D2 is built with a CPU BLAS backend (N2D2_BLAS CMake option set to
+     *OpenBLAS, MKL or BLIS), the product is delegated to cblas_sgemm().
+     * Otherwise, the built-in implementation is used: the operands are packed
+     *into panels that fit in the L1/L2 caches and the inner product is
+     *computed by a register-blocked micro-kernel (explicitly vectorized with
+     *AVX/FMA when available).
+     * The computation is parallelized with OpenMP along the largest dimension
+     *of C, unless already called from within a parallel region.
+     *
+     * @param transA        If Trans, A is stored as a K x M matrix
+     * @param transB        If Trans, B is stored as a N x K matrix
+     * @param M             Number of rows of op(A) and C
+     * @param N             Number of columns of op(B) and C
+     * @param K             Number of columns of op(A) and rows of op(B)
+     * @param alpha         Scaling factor of the product
+     * @param A             Pointer to the first element of A
+     * @param lda           Leading dimension (row stride) of A
+     * @param B             Pointer to the first element of B
+     * @param ldb           Leading dimension (row stride) of B
+     * @param beta          Scaling factor of C. If 0, C does not need to be
+     *initialized
+     * @param C             Pointer to the first element of C
+     * @param ldc           Leading dimension (row stride) of C
+    */
+    void sgemm(Transpose transA,
+               Transpose transB,
+               unsigned int M,
+               unsigned int N,
+               unsigned int K,
+               float alpha,
+               const float* A,
+               unsigned int lda,
+               const float* B,
+               unsigned int ldb,
+               float beta,
+               float* C,
+               unsigned int ldc);
+
+    /**
+     * Returns a description of the BLAS backend used by sgemm(), with its
+     *version and number of threads when available.
+    */
+    std::string getBackend();
+}
+}
+
+#endif // N2D2_GEMM_H
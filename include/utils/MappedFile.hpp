@@ -0,0 +1,68 @@
+/*
+    (C) Copyright 2016 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#ifndef N2D2_MAPPEDFILE_H
+#define N2D2_MAPPEDFILE_H
+
+#include <string>
+#include <vector>
+
+namespace N2D2 {
+/**
+ * @class   MappedFile
+ * @brief   Read-only view of a whole file, memory-mapped when the platform
+ * supports it and read in memory otherwise.
+ *
+ * The mapping is read-only: writing through data() is not allowed and would
+ * fault when the file is mapped.
+*/
+class MappedFile {
+public:
+    MappedFile(const std::string& fileName);
+    const std::string& getFileName() const
+    {
+        return mFileName;
+    };
+    unsigned long long size() const
+    {
+        return mSize;
+    };
+    /// The data is valid as long as the object
+    const unsigned char* data() const
+    {
+        return mData;
+    };
+    virtual ~MappedFile();
+
+private:
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const std::string mFileName;
+    unsigned long long mSize;
+    const unsigned char* mData;
+    /// Mapping address, to unmap it
+    void* mMapping;
+    /// File content, when it is not mapped
+    std::vector<unsigned char> mBuffer;
+};
+}
+
+#endif // N2D2_MAPPEDFILE_H
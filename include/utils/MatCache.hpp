@@ -0,0 +1,106 @@
+/*
+    (C) Copyright 2016 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#ifndef N2D2_MATCACHE_H
+#define N2D2_MATCACHE_H
+
+#include <cstddef>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "opencv2/core/core.hpp"
+
+namespace N2D2 {
+/**
+ * @class   MatCache
+ * @brief   Thread-safe, memory bounded LRU cache of cv::Mat.
+ *
+ * The keys are spread over several independently locked shards, each with
+ * its own LRU list and an equal part of the memory budget, so that
+ * concurrent lookups from different threads seldom contend. When inserting
+ * in a full shard, the least recently used entries of this shard are
+ * evicted. An entry larger than the budget of a shard is not cached.
+ * The cached matrices are shared (not copied) with the caller.
+*/
+class MatCache {
+public:
+    typedef unsigned long long Key;
+
+    struct Stats {
+        unsigned long long nbHits;
+        unsigned long long nbMisses;
+        unsigned long long nbInsertions;
+        unsigned long long nbEvictions;
+        /// Number of matrices currently cached
+        std::size_t nbEntries;
+        /// Bytes currently cached
+        std::size_t bytes;
+    };
+
+    /**
+     * @param budget        Maximum number of bytes cached (0 = unlimited)
+     * @param nbShards      Number of independently locked shards
+    */
+    MatCache(std::size_t budget = 0, unsigned int nbShards = 16);
+    /// Return true and set @p mat if @p key is cached
+    bool get(Key key, cv::Mat& mat);
+    /// Insert or replace the entry @p key
+    void insert(Key key, const cv::Mat& mat);
+    void erase(Key key);
+    void clear();
+    /// Change the memory budget, evicting entries if it is reduced
+    void setBudget(std::size_t budget);
+    std::size_t getBudget() const;
+    unsigned int getNbShards() const
+    {
+        return mShards.size();
+    };
+    Stats getStats() const;
+    void resetStats();
+    static std::size_t matSize(const cv::Mat& mat);
+    virtual ~MatCache() {};
+
+private:
+    typedef std::list<std::pair<Key, cv::Mat> > LruList_T;
+
+    struct Shard {
+        Shard();
+
+        mutable std::mutex mutex;
+        /// Most recently used entry first
+        LruList_T lru;
+        std::unordered_map<Key, LruList_T::iterator> index;
+        std::size_t budget;
+        Stats stats;
+    };
+
+    Shard& shard(Key key);
+    void evict(Shard& shard, std::size_t size);
+
+    std::vector<Shard> mShards;
+    std::size_t mBudget;
+    mutable std::mutex mBudgetMutex;
+};
+}
+
+#endif // N2D2_MATCACHE_H
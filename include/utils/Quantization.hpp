@@ -0,0 +1,139 @@
+/*
+    (C) Copyright 2016 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#ifndef N2D2_QUANTIZATION_H
+#define N2D2_QUANTIZATION_H
+
+#include <string>
+#include <vector>
+
+#include "containers/Tensor4d.hpp"
+#include "controler/Interface.hpp"
+#include "utils/Utils.hpp"
+
+namespace N2D2 {
+namespace Quantization {
+    enum Calibration {
+        /// Clipping threshold at the maximum absolute value
+        MaxAbs,
+        /// Clipping threshold minimizing the Kullback-Leibler divergence
+        /// between the reference and the quantized distributions
+        KL
+    };
+
+    /// Quantization of the signals at the inputs or the outputs of a cell:
+    /// value = integer * scale
+    struct Signals {
+        Signals(float scale_ = 0.0, bool isSigned_ = true)
+            : scale(scale_), isSigned(isSigned_) {}
+
+        float scale;
+        bool isSigned;
+    };
+
+    /// Largest integer of a @p nbBits symmetric quantization
+    inline int maxValue(unsigned int nbBits, bool isSigned)
+    {
+        return (isSigned) ? (1 << (nbBits - 1)) - 1 : (1 << nbBits) - 1;
+    }
+
+    /// Smallest integer of a @p nbBits symmetric quantization
+    inline int minValue(unsigned int nbBits, bool isSigned)
+    {
+        return (isSigned) ? -maxValue(nbBits, isSigned) : 0;
+    }
+
+    /**
+     * Histogram of the absolute values of a signal, used to calibrate its
+     * quantization. The range adapts to the values: it is doubled (merging
+     * the bins by pairs) each time a value exceeds it, so that the signal
+     * can be accumulated over any number of batches in a single pass.
+    */
+    class Histogram {
+    public:
+        Histogram(unsigned int nbBins = 2048);
+        void operator()(double value);
+        void fill(const Tensor4d<float>& data);
+        double getMaxAbs() const
+        {
+            return mMaxAbs;
+        };
+        bool isSigned() const
+        {
+            return mSigned;
+        };
+        /**
+         * Returns the clipping threshold of the signal for a @p nbBits
+         * quantization, with the @p calibration method
+        */
+        double calibrate(Calibration calibration, unsigned int nbBits) const;
+        void log(const std::string& fileName) const;
+
+    private:
+        double calibrateKL(unsigned int nbLevels) const;
+
+        std::vector<unsigned long long int> mBins;
+        double mRange;
+        double mMaxAbs;
+        bool mSigned;
+    };
+
+    /**
+     * Per-output (dimB() of each weights tensor) scales of a @p nbBits
+     * symmetric quantization of @p weights
+    */
+    std::vector<float> weightsScales(const Interface<float>& weights,
+                                     unsigned int nbBits);
+    void quantizeWeights(const Tensor4d<float>& weights,
+                         const std::vector<float>& scales,
+                         unsigned int nbBits,
+                         Tensor4d<signed char>& quantized);
+    /**
+     * Quantize @p signals on @p nbBits. The integers are stored on 16 bits,
+     * to hold both the signed and the unsigned 8 bits ranges.
+    */
+    void quantizeSignals(const Tensor4d<float>& signals,
+                         const Signals& quantization,
+                         unsigned int nbBits,
+                         Tensor4d<short>& quantized);
+    /**
+     * Float outputs of an integer cell from its 32 bits accumulators:
+     * (accumulator + bias[o]) * inputsScale * synapsesScales[o], o being the
+     * output channel (the bias is empty for a cell without bias)
+    */
+    void dequantize(const Tensor4d<int>& accumulators,
+                    const std::vector<int>& bias,
+                    float inputsScale,
+                    const std::vector<float>& synapsesScales,
+                    Tensor4d<float>& outputs);
+    /// Round @p signals (in place) to the closest value of the quantization
+    void requantize(Tensor4d<float>& signals,
+                    const Signals& quantization,
+                    unsigned int nbBits);
+}
+}
+
+namespace {
+template <>
+const char* const EnumStrings<N2D2::Quantization::Calibration>::data[]
+    = {"MaxAbs", "KL"};
+}
+
+#endif // N2D2_QUANTIZATION_H
@@ -22,19 +22,24 @@
 #ifndef N2D2_RANDOM_H
 #define N2D2_RANDOM_H
 
+#include <algorithm>
 #include <cmath>
 #include <cstdlib>
 #include <stdexcept>
+#include <string>
 
 #include "utils/Utils.hpp"
 
 #define MT_RAND_MAX 0xFFFFFFFF
 
+#if defined(_MSC_VER)
+#define N2D2_THREAD_LOCAL __declspec(thread)
+#else
+#define N2D2_THREAD_LOCAL __thread
+#endif
+
 namespace N2D2 {
 namespace Random {
-    extern unsigned int _mt[624];
-    extern unsigned int _mt_index;
-
     enum Endpoints {
         ClosedInterval,
         LeftHalfOpenInterval,
@@ -42,6 +47,82 @@ namespace Random {
         OpenInterval
     };
 
+    /**
+     * Counter-based Philox4x32-10 pseudorandom number generator (Salmon et
+     *al., "Parallel random numbers: as easy as 1, 2, 3", SC'11).
+     * The n-th number of a stream only depends on (seed, stream, n), so that
+     *independent streams can be used concurrently by different threads and
+     *any position of a stream can be reached in O(1).
+    */
+    class Philox {
+    public:
+        Philox(unsigned long long seed = 0,
+               unsigned long long stream = 0,
+               unsigned long long counter = 0);
+        /**
+         * (Re-)initialize the generator.
+         *
+         * @param seed          Seed value (the generator key)
+         * @param stream        Stream number
+         * @param counter       Position in the stream, in blocks of 4 numbers
+        */
+        void seed(unsigned long long seed,
+                  unsigned long long stream = 0,
+                  unsigned long long counter = 0);
+
+        /**
+         * Generates uniformly distributed 32-bit integers in the range [0,
+         *(2^32)-1].
+        */
+        inline unsigned int rand();
+        double randUniform(double vmin = 0.0,
+                           double vmax = 1.0,
+                           Endpoints endpoints = ClosedInterval);
+        double randNormal(double mean = 0.0, double stdDev = 1.0);
+        bool randBernoulli(double p = 0.5);
+
+        /// Philox4x32-10 bijection: result = f_key(counter)
+        static void generate(const unsigned int counter[4],
+                             const unsigned int key[2],
+                             unsigned int result[4]);
+
+    private:
+        unsigned int mKey[2];
+        unsigned int mStream[2];
+        unsigned long long mCounter;
+        unsigned int mBuffer[4];
+        unsigned int mBufferIndex;
+        bool mAvailableDeviate;
+        double mStoredDeviate;
+    };
+
+    extern unsigned int _mt[624];
+    extern unsigned int _mt_index;
+    extern unsigned int _mt_seed;
+    extern N2D2_THREAD_LOCAL Philox* _stream;
+
+    /**
+     * While an instance exists, the random functions of this namespace
+     *(mtRand(), randUniform(), randNormal()...) called from the thread that
+     *created it draw their numbers from its own Philox stream instead of the
+     *global Mersenne Twister generator. This makes them thread-safe, and the
+     *numbers drawn do not depend on the thread that runs the code.
+     * Instances must be destroyed in the reverse order of their creation.
+    */
+    class ThreadStream {
+    public:
+        ThreadStream(unsigned long long seed, unsigned long long stream = 0);
+        Philox& get()
+        {
+            return mPhilox;
+        };
+        ~ThreadStream();
+
+    private:
+        Philox mPhilox;
+        Philox* mPrevious;
+    };
+
     /**
      * Initialize the internal Mersenne Twister MT19937 pseudorandom number
      *generator from a seed.
@@ -51,6 +132,29 @@ namespace Random {
     */
     void mtSeed(unsigned int seed = 1);
 
+    /// Seed of the last mtSeed() call
+    unsigned int getSeed();
+
+    /**
+     * Derive the seed of an independent Philox key from a base seed, a
+     *stream identifier and an iteration counter.
+     * Objects drawing random numbers from a thread other than the main one
+     *(cells, stimuli provider...) use their own key, obtained with
+     *streamSeed(getSeed(), id, iteration), instead of calling mtRand(), which
+     *is not thread-safe.
+     *
+     * @param seed          Base seed
+     * @param id            Stream identifier (see streamId())
+     * @param iteration     Iteration counter
+     * @return Seed for Philox, ThreadStream or the fill*() functions
+    */
+    unsigned long long streamSeed(unsigned long long seed,
+                                  unsigned long long id,
+                                  unsigned long long iteration);
+
+    /// Platform independent stream identifier for a name (64-bit FNV-1a)
+    unsigned long long streamId(const std::string& name);
+
     /**
      * Generates uniformly distributed 32-bit integers in the range [0,
      *(2^32)-1] with the internal Mersenne Twister MT19937
@@ -98,9 +202,58 @@ namespace Random {
      * @return 1 with probability p and 0 with probability 1-p
     */
     inline bool randBernoulli(double p = 0.5);
+
+    /**
+     * Fill a tensor (or any container with size() and operator()(index)) in
+     *parallel with uniformly distributed numbers.
+     * The elements are generated in blocks of FillBlockSize consecutive
+     *elements, each block using its own position in the (seed, stream) Philox
+     *stream, so that the result does not depend on the number of threads.
+     * Blocks are also a multiple of the word size of std::vector<bool>, so
+     *that threads never write the same word.
+    */
+    template <class T>
+    void fillUniform(T& data,
+                     double vmin,
+                     double vmax,
+                     unsigned long long seed,
+                     unsigned long long stream = 0,
+                     Endpoints endpoints = ClosedInterval);
+    /// Same as fillUniform(), with normally distributed numbers
+    template <class T>
+    void fillNormal(T& data,
+                    double mean,
+                    double stdDev,
+                    unsigned long long seed,
+                    unsigned long long stream = 0);
+    /// Same as fillUniform(), with Bernoulli distributed numbers
+    template <class T>
+    void fillBernoulli(T& data,
+                       double p,
+                       unsigned long long seed,
+                       unsigned long long stream = 0);
+
+    const unsigned int FillBlockSize = 256;
 }
 }
 
+unsigned int N2D2::Random::Philox::rand()
+{
+    if (mBufferIndex == 4) {
+        const unsigned int counter[4]
+            = {(unsigned int)(mCounter & 0xFFFFFFFF),
+               (unsigned int)(mCounter >> 32),
+               mStream[0],
+               mStream[1]};
+
+        generate(counter, mKey, mBuffer);
+        ++mCounter;
+        mBufferIndex = 0;
+    }
+
+    return mBuffer[mBufferIndex++];
+}
+
 double N2D2::Random::randUniform(double vmin, double vmax, Endpoints endpoints)
 {
     if (vmax < vmin)
@@ -161,4 +314,71 @@ bool N2D2::Random::randBernoulli(double p)
     return (Random::randUniform(0.0, 1.0, Random::RightHalfOpenInterval) < p);
 }
 
+template <class T>
+void N2D2::Random::fillUniform(T& data,
+                               double vmin,
+                               double vmax,
+                               unsigned long long seed,
+                               unsigned long long stream,
+                               Endpoints endpoints)
+{
+    if (vmax < vmin)
+        throw std::domain_error("Random::fillUniform(): vmax must be >= vmin.");
+
+    const unsigned int size = data.size();
+    const int nbBlocks = (size + FillBlockSize - 1) / FillBlockSize;
+
+#pragma omp parallel for if (nbBlocks > 1)
+    for (int block = 0; block < nbBlocks; ++block) {
+        Philox philox(seed, stream, (unsigned long long)block * FillBlockSize);
+        const unsigned int end = std::min(size, (block + 1) * FillBlockSize);
+
+        for (unsigned int index = block * FillBlockSize; index < end; ++index)
+            data(index) = philox.randUniform(vmin, vmax, endpoints);
+    }
+}
+
+template <class T>
+void N2D2::Random::fillNormal(T& data,
+                              double mean,
+                              double stdDev,
+                              unsigned long long seed,
+                              unsigned long long stream)
+{
+    if (stdDev < 0.0)
+        throw std::domain_error(
+            "Random::fillNormal(): standard deviation must be >= 0.");
+
+    const unsigned int size = data.size();
+    const int nbBlocks = (size + FillBlockSize - 1) / FillBlockSize;
+
+#pragma omp parallel for if (nbBlocks > 1)
+    for (int block = 0; block < nbBlocks; ++block) {
+        Philox philox(seed, stream, (unsigned long long)block * FillBlockSize);
+        const unsigned int end = std::min(size, (block + 1) * FillBlockSize);
+
+        for (unsigned int index = block * FillBlockSize; index < end; ++index)
+            data(index) = philox.randNormal(mean, stdDev);
+    }
+}
+
+template <class T>
+void N2D2::Random::fillBernoulli(T& data,
+                                 double p,
+                                 unsigned long long seed,
+                                 unsigned long long stream)
+{
+    const unsigned int size = data.size();
+    const int nbBlocks = (size + FillBlockSize - 1) / FillBlockSize;
+
+#pragma omp parallel for if (nbBlocks > 1)
+    for (int block = 0; block < nbBlocks; ++block) {
+        Philox philox(seed, stream, (unsigned long long)block * FillBlockSize);
+        const unsigned int end = std::min(size, (block + 1) * FillBlockSize);
+
+        for (unsigned int index = block * FillBlockSize; index < end; ++index)
+            data(index) = philox.randBernoulli(p);
+    }
+}
+
 #endif // N2D2_RANDOM_H
@@ -0,0 +1,110 @@
+/*
+    (C) Copyright 2016 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#ifndef N2D2_SHARDCACHE_H
+#define N2D2_SHARDCACHE_H
+
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "opencv2/core/core.hpp"
+
+namespace N2D2 {
+/**
+ * @class   ShardCache
+ * @brief   Packed storage for pre-processed stimuli.
+ *
+ * Records (a list of cv::Mat) are appended to a few large shard files and
+ * located through an append-only offset index, instead of using one file per
+ * record. Shards that are complete when the cache is opened (or when a new
+ * shard is started) are memory-mapped: the matrices returned by read() then
+ * point directly to the mapped data, without copy. The mapping is private, so
+ * the shard files are never altered, but a returned matrix must be cloned
+ * before any in-place modification, as the change would otherwise be seen by
+ * the next read() of the same record.
+*/
+class ShardCache {
+public:
+    ShardCache(const std::string& path,
+               unsigned long long shardSize = 1024ULL * 1024ULL * 1024ULL);
+    bool contains(const std::string& key) const;
+    /// Position of the record @p key in the shards, in write order. Return
+    /// false if @p key is not present
+    bool locate(const std::string& key,
+                unsigned int& shard,
+                unsigned long long& offset) const;
+    /// The returned matrices are valid as long as the cache object and may
+    /// share its memory
+    std::vector<cv::Mat> read(const std::string& key) const;
+    /// Append a record. Nothing is done if @p key is already present
+    void write(const std::string& key, const std::vector<cv::Mat>& data);
+    unsigned int getNbRecords() const;
+    unsigned int getNbShards() const;
+    const std::string& getPath() const
+    {
+        return mPath;
+    };
+    virtual ~ShardCache();
+
+    static const char* IndexFileName;
+
+private:
+    struct Record {
+        unsigned int shard;
+        unsigned long long offset;
+        unsigned long long size;
+    };
+
+    struct Shard {
+        std::string fileName;
+        unsigned long long size;
+        /// Mapped content, NULL if the shard is not mapped
+        char* data;
+    };
+
+    /// Size of the record and matrix headers, which is also the alignment
+    /// of the matrices data in the shards
+    static const unsigned int HeaderSize = 16;
+
+    std::string shardFileName(unsigned int shard) const;
+    void loadIndex();
+    void mapShard(Shard& shard);
+    void unmapShard(Shard& shard);
+    void openWriteShard();
+    static std::vector<cv::Mat> parse(char* data, unsigned long long size);
+    static unsigned long long alignedSize(unsigned long long size);
+
+    const std::string mPath;
+    const unsigned long long mShardSize;
+    std::map<std::string, Record> mRecords;
+    std::vector<Shard> mShards;
+    /// Shard currently open for writing (mShards.size() if none)
+    unsigned int mWriteShard;
+    std::ofstream mWriteStream;
+    std::ofstream mIndexStream;
+    mutable std::mutex mMutex;
+};
+}
+
+#endif // N2D2_SHARDCACHE_H
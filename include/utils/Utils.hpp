@@ -569,10 +569,10 @@ namespace Utils {
 
 template <class T>
 std::vector<T>& operator<<(std::vector<T>& vec, const std::string& data);
-template <class T>
-std::ostream& operator<<(std::ostream& os, const std::vector<T>& vec);
-template <class T>
-std::istream& operator>>(std::istream& is, std::vector<T>& vec);
+template <class T, class Alloc>
+std::ostream& operator<<(std::ostream& os, const std::vector<T, Alloc>& vec);
+template <class T, class Alloc>
+std::istream& operator>>(std::istream& is, std::vector<T, Alloc>& vec);
 
 // I get an undefined reference error on GCC 4.8.4 if I put the definition in
 // the .cpp, but it works on GCC 4.4.7!
@@ -972,15 +972,15 @@ std::vector<T>& operator<<(std::vector<T>& vec, const std::string& data)
     return vec;
 }
 
-template <class T>
-std::ostream& operator<<(std::ostream& os, const std::vector<T>& vec)
+template <class T, class Alloc>
+std::ostream& operator<<(std::ostream& os, const std::vector<T, Alloc>& vec)
 {
     std::copy(vec.begin(), vec.end(), std::ostream_iterator<T>(os, " "));
     return os;
 }
 
-template <class T>
-std::istream& operator>>(std::istream& is, std::vector<T>& vec)
+template <class T, class Alloc>
+std::istream& operator>>(std::istream& is, std::vector<T, Alloc>& vec)
 {
     vec.clear();
     std::copy(std::istream_iterator<T>(is),
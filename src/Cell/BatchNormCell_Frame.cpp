@@ -297,22 +297,22 @@ void N2D2::BatchNormCell_Frame::saveFreeParameters(const std::string
         throw std::runtime_error("Could not create parameter file (.SYN): "
                                  + fileName);
 
-    for (std::vector<Float_T>::const_iterator it = mScale.begin();
+    for (Tensor4d<Float_T>::const_iterator it = mScale.begin();
          it != mScale.end();
          ++it)
         syn.write(reinterpret_cast<const char*>(&(*it)), sizeof(*it));
 
-    for (std::vector<Float_T>::const_iterator it = mBias.begin();
+    for (Tensor4d<Float_T>::const_iterator it = mBias.begin();
          it != mBias.end();
          ++it)
         syn.write(reinterpret_cast<const char*>(&(*it)), sizeof(*it));
 
-    for (std::vector<Float_T>::const_iterator it = mMean.begin();
+    for (Tensor4d<Float_T>::const_iterator it = mMean.begin();
          it != mMean.end();
          ++it)
         syn.write(reinterpret_cast<const char*>(&(*it)), sizeof(*it));
 
-    for (std::vector<Float_T>::const_iterator it = mVariance.begin();
+    for (Tensor4d<Float_T>::const_iterator it = mVariance.begin();
          it != mVariance.end();
          ++it)
         syn.write(reinterpret_cast<const char*>(&(*it)), sizeof(*it));
@@ -337,19 +337,19 @@ void N2D2::BatchNormCell_Frame::loadFreeParameters(const std::string& fileName,
                                      + fileName);
     }
 
-    for (std::vector<Float_T>::iterator it = mScale.begin(); it != mScale.end();
+    for (Tensor4d<Float_T>::iterator it = mScale.begin(); it != mScale.end();
          ++it)
         syn.read(reinterpret_cast<char*>(&(*it)), sizeof(*it));
 
-    for (std::vector<Float_T>::iterator it = mBias.begin(); it != mBias.end();
+    for (Tensor4d<Float_T>::iterator it = mBias.begin(); it != mBias.end();
          ++it)
         syn.read(reinterpret_cast<char*>(&(*it)), sizeof(*it));
 
-    for (std::vector<Float_T>::iterator it = mMean.begin(); it != mMean.end();
+    for (Tensor4d<Float_T>::iterator it = mMean.begin(); it != mMean.end();
          ++it)
         syn.read(reinterpret_cast<char*>(&(*it)), sizeof(*it));
 
-    for (std::vector<Float_T>::iterator it = mVariance.begin();
+    for (Tensor4d<Float_T>::iterator it = mVariance.begin();
          it != mVariance.end();
          ++it)
         syn.read(reinterpret_cast<char*>(&(*it)), sizeof(*it));
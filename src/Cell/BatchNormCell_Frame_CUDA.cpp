@@ -216,28 +216,28 @@ void N2D2::BatchNormCell_Frame_CUDA::saveFreeParameters(const std::string
 
     mScale.synchronizeDToH();
 
-    for (std::vector<Float_T>::const_iterator it = mScale.begin();
+    for (Tensor4d<Float_T>::const_iterator it = mScale.begin();
          it != mScale.end();
          ++it)
         syn.write(reinterpret_cast<const char*>(&(*it)), sizeof(*it));
 
     mBias.synchronizeDToH();
 
-    for (std::vector<Float_T>::const_iterator it = mBias.begin();
+    for (Tensor4d<Float_T>::const_iterator it = mBias.begin();
          it != mBias.end();
          ++it)
         syn.write(reinterpret_cast<const char*>(&(*it)), sizeof(*it));
 
     mMean.synchronizeDToH();
 
-    for (std::vector<Float_T>::const_iterator it = mMean.begin();
+    for (Tensor4d<Float_T>::const_iterator it = mMean.begin();
          it != mMean.end();
          ++it)
         syn.write(reinterpret_cast<const char*>(&(*it)), sizeof(*it));
 
     mVariance.synchronizeDToH();
 
-    for (std::vector<Float_T>::const_iterator it = mVariance.begin();
+    for (Tensor4d<Float_T>::const_iterator it = mVariance.begin();
          it != mVariance.end();
          ++it)
         syn.write(reinterpret_cast<const char*>(&(*it)), sizeof(*it));
@@ -263,25 +263,25 @@ void N2D2::BatchNormCell_Frame_CUDA::loadFreeParameters(const std::string
                                      + fileName);
     }
 
-    for (std::vector<Float_T>::iterator it = mScale.begin(); it != mScale.end();
+    for (Tensor4d<Float_T>::iterator it = mScale.begin(); it != mScale.end();
          ++it)
         syn.read(reinterpret_cast<char*>(&(*it)), sizeof(*it));
 
     mScale.synchronizeHToD();
 
-    for (std::vector<Float_T>::iterator it = mBias.begin(); it != mBias.end();
+    for (Tensor4d<Float_T>::iterator it = mBias.begin(); it != mBias.end();
          ++it)
         syn.read(reinterpret_cast<char*>(&(*it)), sizeof(*it));
 
     mBias.synchronizeHToD();
 
-    for (std::vector<Float_T>::iterator it = mMean.begin(); it != mMean.end();
+    for (Tensor4d<Float_T>::iterator it = mMean.begin(); it != mMean.end();
          ++it)
         syn.read(reinterpret_cast<char*>(&(*it)), sizeof(*it));
 
     mMean.synchronizeHToD();
 
-    for (std::vector<Float_T>::iterator it = mVariance.begin();
+    for (Tensor4d<Float_T>::iterator it = mVariance.begin();
          it != mVariance.end();
          ++it)
         syn.read(reinterpret_cast<char*>(&(*it)), sizeof(*it));
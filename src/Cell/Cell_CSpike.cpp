@@ -0,0 +1,224 @@
+/*
+    (C) Copyright 2016 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include "Cell/Cell_CSpike.hpp"
+
+N2D2::Cell_CSpike::Cell_CSpike(const std::string& name, unsigned int nbOutputs)
+    : Cell(name, nbOutputs),
+      // IMPORTANT: Do not change the value of the parameters here! Use
+      // setParameter() or loadParameters().
+      mThreshold(this, "Threshold", 1.0),
+      mBipolarThreshold(this, "BipolarThreshold", true),
+      mLeak(this, "Leak", 0 * TimeS),
+      mRefractory(this, "Refractory", 0 * TimeS),
+      mLastTick(0)
+{
+    // ctor
+}
+
+void N2D2::Cell_CSpike::addInput(StimuliProvider& /*sp*/,
+                                 unsigned int /*channel*/,
+                                 unsigned int /*x0*/,
+                                 unsigned int /*y0*/,
+                                 unsigned int /*width*/,
+                                 unsigned int /*height*/,
+                                 const std::vector<bool>& /*mapping*/)
+{
+    throw std::runtime_error("Cell_CSpike::addInput(): adding a single "
+                             "environment channel as input is not supported");
+}
+
+void N2D2::Cell_CSpike::addInput(StimuliProvider& sp,
+                                 unsigned int x0,
+                                 unsigned int y0,
+                                 unsigned int width,
+                                 unsigned int height,
+                                 const Matrix<bool>& mapping)
+{
+    CEnvironment* cEnv = dynamic_cast<CEnvironment*>(&sp);
+
+    if (cEnv == NULL)
+        throw std::runtime_error(
+            "Cell_CSpike::addInput(): CSpike models require CEnvironment");
+
+    if (width == 0)
+        width = sp.getSizeX() - x0;
+    if (height == 0)
+        height = sp.getSizeY() - y0;
+
+    if (x0 > 0 || y0 > 0 || width < sp.getSizeX() || height < sp.getSizeY())
+        throw std::runtime_error("Cell_CSpike::addInput(): adding a cropped "
+                                 "environment channel map as input is not "
+                                 "supported");
+
+    addInput(cEnv->getTickData(), mapping);
+}
+
+void N2D2::Cell_CSpike::addInput(Cell* cell, const Matrix<bool>& mapping)
+{
+    Cell_CSpike* cellCSpike = dynamic_cast<Cell_CSpike*>(cell);
+
+    if (cellCSpike == NULL)
+        throw std::runtime_error(
+            "Cell_CSpike::addInput(): cannot mix CSpike and other models");
+
+    addInput(cellCSpike->getOutputs(), mapping);
+}
+
+void N2D2::Cell_CSpike::addInput(Cell* cell,
+                                 unsigned int x0,
+                                 unsigned int y0,
+                                 unsigned int width,
+                                 unsigned int height)
+{
+    if (width == 0)
+        width = cell->getOutputsWidth() - x0;
+    if (height == 0)
+        height = cell->getOutputsHeight() - y0;
+
+    if (x0 > 0 || y0 > 0 || width < cell->getOutputsWidth()
+        || height < cell->getOutputsHeight())
+        throw std::runtime_error("Cell_CSpike::addInput(): adding a cropped "
+                                 "output map as input is not supported");
+
+    Cell_CSpike::addInput(cell);
+}
+
+void N2D2::Cell_CSpike::reset(Time_T timestamp)
+{
+    mOutputs.fill(0);
+    mOutputsActivity.fill(0.0);
+    mOutputsIntegration.fill(0.0);
+    mOutputsRefractoryEnd.fill(0);
+    mLastTick = timestamp;
+}
+
+void N2D2::Cell_CSpike::addInput(Tensor4d<char>& inputs,
+                                 const Matrix<bool>& mapping)
+{
+    // Define input-output sizes
+    setInputsSize(inputs.dimX(), inputs.dimY());
+    mNbChannels += inputs.dimZ();
+
+    mInputs.push_back(&inputs);
+    setOutputsSize();
+
+    if (mOutputs.empty()) {
+        mOutputs.resize(
+            mOutputsWidth, mOutputsHeight, mNbOutputs, mInputs.dimB(), 0);
+        mOutputsActivity.resize(
+            mOutputsWidth, mOutputsHeight, mNbOutputs, mInputs.dimB(), 0.0);
+        mOutputsIntegration.resize(
+            mOutputsWidth, mOutputsHeight, mNbOutputs, mInputs.dimB(), 0.0);
+        mOutputsRefractoryEnd.resize(
+            mOutputsWidth, mOutputsHeight, mNbOutputs, mInputs.dimB(), 0);
+    }
+
+    // Define input-output connections
+    if (!mapping.empty() && mapping.rows() != inputs.dimZ())
+        throw std::runtime_error("Cell_CSpike::addInput(): number of mapping "
+                                 "rows must be equal to the number of input "
+                                 "channels");
+
+    mMaps.resize(mNbOutputs, mNbChannels);
+    const unsigned int channelOffset = mNbChannels - inputs.dimZ();
+
+    for (unsigned int output = 0; output < mNbOutputs; ++output) {
+        for (unsigned int channel = 0; channel < inputs.dimZ(); ++channel) {
+            mMaps(output, channelOffset + channel)
+                = (!mapping.empty()) ? mapping(channel, output) : true;
+        }
+    }
+
+    mInputsActive.resize(mNbChannels, mInputs.dimB(), 0);
+}
+
+bool N2D2::Cell_CSpike::updateInputsActive()
+{
+    const unsigned int dimB = mInputs.dimB();
+    bool active = false;
+    unsigned int channelOffset = 0;
+
+    for (unsigned int k = 0, size = mInputs.size(); k < size; ++k) {
+        const Tensor4d<char>& input = mInputs[k];
+        const unsigned int mapSize = input.dimX() * input.dimY();
+
+        for (unsigned int batchPos = 0; batchPos < dimB; ++batchPos) {
+            for (unsigned int channel = 0; channel < input.dimZ(); ++channel)
+            {
+                const char* map = &input(0, 0, channel, batchPos);
+                char mapActive = 0;
+
+                for (unsigned int i = 0; i < mapSize; ++i)
+                    mapActive |= map[i];
+
+                mInputsActive(channelOffset + channel, batchPos)
+                    = (mapActive != 0);
+                active = active || (mapActive != 0);
+            }
+        }
+
+        channelOffset += input.dimZ();
+    }
+
+    return active;
+}
+
+N2D2::Float_T N2D2::Cell_CSpike::leak(Time_T timestamp)
+{
+    Float_T leakFactor = 1.0;
+
+    if (mLeak > 0 && timestamp > mLastTick)
+        leakFactor = std::exp(-((double)(timestamp - mLastTick))
+                              / ((double)mLeak));
+
+    mLastTick = timestamp;
+    return leakFactor;
+}
+
+void N2D2::Cell_CSpike::fire(Time_T timestamp)
+{
+    const Float_T threshold = mThreshold;
+    const bool bipolarThreshold = mBipolarThreshold;
+    const Time_T refractory = mRefractory;
+    const int size = mOutputsIntegration.size();
+
+#pragma omp parallel for if (size > 1024)
+    for (int index = 0; index < size; ++index) {
+        Float_T& integration = mOutputsIntegration(index);
+        char spike = 0;
+
+        if (timestamp >= mOutputsRefractoryEnd(index)) {
+            if (integration >= threshold)
+                spike = 1;
+            else if (bipolarThreshold && (-integration) >= threshold)
+                spike = -1;
+        }
+
+        if (spike != 0) {
+            // The value above the threshold is kept, as in the Spike models
+            integration -= spike * threshold;
+            mOutputsRefractoryEnd(index) = timestamp + refractory;
+            mOutputsActivity(index) += spike;
+        }
+
+        mOutputs(index) = spike;
+    }
+}
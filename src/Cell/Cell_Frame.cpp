@@ -177,6 +177,22 @@ void N2D2::Cell_Frame::addInput(Tensor4d<Float_T>& inputs,
     mMaps.resize(mNbOutputs, mNbChannels, true);
 }
 
+void N2D2::Cell_Frame::replaceInput(Tensor4d<Float_T>& inputs,
+                                    Tensor4d<Float_T>& newInputs,
+                                    Tensor4d<Float_T>& diffOutputs,
+                                    Tensor4d<Float_T>& newDiffOutputs)
+{
+    if (newInputs.channelBlock() != inputs.channelBlock())
+        throw std::runtime_error("Cell_Frame::replaceInput(): the new inputs "
+                                 "must have the same layout for cell "
+                                 + mName);
+
+    mInputs.replace(&inputs, &newInputs);
+
+    if (!mDiffOutputs.empty())
+        mDiffOutputs.replace(&diffOutputs, &newDiffOutputs);
+}
+
 void N2D2::Cell_Frame::propagate(bool /*inference*/)
 {
     if (mActivation)
@@ -335,3 +351,14 @@ void N2D2::Cell_Frame::discretizeSignals(unsigned int nbLevels)
                               / (nbLevels - 1);
     }
 }
+
+void N2D2::Cell_Frame::setChannelBlock(unsigned int channelBlock)
+{
+    if (channelBlock > 1 && !isChannelBlockable())
+        throw std::runtime_error("Cell_Frame::setChannelBlock(): cell " + mName
+                                 + " does not support the channel-blocked "
+                                 "layout");
+
+    mOutputs.setChannelBlock(channelBlock);
+    mDiffInputs.setChannelBlock(channelBlock);
+}
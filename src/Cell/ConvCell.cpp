@@ -556,6 +556,38 @@ void N2D2::ConvCell::processFreeParameters(const std::function
     }
 }
 
+void N2D2::ConvCell::foldScaleShift(const std::vector<Float_T>& scale,
+                                    const std::vector<Float_T>& shift)
+{
+    if (scale.size() != mNbOutputs || shift.size() != mNbOutputs)
+        throw std::runtime_error("ConvCell::foldScaleShift(): scale and shift "
+                                 "sizes must match the number of outputs for "
+                                 "cell " + mName);
+
+    for (unsigned int output = 0; output < mNbOutputs; ++output) {
+        for (unsigned int channel = 0; channel < getNbChannels(); ++channel) {
+            if (!isConnection(channel, output))
+                continue;
+
+            for (unsigned int sy = 0; sy < mKernelHeight; ++sy) {
+                for (unsigned int sx = 0; sx < mKernelWidth; ++sx) {
+                    setWeight(output,
+                              channel,
+                              sx,
+                              sy,
+                              scale[output]
+                              * getWeight(output, channel, sx, sy));
+                }
+            }
+        }
+
+        const Float_T bias = (mNoBias) ? 0.0 : getBias(output);
+        setBias(output, scale[output] * bias + shift[output]);
+    }
+
+    mNoBias = false;
+}
+
 void N2D2::ConvCell::getStats(Stats& stats) const
 {
     const unsigned long long int nbVirtualSynapses = getNbVirtualSynapses();
@@ -0,0 +1,252 @@
+/*
+    (C) Copyright 2016 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include "Cell/ConvCell_CSpike.hpp"
+
+N2D2::Registrar<N2D2::ConvCell>
+N2D2::ConvCell_CSpike::mRegistrar("CSpike", N2D2::ConvCell_CSpike::create);
+
+N2D2::ConvCell_CSpike::ConvCell_CSpike(const std::string& name,
+                                       unsigned int kernelWidth,
+                                       unsigned int kernelHeight,
+                                       unsigned int nbOutputs,
+                                       unsigned int subSampleX,
+                                       unsigned int subSampleY,
+                                       unsigned int strideX,
+                                       unsigned int strideY,
+                                       int paddingX,
+                                       int paddingY)
+    : Cell(name, nbOutputs),
+      ConvCell(name,
+               kernelWidth,
+               kernelHeight,
+               nbOutputs,
+               subSampleX,
+               subSampleY,
+               strideX,
+               strideY,
+               paddingX,
+               paddingY),
+      Cell_CSpike(name, nbOutputs),
+      mBias(1, 1, mNbOutputs, 1)
+{
+    // ctor
+}
+
+void N2D2::ConvCell_CSpike::initialize()
+{
+    if (mThreshold <= 0.0)
+        throw std::domain_error("mThreshold is <= 0.0");
+
+    if (!mNoBias)
+        mBiasFiller->apply(mBias);
+
+    for (unsigned int k = 0, size = mInputs.size(); k < size; ++k) {
+        if (mInputs[k].size() == 0)
+            throw std::runtime_error("Zero-sized input for ConvCell " + mName);
+
+        mSharedSynapses.push_back(new Tensor4d<Float_T>(
+            mKernelWidth, mKernelHeight, mInputs[k].dimZ(), mNbOutputs));
+        mWeightsFiller->apply(mSharedSynapses.back());
+    }
+}
+
+bool N2D2::ConvCell_CSpike::tick(Time_T timestamp)
+{
+    const Float_T leakFactor = leak(timestamp);
+    const bool active = updateInputsActive();
+
+    // Convolution size, before subsampling
+    const unsigned int oxSize
+        = (unsigned int)((mChannelsWidth + 2 * mPaddingX - mKernelWidth
+                          + mStrideX) / (double)mStrideX);
+    const unsigned int oySize
+        = (unsigned int)((mChannelsHeight + 2 * mPaddingY - mKernelHeight
+                          + mStrideY) / (double)mStrideY);
+
+    const unsigned int dimB = mOutputs.dimB();
+    const unsigned int size = dimB * mNbOutputs;
+
+#if defined(_OPENMP) && _OPENMP >= 200805
+#pragma omp parallel for collapse(2) if (size > 16)
+#else
+#pragma omp parallel for if (dimB > 4 && size > 16)
+#endif
+    for (int batchPos = 0; batchPos < (int)dimB; ++batchPos) {
+        for (unsigned int output = 0; output < mNbOutputs; ++output) {
+            const Float_T bias = (!mNoBias) ? mBias(output) : 0.0;
+
+            for (unsigned int soy = 0; soy < mOutputsHeight; ++soy) {
+                for (unsigned int sox = 0; sox < mOutputsWidth; ++sox) {
+                    Float_T weightedSum = bias;
+
+                    // Skip the convolution when no input spiked
+                    for (unsigned int oy = soy * mSubSampleY,
+                                      oyEnd = std::min(oySize,
+                                                       oy + mSubSampleY);
+                         active && oy < oyEnd;
+                         ++oy) {
+                        for (unsigned int ox = sox * mSubSampleX,
+                                          oxEnd = std::min(oxSize,
+                                                           ox + mSubSampleX);
+                             ox < oxEnd;
+                             ++ox) {
+                            const unsigned int sxMin = (unsigned int)std::max(
+                                mPaddingX - (int)(ox * mStrideX), 0);
+                            const unsigned int syMin = (unsigned int)std::max(
+                                mPaddingY - (int)(oy * mStrideY), 0);
+                            const unsigned int sxMax = Utils::clamp<int>(
+                                mChannelsWidth + mPaddingX - ox * mStrideX,
+                                0,
+                                mKernelWidth);
+                            const unsigned int syMax = Utils::clamp<int>(
+                                mChannelsHeight + mPaddingY - oy * mStrideY,
+                                0,
+                                mKernelHeight);
+
+                            const int ix = (int)(ox * mStrideX) - mPaddingX;
+                            const int iy = (int)(oy * mStrideY) - mPaddingY;
+
+                            unsigned int channelOffset = 0;
+
+                            for (unsigned int k = 0, nbInputs = mInputs.size();
+                                 k < nbInputs;
+                                 ++k) {
+                                const Tensor4d<char>& input = mInputs[k];
+                                const Tensor4d<Float_T>& synapses
+                                    = mSharedSynapses[k];
+
+                                for (unsigned int channel = 0;
+                                     channel < input.dimZ();
+                                     ++channel) {
+                                    // Zero input maps are skipped
+                                    if (!mInputsActive(channelOffset + channel,
+                                                       batchPos)
+                                        || !mMaps(output,
+                                                  channelOffset + channel))
+                                        continue;
+
+                                    for (unsigned int sy = syMin; sy < syMax;
+                                         ++sy) {
+                                        const Float_T* weights = &synapses(
+                                            0, sy, channel, output);
+                                        const char* spikes = &input(
+                                            0, iy + sy, channel, batchPos);
+
+                                        for (unsigned int sx = sxMin;
+                                             sx < sxMax;
+                                             ++sx)
+                                            weightedSum += weights[sx]
+                                                           * spikes[ix + sx];
+                                    }
+                                }
+
+                                channelOffset += input.dimZ();
+                            }
+                        }
+                    }
+
+                    Float_T& integration
+                        = mOutputsIntegration(sox, soy, output, batchPos);
+                    integration = leakFactor * integration + weightedSum;
+                }
+            }
+        }
+    }
+
+    fire(timestamp);
+    return false;
+}
+
+void N2D2::ConvCell_CSpike::saveFreeParameters(const std::string& fileName)
+    const
+{
+    std::ofstream syn(fileName.c_str(), std::fstream::binary);
+
+    if (!syn.good())
+        throw std::runtime_error("Could not create synaptic file (.SYN): "
+                                 + fileName);
+
+    for (unsigned int k = 0; k < mSharedSynapses.size(); ++k) {
+        for (Tensor4d<Float_T>::const_iterator it
+             = mSharedSynapses[k].begin();
+             it != mSharedSynapses[k].end();
+             ++it)
+            syn.write(reinterpret_cast<const char*>(&(*it)), sizeof(*it));
+    }
+
+    if (!mNoBias) {
+        for (Tensor4d<Float_T>::const_iterator it = mBias.begin();
+             it != mBias.end();
+             ++it)
+            syn.write(reinterpret_cast<const char*>(&(*it)), sizeof(*it));
+    }
+
+    if (!syn.good())
+        throw std::runtime_error("Error writing synaptic file: " + fileName);
+}
+
+void N2D2::ConvCell_CSpike::loadFreeParameters(const std::string& fileName,
+                                               bool ignoreNotExists)
+{
+    std::ifstream syn(fileName.c_str(), std::fstream::binary);
+
+    if (!syn.good()) {
+        if (ignoreNotExists) {
+            std::cout << Utils::cnotice
+                      << "Notice: Could not open synaptic file (.SYN): "
+                      << fileName << Utils::cdef << std::endl;
+            return;
+        } else
+            throw std::runtime_error("Could not open synaptic file (.SYN): "
+                                     + fileName);
+    }
+
+    for (unsigned int k = 0; k < mSharedSynapses.size(); ++k) {
+        for (Tensor4d<Float_T>::iterator it = mSharedSynapses[k].begin();
+             it != mSharedSynapses[k].end();
+             ++it)
+            syn.read(reinterpret_cast<char*>(&(*it)), sizeof(*it));
+    }
+
+    if (!mNoBias) {
+        for (Tensor4d<Float_T>::iterator it = mBias.begin();
+             it != mBias.end();
+             ++it)
+            syn.read(reinterpret_cast<char*>(&(*it)), sizeof(*it));
+    }
+
+    if (syn.eof())
+        throw std::runtime_error(
+            "End-of-file reached prematurely in synaptic file (.SYN): "
+            + fileName);
+    else if (!syn.good())
+        throw std::runtime_error("Error while reading synaptic file (.SYN): "
+                                 + fileName);
+    else if (syn.get() != std::fstream::traits_type::eof())
+        throw std::runtime_error(
+            "Synaptic file (.SYN) size larger than expected: " + fileName);
+}
+
+N2D2::ConvCell_CSpike::~ConvCell_CSpike()
+{
+    for (unsigned int k = 0, size = mSharedSynapses.size(); k < size; ++k)
+        delete &mSharedSynapses[k];
+}
@@ -49,9 +49,14 @@ N2D2::ConvCell_Frame::ConvCell_Frame(const std::string& name,
       Cell_Frame(name, nbOutputs, activation),
       // IMPORTANT: Do not change the value of the parameters here! Use
       // setParameter() or loadParameters().
+      mAlgorithm(this, "Algorithm", Auto),
       mBias(1, 1, mNbOutputs, 1),
       mDiffBias(1, 1, mNbOutputs, 1),
-      mConvDesc(subSampleX, subSampleY, strideX, strideY, paddingX, paddingY)
+      mConvDesc(subSampleX, subSampleY, strideX, strideY, paddingX, paddingY),
+      mWinogradTileSize(0),
+      mWinogradValid(false),
+      mWinogradBackwardValid(false),
+      mQuantizationBits(0)
 {
     // ctor
     mWeightsSolver = std::make_shared<SGDSolver_Frame<Float_T> >();
@@ -74,36 +79,100 @@ void N2D2::ConvCell_Frame::initialize()
             mKernelWidth, mKernelHeight, mInputs[k].dimZ(), mNbOutputs));
         mWeightsFiller->apply(mSharedSynapses.back());
     }
+
+    if (mAlgorithm == Winograd && !isWinogradEligible())
+        throw std::runtime_error("ConvCell_Frame::initialize(): Winograd "
+                                 "algorithm requires 3x3 kernels, a unit "
+                                 "stride, no subsampling, a padding <= 2 and "
+                                 "dense maps for cell " + mName);
 }
 
 void N2D2::ConvCell_Frame::propagate(bool /*inference*/)
 {
     mInputs.synchronizeDToH();
 
+    if (mQuantizationBits > 0) {
+        propagateQuantized();
+        return;
+    }
+
     const Float_T alpha = 1.0;
     Float_T beta = 0.0;
 
+    // Channel-blocked outputs are computed with the blocked kernel, which
+    // accepts inputs in any layout
+    const bool blocked = (mOutputs.channelBlock() > 1 && mSubSampleX == 1
+                          && mSubSampleY == 1);
+    const bool winograd = !blocked
+        && (mAlgorithm == Winograd
+            || (mAlgorithm == Auto && isWinogradEligible()));
+
+    if (winograd)
+        updateWinogradSynapses(false);
+
     unsigned int offset = 0;
 
     for (unsigned int k = 0, size = mInputs.size(); k < size; ++k) {
         if (k > 0)
             beta = 1.0;
 
-        ConvCell_Frame_Kernels::forward(&alpha,
-                                        mInputs[k],
-                                        mSharedSynapses[k],
-                                        mConvDesc,
-                                        &beta,
-                                        mOutputs,
-                                        mMaps.rows(offset, mInputs[k].dimZ()));
+        if (blocked)
+            ConvCell_Frame_Kernels::forwardBlocked(&alpha,
+                                                   mInputs[k],
+                                                   mSharedSynapses[k],
+                                                   mConvDesc,
+                                                   &beta,
+                                                   mOutputs,
+                                                   mMaps.rows(offset,
+                                                       mInputs[k].dimZ()));
+        else if (winograd)
+            ConvCell_Frame_Kernels::forwardWinograd(&alpha,
+                                                    mInputs[k],
+                                                    mWinogradSynapses[k],
+                                                    mWinogradTileSize,
+                                                    mConvDesc,
+                                                    &beta,
+                                                    mOutputs);
+        else if (mAlgorithm == GEMM && mOutputs.channelBlock() == 1)
+            ConvCell_Frame_Kernels::forwardGemm(&alpha,
+                                                mInputs[k],
+                                                mSharedSynapses[k],
+                                                mConvDesc,
+                                                &beta,
+                                                mOutputs,
+                                                mMaps.rows(offset,
+                                                           mInputs[k].dimZ()));
+        else
+            ConvCell_Frame_Kernels::forward(&alpha,
+                                            mInputs[k],
+                                            mSharedSynapses[k],
+                                            mConvDesc,
+                                            &beta,
+                                            mOutputs,
+                                            mMaps.rows(offset,
+                                                       mInputs[k].dimZ()));
 
         offset += mInputs[k].dimZ();
     }
 
-    if (!mNoBias)
-        ConvCell_Frame_Kernels::forwardBias(mBias, mOutputs);
+    const std::shared_ptr<RectifierActivation_Frame<Float_T> > rectifier
+        = std::dynamic_pointer_cast
+        <RectifierActivation_Frame<Float_T> >(mActivation);
+
+    if (rectifier) {
+        // The activation is applied in the same pass as the bias
+        ConvCell_Frame_Kernels::forwardBiasRectifier(
+            (!mNoBias) ? &mBias : NULL,
+            rectifier->getParameter<double>("LeakSlope"),
+            rectifier->getParameter<double>("Clipping"),
+            mOutputs);
+    } else {
+        if (!mNoBias)
+            ConvCell_Frame_Kernels::forwardBias(mBias, mOutputs);
+
+        Cell_Frame::propagate();
+    }
 
-    Cell_Frame::propagate();
     mDiffInputs.clearValid();
 }
 
@@ -114,17 +183,43 @@ void N2D2::ConvCell_Frame::backPropagate()
     const Float_T alpha = 1.0;
     const Float_T beta = 0.0;
 
+    // There is no Winograd kernel for the weights gradient, the lowered
+    // convolution is used instead
+    const bool winograd = (mAlgorithm == Winograd
+                           || (mAlgorithm == Auto && isWinogradEligible()));
+    const bool subSample = (mSubSampleX > 1 || mSubSampleY > 1);
+    const bool blocked = (mDiffInputs.channelBlock() > 1);
+
     unsigned int offset = 0;
 
     for (unsigned int k = 0, size = mInputs.size(); k < size; ++k) {
-        ConvCell_Frame_Kernels::backwardFilter(&alpha,
-                                               mInputs[k],
-                                               mDiffInputs,
-                                               mConvDesc,
-                                               &beta,
-                                               mDiffSharedSynapses[k],
-                                               mMaps.rows(offset,
-                                                          mInputs[k].dimZ()));
+        if (blocked && !subSample)
+            ConvCell_Frame_Kernels::backwardFilterBlocked(
+                &alpha,
+                mInputs[k],
+                mDiffInputs,
+                mConvDesc,
+                &beta,
+                mDiffSharedSynapses[k],
+                mMaps.rows(offset, mInputs[k].dimZ()));
+        else if ((winograd || mAlgorithm == GEMM) && !blocked)
+            ConvCell_Frame_Kernels::backwardFilterGemm(&alpha,
+                                                       mInputs[k],
+                                                       mDiffInputs,
+                                                       mConvDesc,
+                                                       &beta,
+                                                       mDiffSharedSynapses[k],
+                                                       mMaps.rows(offset,
+                                                       mInputs[k].dimZ()));
+        else
+            ConvCell_Frame_Kernels::backwardFilter(&alpha,
+                                                   mInputs[k],
+                                                   mDiffInputs,
+                                                   mConvDesc,
+                                                   &beta,
+                                                   mDiffSharedSynapses[k],
+                                                   mMaps.rows(offset,
+                                                   mInputs[k].dimZ()));
 
         offset += mInputs[k].dimZ();
     }
@@ -133,19 +228,51 @@ void N2D2::ConvCell_Frame::backPropagate()
         ConvCell_Frame_Kernels::backwardBias(mDiffInputs, mDiffBias);
 
     if (!mDiffOutputs.empty() && mBackPropagate) {
+        if (winograd)
+            updateWinogradSynapses(true);
+
         offset = 0;
 
         for (unsigned int k = 0, size = mInputs.size(); k < size; ++k) {
             const Float_T beta = (mDiffOutputs[k].isValid()) ? 1.0 : 0.0;
 
-            ConvCell_Frame_Kernels::backwardData(&alpha,
-                                                 mSharedSynapses[k],
-                                                 mDiffInputs,
-                                                 mConvDesc,
-                                                 &beta,
-                                                 mDiffOutputs[k],
-                                                 mMaps.rows(offset,
-                                                            mInputs[k].dimZ()));
+            if (mDiffOutputs[k].channelBlock() > 1 && !subSample)
+                ConvCell_Frame_Kernels::backwardDataBlocked(&alpha,
+                                                            mSharedSynapses[k],
+                                                            mDiffInputs,
+                                                            mConvDesc,
+                                                            &beta,
+                                                            mDiffOutputs[k],
+                                                            mMaps.rows(offset,
+                                                        mInputs[k].dimZ()));
+            else if (winograd)
+                ConvCell_Frame_Kernels::backwardDataWinograd(
+                    &alpha,
+                    mWinogradBackwardSynapses[k],
+                    mWinogradTileSize,
+                    mDiffInputs,
+                    mConvDesc,
+                    &beta,
+                    mDiffOutputs[k]);
+            else if (mAlgorithm == GEMM && !blocked
+                     && mDiffOutputs[k].channelBlock() == 1)
+                ConvCell_Frame_Kernels::backwardDataGemm(&alpha,
+                                                         mSharedSynapses[k],
+                                                         mDiffInputs,
+                                                         mConvDesc,
+                                                         &beta,
+                                                         mDiffOutputs[k],
+                                                         mMaps.rows(offset,
+                                                         mInputs[k].dimZ()));
+            else
+                ConvCell_Frame_Kernels::backwardData(&alpha,
+                                                     mSharedSynapses[k],
+                                                     mDiffInputs,
+                                                     mConvDesc,
+                                                     &beta,
+                                                     mDiffOutputs[k],
+                                                     mMaps.rows(offset,
+                                                     mInputs[k].dimZ()));
 
             offset += mInputs[k].dimZ();
             mDiffOutputs[k].setValid();
@@ -163,6 +290,120 @@ void N2D2::ConvCell_Frame::update()
 
     if (!mNoBias)
         mBiasSolver->update(&mBias, &mDiffBias, mInputs.dimB());
+
+    mWinogradValid = false;
+}
+
+void N2D2::ConvCell_Frame::setQuantization(unsigned int nbBits,
+                                           const Quantization::Signals& inputs,
+                                           const Quantization::Signals& outputs)
+{
+    for (unsigned int k = 0, size = mQuantizedSynapses.size(); k < size; ++k)
+        delete &mQuantizedSynapses[k];
+
+    mQuantizedSynapses.clear();
+    mSynapsesScales.clear();
+    mQuantizedBias.clear();
+    mQuantizationBits = 0;
+
+    if (nbBits == 0)
+        return;
+
+    if (nbBits < 2 || nbBits > 8)
+        throw std::domain_error("ConvCell_Frame::setQuantization(): the "
+                                "integer inference is limited to 2 to 8 bits "
+                                "for cell " + mName);
+
+    if (mSubSampleX > 1 || mSubSampleY > 1)
+        throw std::runtime_error("ConvCell_Frame::setQuantization(): the "
+                                 "integer inference does not support "
+                                 "subsampling for cell " + mName);
+
+    if (mOutputs.channelBlock() > 1)
+        throw std::runtime_error("ConvCell_Frame::setQuantization(): the "
+                                 "integer inference requires plain layout "
+                                 "outputs for cell " + mName);
+
+    if (!(inputs.scale > 0.0) || !(outputs.scale > 0.0))
+        throw std::domain_error("ConvCell_Frame::setQuantization(): "
+                                "the signals scales must be > 0 for cell "
+                                + mName);
+
+    mSynapsesScales = Quantization::weightsScales(mSharedSynapses, nbBits);
+
+    for (unsigned int k = 0, size = mSharedSynapses.size(); k < size; ++k) {
+        mQuantizedSynapses.push_back(new Tensor4d<signed char>());
+        Quantization::quantizeWeights(mSharedSynapses[k],
+                                      mSynapsesScales,
+                                      nbBits,
+                                      mQuantizedSynapses.back());
+    }
+
+    if (!mNoBias) {
+        mQuantizedBias.resize(mNbOutputs);
+
+        for (unsigned int output = 0; output < mNbOutputs; ++output) {
+            mQuantizedBias[output] = (int)Utils::round(
+                mBias(output) / (inputs.scale * mSynapsesScales[output]));
+        }
+    }
+
+    mAccumulators.resize(mOutputs.dimX(),
+                         mOutputs.dimY(),
+                         mOutputs.dimZ(),
+                         mOutputs.dimB());
+
+    mQuantizationBits = nbBits;
+    mQuantizedInputs = inputs;
+    mQuantizedOutputs = outputs;
+}
+
+void N2D2::ConvCell_Frame::propagateQuantized()
+{
+    unsigned int offset = 0;
+
+    for (unsigned int k = 0, size = mInputs.size(); k < size; ++k) {
+        if (mInputs[k].channelBlock() > 1)
+            throw std::runtime_error("ConvCell_Frame::propagateQuantized(): "
+                                     "the integer inference requires plain "
+                                     "layout inputs for cell " + mName);
+
+        Quantization::quantizeSignals(mInputs[k],
+                                      mQuantizedInputs,
+                                      mQuantizationBits,
+                                      mQuantizedInputsData);
+        ConvCell_Frame_Kernels::forwardQuantized(mQuantizedInputsData,
+                                                 mQuantizedSynapses[k],
+                                                 mConvDesc,
+                                                 (k > 0),
+                                                 mAccumulators,
+                                                 mMaps.rows(offset,
+                                                     mInputs[k].dimZ()));
+
+        offset += mInputs[k].dimZ();
+    }
+
+    Quantization::dequantize(mAccumulators,
+                             mQuantizedBias,
+                             mQuantizedInputs.scale,
+                             mSynapsesScales,
+                             mOutputs);
+
+    const std::shared_ptr<RectifierActivation_Frame<Float_T> > rectifier
+        = std::dynamic_pointer_cast
+        <RectifierActivation_Frame<Float_T> >(mActivation);
+
+    if (rectifier) {
+        ConvCell_Frame_Kernels::forwardBiasRectifier(
+            NULL,
+            rectifier->getParameter<double>("LeakSlope"),
+            rectifier->getParameter<double>("Clipping"),
+            mOutputs);
+    } else
+        Cell_Frame::propagate();
+
+    Quantization::requantize(mOutputs, mQuantizedOutputs, mQuantizationBits);
+    mDiffInputs.clearValid();
 }
 
 void N2D2::ConvCell_Frame::checkGradient(double epsilon, double maxError)
@@ -171,7 +412,7 @@ void N2D2::ConvCell_Frame::checkGradient(double epsilon, double maxError)
     gc.initialize(mInputs,
                   mOutputs,
                   mDiffInputs,
-                  std::bind(&ConvCell_Frame::propagate, this, false),
+                  std::bind(&ConvCell_Frame::propagateUncached, this, false),
                   std::bind(&ConvCell_Frame::backPropagate, this));
 
     for (unsigned int k = 0, size = mSharedSynapses.size(); k < size; ++k) {
@@ -207,7 +448,7 @@ void N2D2::ConvCell_Frame::saveFreeParameters(const std::string& fileName) const
                                  + fileName);
 
     for (unsigned int k = 0; k < mSharedSynapses.size(); ++k) {
-        for (std::vector<Float_T>::const_iterator it
+        for (Tensor4d<Float_T>::const_iterator it
              = mSharedSynapses[k].begin();
              it != mSharedSynapses[k].end();
              ++it)
@@ -215,7 +456,7 @@ void N2D2::ConvCell_Frame::saveFreeParameters(const std::string& fileName) const
     }
 
     if (!mNoBias) {
-        for (std::vector<Float_T>::const_iterator it = mBias.begin();
+        for (Tensor4d<Float_T>::const_iterator it = mBias.begin();
              it != mBias.end();
              ++it)
             syn.write(reinterpret_cast<const char*>(&(*it)), sizeof(*it));
@@ -242,14 +483,14 @@ void N2D2::ConvCell_Frame::loadFreeParameters(const std::string& fileName,
     }
 
     for (unsigned int k = 0; k < mSharedSynapses.size(); ++k) {
-        for (std::vector<Float_T>::iterator it = mSharedSynapses[k].begin();
+        for (Tensor4d<Float_T>::iterator it = mSharedSynapses[k].begin();
              it != mSharedSynapses[k].end();
              ++it)
             syn.read(reinterpret_cast<char*>(&(*it)), sizeof(*it));
     }
 
     if (!mNoBias) {
-        for (std::vector<Float_T>::iterator it = mBias.begin();
+        for (Tensor4d<Float_T>::iterator it = mBias.begin();
              it != mBias.end();
              ++it)
             syn.read(reinterpret_cast<char*>(&(*it)), sizeof(*it));
@@ -265,10 +506,77 @@ void N2D2::ConvCell_Frame::loadFreeParameters(const std::string& fileName,
     else if (syn.get() != std::fstream::traits_type::eof())
         throw std::runtime_error(
             "Synaptic file (.SYN) size larger than expected: " + fileName);
+
+    mWinogradValid = false;
+}
+
+bool N2D2::ConvCell_Frame::isWinogradEligible() const
+{
+    if (mKernelWidth != 3 || mKernelHeight != 3 || mStrideX != 1
+        || mStrideY != 1 || mSubSampleX != 1 || mSubSampleY != 1
+        || mPaddingX < 0 || mPaddingX > 2 || mPaddingY < 0 || mPaddingY > 2)
+        return false;
+
+    for (unsigned int output = 0; output < mMaps.dimX(); ++output) {
+        for (unsigned int channel = 0; channel < mMaps.dimY(); ++channel) {
+            if (!mMaps(output, channel))
+                return false;
+        }
+    }
+
+    return true;
+}
+
+void N2D2::ConvCell_Frame::propagateUncached(bool inference)
+{
+    // The weights may have been modified in place since the last transform
+    mWinogradValid = false;
+    propagate(inference);
+}
+
+void N2D2::ConvCell_Frame::updateWinogradSynapses(bool backward)
+{
+    if (!mWinogradValid) {
+        // F(4x4, 3x3) needs less multiplications per output than F(2x2, 3x3),
+        // but wastes more of them on the borders of small maps
+        const unsigned int cost2 = 16 * ((mOutputsWidth + 1) / 2)
+                                   * ((mOutputsHeight + 1) / 2);
+        const unsigned int cost4 = 36 * ((mOutputsWidth + 3) / 4)
+                                   * ((mOutputsHeight + 3) / 4);
+
+        mWinogradTileSize = (cost4 < cost2) ? 4 : 2;
+        mWinogradSynapses.resize(mSharedSynapses.size());
+
+        for (unsigned int k = 0, size = mSharedSynapses.size(); k < size; ++k)
+            ConvCell_Frame_Kernels::winogradFilterTransform(
+                mSharedSynapses[k],
+                mWinogradTileSize,
+                false,
+                mWinogradSynapses[k]);
+
+        mWinogradValid = true;
+        mWinogradBackwardValid = false;
+    }
+
+    if (backward && !mWinogradBackwardValid) {
+        mWinogradBackwardSynapses.resize(mSharedSynapses.size());
+
+        for (unsigned int k = 0, size = mSharedSynapses.size(); k < size; ++k)
+            ConvCell_Frame_Kernels::winogradFilterTransform(
+                mSharedSynapses[k],
+                mWinogradTileSize,
+                true,
+                mWinogradBackwardSynapses[k]);
+
+        mWinogradBackwardValid = true;
+    }
 }
 
 N2D2::ConvCell_Frame::~ConvCell_Frame()
 {
     for (unsigned int k = 0, size = mSharedSynapses.size(); k < size; ++k)
         delete &mSharedSynapses[k];
+
+    for (unsigned int k = 0, size = mQuantizedSynapses.size(); k < size; ++k)
+        delete &mQuantizedSynapses[k];
 }
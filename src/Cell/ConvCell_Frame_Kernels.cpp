@@ -19,6 +19,7 @@
 */
 
 #include "Cell/ConvCell_Frame_Kernels.hpp"
+#include "utils/Gemm.hpp"
 
 void N2D2::ConvCell_Frame_Kernels::forward(const Float_T* alpha,
                                            const Tensor4d<Float_T>& inputs,
@@ -153,6 +154,40 @@ void N2D2::ConvCell_Frame_Kernels::forwardBias(const Tensor4d<Float_T>& bias,
     }
 }
 
+void N2D2::ConvCell_Frame_Kernels::forwardBiasRectifier(const Tensor4d
+                                                        <Float_T>* bias,
+                                                        Float_T leakSlope,
+                                                        Float_T clipping,
+                                                        Tensor4d
+                                                        <Float_T>& outputs)
+{
+    const unsigned int size = outputs.dimB() * outputs.dimZ();
+
+#if defined(_OPENMP) && _OPENMP >= 200805
+#pragma omp parallel for collapse(2) if (size > 16)
+#else
+#pragma omp parallel for if (outputs.dimB() > 4 && size > 16)
+#endif
+    for (int batchPos = 0; batchPos < (int)outputs.dimB(); ++batchPos) {
+        for (unsigned int output = 0; output < outputs.dimZ(); ++output) {
+            const Float_T biasValue = (bias != NULL) ? (*bias)(output) : 0.0;
+
+            for (unsigned int oy = 0; oy < outputs.dimY(); ++oy) {
+                for (unsigned int ox = 0; ox < outputs.dimX(); ++ox) {
+                    const Float_T value = outputs(ox, oy, output, batchPos)
+                                          + biasValue;
+
+                    outputs(ox, oy, output, batchPos)
+                        = (value > 0)
+                            ? ((clipping > 0) ? std::min(value, clipping)
+                                              : value)
+                            : leakSlope * value;
+                }
+            }
+        }
+    }
+}
+
 void N2D2::ConvCell_Frame_Kernels::backwardData(const Float_T* alpha,
                                                 const Tensor4d
                                                 <Float_T>& sharedSynapses,
@@ -338,3 +373,1252 @@ void N2D2::ConvCell_Frame_Kernels::backwardBias(const Tensor4d
         diffBias(output) = sum;
     }
 }
+
+/**
+ * Return a pointer to the synaptic kernels, as a row-major
+ * (nbOutputs) x (kernelWidth * kernelHeight * nbChannels) matrix.
+ * If some (output, channel) pairs are not connected in @p maps, the kernels are
+ * copied in @p buffer, with the unconnected kernels set to 0.
+*/
+static const N2D2::Float_T*
+maskedSynapses(const N2D2::Tensor4d<N2D2::Float_T>& sharedSynapses,
+               const N2D2::Tensor2d<bool>& maps,
+               N2D2::PoolVector<N2D2::Float_T>::type& buffer)
+{
+    const unsigned int kernelSize = sharedSynapses.dimX()
+                                    * sharedSynapses.dimY();
+    bool dense = true;
+
+    for (unsigned int output = 0; output < maps.dimX() && dense; ++output) {
+        for (unsigned int channel = 0; channel < maps.dimY(); ++channel) {
+            if (!maps(output, channel)) {
+                dense = false;
+                break;
+            }
+        }
+    }
+
+    if (dense)
+        return &sharedSynapses(0);
+
+    buffer.assign(sharedSynapses.begin(), sharedSynapses.end());
+
+    for (unsigned int output = 0; output < sharedSynapses.dimB(); ++output) {
+        for (unsigned int channel = 0; channel < sharedSynapses.dimZ();
+             ++channel) {
+            if (!maps(output, channel)) {
+                N2D2::PoolVector<N2D2::Float_T>::type::iterator it
+                    = buffer.begin()
+                      + (channel + output * sharedSynapses.dimZ()) * kernelSize;
+                std::fill(it, it + kernelSize, 0.0);
+            }
+        }
+    }
+
+    return &buffer[0];
+}
+
+void N2D2::ConvCell_Frame_Kernels::im2col(const Tensor4d<Float_T>& inputs,
+                                          unsigned int batchPos,
+                                          unsigned int kernelWidth,
+                                          unsigned int kernelHeight,
+                                          const Descriptor& desc,
+                                          unsigned int oxSize,
+                                          unsigned int oySize,
+                                          Float_T* col)
+{
+    const unsigned int nbRows = kernelWidth * kernelHeight * inputs.dimZ();
+    const unsigned int outputSize = oxSize * oySize;
+    const unsigned int inputStride = inputs.pixelStride();
+    const Float_T* input = &inputs(0);
+
+#pragma omp parallel for if (nbRows > 16 && outputSize > 64)
+    for (int row = 0; row < (int)nbRows; ++row) {
+        const unsigned int sx = row % kernelWidth;
+        const unsigned int sy = (row / kernelWidth) % kernelHeight;
+        const unsigned int channel = row / (kernelWidth * kernelHeight);
+        const Float_T* inputMap = input
+                                  + inputs.channelOffset(channel, batchPos);
+        Float_T* colRow = col + row * outputSize;
+
+        for (unsigned int oy = 0; oy < oySize; ++oy) {
+            const int iy = (int)(oy * desc.strideY + sy) - desc.paddingY;
+            Float_T* colLine = colRow + oy * oxSize;
+
+            if (iy < 0 || iy >= (int)inputs.dimY()) {
+                std::fill(colLine, colLine + oxSize, 0.0);
+                continue;
+            }
+
+            const Float_T* inputLine = inputMap
+                                       + iy * inputs.dimX() * inputStride;
+
+            for (unsigned int ox = 0; ox < oxSize; ++ox) {
+                const int ix = (int)(ox * desc.strideX + sx) - desc.paddingX;
+
+                colLine[ox] = (ix >= 0 && ix < (int)inputs.dimX())
+                                  ? inputLine[ix * inputStride]
+                                  : 0.0;
+            }
+        }
+    }
+}
+
+void N2D2::ConvCell_Frame_Kernels::col2im(const Float_T* col,
+                                          unsigned int kernelWidth,
+                                          unsigned int kernelHeight,
+                                          const Descriptor& desc,
+                                          unsigned int oxSize,
+                                          unsigned int oySize,
+                                          unsigned int batchPos,
+                                          Tensor4d<Float_T>& outputs)
+{
+    const unsigned int outputSize = oxSize * oySize;
+    Float_T* output = &outputs(0, batchPos);
+
+    // Each channel accumulates only its own rows: no write conflict
+#pragma omp parallel for if (outputs.dimZ() > 4 && outputSize > 64)
+    for (int channel = 0; channel < (int)outputs.dimZ(); ++channel) {
+        Float_T* outputMap = output + channel * outputs.dimX()
+                                          * outputs.dimY();
+
+        for (unsigned int sy = 0; sy < kernelHeight; ++sy) {
+            for (unsigned int sx = 0; sx < kernelWidth; ++sx) {
+                const unsigned int row
+                    = sx + kernelWidth * (sy + kernelHeight * channel);
+                const Float_T* colRow = col + row * outputSize;
+
+                for (unsigned int oy = 0; oy < oySize; ++oy) {
+                    const int iy = (int)(oy * desc.strideY + sy)
+                                   - desc.paddingY;
+
+                    if (iy < 0 || iy >= (int)outputs.dimY())
+                        continue;
+
+                    const Float_T* colLine = colRow + oy * oxSize;
+                    Float_T* outputLine = outputMap + iy * outputs.dimX();
+
+                    for (unsigned int ox = 0; ox < oxSize; ++ox) {
+                        const int ix = (int)(ox * desc.strideX + sx)
+                                       - desc.paddingX;
+
+                        if (ix >= 0 && ix < (int)outputs.dimX())
+                            outputLine[ix] += colLine[ox];
+                    }
+                }
+            }
+        }
+    }
+}
+
+void N2D2::ConvCell_Frame_Kernels::forwardGemm(const Float_T* alpha,
+                                               const Tensor4d<Float_T>& inputs,
+                                               const Tensor4d
+                                               <Float_T>& sharedSynapses,
+                                               const Descriptor& desc,
+                                               const Float_T* beta,
+                                               Tensor4d<Float_T>& outputs,
+                                               const Tensor2d<bool>& maps)
+{
+    const unsigned int oxSize
+        = (unsigned int)((inputs.dimX() + 2 * desc.paddingX
+                          - sharedSynapses.dimX() + desc.strideX)
+                         / (double)desc.strideX);
+    const unsigned int oySize
+        = (unsigned int)((inputs.dimY() + 2 * desc.paddingY
+                          - sharedSynapses.dimY() + desc.strideY)
+                         / (double)desc.strideY);
+    const bool subSample = (desc.subSampleX > 1 || desc.subSampleY > 1);
+
+    const unsigned int kernelSize = sharedSynapses.dimX()
+                                    * sharedSynapses.dimY() * inputs.dimZ();
+    const unsigned int outputSize = oxSize * oySize;
+
+    if (subSample) {
+        for (unsigned int index = 0; index < outputs.size(); ++index)
+            outputs(index) *= (*beta);
+    }
+
+    PoolVector<Float_T>::type maskedBuffer;
+    const Float_T* weights = maskedSynapses(sharedSynapses, maps, maskedBuffer);
+
+    PoolVector<Float_T>::type col(kernelSize * outputSize);
+    PoolVector<Float_T>::type result((subSample)
+                                     ? outputs.dimZ() * outputSize : 0);
+
+    for (unsigned int batchPos = 0; batchPos < inputs.dimB(); ++batchPos) {
+        im2col(inputs,
+               batchPos,
+               sharedSynapses.dimX(),
+               sharedSynapses.dimY(),
+               desc,
+               oxSize,
+               oySize,
+               &col[0]);
+
+        if (!subSample) {
+            Gemm::sgemm(Gemm::NoTrans,
+                        Gemm::NoTrans,
+                        outputs.dimZ(),
+                        outputSize,
+                        kernelSize,
+                        (*alpha),
+                        weights,
+                        kernelSize,
+                        &col[0],
+                        outputSize,
+                        (*beta),
+                        &outputs(0, batchPos),
+                        outputSize);
+        } else {
+            Gemm::sgemm(Gemm::NoTrans,
+                        Gemm::NoTrans,
+                        outputs.dimZ(),
+                        outputSize,
+                        kernelSize,
+                        (*alpha),
+                        weights,
+                        kernelSize,
+                        &col[0],
+                        outputSize,
+                        0.0,
+                        &result[0],
+                        outputSize);
+
+            for (unsigned int output = 0; output < outputs.dimZ(); ++output) {
+                for (unsigned int oy = 0; oy < oySize; ++oy) {
+                    for (unsigned int ox = 0; ox < oxSize; ++ox)
+                        outputs(ox / desc.subSampleX,
+                                oy / desc.subSampleY,
+                                output,
+                                batchPos)
+                            += result[ox + oxSize * (oy + oySize * output)];
+                }
+            }
+        }
+    }
+}
+
+void N2D2::ConvCell_Frame_Kernels::backwardDataGemm(const Float_T* alpha,
+                                                    const Tensor4d
+                                                    <Float_T>& sharedSynapses,
+                                                    const Tensor4d
+                                                    <Float_T>& diffInputs,
+                                                    const Descriptor& desc,
+                                                    const Float_T* beta,
+                                                    Tensor4d
+                                                    <Float_T>& diffOutputs,
+                                                    const Tensor2d<bool>& maps)
+{
+    const unsigned int oxSize
+        = (unsigned int)((diffOutputs.dimX() + 2 * desc.paddingX
+                          - sharedSynapses.dimX() + desc.strideX)
+                         / (double)desc.strideX);
+    const unsigned int oySize
+        = (unsigned int)((diffOutputs.dimY() + 2 * desc.paddingY
+                          - sharedSynapses.dimY() + desc.strideY)
+                         / (double)desc.strideY);
+    const bool subSample = (desc.subSampleX > 1 || desc.subSampleY > 1);
+
+    const unsigned int kernelSize = sharedSynapses.dimX()
+                                    * sharedSynapses.dimY()
+                                    * diffOutputs.dimZ();
+    const unsigned int outputSize = oxSize * oySize;
+    const unsigned int inputSize = diffOutputs.dimX() * diffOutputs.dimY()
+                                   * diffOutputs.dimZ();
+
+    PoolVector<Float_T>::type maskedBuffer;
+    const Float_T* weights = maskedSynapses(sharedSynapses, maps, maskedBuffer);
+
+    PoolVector<Float_T>::type col(kernelSize * outputSize);
+    PoolVector<Float_T>::type diffInput((subSample)
+                                        ? diffInputs.dimZ() * outputSize : 0);
+
+    for (unsigned int batchPos = 0; batchPos < diffOutputs.dimB();
+         ++batchPos) {
+        const Float_T* gradient = &diffInputs(0, batchPos);
+
+        if (subSample) {
+            // Up-sample the gradient to the convolution output size
+            for (unsigned int output = 0; output < diffInputs.dimZ();
+                 ++output) {
+                for (unsigned int oy = 0; oy < oySize; ++oy) {
+                    for (unsigned int ox = 0; ox < oxSize; ++ox)
+                        diffInput[ox + oxSize * (oy + oySize * output)]
+                            = diffInputs(ox / desc.subSampleX,
+                                         oy / desc.subSampleY,
+                                         output,
+                                         batchPos);
+                }
+            }
+
+            gradient = &diffInput[0];
+        }
+
+        Gemm::sgemm(Gemm::Trans,
+                    Gemm::NoTrans,
+                    kernelSize,
+                    outputSize,
+                    diffInputs.dimZ(),
+                    (*alpha),
+                    weights,
+                    kernelSize,
+                    gradient,
+                    outputSize,
+                    0.0,
+                    &col[0],
+                    outputSize);
+
+        Float_T* diffOutput = &diffOutputs(0, batchPos);
+
+        if ((*beta) == 0.0)
+            std::fill(diffOutput, diffOutput + inputSize, 0.0);
+        else {
+            for (unsigned int index = 0; index < inputSize; ++index)
+                diffOutput[index] *= (*beta);
+        }
+
+        col2im(&col[0],
+               sharedSynapses.dimX(),
+               sharedSynapses.dimY(),
+               desc,
+               oxSize,
+               oySize,
+               batchPos,
+               diffOutputs);
+    }
+}
+
+void N2D2::ConvCell_Frame_Kernels::backwardFilterGemm(const Float_T* alpha,
+                                                      const Tensor4d
+                                                      <Float_T>& inputs,
+                                                      const Tensor4d
+                                                      <Float_T>& diffInputs,
+                                                      const Descriptor& desc,
+                                                      const Float_T* beta,
+                                                      Tensor4d
+                                                      <Float_T>& diffSharedSynapses,
+                                                      const Tensor2d
+                                                      <bool>& maps)
+{
+    const unsigned int oxSize
+        = (unsigned int)((inputs.dimX() + 2 * desc.paddingX
+                          - diffSharedSynapses.dimX() + desc.strideX)
+                         / (double)desc.strideX);
+    const unsigned int oySize
+        = (unsigned int)((inputs.dimY() + 2 * desc.paddingY
+                          - diffSharedSynapses.dimY() + desc.strideY)
+                         / (double)desc.strideY);
+    const bool subSample = (desc.subSampleX > 1 || desc.subSampleY > 1);
+
+    const unsigned int kernelSize2d = diffSharedSynapses.dimX()
+                                      * diffSharedSynapses.dimY();
+    const unsigned int kernelSize = kernelSize2d * inputs.dimZ();
+    const unsigned int outputSize = oxSize * oySize;
+
+    PoolVector<Float_T>::type col(kernelSize * outputSize);
+    PoolVector<Float_T>::type diffInput((subSample)
+                                        ? diffInputs.dimZ() * outputSize : 0);
+    PoolVector<Float_T>::type gradient(diffInputs.dimZ() * kernelSize, 0.0);
+
+    for (unsigned int batchPos = 0; batchPos < inputs.dimB(); ++batchPos) {
+        im2col(inputs,
+               batchPos,
+               diffSharedSynapses.dimX(),
+               diffSharedSynapses.dimY(),
+               desc,
+               oxSize,
+               oySize,
+               &col[0]);
+
+        const Float_T* diffOutput = &diffInputs(0, batchPos);
+
+        if (subSample) {
+            for (unsigned int output = 0; output < diffInputs.dimZ();
+                 ++output) {
+                for (unsigned int oy = 0; oy < oySize; ++oy) {
+                    for (unsigned int ox = 0; ox < oxSize; ++ox)
+                        diffInput[ox + oxSize * (oy + oySize * output)]
+                            = diffInputs(ox / desc.subSampleX,
+                                         oy / desc.subSampleY,
+                                         output,
+                                         batchPos);
+                }
+            }
+
+            diffOutput = &diffInput[0];
+        }
+
+        Gemm::sgemm(Gemm::NoTrans,
+                    Gemm::Trans,
+                    diffInputs.dimZ(),
+                    kernelSize,
+                    outputSize,
+                    1.0,
+                    diffOutput,
+                    outputSize,
+                    &col[0],
+                    outputSize,
+                    (batchPos > 0) ? 1.0 : 0.0,
+                    &gradient[0],
+                    kernelSize);
+    }
+
+    // Unconnected kernels are left untouched, as in backwardFilter()
+#pragma omp parallel for if (diffInputs.dimZ() > 16)
+    for (int output = 0; output < (int)diffInputs.dimZ(); ++output) {
+        for (unsigned int channel = 0; channel < inputs.dimZ(); ++channel) {
+            if (!maps.empty() && !maps(output, channel))
+                continue;
+
+            const unsigned int offset = kernelSize2d
+                                        * (channel + inputs.dimZ() * output);
+
+            for (unsigned int index = offset; index < offset + kernelSize2d;
+                 ++index)
+                diffSharedSynapses(index) = (*alpha) * gradient[index]
+                                            + (*beta)
+                                              * diffSharedSynapses(index);
+        }
+    }
+}
+
+namespace {
+// Winograd F(2x2, 3x3) transform matrices
+const N2D2::Float_T winogradBT2[4 * 4] = {
+    1.0,  0.0, -1.0,  0.0,
+    0.0,  1.0,  1.0,  0.0,
+    0.0, -1.0,  1.0,  0.0,
+    0.0,  1.0,  0.0, -1.0
+};
+const N2D2::Float_T winogradG2[4 * 3] = {
+    1.0,  0.0, 0.0,
+    0.5,  0.5, 0.5,
+    0.5, -0.5, 0.5,
+    0.0,  0.0, 1.0
+};
+const N2D2::Float_T winogradAT2[2 * 4] = {
+    1.0, 1.0,  1.0,  0.0,
+    0.0, 1.0, -1.0, -1.0
+};
+
+// Winograd F(4x4, 3x3) transform matrices
+const N2D2::Float_T winogradBT4[6 * 6] = {
+    4.0,  0.0, -5.0,  0.0, 1.0, 0.0,
+    0.0, -4.0, -4.0,  1.0, 1.0, 0.0,
+    0.0,  4.0, -4.0, -1.0, 1.0, 0.0,
+    0.0, -2.0, -1.0,  2.0, 1.0, 0.0,
+    0.0,  2.0, -1.0, -2.0, 1.0, 0.0,
+    0.0,  4.0,  0.0, -5.0, 0.0, 1.0
+};
+const N2D2::Float_T winogradG4[6 * 3] = {
+    1.0 / 4.0,         0.0,        0.0,
+    -1.0 / 6.0, -1.0 / 6.0, -1.0 / 6.0,
+    -1.0 / 6.0,  1.0 / 6.0, -1.0 / 6.0,
+    1.0 / 24.0, 1.0 / 12.0,  1.0 / 6.0,
+    1.0 / 24.0, -1.0 / 12.0, 1.0 / 6.0,
+    0.0,               0.0,        1.0
+};
+const N2D2::Float_T winogradAT4[4 * 6] = {
+    1.0, 1.0,  1.0, 1.0,  1.0, 0.0,
+    0.0, 1.0, -1.0, 2.0, -2.0, 0.0,
+    0.0, 1.0,  1.0, 4.0,  4.0, 0.0,
+    0.0, 1.0, -1.0, 8.0, -8.0, 1.0
+};
+}
+
+/**
+ * Computes Y = L.X.L^T, with L a (rows x cols) matrix and X a (cols x cols)
+ * matrix. All the matrices are row-major.
+*/
+template <unsigned int rows, unsigned int cols>
+static void winogradTransform(const N2D2::Float_T* L,
+                              const N2D2::Float_T* X,
+                              N2D2::Float_T* Y)
+{
+    N2D2::Float_T tmp[rows * cols];
+
+    // tmp = L.X (rows x cols)
+    for (unsigned int i = 0; i < rows; ++i) {
+        for (unsigned int j = 0; j < cols; ++j) {
+            N2D2::Float_T value = 0.0;
+
+            for (unsigned int k = 0; k < cols; ++k)
+                value += L[i * cols + k] * X[k * cols + j];
+
+            tmp[i * cols + j] = value;
+        }
+    }
+
+    // Y = tmp.L^T (rows x rows)
+    for (unsigned int i = 0; i < rows; ++i) {
+        for (unsigned int j = 0; j < rows; ++j) {
+            N2D2::Float_T value = 0.0;
+
+            for (unsigned int k = 0; k < cols; ++k)
+                value += tmp[i * cols + k] * L[j * cols + k];
+
+            Y[i * rows + j] = value;
+        }
+    }
+}
+
+void N2D2::ConvCell_Frame_Kernels::winogradFilterTransform(const Tensor4d
+                                                           <Float_T>&
+                                                               sharedSynapses,
+                                                           unsigned int
+                                                               tileSize,
+                                                           bool backward,
+                                                           std::vector
+                                                           <Float_T>&
+                                                               transformed)
+{
+    if (sharedSynapses.dimX() != 3 || sharedSynapses.dimY() != 3)
+        throw std::runtime_error("ConvCell_Frame_Kernels::"
+                                 "winogradFilterTransform(): only 3x3 kernels "
+                                 "are supported");
+
+    if (tileSize != 2 && tileSize != 4)
+        throw std::runtime_error("ConvCell_Frame_Kernels::"
+                                 "winogradFilterTransform(): tile size must be "
+                                 "2 or 4");
+
+    const Float_T* G = (tileSize == 4) ? winogradG4 : winogradG2;
+    const unsigned int tileDim = tileSize + 2;
+    const unsigned int tileArea = tileDim * tileDim;
+
+    // For the backward data pass, the kernels are flipped and the inputs and
+    // outputs are swapped.
+    const unsigned int nbOutputs = (backward) ? sharedSynapses.dimZ()
+                                              : sharedSynapses.dimB();
+    const unsigned int nbChannels = (backward) ? sharedSynapses.dimB()
+                                               : sharedSynapses.dimZ();
+
+    transformed.resize(tileArea * nbOutputs * nbChannels);
+
+#pragma omp parallel for if (nbOutputs > 16)
+    for (int output = 0; output < (int)nbOutputs; ++output) {
+        for (unsigned int channel = 0; channel < nbChannels; ++channel) {
+            Float_T kernel[3 * 3];
+            Float_T U[6 * 6];
+
+            for (unsigned int sy = 0; sy < 3; ++sy) {
+                for (unsigned int sx = 0; sx < 3; ++sx) {
+                    kernel[sx + 3 * sy]
+                        = (backward)
+                            ? sharedSynapses(2 - sx, 2 - sy, output, channel)
+                            : sharedSynapses(sx, sy, channel, output);
+                }
+            }
+
+            // U = G.g.G^T
+            Float_T tmp[6 * 3];
+
+            for (unsigned int i = 0; i < tileDim; ++i) {
+                for (unsigned int j = 0; j < 3; ++j) {
+                    tmp[i * 3 + j] = G[i * 3 + 0] * kernel[0 * 3 + j]
+                                     + G[i * 3 + 1] * kernel[1 * 3 + j]
+                                     + G[i * 3 + 2] * kernel[2 * 3 + j];
+                }
+            }
+
+            for (unsigned int i = 0; i < tileDim; ++i) {
+                for (unsigned int j = 0; j < tileDim; ++j) {
+                    U[i * tileDim + j] = tmp[i * 3 + 0] * G[j * 3 + 0]
+                                         + tmp[i * 3 + 1] * G[j * 3 + 1]
+                                         + tmp[i * 3 + 2] * G[j * 3 + 2];
+                }
+            }
+
+            for (unsigned int e = 0; e < tileArea; ++e)
+                transformed[channel
+                            + nbChannels * (output + nbOutputs * e)] = U[e];
+        }
+    }
+}
+
+void N2D2::ConvCell_Frame_Kernels::forwardWinograd(const Float_T* alpha,
+                                                   const Tensor4d
+                                                   <Float_T>& inputs,
+                                                   const std::vector
+                                                   <Float_T>&
+                                                       transformedSynapses,
+                                                   unsigned int tileSize,
+                                                   const Descriptor& desc,
+                                                   const Float_T* beta,
+                                                   Tensor4d<Float_T>& outputs)
+{
+    const unsigned int tileDim = tileSize + 2;
+    const unsigned int tileArea = tileDim * tileDim;
+    const unsigned int nbChannels = inputs.dimZ();
+    const unsigned int nbOutputs = outputs.dimZ();
+
+    if (transformedSynapses.size() != tileArea * nbOutputs * nbChannels)
+        throw std::runtime_error("ConvCell_Frame_Kernels::forwardWinograd(): "
+                                 "transformed synapses size mismatch");
+
+    const unsigned int oxSize = outputs.dimX();
+    const unsigned int oySize = outputs.dimY();
+    const unsigned int tilesX = (oxSize + tileSize - 1) / tileSize;
+    const unsigned int tilesY = (oySize + tileSize - 1) / tileSize;
+    const unsigned int tilesPerImage = tilesX * tilesY;
+    const unsigned int nbTiles = tilesPerImage * inputs.dimB();
+
+    // Tiles are processed by chunks to bound the size of the transformed
+    // input and output buffers (about 16 MB)
+    const unsigned int chunkSize = std::min(
+        nbTiles,
+        std::max(64U, (4U << 20) / (tileArea * (nbChannels + nbOutputs))));
+
+    PoolVector<Float_T>::type V(tileArea * nbChannels * chunkSize);
+    PoolVector<Float_T>::type M(tileArea * nbOutputs * chunkSize);
+
+    for (unsigned int tileOffset = 0; tileOffset < nbTiles;
+         tileOffset += chunkSize)
+    {
+        const unsigned int nt = std::min(chunkSize, nbTiles - tileOffset);
+
+        // Input transform: V = B^T.d.B
+#pragma omp parallel for if (nbChannels * nt > 16)
+        for (int index = 0; index < (int)(nbChannels * nt); ++index) {
+            const unsigned int channel = index / nt;
+            const unsigned int t = index % nt;
+            const unsigned int tile = tileOffset + t;
+            const unsigned int batchPos = tile / tilesPerImage;
+            const unsigned int ty = (tile % tilesPerImage) / tilesX;
+            const unsigned int tx = (tile % tilesPerImage) % tilesX;
+            const int x0 = (int)(tx * tileSize) - desc.paddingX;
+            const int y0 = (int)(ty * tileSize) - desc.paddingY;
+
+            Float_T d[6 * 6];
+            Float_T v[6 * 6];
+
+            for (unsigned int i = 0; i < tileDim; ++i) {
+                const int iy = y0 + (int)i;
+
+                for (unsigned int j = 0; j < tileDim; ++j) {
+                    const int ix = x0 + (int)j;
+
+                    d[i * tileDim + j]
+                        = (ix >= 0 && iy >= 0 && ix < (int)inputs.dimX()
+                           && iy < (int)inputs.dimY())
+                              ? inputs(ix, iy, channel, batchPos)
+                              : 0.0;
+                }
+            }
+
+            if (tileSize == 4)
+                winogradTransform<6, 6>(winogradBT4, d, v);
+            else
+                winogradTransform<4, 4>(winogradBT2, d, v);
+
+            for (unsigned int e = 0; e < tileArea; ++e)
+                V[t + nt * (channel + nbChannels * e)] = v[e];
+        }
+
+        // Element-wise products, batched as one matrix product per element
+        for (unsigned int e = 0; e < tileArea; ++e) {
+            Gemm::sgemm(Gemm::NoTrans,
+                        Gemm::NoTrans,
+                        nbOutputs,
+                        nt,
+                        nbChannels,
+                        1.0,
+                        &transformedSynapses[nbOutputs * nbChannels * e],
+                        nbChannels,
+                        &V[nbChannels * nt * e],
+                        nt,
+                        0.0,
+                        &M[nbOutputs * nt * e],
+                        nt);
+        }
+
+        // Output transform: Y = A^T.m.A
+#pragma omp parallel for if (nbOutputs * nt > 16)
+        for (int index = 0; index < (int)(nbOutputs * nt); ++index) {
+            const unsigned int output = index / nt;
+            const unsigned int t = index % nt;
+            const unsigned int tile = tileOffset + t;
+            const unsigned int batchPos = tile / tilesPerImage;
+            const unsigned int ty = (tile % tilesPerImage) / tilesX;
+            const unsigned int tx = (tile % tilesPerImage) % tilesX;
+
+            Float_T m[6 * 6];
+            Float_T y[4 * 4];
+
+            for (unsigned int e = 0; e < tileArea; ++e)
+                m[e] = M[t + nt * (output + nbOutputs * e)];
+
+            if (tileSize == 4)
+                winogradTransform<4, 6>(winogradAT4, m, y);
+            else
+                winogradTransform<2, 4>(winogradAT2, m, y);
+
+            for (unsigned int i = 0; i < tileSize; ++i) {
+                const unsigned int oy = ty * tileSize + i;
+
+                if (oy >= oySize)
+                    break;
+
+                for (unsigned int j = 0; j < tileSize; ++j) {
+                    const unsigned int ox = tx * tileSize + j;
+
+                    if (ox >= oxSize)
+                        break;
+
+                    Float_T& value = outputs(ox, oy, output, batchPos);
+                    value = (*alpha) * y[i * tileSize + j]
+                            + ((*beta) != 0.0 ? (*beta) * value : 0.0);
+                }
+            }
+        }
+    }
+}
+
+void N2D2::ConvCell_Frame_Kernels::backwardDataWinograd(const Float_T* alpha,
+                                                        const std::vector
+                                                        <Float_T>&
+                                                            transformedSynapses,
+                                                        unsigned int tileSize,
+                                                        const Tensor4d
+                                                        <Float_T>& diffInputs,
+                                                        const Descriptor& desc,
+                                                        const Float_T* beta,
+                                                        Tensor4d
+                                                        <Float_T>& diffOutputs)
+{
+    // The gradient w.r.t. the inputs is the "full" correlation of the output
+    // gradient with the flipped kernels (see winogradFilterTransform())
+    const Descriptor backwardDesc(
+        1, 1, 1, 1, 2 - desc.paddingX, 2 - desc.paddingY);
+
+    forwardWinograd(alpha,
+                    diffInputs,
+                    transformedSynapses,
+                    tileSize,
+                    backwardDesc,
+                    beta,
+                    diffOutputs);
+}
+
+/**
+ * Storage offsets of every (channel, batchPos) plane of a tensor, as
+ * offsets[channel + batchPos * dimZ].
+*/
+static std::vector<unsigned int>
+channelOffsets(const N2D2::Tensor4d<N2D2::Float_T>& tensor)
+{
+    std::vector<unsigned int> offsets(tensor.dimZ() * tensor.dimB());
+
+    for (unsigned int batchPos = 0; batchPos < tensor.dimB(); ++batchPos) {
+        for (unsigned int k = 0; k < tensor.dimZ(); ++k)
+            offsets[k + batchPos * tensor.dimZ()]
+                = tensor.channelOffset(k, batchPos);
+    }
+
+    return offsets;
+}
+
+template <unsigned int CB>
+static void forwardBlockedLanes(const N2D2::Float_T alpha,
+                                const N2D2::Tensor4d<N2D2::Float_T>& inputs,
+                                const N2D2::Tensor4d
+                                <N2D2::Float_T>& sharedSynapses,
+                                const N2D2::ConvCell_Frame_Kernels::Descriptor&
+                                desc,
+                                const N2D2::Float_T beta,
+                                N2D2::Tensor4d<N2D2::Float_T>& outputs,
+                                const N2D2::Tensor2d<bool>& maps)
+{
+    const unsigned int kernelWidth = sharedSynapses.dimX();
+    const unsigned int kernelHeight = sharedSynapses.dimY();
+    const unsigned int kernelSize = kernelWidth * kernelHeight;
+    const unsigned int nbChannels = inputs.dimZ();
+    const unsigned int nbOutputs = outputs.dimZ();
+    const unsigned int nbBlocks = (nbOutputs + CB - 1) / CB;
+
+    // Weights as [outputBlock][channel][sy][sx][lane], masked connections and
+    // padding lanes are zeroed
+    N2D2::PoolVector<N2D2::Float_T>::type weights(
+        nbBlocks * nbChannels * kernelSize * CB, 0.0);
+
+    for (unsigned int output = 0; output < nbOutputs; ++output) {
+        const unsigned int block = output / CB;
+        const unsigned int lane = output % CB;
+
+        for (unsigned int channel = 0; channel < nbChannels; ++channel) {
+            if (!maps.empty() && !maps(output, channel))
+                continue;
+
+            for (unsigned int sy = 0; sy < kernelHeight; ++sy) {
+                for (unsigned int sx = 0; sx < kernelWidth; ++sx) {
+                    weights[(((block * nbChannels + channel) * kernelHeight
+                              + sy) * kernelWidth + sx) * CB + lane]
+                        = sharedSynapses(sx, sy, channel, output);
+                }
+            }
+        }
+    }
+
+    const std::vector<unsigned int> inputOffsets = channelOffsets(inputs);
+    const unsigned int inputStride = inputs.pixelStride();
+    const N2D2::Float_T* inputData = &inputs(0);
+    N2D2::Float_T* outputData = &outputs(0);
+    const unsigned int size = inputs.dimB() * nbBlocks;
+
+#if defined(_OPENMP) && _OPENMP >= 200805
+#pragma omp parallel for collapse(2) if (size > 16)
+#else
+#pragma omp parallel for if (inputs.dimB() > 4 && size > 16)
+#endif
+    for (int batchPos = 0; batchPos < (int)inputs.dimB(); ++batchPos) {
+        for (unsigned int block = 0; block < nbBlocks; ++block) {
+            const unsigned int nbLanes = std::min(CB, nbOutputs - block * CB);
+            N2D2::Float_T* output = outputData
+                + outputs.channelOffset(block * CB, batchPos);
+
+            for (unsigned int oy = 0; oy < outputs.dimY(); ++oy) {
+                for (unsigned int ox = 0; ox < outputs.dimX(); ++ox) {
+                    const unsigned int sxMin = (unsigned int)std::max(
+                        desc.paddingX - (int)(ox * desc.strideX), 0);
+                    const unsigned int syMin = (unsigned int)std::max(
+                        desc.paddingY - (int)(oy * desc.strideY), 0);
+                    const unsigned int sxMax = N2D2::Utils::clamp
+                        <int>(inputs.dimX() + desc.paddingX - ox * desc.strideX,
+                              0,
+                              kernelWidth);
+                    const unsigned int syMax = N2D2::Utils::clamp
+                        <int>(inputs.dimY() + desc.paddingY - oy * desc.strideY,
+                              0,
+                              kernelHeight);
+
+                    const int ix = (int)(ox * desc.strideX) - desc.paddingX;
+                    const int iy = (int)(oy * desc.strideY) - desc.paddingY;
+
+                    N2D2::Float_T weightedSum[CB] = {};
+
+                    for (unsigned int channel = 0; channel < nbChannels;
+                         ++channel) {
+                        const N2D2::Float_T* input = inputData
+                            + inputOffsets[channel + batchPos * nbChannels];
+                        const N2D2::Float_T* weight = &weights[
+                            (block * nbChannels + channel) * kernelSize * CB];
+
+                        for (unsigned int sy = syMin; sy < syMax; ++sy) {
+                            for (unsigned int sx = sxMin; sx < sxMax; ++sx) {
+                                const N2D2::Float_T value = input[
+                                    (ix + sx + (iy + sy) * inputs.dimX())
+                                    * inputStride];
+                                const N2D2::Float_T* w
+                                    = weight + (sx + sy * kernelWidth) * CB;
+
+                                for (unsigned int lane = 0; lane < CB; ++lane)
+                                    weightedSum[lane] += value * w[lane];
+                            }
+                        }
+                    }
+
+                    N2D2::Float_T* out = output
+                        + (ox + oy * outputs.dimX()) * CB;
+
+                    for (unsigned int lane = 0; lane < nbLanes; ++lane)
+                        out[lane] = alpha * weightedSum[lane]
+                                    + beta * out[lane];
+                }
+            }
+        }
+    }
+}
+
+template <unsigned int CB>
+static void backwardDataBlockedLanes(const N2D2::Float_T alpha,
+                                     const N2D2::Tensor4d
+                                     <N2D2::Float_T>& sharedSynapses,
+                                     const N2D2::Tensor4d
+                                     <N2D2::Float_T>& diffInputs,
+                                     const N2D2::ConvCell_Frame_Kernels::
+                                     Descriptor& desc,
+                                     const N2D2::Float_T beta,
+                                     N2D2::Tensor4d<N2D2::Float_T>& diffOutputs,
+                                     const N2D2::Tensor2d<bool>& maps)
+{
+    const unsigned int kernelWidth = sharedSynapses.dimX();
+    const unsigned int kernelHeight = sharedSynapses.dimY();
+    const unsigned int kernelSize = kernelWidth * kernelHeight;
+    const unsigned int nbChannels = diffOutputs.dimZ();
+    const unsigned int nbOutputs = diffInputs.dimZ();
+    const unsigned int nbBlocks = (nbChannels + CB - 1) / CB;
+
+    // Weights as [channelBlock][output][sy][sx][lane], masked connections and
+    // padding lanes are zeroed
+    N2D2::PoolVector<N2D2::Float_T>::type weights(
+        nbBlocks * nbOutputs * kernelSize * CB, 0.0);
+
+    for (unsigned int channel = 0; channel < nbChannels; ++channel) {
+        const unsigned int block = channel / CB;
+        const unsigned int lane = channel % CB;
+
+        for (unsigned int output = 0; output < nbOutputs; ++output) {
+            if (!maps.empty() && !maps(output, channel))
+                continue;
+
+            for (unsigned int sy = 0; sy < kernelHeight; ++sy) {
+                for (unsigned int sx = 0; sx < kernelWidth; ++sx) {
+                    weights[(((block * nbOutputs + output) * kernelHeight + sy)
+                             * kernelWidth + sx) * CB + lane]
+                        = sharedSynapses(sx, sy, channel, output);
+                }
+            }
+        }
+    }
+
+    const unsigned int oxStride = desc.strideX * diffInputs.dimX();
+    const unsigned int oyStride = desc.strideY * diffInputs.dimY();
+    const std::vector<unsigned int> diffInputOffsets
+        = channelOffsets(diffInputs);
+    const unsigned int diffInputStride = diffInputs.pixelStride();
+    const N2D2::Float_T* diffInputData = &diffInputs(0);
+    N2D2::Float_T* diffOutputData = &diffOutputs(0);
+    const unsigned int size = diffOutputs.dimB() * nbBlocks;
+
+#if defined(_OPENMP) && _OPENMP >= 200805
+#pragma omp parallel for collapse(2) if (size > 16)
+#else
+#pragma omp parallel for if (diffOutputs.dimB() > 4 && size > 16)
+#endif
+    for (int batchPos = 0; batchPos < (int)diffOutputs.dimB(); ++batchPos) {
+        for (unsigned int block = 0; block < nbBlocks; ++block) {
+            const unsigned int nbLanes = std::min(CB, nbChannels - block * CB);
+            N2D2::Float_T* diffOutput = diffOutputData
+                + diffOutputs.channelOffset(block * CB, batchPos);
+
+            for (unsigned int iy = 0; iy < diffOutputs.dimY(); ++iy) {
+                for (unsigned int ix = 0; ix < diffOutputs.dimX(); ++ix) {
+                    const unsigned int ixPad = ix + desc.paddingX;
+                    const unsigned int iyPad = iy + desc.paddingY;
+                    const unsigned int sxMax
+                        = std::min(kernelWidth, ixPad + 1);
+                    const unsigned int syMax
+                        = std::min(kernelHeight, iyPad + 1);
+
+                    N2D2::Float_T gradient[CB] = {};
+
+                    for (unsigned int sy = iyPad % desc.strideY,
+                                      sx0 = ixPad % desc.strideX;
+                         sy < syMax;
+                         sy += desc.strideY) {
+                        if (iyPad >= oyStride + sy)
+                            continue;
+
+                        for (unsigned int sx = sx0; sx < sxMax;
+                             sx += desc.strideX) {
+                            // Border conditions
+                            if (ixPad >= oxStride + sx)
+                                continue;
+
+                            // Output node coordinates
+                            const unsigned int ox = (ixPad - sx) / desc.strideX;
+                            const unsigned int oy = (iyPad - sy) / desc.strideY;
+                            const unsigned int pixel
+                                = (ox + oy * diffInputs.dimX())
+                                  * diffInputStride;
+
+                            for (unsigned int output = 0; output < nbOutputs;
+                                 ++output) {
+                                const N2D2::Float_T value = diffInputData[
+                                    diffInputOffsets[output + batchPos
+                                                              * nbOutputs]
+                                    + pixel];
+                                const N2D2::Float_T* w = &weights[
+                                    ((block * nbOutputs + output) * kernelSize
+                                     + sx + sy * kernelWidth) * CB];
+
+                                for (unsigned int lane = 0; lane < CB; ++lane)
+                                    gradient[lane] += value * w[lane];
+                            }
+                        }
+                    }
+
+                    N2D2::Float_T* diffOut = diffOutput
+                        + (ix + iy * diffOutputs.dimX()) * CB;
+
+                    for (unsigned int lane = 0; lane < nbLanes; ++lane)
+                        diffOut[lane] = alpha * gradient[lane]
+                                        + beta * diffOut[lane];
+                }
+            }
+        }
+    }
+}
+
+template <unsigned int CB>
+static void backwardFilterBlockedLanes(const N2D2::Float_T alpha,
+                                       const N2D2::Tensor4d
+                                       <N2D2::Float_T>& inputs,
+                                       const N2D2::Tensor4d
+                                       <N2D2::Float_T>& diffInputs,
+                                       const N2D2::ConvCell_Frame_Kernels::
+                                       Descriptor& desc,
+                                       const N2D2::Float_T beta,
+                                       N2D2::Tensor4d
+                                       <N2D2::Float_T>& diffSharedSynapses,
+                                       const N2D2::Tensor2d<bool>& maps)
+{
+    const unsigned int nbChannels = inputs.dimZ();
+    const unsigned int nbOutputs = diffInputs.dimZ();
+    const unsigned int nbBlocks = (nbOutputs + CB - 1) / CB;
+    const unsigned int oxSize = diffInputs.dimX();
+    const unsigned int oySize = diffInputs.dimY();
+
+    const std::vector<unsigned int> inputOffsets = channelOffsets(inputs);
+    const unsigned int inputStride = inputs.pixelStride();
+    const N2D2::Float_T* inputData = &inputs(0);
+    const N2D2::Float_T* diffInputData = &diffInputs(0);
+    const unsigned int size = nbBlocks * nbChannels;
+
+#if defined(_OPENMP) && _OPENMP >= 200805
+#pragma omp parallel for collapse(2) if (size > 16)
+#else
+#pragma omp parallel for if (nbBlocks > 4 && size > 16)
+#endif
+    for (int block = 0; block < (int)nbBlocks; ++block) {
+        for (unsigned int channel = 0; channel < nbChannels; ++channel) {
+            const unsigned int nbLanes = std::min(CB, nbOutputs - block * CB);
+
+            for (unsigned int sy = 0; sy < diffSharedSynapses.dimY(); ++sy) {
+                for (unsigned int sx = 0; sx < diffSharedSynapses.dimX();
+                     ++sx) {
+                    const unsigned int oxMin = (unsigned int)std::max(
+                        (int)std::ceil((desc.paddingX - (int)sx)
+                                       / (double)desc.strideX),
+                        0);
+                    const unsigned int oyMin = (unsigned int)std::max(
+                        (int)std::ceil((desc.paddingY - (int)sy)
+                                       / (double)desc.strideY),
+                        0);
+                    const unsigned int oxMax = std::min(
+                        (unsigned int)std::ceil((inputs.dimX() + desc.paddingX
+                                                 - sx) / (double)desc.strideX),
+                        oxSize);
+                    const unsigned int oyMax = std::min(
+                        (unsigned int)std::ceil((inputs.dimY() + desc.paddingY
+                                                 - sy) / (double)desc.strideY),
+                        oySize);
+
+                    N2D2::Float_T gradient[CB] = {};
+
+                    for (unsigned int batchPos = 0; batchPos < inputs.dimB();
+                         ++batchPos) {
+                        const N2D2::Float_T* input = inputData
+                            + inputOffsets[channel + batchPos * nbChannels];
+                        const N2D2::Float_T* diffInput = diffInputData
+                            + diffInputs.channelOffset(block * CB, batchPos);
+
+                        for (unsigned int oy = oyMin; oy < oyMax; ++oy) {
+                            for (unsigned int ox = oxMin; ox < oxMax; ++ox) {
+                                const unsigned int ix
+                                    = (int)(ox * desc.strideX + sx)
+                                      - desc.paddingX;
+                                const unsigned int iy
+                                    = (int)(oy * desc.strideY + sy)
+                                      - desc.paddingY;
+                                const N2D2::Float_T value = input[
+                                    (ix + iy * inputs.dimX()) * inputStride];
+                                const N2D2::Float_T* diff = diffInput
+                                    + (ox + oy * oxSize) * CB;
+
+                                for (unsigned int lane = 0; lane < CB; ++lane)
+                                    gradient[lane] += value * diff[lane];
+                            }
+                        }
+                    }
+
+                    for (unsigned int lane = 0; lane < nbLanes; ++lane) {
+                        const unsigned int output = block * CB + lane;
+
+                        if (!maps.empty() && !maps(output, channel))
+                            continue;
+
+                        diffSharedSynapses(sx, sy, channel, output)
+                            = alpha * gradient[lane]
+                              + beta
+                                * diffSharedSynapses(sx, sy, channel, output);
+                    }
+                }
+            }
+        }
+    }
+}
+
+void N2D2::ConvCell_Frame_Kernels::forwardBlocked(const Float_T* alpha,
+                                                  const Tensor4d
+                                                  <Float_T>& inputs,
+                                                  const Tensor4d
+                                                  <Float_T>& sharedSynapses,
+                                                  const Descriptor& desc,
+                                                  const Float_T* beta,
+                                                  Tensor4d<Float_T>& outputs,
+                                                  const Tensor2d<bool>& maps)
+{
+    if (desc.subSampleX > 1 || desc.subSampleY > 1)
+        throw std::runtime_error("ConvCell_Frame_Kernels::forwardBlocked(): "
+                                 "subsampling is not supported");
+
+    if (outputs.channelBlock() == 8)
+        forwardBlockedLanes<8>(
+            *alpha, inputs, sharedSynapses, desc, *beta, outputs, maps);
+    else if (outputs.channelBlock() == 16)
+        forwardBlockedLanes<16>(
+            *alpha, inputs, sharedSynapses, desc, *beta, outputs, maps);
+    else
+        throw std::runtime_error("ConvCell_Frame_Kernels::forwardBlocked(): "
+                                 "outputs channel block must be 8 or 16");
+}
+
+void N2D2::ConvCell_Frame_Kernels::backwardDataBlocked(const Float_T* alpha,
+                                                       const Tensor4d
+                                                       <Float_T>&
+                                                       sharedSynapses,
+                                                       const Tensor4d
+                                                       <Float_T>& diffInputs,
+                                                       const Descriptor& desc,
+                                                       const Float_T* beta,
+                                                       Tensor4d
+                                                       <Float_T>& diffOutputs,
+                                                       const Tensor2d
+                                                       <bool>& maps)
+{
+    if (desc.subSampleX > 1 || desc.subSampleY > 1)
+        throw std::runtime_error("ConvCell_Frame_Kernels::"
+                                 "backwardDataBlocked(): subsampling is not "
+                                 "supported");
+
+    if (diffOutputs.channelBlock() == 8)
+        backwardDataBlockedLanes<8>(
+            *alpha, sharedSynapses, diffInputs, desc, *beta, diffOutputs, maps);
+    else if (diffOutputs.channelBlock() == 16)
+        backwardDataBlockedLanes<16>(
+            *alpha, sharedSynapses, diffInputs, desc, *beta, diffOutputs, maps);
+    else
+        throw std::runtime_error("ConvCell_Frame_Kernels::"
+                                 "backwardDataBlocked(): diffOutputs channel "
+                                 "block must be 8 or 16");
+}
+
+void N2D2::ConvCell_Frame_Kernels::backwardFilterBlocked(const Float_T* alpha,
+                                                         const Tensor4d
+                                                         <Float_T>& inputs,
+                                                         const Tensor4d
+                                                         <Float_T>& diffInputs,
+                                                         const Descriptor& desc,
+                                                         const Float_T* beta,
+                                                         Tensor4d<Float_T>&
+                                                         diffSharedSynapses,
+                                                         const Tensor2d
+                                                         <bool>& maps)
+{
+    if (desc.subSampleX > 1 || desc.subSampleY > 1)
+        throw std::runtime_error("ConvCell_Frame_Kernels::"
+                                 "backwardFilterBlocked(): subsampling is not "
+                                 "supported");
+
+    if (diffInputs.channelBlock() == 8)
+        backwardFilterBlockedLanes<8>(*alpha,
+                                      inputs,
+                                      diffInputs,
+                                      desc,
+                                      *beta,
+                                      diffSharedSynapses,
+                                      maps);
+    else if (diffInputs.channelBlock() == 16)
+        backwardFilterBlockedLanes<16>(*alpha,
+                                       inputs,
+                                       diffInputs,
+                                       desc,
+                                       *beta,
+                                       diffSharedSynapses,
+                                       maps);
+    else
+        throw std::runtime_error("ConvCell_Frame_Kernels::"
+                                 "backwardFilterBlocked(): diffInputs channel "
+                                 "block must be 8 or 16");
+}
+
+void N2D2::ConvCell_Frame_Kernels::forwardQuantized(const Tensor4d
+                                                    <short>& inputs,
+                                                    const Tensor4d<signed char>&
+                                                    sharedSynapses,
+                                                    const Descriptor& desc,
+                                                    bool accumulate,
+                                                    Tensor4d<int>& outputs,
+                                                    const Tensor2d<bool>& maps)
+{
+    const unsigned int oxSize = outputs.dimX();
+    const unsigned int oySize = outputs.dimY();
+    const int inputsDimX = inputs.dimX();
+    const int strideX = desc.strideX;
+    const unsigned int size = inputs.dimB() * outputs.dimZ();
+
+#if defined(_OPENMP) && _OPENMP >= 200805
+#pragma omp parallel for collapse(2) if (size > 16)
+#else
+#pragma omp parallel for if (inputs.dimB() > 4 && size > 16)
+#endif
+    for (int batchPos = 0; batchPos < (int)inputs.dimB(); ++batchPos) {
+        for (unsigned int output = 0; output < outputs.dimZ(); ++output) {
+            int* outputPlane = &outputs(0, 0, output, batchPos);
+
+            if (!accumulate)
+                std::fill(outputPlane, outputPlane + oxSize * oySize, 0);
+
+            for (unsigned int channel = 0; channel < inputs.dimZ(); ++channel) {
+                if (!maps.empty() && !maps(output, channel))
+                    continue;
+
+                for (unsigned int sx = 0; sx < sharedSynapses.dimX(); ++sx) {
+                    // Range of ox for which ix = ox * strideX - paddingX + sx
+                    // is inside the input, so that the inner loop is free of
+                    // bound checks
+                    const int firstX = desc.paddingX - (int)sx;
+                    const int lastX = inputsDimX - 1 + desc.paddingX - (int)sx;
+                    const unsigned int oxMin = (firstX > 0)
+                        ? (firstX + strideX - 1) / strideX : 0;
+                    const unsigned int oxMax = (lastX >= 0)
+                        ? std::min(oxSize, (unsigned int)(lastX / strideX + 1))
+                        : 0;
+
+                    if (oxMin >= oxMax)
+                        continue;
+
+                    for (unsigned int oy = 0; oy < oySize; ++oy) {
+                        const unsigned int syMin = (unsigned int)std::max(
+                            desc.paddingY - (int)(oy * desc.strideY), 0);
+                        const unsigned int syMax = Utils::clamp
+                            <int>(inputs.dimY() + desc.paddingY
+                                    - oy * desc.strideY,
+                                  0,
+                                  sharedSynapses.dimY());
+                        const int iy = (int)(oy * desc.strideY) - desc.paddingY;
+                        int* outputLine = outputPlane + oy * oxSize;
+
+                        for (unsigned int sy = syMin; sy < syMax; ++sy) {
+                            const int weight
+                                = sharedSynapses(sx, sy, channel, output);
+
+                            if (weight == 0)
+                                continue;
+
+                            const short* inputLine
+                                = &inputs(0, iy + sy, channel, batchPos);
+                            const int offset = (int)sx - desc.paddingX;
+
+                            for (unsigned int ox = oxMin; ox < oxMax; ++ox)
+                                outputLine[ox] += weight
+                                    * inputLine[(int)ox * strideX + offset];
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
@@ -52,7 +52,8 @@ N2D2::ConvCell_Spike::ConvCell_Spike(Network& net,
       mThreshold(this, "Threshold", 1.0),
       mBipolarThreshold(this, "BipolarThreshold", true),
       mLeak(this, "Leak", 0.0),
-      mRefractory(this, "Refractory", 0 * TimeS)
+      mRefractory(this, "Refractory", 0 * TimeS),
+      mLeakCacheLeak(0)
 {
     // ctor
 }
@@ -72,13 +73,8 @@ void N2D2::ConvCell_Spike::initialize()
         mOutputsWidth, mOutputsHeight, mNbOutputs, 1, 0.0);
     mOutputsRefractoryEnd.resize(
         mOutputsWidth, mOutputsHeight, mNbOutputs, 1, 0);
-}
 
-void N2D2::ConvCell_Spike::propagateSpike(NodeIn* origin,
-                                          Time_T timestamp,
-                                          EventType_T type)
-{
-    const Area& area = origin->getArea();
+    // Fan-out of each input position
     const unsigned int oxStride
         = mStrideX
           * (unsigned int)((mChannelsWidth + 2 * mPaddingX - mKernelWidth
@@ -87,42 +83,94 @@ void N2D2::ConvCell_Spike::propagateSpike(NodeIn* origin,
         = mStrideY
           * (unsigned int)((mChannelsHeight + 2 * mPaddingY - mKernelHeight
                             + mStrideY) / (double)mStrideY);
-    const unsigned int ixPad = area.x + mPaddingX;
-    const unsigned int iyPad = area.y + mPaddingY;
-    const unsigned int sxMax = std::min(mKernelWidth, ixPad + 1);
-    const unsigned int syMax = std::min(mKernelHeight, iyPad + 1);
-
-    for (unsigned int sy = iyPad % mStrideY, sx0 = ixPad % mStrideX; sy < syMax;
-         sy += mStrideY) {
-        if (iyPad >= oyStride + sy)
-            continue;
-
-        for (unsigned int sx = sx0; sx < sxMax; sx += mStrideX) {
-            // Border conditions
-            if (ixPad >= oxStride + sx)
-                continue;
 
-            // Output node coordinates
-            const unsigned int ox = (ixPad - sx) / mStrideX;
-            const unsigned int oy = (iyPad - sy) / mStrideY;
+    mFanOut.clear();
+    mFanOutOffsets.assign(1, 0);
+
+    for (unsigned int iy = 0; iy < mChannelsHeight; ++iy) {
+        for (unsigned int ix = 0; ix < mChannelsWidth; ++ix) {
+            const unsigned int ixPad = ix + mPaddingX;
+            const unsigned int iyPad = iy + mPaddingY;
+            const unsigned int sxMax = std::min(mKernelWidth, ixPad + 1);
+            const unsigned int syMax = std::min(mKernelHeight, iyPad + 1);
 
-            for (unsigned int output = 0; output < mNbOutputs; ++output) {
-                if (!isConnection(origin->getChannel(), output))
+            for (unsigned int sy = iyPad % mStrideY, sx0 = ixPad % mStrideX;
+                 sy < syMax;
+                 sy += mStrideY) {
+                if (iyPad >= oyStride + sy)
                     continue;
 
-                const Time_T delay = static_cast<Synapse_Static*>(
-                    mSharedSynapses(sx, sy, origin->getChannel(), output))
-                                         ->delay;
-
-                if (delay > 0)
-                    mNet.newEvent(origin,
-                                  NULL,
-                                  timestamp + delay,
-                                  maps(output, ox, oy, type));
-                else
-                    incomingSpike(
-                        origin, timestamp, maps(output, ox, oy, type));
+                for (unsigned int sx = sx0; sx < sxMax; sx += mStrideX) {
+                    // Border conditions
+                    if (ixPad >= oxStride + sx)
+                        continue;
+
+                    FanOut fanOut;
+                    fanOut.synapse = sx + mKernelWidth * sy;
+                    fanOut.ox = (ixPad - sx) / mStrideX;
+                    fanOut.oy = (iyPad - sy) / mStrideY;
+                    fanOut.index = fanOut.ox / mSubSampleX
+                                   + mOutputsWidth * (fanOut.oy / mSubSampleY);
+                    mFanOut.push_back(fanOut);
+                }
             }
+
+            mFanOutOffsets.push_back(mFanOut.size());
+        }
+    }
+
+    // Outputs connected to each input channel
+    mChannelOutputs.assign(mNbChannels, std::vector<unsigned int>());
+
+    for (unsigned int channel = 0; channel < mNbChannels; ++channel) {
+        for (unsigned int output = 0; output < mNbOutputs; ++output) {
+            if (isConnection(channel, output))
+                mChannelOutputs[channel].push_back(output);
+        }
+    }
+}
+
+void N2D2::ConvCell_Spike::propagateSpike(NodeIn* origin,
+                                          Time_T timestamp,
+                                          EventType_T type)
+{
+    const Area& area = origin->getArea();
+
+    // Border conditions
+    if (area.x >= mChannelsWidth || area.y >= mChannelsHeight)
+        return;
+
+    const unsigned int channel = origin->getChannel();
+    const std::vector<unsigned int>& outputs = mChannelOutputs[channel];
+    const unsigned int position = area.x + mChannelsWidth * area.y;
+    const unsigned int kernelSize = mKernelWidth * mKernelHeight;
+    const unsigned int outputSize = mOutputsWidth * mOutputsHeight;
+
+    for (std::vector<FanOut>::const_iterator it
+         = mFanOut.begin() + mFanOutOffsets[position],
+         itEnd = mFanOut.begin() + mFanOutOffsets[position + 1];
+         it != itEnd;
+         ++it) {
+        for (std::vector<unsigned int>::const_iterator itOutput
+             = outputs.begin(),
+             itOutputEnd = outputs.end();
+             itOutput != itOutputEnd;
+             ++itOutput) {
+            const unsigned int output = (*itOutput);
+            Synapse_Static* synapse = static_cast<Synapse_Static*>(
+                mSharedSynapses((*it).synapse + kernelSize
+                                * (channel + mNbChannels * output)));
+
+            if (synapse->delay > 0)
+                mNet.newEvent(origin,
+                              NULL,
+                              timestamp + synapse->delay,
+                              maps(output, (*it).ox, (*it).oy, type));
+            else
+                integrate(synapse,
+                          (*it).index + outputSize * output,
+                          timestamp,
+                          type);
         }
     }
 }
@@ -146,30 +194,34 @@ void N2D2::ConvCell_Spike::incomingSpike(NodeIn* origin,
     const unsigned int synX = area.x - ox * mStrideX + mPaddingX;
     const unsigned int synY = area.y - oy * mStrideY + mPaddingY;
 
+    Synapse_Static* synapse = static_cast<Synapse_Static*>(
+        mSharedSynapses(synX, synY, origin->getChannel(), output));
+
+    integrate(synapse,
+              subOx + mOutputsWidth * (subOy + mOutputsHeight * output),
+              timestamp,
+              negative);
+}
+
+void N2D2::ConvCell_Spike::integrate(Synapse_Static* synapse,
+                                     unsigned int index,
+                                     Time_T timestamp,
+                                     bool negative)
+{
     // Neuron state variables
-    Time_T& lastIntegration = mOutputsLastIntegration(subOx, subOy, output, 0);
-    double& integration = mOutputsIntegration(subOx, subOy, output, 0);
-    Time_T& refractoryEnd = mOutputsRefractoryEnd(subOx, subOy, output, 0);
+    Time_T& lastIntegration = mOutputsLastIntegration(index);
+    double& integration = mOutputsIntegration(index);
+    Time_T& refractoryEnd = mOutputsRefractoryEnd(index);
 
     // Integrates
     if (mLeak > 0.0) {
         const Time_T dt = timestamp - lastIntegration;
-        const double expVal = -((double)dt) / ((double)mLeak);
 
-        if (expVal > std::log(1e-20))
-            integration *= std::exp(expVal);
-        else {
-            integration = 0.0;
-            // std::cout << "Notice: integration leaked to 0 (no activity during
-            // " << dt/((double) TimeS) << " s = "
-            //    << (-expVal) << " * mLeak)." << std::endl;
-        }
+        if (dt != 0)
+            integration *= leakFactor(dt);
     }
 
     lastIntegration = timestamp;
-
-    Synapse_Static* synapse = static_cast<Synapse_Static*>(
-        mSharedSynapses(synX, synY, origin->getChannel(), output));
     integration += (negative) ? -synapse->weight : synapse->weight;
 
     // Stats
@@ -191,9 +243,31 @@ void N2D2::ConvCell_Spike::incomingSpike(NodeIn* origin,
         else
             integration -= mThreshold;
 
-        mOutputs(subOx, subOy, output, 0)
-            ->incomingSpike(NULL, timestamp + 1 * TimeFs, negSpike);
+        mOutputs(index)->incomingSpike(NULL, timestamp + 1 * TimeFs, negSpike);
+    }
+}
+
+double N2D2::ConvCell_Spike::leakFactor(Time_T dt)
+{
+    if (mLeakCache.empty() || mLeakCacheLeak != mLeak) {
+        // dt = 0 is never looked up and marks the empty entries
+        mLeakCache.assign(256, std::make_pair((Time_T)0, 0.0));
+        mLeakCacheLeak = mLeak;
+    }
+
+    // Timestamps are often multiples of a round time unit, so the low-order
+    // bits of dt cannot be used directly as the entry index
+    std::pair<Time_T, double>& entry
+        = mLeakCache[(unsigned int)((dt * 0x9E3779B97F4A7C15ULL) >> 56)];
+
+    if (entry.first != dt) {
+        const double expVal = -((double)dt) / ((double)mLeak);
+
+        entry.first = dt;
+        entry.second = (expVal > std::log(1e-20)) ? std::exp(expVal) : 0.0;
     }
+
+    return entry.second;
 }
 
 void N2D2::ConvCell_Spike::notify(Time_T timestamp, NotifyType notify)
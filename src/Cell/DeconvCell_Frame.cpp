@@ -45,6 +45,7 @@ N2D2::DeconvCell_Frame::DeconvCell_Frame(const std::string& name,
       Cell_Frame(name, nbOutputs, activation),
       // IMPORTANT: Do not change the value of the parameters here! Use
       // setParameter() or loadParameters().
+      mAlgorithm(this, "Algorithm", Direct),
       mBias(1, 1, mNbOutputs, 1),
       mDiffBias(1, 1, mNbOutputs, 1),
       mConvDesc(1, 1, strideX, strideY, paddingX, paddingY)
@@ -79,6 +80,23 @@ void N2D2::DeconvCell_Frame::initialize()
         mDiffSharedSynapses.push_back(new Tensor4d<Float_T>(
             mKernelWidth, mKernelHeight, mNbOutputs, mInputs[k].dimZ()));
     }
+
+    // The convolution kernels index the maps with the convolution output
+    // (the Deconv input channel) first
+    unsigned int offset = 0;
+
+    for (unsigned int k = 0, size = mInputs.size(); k < size; ++k) {
+        Tensor2d<bool> inputMaps(mInputs[k].dimZ(), mNbOutputs);
+
+        for (unsigned int channel = 0; channel < mInputs[k].dimZ(); ++channel)
+        {
+            for (unsigned int output = 0; output < mNbOutputs; ++output)
+                inputMaps(channel, output) = mMaps(output, offset + channel);
+        }
+
+        mInputsMaps.push_back(inputMaps);
+        offset += mInputs[k].dimZ();
+    }
 }
 
 void N2D2::DeconvCell_Frame::propagate(bool /*inference*/)
@@ -88,22 +106,26 @@ void N2D2::DeconvCell_Frame::propagate(bool /*inference*/)
     const Float_T alpha = 1.0;
     Float_T beta = 0.0;
 
-    unsigned int offset = 0;
-
     for (unsigned int k = 0, size = mInputs.size(); k < size; ++k) {
         if (k > 0)
             beta = 1.0;
 
-        ConvCell_Frame_Kernels::backwardData(&alpha,
-                                             mSharedSynapses[k],
-                                             mInputs[k],
-                                             mConvDesc,
-                                             &beta,
-                                             mOutputs,
-                                             mMaps.rows(offset,
-                                                        mInputs[k].dimZ()));
-
-        offset += mInputs[k].dimZ();
+        if (mAlgorithm == GEMM)
+            ConvCell_Frame_Kernels::backwardDataGemm(&alpha,
+                                                     mSharedSynapses[k],
+                                                     mInputs[k],
+                                                     mConvDesc,
+                                                     &beta,
+                                                     mOutputs,
+                                                     mInputsMaps[k]);
+        else
+            ConvCell_Frame_Kernels::backwardData(&alpha,
+                                                 mSharedSynapses[k],
+                                                 mInputs[k],
+                                                 mConvDesc,
+                                                 &beta,
+                                                 mOutputs,
+                                                 mInputsMaps[k]);
     }
 
     if (!mNoBias)
@@ -120,40 +142,49 @@ void N2D2::DeconvCell_Frame::backPropagate()
     const Float_T alpha = 1.0;
     const Float_T beta = 0.0;
 
-    unsigned int offset = 0;
-
     for (unsigned int k = 0, size = mInputs.size(); k < size; ++k) {
-        ConvCell_Frame_Kernels::backwardFilter(&alpha,
-                                               mDiffInputs,
-                                               mInputs[k],
-                                               mConvDesc,
-                                               &beta,
-                                               mDiffSharedSynapses[k],
-                                               mMaps.rows(offset,
-                                                          mInputs[k].dimZ()));
-
-        offset += mInputs[k].dimZ();
+        if (mAlgorithm == GEMM)
+            ConvCell_Frame_Kernels::backwardFilterGemm(&alpha,
+                                                       mDiffInputs,
+                                                       mInputs[k],
+                                                       mConvDesc,
+                                                       &beta,
+                                                       mDiffSharedSynapses[k],
+                                                       mInputsMaps[k]);
+        else
+            ConvCell_Frame_Kernels::backwardFilter(&alpha,
+                                                   mDiffInputs,
+                                                   mInputs[k],
+                                                   mConvDesc,
+                                                   &beta,
+                                                   mDiffSharedSynapses[k],
+                                                   mInputsMaps[k]);
     }
 
     if (!mNoBias)
         ConvCell_Frame_Kernels::backwardBias(mDiffInputs, mDiffBias);
 
     if (!mDiffOutputs.empty() && mBackPropagate) {
-        offset = 0;
-
         for (unsigned int k = 0, size = mInputs.size(); k < size; ++k) {
             const Float_T beta = (mDiffOutputs[k].isValid()) ? 1.0 : 0.0;
 
-            ConvCell_Frame_Kernels::forward(&alpha,
-                                            mDiffInputs,
-                                            mSharedSynapses[k],
-                                            mConvDesc,
-                                            &beta,
-                                            mDiffOutputs[k],
-                                            mMaps.rows(offset,
-                                                       mInputs[k].dimZ()));
+            if (mAlgorithm == GEMM)
+                ConvCell_Frame_Kernels::forwardGemm(&alpha,
+                                                    mDiffInputs,
+                                                    mSharedSynapses[k],
+                                                    mConvDesc,
+                                                    &beta,
+                                                    mDiffOutputs[k],
+                                                    mInputsMaps[k]);
+            else
+                ConvCell_Frame_Kernels::forward(&alpha,
+                                                mDiffInputs,
+                                                mSharedSynapses[k],
+                                                mConvDesc,
+                                                &beta,
+                                                mDiffOutputs[k],
+                                                mInputsMaps[k]);
 
-            offset += mInputs[k].dimZ();
             mDiffOutputs[k].setValid();
         }
 
@@ -214,7 +245,7 @@ void N2D2::DeconvCell_Frame::saveFreeParameters(const std::string
                                  + fileName);
 
     for (unsigned int k = 0; k < mSharedSynapses.size(); ++k) {
-        for (std::vector<Float_T>::const_iterator it
+        for (Tensor4d<Float_T>::const_iterator it
              = mSharedSynapses[k].begin();
              it != mSharedSynapses[k].end();
              ++it)
@@ -222,7 +253,7 @@ void N2D2::DeconvCell_Frame::saveFreeParameters(const std::string
     }
 
     if (!mNoBias) {
-        for (std::vector<Float_T>::const_iterator it = mBias.begin();
+        for (Tensor4d<Float_T>::const_iterator it = mBias.begin();
              it != mBias.end();
              ++it)
             syn.write(reinterpret_cast<const char*>(&(*it)), sizeof(*it));
@@ -249,14 +280,14 @@ void N2D2::DeconvCell_Frame::loadFreeParameters(const std::string& fileName,
     }
 
     for (unsigned int k = 0; k < mSharedSynapses.size(); ++k) {
-        for (std::vector<Float_T>::iterator it = mSharedSynapses[k].begin();
+        for (Tensor4d<Float_T>::iterator it = mSharedSynapses[k].begin();
              it != mSharedSynapses[k].end();
              ++it)
             syn.read(reinterpret_cast<char*>(&(*it)), sizeof(*it));
     }
 
     if (!mNoBias) {
-        for (std::vector<Float_T>::iterator it = mBias.begin();
+        for (Tensor4d<Float_T>::iterator it = mBias.begin();
              it != mBias.end();
              ++it)
             syn.read(reinterpret_cast<char*>(&(*it)), sizeof(*it));
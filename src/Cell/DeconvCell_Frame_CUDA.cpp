@@ -494,7 +494,7 @@ void N2D2::DeconvCell_Frame_CUDA::saveFreeParameters(const std::string
     mSharedSynapses.synchronizeDToH();
 
     for (unsigned int k = 0; k < mSharedSynapses.size(); ++k) {
-        for (std::vector<Float_T>::const_iterator it
+        for (Tensor4d<Float_T>::const_iterator it
              = mSharedSynapses[k].begin();
              it != mSharedSynapses[k].end();
              ++it)
@@ -504,7 +504,7 @@ void N2D2::DeconvCell_Frame_CUDA::saveFreeParameters(const std::string
     if (!mNoBias) {
         mBias.synchronizeDToH();
 
-        for (std::vector<Float_T>::const_iterator it = mBias.begin();
+        for (Tensor4d<Float_T>::const_iterator it = mBias.begin();
              it != mBias.end();
              ++it)
             syn.write(reinterpret_cast<const char*>(&(*it)), sizeof(*it));
@@ -532,7 +532,7 @@ void N2D2::DeconvCell_Frame_CUDA::loadFreeParameters(const std::string
     }
 
     for (unsigned int k = 0; k < mSharedSynapses.size(); ++k) {
-        for (std::vector<Float_T>::iterator it = mSharedSynapses[k].begin();
+        for (Tensor4d<Float_T>::iterator it = mSharedSynapses[k].begin();
              it != mSharedSynapses[k].end();
              ++it)
             syn.read(reinterpret_cast<char*>(&(*it)), sizeof(*it));
@@ -541,7 +541,7 @@ void N2D2::DeconvCell_Frame_CUDA::loadFreeParameters(const std::string
     mSharedSynapses.synchronizeHToD();
 
     if (!mNoBias) {
-        for (std::vector<Float_T>::iterator it = mBias.begin();
+        for (Tensor4d<Float_T>::iterator it = mBias.begin();
              it != mBias.end();
              ++it)
             syn.read(reinterpret_cast<char*>(&(*it)), sizeof(*it));
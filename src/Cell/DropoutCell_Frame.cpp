@@ -28,7 +28,8 @@ N2D2::DropoutCell_Frame::DropoutCell_Frame(const std::string& name,
                                                      unsigned int nbOutputs)
     : Cell(name, nbOutputs),
       DropoutCell(name, nbOutputs),
-      Cell_Frame(name, nbOutputs)
+      Cell_Frame(name, nbOutputs),
+      mMaskCounter(0)
 {
     // ctor
 }
@@ -86,30 +87,33 @@ void N2D2::DropoutCell_Frame::propagate(bool inference)
             }
         }
     } else {
+        // The mask is drawn from the own key of the cell: it does not depend
+        // on the number of threads, nor on the other threads drawing random
+        // numbers (stimuli provider, concurrent cells)
+        Random::fillBernoulli(mMask,
+                              1.0 - mDropout,
+                              Random::streamSeed(Random::getSeed(),
+                                                 Random::streamId(mName),
+                                                 mMaskCounter));
+        ++mMaskCounter;
+
         for (unsigned int k = 0, size = mInputs.size(); k < size; ++k) {
-            unsigned int outputOffset = offset;
-            unsigned int inputOffset = 0;
+            const unsigned int batchSize = mInputs[k].size() / mInputs.dimB();
 
-            for (unsigned int batchPos = 0; batchPos < mInputs.dimB();
-                ++batchPos)
+#pragma omp parallel for if (mInputs.dimB() > 4)
+            for (int batchPos = 0; batchPos < (int)mInputs.dimB(); ++batchPos)
             {
-                for (unsigned int index = 0,
-                     batchSize = (mInputs[k].size() / mInputs.dimB());
-                     index < batchSize;
-                     ++index)
-                {
+                const unsigned int outputOffset = offset + batchPos
+                    * mOutputs.dimX() * mOutputs.dimY() * mInputs.dimZ();
+                const unsigned int inputOffset = batchPos * batchSize;
+
+                for (unsigned int index = 0; index < batchSize; ++index) {
                     const unsigned int outputIndex = index + outputOffset;
 
-                    mMask(outputIndex) = Random::randBernoulli(1.0 - mDropout);
                     mOutputs(outputIndex) = (mMask(outputIndex))
                         ? mInputs[k](index + inputOffset)
                         : 0.0;
                 }
-
-                outputOffset += mOutputs.dimX() * mOutputs.dimY()
-                                * mInputs.dimZ();
-                inputOffset += mOutputs.dimX() * mOutputs.dimY()
-                               * mInputs[k].dimZ();
             }
 
             offset += mOutputs.dimX() * mOutputs.dimY() * mInputs[k].dimZ();
@@ -0,0 +1,188 @@
+/*
+    (C) Copyright 2016 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include "Cell/FcCell_CSpike.hpp"
+
+N2D2::Registrar<N2D2::FcCell>
+N2D2::FcCell_CSpike::mRegistrar("CSpike", N2D2::FcCell_CSpike::create);
+
+N2D2::FcCell_CSpike::FcCell_CSpike(const std::string& name,
+                                   unsigned int nbOutputs)
+    : Cell(name, nbOutputs),
+      FcCell(name, nbOutputs),
+      Cell_CSpike(name, nbOutputs)
+{
+    // ctor
+}
+
+void N2D2::FcCell_CSpike::initialize()
+{
+    if (mThreshold <= 0.0)
+        throw std::domain_error("mThreshold is <= 0.0");
+
+    if (!mNoBias) {
+        mBias.resize(mOutputs.dimZ());
+        mBiasFiller->apply(mBias);
+    }
+
+    for (unsigned int k = 0, size = mInputs.size(); k < size; ++k) {
+        if (mInputs[k].size() == 0)
+            throw std::runtime_error("Zero-sized input for FcCell " + mName);
+
+        mSynapses.push_back(new Tensor4d<Float_T>(
+            1, 1, mInputs[k].size() / mInputs.dimB(), mOutputs.dimZ()));
+        mWeightsFiller->apply(mSynapses.back());
+    }
+
+    mInputsSpiking.resize(mInputs.size() * mInputs.dimB());
+    mInputsSpikes.resize(mInputs.size() * mInputs.dimB());
+}
+
+bool N2D2::FcCell_CSpike::tick(Time_T timestamp)
+{
+    const Float_T leakFactor = leak(timestamp);
+    const unsigned int dimB = mInputs.dimB();
+    const unsigned int nbInputs = mInputs.size();
+
+    // List the input spikes
+#pragma omp parallel for if (dimB > 1)
+    for (int batchPos = 0; batchPos < (int)dimB; ++batchPos) {
+        for (unsigned int k = 0; k < nbInputs; ++k) {
+            const Tensor4d<char>& input = mInputs[k];
+            const unsigned int inputSize = input.size() / dimB;
+            const char* spikes = &input(0, 0, 0, batchPos);
+
+            std::vector<unsigned int>& spiking
+                = mInputsSpiking[k * dimB + batchPos];
+            std::vector<char>& values = mInputsSpikes[k * dimB + batchPos];
+            spiking.clear();
+            values.clear();
+
+            for (unsigned int channel = 0; channel < inputSize; ++channel) {
+                if (spikes[channel] != 0) {
+                    spiking.push_back(channel);
+                    values.push_back(spikes[channel]);
+                }
+            }
+        }
+    }
+
+    const unsigned int nbOutputs = mOutputs.dimZ();
+    const unsigned int size = dimB * nbOutputs;
+
+#if defined(_OPENMP) && _OPENMP >= 200805
+#pragma omp parallel for collapse(2) if (size > 16)
+#else
+#pragma omp parallel for if (dimB > 4 && size > 16)
+#endif
+    for (int batchPos = 0; batchPos < (int)dimB; ++batchPos) {
+        for (unsigned int output = 0; output < nbOutputs; ++output) {
+            Float_T weightedSum = (!mNoBias) ? mBias(output) : 0.0;
+
+            for (unsigned int k = 0; k < nbInputs; ++k) {
+                const Float_T* weights = &mSynapses[k](0, 0, 0, output);
+                const std::vector<unsigned int>& spiking
+                    = mInputsSpiking[k * dimB + batchPos];
+                const std::vector<char>& values
+                    = mInputsSpikes[k * dimB + batchPos];
+
+                for (unsigned int i = 0, nbSpikes = spiking.size();
+                     i < nbSpikes;
+                     ++i)
+                    weightedSum += values[i] * weights[spiking[i]];
+            }
+
+            Float_T& integration = mOutputsIntegration(0, 0, output, batchPos);
+            integration = leakFactor * integration + weightedSum;
+        }
+    }
+
+    fire(timestamp);
+    return false;
+}
+
+void N2D2::FcCell_CSpike::saveFreeParameters(const std::string& fileName) const
+{
+    std::ofstream syn(fileName.c_str(), std::fstream::binary);
+
+    if (!syn.good())
+        throw std::runtime_error("Could not create synaptic file (.SYN): "
+                                 + fileName);
+
+    for (unsigned int k = 0; k < mSynapses.size(); ++k) {
+        for (Tensor4d<Float_T>::const_iterator it = mSynapses[k].begin();
+             it != mSynapses[k].end();
+             ++it)
+            syn.write(reinterpret_cast<const char*>(&(*it)), sizeof(*it));
+    }
+
+    for (Tensor4d<Float_T>::const_iterator it = mBias.begin();
+         it != mBias.end();
+         ++it)
+        syn.write(reinterpret_cast<const char*>(&(*it)), sizeof(*it));
+
+    if (!syn.good())
+        throw std::runtime_error("Error writing synaptic file: " + fileName);
+}
+
+void N2D2::FcCell_CSpike::loadFreeParameters(const std::string& fileName,
+                                             bool ignoreNotExists)
+{
+    std::ifstream syn(fileName.c_str(), std::fstream::binary);
+
+    if (!syn.good()) {
+        if (ignoreNotExists) {
+            std::cout << Utils::cnotice
+                      << "Notice: Could not open synaptic file (.SYN): "
+                      << fileName << Utils::cdef << std::endl;
+            return;
+        } else
+            throw std::runtime_error("Could not open synaptic file (.SYN): "
+                                     + fileName);
+    }
+
+    for (unsigned int k = 0; k < mSynapses.size(); ++k) {
+        for (Tensor4d<Float_T>::iterator it = mSynapses[k].begin();
+             it != mSynapses[k].end();
+             ++it)
+            syn.read(reinterpret_cast<char*>(&(*it)), sizeof(*it));
+    }
+
+    for (Tensor4d<Float_T>::iterator it = mBias.begin(); it != mBias.end();
+         ++it)
+        syn.read(reinterpret_cast<char*>(&(*it)), sizeof(*it));
+
+    if (syn.eof())
+        throw std::runtime_error(
+            "End-of-file reached prematurely in synaptic file (.SYN): "
+            + fileName);
+    else if (!syn.good())
+        throw std::runtime_error("Error while reading synaptic file (.SYN): "
+                                 + fileName);
+    else if (syn.get() != std::fstream::traits_type::eof())
+        throw std::runtime_error(
+            "Synaptic file (.SYN) size larger than expected: " + fileName);
+}
+
+N2D2::FcCell_CSpike::~FcCell_CSpike()
+{
+    for (unsigned int k = 0, size = mSynapses.size(); k < size; ++k)
+        delete &mSynapses[k];
+}
@@ -19,6 +19,7 @@
 */
 
 #include "Cell/FcCell_Frame.hpp"
+#include "utils/Gemm.hpp"
 
 N2D2::Registrar<N2D2::FcCell>
 N2D2::FcCell_Frame::mRegistrar("Frame", N2D2::FcCell_Frame::create);
@@ -33,7 +34,9 @@ N2D2::FcCell_Frame::FcCell_Frame(const std::string& name,
       // IMPORTANT: Do not change the value of the parameters here! Use
       // setParameter() or loadParameters().,
       mDropConnect(this, "DropConnect", 1.0),
-      mLockRandom(false)
+      mLockRandom(false),
+      mMaskCounter(0),
+      mQuantizationBits(0)
 {
     // ctor
     mWeightsSolver = std::make_shared<SGDSolver_Frame<Float_T> >();
@@ -67,61 +70,63 @@ void N2D2::FcCell_Frame::propagate(bool inference)
 {
     mInputs.synchronizeDToH();
 
+    if (mQuantizationBits > 0) {
+        propagateQuantized();
+        return;
+    }
+
     const unsigned int outputSize = mOutputs.dimX() * mOutputs.dimY()
                                     * mOutputs.dimZ();
-    const unsigned int count = mInputs.dimB() * outputSize;
 
-    Float_T beta = 0.0;
+    if (!mNoBias) {
+        for (unsigned int batchPos = 0; batchPos < mInputs.dimB(); ++batchPos)
+        {
+            for (unsigned int output = 0; output < outputSize; ++output)
+                mOutputs(output, batchPos) = mBias(output);
+        }
+    } else
+        mOutputs.fill(0.0);
+
+    const bool drawMasks = (mDropConnect < 1.0 && !inference && !mLockRandom);
 
     for (unsigned int k = 0, size = mInputs.size(); k < size; ++k) {
-        if (k > 0)
-            beta = 1.0;
-
-        if (mDropConnect < 1.0 && !inference && !mLockRandom) {
-            // Random::randBernoulli() is not thread-safe!
-            for (unsigned int index = 0; index < mDropConnectMask[k].size();
-                 ++index)
-                mDropConnectMask[k](index)
-                    = Random::randBernoulli(mDropConnect);
+        const unsigned int nbChannels = mInputs[k].size() / mInputs.dimB();
+
+        if (drawMasks) {
+            // Own key of the cell (see DropoutCell_Frame::propagate()), with
+            // one stream per input
+            Random::fillBernoulli(mDropConnectMask[k],
+                                  mDropConnect,
+                                  Random::streamSeed(Random::getSeed(),
+                                                     Random::streamId(mName),
+                                                     mMaskCounter),
+                                  k);
         }
 
-        const Tensor4d<Float_T>& synapses = mSynapses[k];
-
-#if defined(_OPENMP) && _OPENMP >= 200805
-#pragma omp parallel for collapse(2) if (count > 16)
-#else
-#pragma omp parallel for if (mInputs.dimB() > 4 && count > 16)
-#endif
-        for (int batchPos = 0; batchPos < (int)mInputs.dimB(); ++batchPos) {
-            for (unsigned int output = 0; output < outputSize; ++output) {
-                const Tensor3d<Float_T> inputs = mInputs[k][batchPos];
-                const int inputSize = inputs.size();
-
-                // Compute the weighted sum
-                Float_T weightedSum = (!mNoBias) ? mBias(output) : 0.0;
-
-                if (mDropConnect < 1.0 && !inference) {
-                    for (int channel = 0; channel < inputSize; ++channel) {
-                        if (mDropConnectMask[k](channel, output))
-                            weightedSum += inputs(channel)
-                                           * synapses(channel, output);
-                    }
-                } else {
-                    // init with weightedSum and not 0.0 to match for loop
-                    // (otherwise it can lead to different result because of
-                    // limited machine precision)
-                    weightedSum = std::inner_product(inputs.begin(),
-                                                     inputs.end(),
-                                                     synapses[output].begin(),
-                                                     weightedSum);
-                }
-
-                mOutputs(output, batchPos)
-                    = weightedSum + beta * mOutputs(output, batchPos);
-            }
-        }
+        const Float_T* synapses = (mDropConnect < 1.0 && !inference)
+                                      ? maskedSynapses(k)
+                                      : &mSynapses[k](0);
+
+        // mOutputs (batch x outputs) += mInputs[k] (batch x channels)
+        //                               * mSynapses[k]^T (channels x outputs)
+        Gemm::sgemm(Gemm::NoTrans,
+                    Gemm::Trans,
+                    mInputs.dimB(),
+                    outputSize,
+                    nbChannels,
+                    1.0,
+                    &mInputs[k](0),
+                    nbChannels,
+                    synapses,
+                    nbChannels,
+                    1.0,
+                    &mOutputs(0),
+                    outputSize);
     }
 
+    if (drawMasks)
+        ++mMaskCounter;
+
     Cell_Frame::propagate();
     mDiffInputs.clearValid();
 }
@@ -141,69 +146,54 @@ void N2D2::FcCell_Frame::backPropagate()
             Tensor4d<Float_T>& diffOutputs = mDiffOutputs[k];
             const Float_T beta = (diffOutputs.isValid()) ? 1.0 : 0.0;
 
-            const Tensor4d<Float_T>& synapses = mSynapses[k];
-            const unsigned int count = mInputs.dimB() * nbChannels;
-
-#if defined(_OPENMP) && _OPENMP >= 200805
-#pragma omp parallel for collapse(2) if (count > 16)
-#else
-#pragma omp parallel for if (mInputs.dimB() > 4 && count > 16)
-#endif
-            for (int batchPos = 0; batchPos < (int)mInputs.dimB(); ++batchPos) {
-                for (unsigned int channel = 0; channel < nbChannels; ++channel)
-                {
-                    const Tensor3d<Float_T> diffInputs = mDiffInputs[batchPos];
-
-                    Float_T gradient = 0.0;
-
-                    if (mDropConnect < 1.0) {
-                        for (unsigned int output = 0; output < outputSize;
-                             ++output)
-                        {
-                            if (mDropConnectMask[k](channel, output))
-                                gradient += synapses(channel, output)
-                                            * diffInputs(output);
-                        }
-                    }
-                    else {
-                        for (unsigned int output = 0; output < outputSize;
-                             ++output)
-                        {
-                            gradient += synapses(channel, output)
-                                        * diffInputs(output);
-                        }
-                    }
-
-                    diffOutputs(channel, batchPos) = gradient
-                        + beta * diffOutputs(channel, batchPos);
-                }
-            }
+            const Float_T* synapses = (mDropConnect < 1.0)
+                                          ? maskedSynapses(k)
+                                          : &mSynapses[k](0);
+
+            // diffOutputs (batch x channels) = mDiffInputs (batch x outputs)
+            //                      * mSynapses[k] (outputs x channels)
+            Gemm::sgemm(Gemm::NoTrans,
+                        Gemm::NoTrans,
+                        input.dimB(),
+                        nbChannels,
+                        outputSize,
+                        1.0,
+                        &mDiffInputs(0),
+                        outputSize,
+                        synapses,
+                        nbChannels,
+                        beta,
+                        &diffOutputs(0),
+                        nbChannels);
 
             diffOutputs.setValid();
         }
 
         Tensor4d<Float_T>& diffSynapses = mDiffSynapses[k];
-        const unsigned int count2 = nbChannels * mNbOutputs;
 
-#if defined(_OPENMP) && _OPENMP >= 200805
-#pragma omp parallel for collapse(2) if (count2 > 16)
-#else
-#pragma omp parallel for if (mNbOutputs > 4 && count2 > 16)
-#endif
-        for (int output = 0; output < (int)mNbOutputs; ++output) {
-            for (unsigned int channel = 0; channel < nbChannels; ++channel) {
-                if (!(mDropConnect < 1.0)
-                    || mDropConnectMask[k](channel, output)) {
-                    Float_T sum = 0.0;
-
-                    for (unsigned int batchPos = 0; batchPos < input.dimB();
-                         ++batchPos)
-                        sum += input(channel, batchPos)
-                               * mDiffInputs(output, batchPos);
-
-                    diffSynapses(channel, output) = sum;
-                } else
-                    diffSynapses(channel, output) = 0.0;
+        // diffSynapses (outputs x channels) = mDiffInputs^T (outputs x batch)
+        //                                     * mInputs[k] (batch x channels)
+        Gemm::sgemm(Gemm::Trans,
+                    Gemm::NoTrans,
+                    outputSize,
+                    nbChannels,
+                    input.dimB(),
+                    1.0,
+                    &mDiffInputs(0),
+                    outputSize,
+                    &input(0),
+                    nbChannels,
+                    0.0,
+                    &diffSynapses(0),
+                    nbChannels);
+
+        if (mDropConnect < 1.0) {
+            const int count = diffSynapses.size();
+
+#pragma omp parallel for if (count > 1024)
+            for (int index = 0; index < count; ++index) {
+                if (!mDropConnectMask[k](index))
+                    diffSynapses(index) = 0.0;
             }
         }
     }
@@ -234,6 +224,107 @@ void N2D2::FcCell_Frame::update()
         mBiasSolver->update(&mBias, &mDiffBias, mInputs.dimB());
 }
 
+void N2D2::FcCell_Frame::setQuantization(unsigned int nbBits,
+                                         const Quantization::Signals& inputs,
+                                         const Quantization::Signals& outputs)
+{
+    for (unsigned int k = 0, size = mQuantizedSynapses.size(); k < size; ++k)
+        delete &mQuantizedSynapses[k];
+
+    mQuantizedSynapses.clear();
+    mSynapsesScales.clear();
+    mQuantizedBias.clear();
+    mQuantizationBits = 0;
+
+    if (nbBits == 0)
+        return;
+
+    if (nbBits < 2 || nbBits > 8)
+        throw std::domain_error("FcCell_Frame::setQuantization(): the "
+                                "integer inference is limited to 2 to 8 bits "
+                                "for cell " + mName);
+
+    if (!(inputs.scale > 0.0) || !(outputs.scale > 0.0))
+        throw std::domain_error("FcCell_Frame::setQuantization(): "
+                                "the signals scales must be > 0 for cell "
+                                + mName);
+
+    mSynapsesScales = Quantization::weightsScales(mSynapses, nbBits);
+
+    for (unsigned int k = 0, size = mSynapses.size(); k < size; ++k) {
+        mQuantizedSynapses.push_back(new Tensor4d<signed char>());
+        Quantization::quantizeWeights(mSynapses[k],
+                                      mSynapsesScales,
+                                      nbBits,
+                                      mQuantizedSynapses.back());
+    }
+
+    if (!mNoBias) {
+        mQuantizedBias.resize(mSynapsesScales.size());
+
+        for (unsigned int output = 0; output < mQuantizedBias.size();
+             ++output)
+        {
+            mQuantizedBias[output] = (int)Utils::round(
+                mBias(output) / (inputs.scale * mSynapsesScales[output]));
+        }
+    }
+
+    mAccumulators.resize(mOutputs.dimX(),
+                         mOutputs.dimY(),
+                         mOutputs.dimZ(),
+                         mOutputs.dimB());
+
+    mQuantizationBits = nbBits;
+    mQuantizedInputs = inputs;
+    mQuantizedOutputs = outputs;
+}
+
+void N2D2::FcCell_Frame::propagateQuantized()
+{
+    const unsigned int outputSize = mOutputs.dimX() * mOutputs.dimY()
+                                    * mOutputs.dimZ();
+    const int size = mInputs.dimB() * outputSize;
+
+    for (unsigned int k = 0, nbInputs = mInputs.size(); k < nbInputs; ++k) {
+        const unsigned int nbChannels = mInputs[k].size() / mInputs.dimB();
+
+        Quantization::quantizeSignals(mInputs[k],
+                                      mQuantizedInputs,
+                                      mQuantizationBits,
+                                      mQuantizedInputsData);
+
+        const Tensor4d<signed char>& synapses = mQuantizedSynapses[k];
+
+#pragma omp parallel for if (size > 16)
+        for (int index = 0; index < size; ++index) {
+            const unsigned int batchPos = index / outputSize;
+            const unsigned int output = index % outputSize;
+            const short* input = &mQuantizedInputsData(0, batchPos);
+            const signed char* weights = &synapses(0, output);
+            int weightedSum = 0;
+
+            for (unsigned int channel = 0; channel < nbChannels; ++channel)
+                weightedSum += weights[channel] * input[channel];
+
+            if (k > 0)
+                mAccumulators(index) += weightedSum;
+            else
+                mAccumulators(index) = weightedSum;
+        }
+    }
+
+    Quantization::dequantize(mAccumulators,
+                             mQuantizedBias,
+                             mQuantizedInputs.scale,
+                             mSynapsesScales,
+                             mOutputs);
+
+    Cell_Frame::propagate();
+    Quantization::requantize(mOutputs, mQuantizedOutputs, mQuantizationBits);
+    mDiffInputs.clearValid();
+}
+
 void N2D2::FcCell_Frame::checkGradient(double epsilon, double maxError)
 {
     GradientCheck gc(epsilon, maxError);
@@ -280,13 +371,13 @@ void N2D2::FcCell_Frame::saveFreeParameters(const std::string& fileName) const
                                  + fileName);
 
     for (unsigned int k = 0; k < mSynapses.size(); ++k) {
-        for (std::vector<Float_T>::const_iterator it = mSynapses[k].begin();
+        for (Tensor4d<Float_T>::const_iterator it = mSynapses[k].begin();
              it != mSynapses[k].end();
              ++it)
             syn.write(reinterpret_cast<const char*>(&(*it)), sizeof(*it));
     }
 
-    for (std::vector<Float_T>::const_iterator it = mBias.begin();
+    for (Tensor4d<Float_T>::const_iterator it = mBias.begin();
          it != mBias.end();
          ++it)
         syn.write(reinterpret_cast<const char*>(&(*it)), sizeof(*it));
@@ -312,13 +403,13 @@ void N2D2::FcCell_Frame::loadFreeParameters(const std::string& fileName,
     }
 
     for (unsigned int k = 0; k < mSynapses.size(); ++k) {
-        for (std::vector<Float_T>::iterator it = mSynapses[k].begin();
+        for (Tensor4d<Float_T>::iterator it = mSynapses[k].begin();
              it != mSynapses[k].end();
              ++it)
             syn.read(reinterpret_cast<char*>(&(*it)), sizeof(*it));
     }
 
-    for (std::vector<Float_T>::iterator it = mBias.begin(); it != mBias.end();
+    for (Tensor4d<Float_T>::iterator it = mBias.begin(); it != mBias.end();
          ++it)
         syn.read(reinterpret_cast<char*>(&(*it)), sizeof(*it));
 
@@ -334,8 +425,26 @@ void N2D2::FcCell_Frame::loadFreeParameters(const std::string& fileName,
             "Synaptic file (.SYN) size larger than expected: " + fileName);
 }
 
+const N2D2::Float_T* N2D2::FcCell_Frame::maskedSynapses(unsigned int k)
+{
+    const Tensor4d<Float_T>& synapses = mSynapses[k];
+    mMaskedSynapses.resize(synapses.size());
+
+    const int count = synapses.size();
+
+#pragma omp parallel for if (count > 1024)
+    for (int index = 0; index < count; ++index)
+        mMaskedSynapses[index]
+            = (mDropConnectMask[k](index)) ? synapses(index) : 0.0;
+
+    return &mMaskedSynapses[0];
+}
+
 N2D2::FcCell_Frame::~FcCell_Frame()
 {
     for (unsigned int k = 0, size = mSynapses.size(); k < size; ++k)
         delete &mSynapses[k];
+
+    for (unsigned int k = 0, size = mQuantizedSynapses.size(); k < size; ++k)
+        delete &mQuantizedSynapses[k];
 }
@@ -284,7 +284,7 @@ void N2D2::FcCell_Frame_CUDA::saveFreeParameters(const std::string
     mSynapses.synchronizeDToH();
 
     for (unsigned int k = 0; k < mSynapses.size(); ++k) {
-        for (std::vector<Float_T>::const_iterator it = mSynapses[k].begin();
+        for (Tensor4d<Float_T>::const_iterator it = mSynapses[k].begin();
              it != mSynapses[k].end();
              ++it)
             syn.write(reinterpret_cast<const char*>(&(*it)), sizeof(*it));
@@ -292,7 +292,7 @@ void N2D2::FcCell_Frame_CUDA::saveFreeParameters(const std::string
 
     mBias.synchronizeDToH();
 
-    for (std::vector<Float_T>::const_iterator it = mBias.data().begin();
+    for (Tensor4d<Float_T>::const_iterator it = mBias.data().begin();
          it != mBias.data().end();
          ++it)
         syn.write(reinterpret_cast<const char*>(&(*it)), sizeof(*it));
@@ -318,7 +318,7 @@ void N2D2::FcCell_Frame_CUDA::loadFreeParameters(const std::string& fileName,
     }
 
     for (unsigned int k = 0; k < mSynapses.size(); ++k) {
-        for (std::vector<Float_T>::iterator it = mSynapses[k].begin();
+        for (Tensor4d<Float_T>::iterator it = mSynapses[k].begin();
              it != mSynapses[k].end();
              ++it)
             syn.read(reinterpret_cast<char*>(&(*it)), sizeof(*it));
@@ -326,7 +326,7 @@ void N2D2::FcCell_Frame_CUDA::loadFreeParameters(const std::string& fileName,
 
     mSynapses.synchronizeHToD();
 
-    for (std::vector<Float_T>::iterator it = mBias.data().begin();
+    for (Tensor4d<Float_T>::iterator it = mBias.data().begin();
          it != mBias.data().end();
          ++it)
         syn.read(reinterpret_cast<char*>(&(*it)), sizeof(*it));
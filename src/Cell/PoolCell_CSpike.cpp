@@ -0,0 +1,302 @@
+/*
+    (C) Copyright 2016 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include "Cell/PoolCell_CSpike.hpp"
+
+N2D2::Registrar<N2D2::PoolCell>
+N2D2::PoolCell_CSpike::mRegistrar("CSpike", N2D2::PoolCell_CSpike::create);
+
+N2D2::PoolCell_CSpike::PoolCell_CSpike(const std::string& name,
+                                       unsigned int poolWidth,
+                                       unsigned int poolHeight,
+                                       unsigned int nbOutputs,
+                                       unsigned int strideX,
+                                       unsigned int strideY,
+                                       unsigned int paddingX,
+                                       unsigned int paddingY,
+                                       Pooling pooling)
+    : Cell(name, nbOutputs),
+      PoolCell(name,
+               poolWidth,
+               poolHeight,
+               nbOutputs,
+               strideX,
+               strideY,
+               paddingX,
+               paddingY,
+               pooling),
+      Cell_CSpike(name, nbOutputs)
+{
+    // ctor
+}
+
+void N2D2::PoolCell_CSpike::initialize()
+{
+    if (mPooling == Average && mThreshold <= 0.0)
+        throw std::domain_error("mThreshold is <= 0.0");
+
+    for (unsigned int k = 0, size = mInputs.size(); k < size; ++k) {
+        if (mInputs[k].size() == 0)
+            throw std::runtime_error("Zero-sized input for PoolCell " + mName);
+
+        if (mPooling == Max && mInputsActivity.size() == k) {
+            mInputsActivity.push_back(new Tensor4d<int>(mInputs[k].dimX(),
+                                                        mInputs[k].dimY(),
+                                                        mInputs[k].dimZ(),
+                                                        mInputs[k].dimB(),
+                                                        0));
+        }
+    }
+}
+
+bool N2D2::PoolCell_CSpike::tick(Time_T timestamp)
+{
+    const Float_T leakFactor = leak(timestamp);
+
+    if (mPooling == Max)
+        tickMax();
+    else {
+        tickAverage(leakFactor);
+        fire(timestamp);
+    }
+
+    return false;
+}
+
+void N2D2::PoolCell_CSpike::reset(Time_T timestamp)
+{
+    Cell_CSpike::reset(timestamp);
+    mInputsActivity.fill(0);
+}
+
+void N2D2::PoolCell_CSpike::tickMax()
+{
+    if (!updateInputsActive()) {
+        mOutputs.fill(0);
+        return;
+    }
+
+    const unsigned int dimB = mOutputs.dimB();
+    unsigned int channelOffset = 0;
+
+    // Update the inputs activity, for the input maps that spiked
+    for (unsigned int k = 0, size = mInputs.size(); k < size; ++k) {
+        const Tensor4d<char>& input = mInputs[k];
+        Tensor4d<int>& activity = mInputsActivity[k];
+        const unsigned int mapSize = input.dimX() * input.dimY();
+
+        for (unsigned int batchPos = 0; batchPos < dimB; ++batchPos) {
+            for (unsigned int channel = 0; channel < input.dimZ(); ++channel)
+            {
+                if (!mInputsActive(channelOffset + channel, batchPos))
+                    continue;
+
+                const char* spikes = &input(0, 0, channel, batchPos);
+                int* counts = &activity(0, 0, channel, batchPos);
+
+                for (unsigned int i = 0; i < mapSize; ++i)
+                    counts[i] += spikes[i];
+            }
+        }
+
+        channelOffset += input.dimZ();
+    }
+
+    const unsigned int size = dimB * mNbOutputs;
+
+#if defined(_OPENMP) && _OPENMP >= 200805
+#pragma omp parallel for collapse(2) if (size > 16)
+#else
+#pragma omp parallel for if (dimB > 4 && size > 16)
+#endif
+    for (int batchPos = 0; batchPos < (int)dimB; ++batchPos) {
+        for (unsigned int output = 0; output < mNbOutputs; ++output) {
+            // The output can only spike if one of its input maps did
+            bool active = false;
+
+            for (unsigned int channel = 0; channel < mNbChannels; ++channel) {
+                if (mMaps(output, channel)
+                    && mInputsActive(channel, batchPos)) {
+                    active = true;
+                    break;
+                }
+            }
+
+            for (unsigned int oy = 0; oy < mOutputsHeight; ++oy) {
+                for (unsigned int ox = 0; ox < mOutputsWidth; ++ox) {
+                    char spike = 0;
+
+                    if (active) {
+                        const unsigned int sxMin = (unsigned int)std::max(
+                            (int)mPaddingX - (int)(ox * mStrideX), 0);
+                        const unsigned int syMin = (unsigned int)std::max(
+                            (int)mPaddingY - (int)(oy * mStrideY), 0);
+                        const unsigned int sxMax = Utils::clamp<int>(
+                            mChannelsWidth + mPaddingX - ox * mStrideX,
+                            0,
+                            mPoolWidth);
+                        const unsigned int syMax = Utils::clamp<int>(
+                            mChannelsHeight + mPaddingY - oy * mStrideY,
+                            0,
+                            mPoolHeight);
+
+                        const int ix = (int)(ox * mStrideX) - mPaddingX;
+                        const int iy = (int)(oy * mStrideY) - mPaddingY;
+
+                        int maxActivity = 0;
+                        bool valid = false;
+                        unsigned int offset = 0;
+
+                        for (unsigned int k = 0, nbInputs = mInputs.size();
+                             k < nbInputs;
+                             ++k) {
+                            const Tensor4d<char>& input = mInputs[k];
+                            const Tensor4d<int>& activity
+                                = mInputsActivity[k];
+
+                            for (unsigned int channel = 0;
+                                 channel < input.dimZ();
+                                 ++channel) {
+                                if (!mMaps(output, offset + channel))
+                                    continue;
+
+                                for (unsigned int sy = syMin; sy < syMax;
+                                     ++sy) {
+                                    for (unsigned int sx = sxMin; sx < sxMax;
+                                         ++sx) {
+                                        const int value
+                                            = activity(ix + sx,
+                                                       iy + sy,
+                                                       channel,
+                                                       batchPos);
+
+                                        if (!valid || value > maxActivity) {
+                                            maxActivity = value;
+                                            valid = true;
+                                            spike = input(ix + sx,
+                                                          iy + sy,
+                                                          channel,
+                                                          batchPos);
+                                        }
+                                    }
+                                }
+                            }
+
+                            offset += input.dimZ();
+                        }
+                    }
+
+                    mOutputs(ox, oy, output, batchPos) = spike;
+                    mOutputsActivity(ox, oy, output, batchPos) += spike;
+                }
+            }
+        }
+    }
+}
+
+void N2D2::PoolCell_CSpike::tickAverage(Float_T leakFactor)
+{
+    const bool active = updateInputsActive();
+    const unsigned int dimB = mOutputs.dimB();
+    const unsigned int size = dimB * mNbOutputs;
+
+#if defined(_OPENMP) && _OPENMP >= 200805
+#pragma omp parallel for collapse(2) if (size > 16)
+#else
+#pragma omp parallel for if (dimB > 4 && size > 16)
+#endif
+    for (int batchPos = 0; batchPos < (int)dimB; ++batchPos) {
+        for (unsigned int output = 0; output < mNbOutputs; ++output) {
+            for (unsigned int oy = 0; oy < mOutputsHeight; ++oy) {
+                for (unsigned int ox = 0; ox < mOutputsWidth; ++ox) {
+                    Float_T poolValue = 0.0;
+
+                    if (active) {
+                        const unsigned int sxMin = (unsigned int)std::max(
+                            (int)mPaddingX - (int)(ox * mStrideX), 0);
+                        const unsigned int syMin = (unsigned int)std::max(
+                            (int)mPaddingY - (int)(oy * mStrideY), 0);
+                        const unsigned int sxMax = Utils::clamp<int>(
+                            mChannelsWidth + mPaddingX - ox * mStrideX,
+                            0,
+                            mPoolWidth);
+                        const unsigned int syMax = Utils::clamp<int>(
+                            mChannelsHeight + mPaddingY - oy * mStrideY,
+                            0,
+                            mPoolHeight);
+
+                        const int ix = (int)(ox * mStrideX) - mPaddingX;
+                        const int iy = (int)(oy * mStrideY) - mPaddingY;
+
+                        unsigned int offset = 0;
+
+                        for (unsigned int k = 0, nbInputs = mInputs.size();
+                             k < nbInputs;
+                             ++k) {
+                            const Tensor4d<char>& input = mInputs[k];
+                            int poolSum = 0;
+                            unsigned int poolCount = 0;
+
+                            for (unsigned int channel = 0;
+                                 channel < input.dimZ();
+                                 ++channel) {
+                                if (!mMaps(output, offset + channel))
+                                    continue;
+
+                                // The padding is included in the count, as
+                                // in PoolCell_Frame
+                                poolCount += mPoolWidth * mPoolHeight;
+
+                                // Zero input maps are skipped
+                                if (!mInputsActive(offset + channel, batchPos))
+                                    continue;
+
+                                for (unsigned int sy = syMin; sy < syMax;
+                                     ++sy) {
+                                    const char* spikes = &input(
+                                        0, iy + sy, channel, batchPos);
+
+                                    for (unsigned int sx = sxMin; sx < sxMax;
+                                         ++sx)
+                                        poolSum += spikes[ix + sx];
+                                }
+                            }
+
+                            if (poolCount > 0)
+                                poolValue += poolSum / (Float_T)poolCount;
+
+                            offset += input.dimZ();
+                        }
+                    }
+
+                    Float_T& integration
+                        = mOutputsIntegration(ox, oy, output, batchPos);
+                    integration = leakFactor * integration + poolValue;
+                }
+            }
+        }
+    }
+}
+
+N2D2::PoolCell_CSpike::~PoolCell_CSpike()
+{
+    for (unsigned int k = 0, size = mInputsActivity.size(); k < size; ++k)
+        delete &mInputsActivity[k];
+}
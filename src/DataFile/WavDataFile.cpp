@@ -43,6 +43,7 @@ void N2D2::WavDataFile::write(const std::string& fileName, const cv::Mat& data)
             "WavDataFile::write(): multiple channels WAV not supported: "
             + fileName);
 
-    Sound snd(Tensor2d<double>(data).data());
+    const Tensor2d<double> samples(data);
+    Sound snd(std::vector<double>(samples.begin(), samples.end()));
     snd.save(fileName);
 }
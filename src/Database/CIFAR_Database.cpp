@@ -21,7 +21,9 @@
 #include "Database/CIFAR_Database.hpp"
 
 N2D2::CIFAR_Database::CIFAR_Database(double validation)
-    : Database(true), mValidation(validation)
+    : Database(true),
+      mValidation(validation),
+      mMemoryMapped(this, "MemoryMapped", false)
 {
     // ctor
 }
@@ -31,9 +33,6 @@ void N2D2::CIFAR_Database::loadCIFAR(const std::string& dataFile,
                                      bool coarseAndFine,
                                      bool useCoarse)
 {
-    const unsigned int nbRows = 32;
-    const unsigned int nbColumns = 32;
-
     // Labels
     std::vector<std::string> labelsName;
 
@@ -59,57 +58,67 @@ void N2D2::CIFAR_Database::loadCIFAR(const std::string& dataFile,
         = images.seekg(0, std::ifstream::end).tellg();
     images.seekg(0, std::ifstream::beg);
 
-    const unsigned int nbImages
-        = size / (1 + coarseAndFine + 3 * nbRows * nbColumns);
+    const unsigned int recordSize = 1 + coarseAndFine
+                                    + 3 * NbRows * NbColumns;
+    const unsigned int nbImages = size / recordSize;
 
-    // For each image...
-    for (unsigned int i = 0; i < nbImages; ++i) {
-        // Read label
-        unsigned char label;
-        images.read(reinterpret_cast<char*>(&label), sizeof(label));
+    std::shared_ptr<MappedFile> imagesFile;
+    std::vector<unsigned char> record(recordSize);
 
-        if (coarseAndFine) {
-            unsigned char fineLabel;
-            images.read(reinterpret_cast<char*>(&fineLabel), sizeof(fineLabel));
+    if (mMemoryMapped) {
+        if ((unsigned long long)size != (unsigned long long)nbImages
+                                        * recordSize)
+            throw std::runtime_error("Data file size larger than expected: "
+                                     + dataFile);
 
-            if (!useCoarse)
-                label = fineLabel;
+        imagesFile = std::make_shared<MappedFile>(dataFile);
+    }
+
+    // For each image...
+    for (unsigned int i = 0; i < nbImages; ++i) {
+        const unsigned long long offset = (unsigned long long)i * recordSize;
+        const unsigned char* recordData;
+
+        if (imagesFile)
+            recordData = imagesFile->data() + offset;
+        else {
+            images.read(reinterpret_cast<char*>(&record[0]), recordSize);
+            recordData = &record[0];
         }
 
+        // Read label
+        const unsigned char label = (coarseAndFine && !useCoarse)
+                                        ? recordData[1]
+                                        : recordData[0];
+
         std::ostringstream nameStr;
         nameStr << dataFile << "[" << std::setfill('0') << std::setw(5) << i
                 << "].ppm";
 
-        // ... generate the stimuli
-        if (!std::ifstream(nameStr.str()).good()) {
-            cv::Mat frame(
-                cv::Size(nbColumns, nbRows), CV_8UC3, cv::Scalar(0, 0, 0));
+        if (imagesFile) {
+            // ... locate the stimulus data in the mapped file
+            MappedStimulus stimulus;
+            stimulus.file = imagesFile;
+            stimulus.offset = offset + 1 + coarseAndFine;
 
-            for (int c = 2; c >= 0; --c) {
-                for (unsigned int y = 0; y < nbRows; ++y) {
-                    for (unsigned int x = 0; x < nbColumns; ++x) {
-                        unsigned char color;
-                        images.read(reinterpret_cast<char*>(&color),
-                                    sizeof(color));
-
-                        // Vec3b color order: blue, green, red
-                        frame.at<cv::Vec3b>(y, x)[c] = color;
-                    }
-                }
-            }
+            mMappedStimuli[nameStr.str()] = stimulus;
+        }
+        // ... or generate the stimuli
+        else if (!std::ifstream(nameStr.str()).good()) {
+            const cv::Mat frame = decodeImage(recordData + 1 + coarseAndFine);
 
             if (!cv::imwrite(nameStr.str(), frame))
                 throw std::runtime_error("Unable to write image: "
                                          + nameStr.str());
-        } else {
-            // Skip image data (to grab labels only)
-            images.seekg(3 * nbColumns * nbRows, images.cur);
         }
 
         mStimuli.push_back(Stimulus(nameStr.str(), labelID(labelsName[label])));
         mStimuliSets(Unpartitioned).push_back(mStimuli.size() - 1);
     }
 
+    if (imagesFile)
+        return;
+
     if (images.eof())
         throw std::runtime_error(
             "End-of-file reached prematurely in data file: " + dataFile);
@@ -120,6 +129,34 @@ void N2D2::CIFAR_Database::loadCIFAR(const std::string& dataFile,
                                  + dataFile);
 }
 
+cv::Mat N2D2::CIFAR_Database::readStimulusData(StimulusID id)
+{
+    const std::map<std::string, MappedStimulus>::const_iterator it
+        = mMappedStimuli.find(mStimuli[id].name);
+
+    if (it == mMappedStimuli.end())
+        return Database::readStimulusData(id);
+
+    return decodeImage((*it).second.file->data() + (*it).second.offset);
+}
+
+cv::Mat N2D2::CIFAR_Database::decodeImage(const unsigned char* data)
+{
+    cv::Mat frame(cv::Size(NbColumns, NbRows), CV_8UC3);
+
+    for (int c = 2; c >= 0; --c) {
+        for (unsigned int y = 0; y < NbRows; ++y) {
+            cv::Vec3b* row = frame.ptr<cv::Vec3b>(y);
+
+            // Vec3b color order: blue, green, red
+            for (unsigned int x = 0; x < NbColumns; ++x)
+                row[x][c] = *(data++);
+        }
+    }
+
+    return frame;
+}
+
 N2D2::CIFAR10_Database::CIFAR10_Database(double validation)
     : CIFAR_Database(validation)
 {
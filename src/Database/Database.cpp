@@ -27,6 +27,7 @@ N2D2::Database::csvLocale(std::locale(),
 N2D2::Database::Database(bool loadDataInMemory)
     : mDefaultLabel(this, "DefaultLabel", ""),
       mROIsMargin(this, "ROIsMargin", 0U),
+      mCacheMemoryBudget(this, "CacheMemoryBudget", 0U),
       mLoadDataInMemory(loadDataInMemory),
       mStimuliDepth(-1)
 {
@@ -470,6 +471,8 @@ void N2D2::Database::extractROIs()
         } else
             removeStimulus(id);
     }
+
+    mStimuliCache.clear();
 }
 
 void N2D2::Database::filterROIs(const std::vector<int>& labels,
@@ -505,6 +508,8 @@ void N2D2::Database::filterROIs(const std::vector<int>& labels,
         "    Remaining ROIs: " << (nbRoi - nbRoiRemoved) << "/" << nbRoi << "\n"
         << "    Remaining stimuli: " << (nbStimuli - nbStimuliRemoved) << "/"
         << nbStimuli << std::endl;
+
+    mStimuliCache.clear();
 }
 
 void N2D2::Database::extractLabels(bool removeROIs)
@@ -535,6 +540,8 @@ void N2D2::Database::extractLabels(bool removeROIs)
         } else
             mStimuli[id].label = defaultLabel;
     }
+
+    mStimuliCache.clear();
 }
 
 void N2D2::Database::extractSlices(unsigned int width,
@@ -668,6 +675,8 @@ void N2D2::Database::extractSlices(unsigned int width,
     }
 
     std::cout << std::endl;
+
+    mStimuliCache.clear();
 }
 
 void N2D2::Database::load(const std::string& /*dataPath*/,
@@ -907,6 +916,9 @@ void N2D2::Database::removeStimulus(StimulusID id)
                                  "the stimulus in any of the partition!");
 
     mStimuli.erase(mStimuli.begin() + id);
+
+    // The IDs of the following stimuli changed
+    mStimuliCache.clear();
 }
 
 void N2D2::Database::removeLabel(int label)
@@ -1073,15 +1085,18 @@ int N2D2::Database::getDefaultLabelID() const {
 cv::Mat N2D2::Database::getStimulusData(StimulusID id)
 {
     if (mLoadDataInMemory) {
-        if (mStimuliData.empty()) {
-#pragma omp critical
-            mStimuliData.resize(mStimuli.size());
-        }
+        const MatCache::Key key = 2ULL * id;
+        cv::Mat data;
 
-        if (mStimuliData[id].empty())
-            mStimuliData[id] = loadStimulusData(id);
+        if (!mStimuliCache.get(key, data)) {
+            data = loadStimulusData(id);
+
+            mStimuliCache.setBudget((std::size_t)mCacheMemoryBudget
+                                    * 1024 * 1024);
+            mStimuliCache.insert(key, data);
+        }
 
-        return mStimuliData[id];
+        return data;
     } else
         return loadStimulusData(id);
 }
@@ -1089,15 +1104,18 @@ cv::Mat N2D2::Database::getStimulusData(StimulusID id)
 cv::Mat N2D2::Database::getStimulusLabelsData(StimulusID id)
 {
     if (mLoadDataInMemory) {
-        if (mStimuliLabelsData.empty()) {
-#pragma omp critical
-            mStimuliLabelsData.resize(mStimuli.size());
-        }
+        const MatCache::Key key = 2ULL * id + 1;
+        cv::Mat labels;
 
-        if (mStimuliLabelsData[id].empty())
-            mStimuliLabelsData[id] = loadStimulusLabelsData(id);
+        if (!mStimuliCache.get(key, labels)) {
+            labels = loadStimulusLabelsData(id);
 
-        return mStimuliLabelsData[id];
+            mStimuliCache.setBudget((std::size_t)mCacheMemoryBudget
+                                    * 1024 * 1024);
+            mStimuliCache.insert(key, labels);
+        }
+
+        return labels;
     } else
         return loadStimulusLabelsData(id);
 }
@@ -1169,6 +1187,21 @@ int N2D2::Database::labelID(const std::string& labelName)
 }
 
 cv::Mat N2D2::Database::loadStimulusData(StimulusID id)
+{
+    cv::Mat data = readStimulusData(id);
+
+    if (mStimuli[id].label >= 0 && !mStimuli[id].ROIs.empty()) {
+        // Non-composite stimulus with ROI
+        data = mStimuli[id].ROIs[0]->extract(data);
+    }
+
+    if (mStimuli[id].slice != NULL)
+        data = mStimuli[id].slice->extract(data);
+
+    return data;
+}
+
+cv::Mat N2D2::Database::readStimulusData(StimulusID id)
 {
     // Initialize mStimuliDepth using the first stimulus
     if (mStimuliDepth == -1) {
@@ -1214,14 +1247,6 @@ cv::Mat N2D2::Database::loadStimulusData(StimulusID id)
         data = dataConverted;
     }
 
-    if (mStimuli[id].label >= 0 && !mStimuli[id].ROIs.empty()) {
-        // Non-composite stimulus with ROI
-        data = mStimuli[id].ROIs[0]->extract(data);
-    }
-
-    if (mStimuli[id].slice != NULL)
-        data = mStimuli[id].slice->extract(data);
-
     return data;
 }
 
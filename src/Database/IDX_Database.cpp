@@ -21,7 +21,7 @@
 #include "Database/IDX_Database.hpp"
 
 N2D2::IDX_Database::IDX_Database(bool loadDataInMemory)
-    : Database(loadDataInMemory)
+    : Database(loadDataInMemory), mMemoryMapped(this, "MemoryMapped", false)
 {
     // ctor
 }
@@ -89,38 +89,59 @@ void N2D2::IDX_Database::load(const std::string& dataPath,
         throw std::runtime_error(
             "The number of images and the number of labels does not match.");
 
+    std::vector<unsigned char> labelsData(nbImages);
+
+    if (nbImages > 0)
+        labels.read(reinterpret_cast<char*>(&labelsData[0]), nbImages);
+
+    const unsigned long long imageSize = nbColumns * nbRows;
+    std::shared_ptr<MappedFile> imagesFile;
+    unsigned long long dataOffset = 0;
+
+    if (mMemoryMapped) {
+        imagesFile = std::make_shared<MappedFile>(dataPath);
+        dataOffset = images.tellg();
+
+        if (imagesFile->size() < dataOffset + nbImages * imageSize)
+            throw std::runtime_error(
+                "End-of-file reached prematurely in data file: " + dataPath);
+
+        // Skip the images data (for the checks below)
+        images.seekg(nbImages * imageSize, images.cur);
+    }
+
     // For each image...
     for (unsigned int i = 0; i < nbImages; ++i) {
-        unsigned char buff;
-
         std::ostringstream nameStr;
         nameStr << dataPath << "[" << std::setfill('0') << std::setw(5) << i
                 << "].pgm";
 
-        // ... generate the stimuli
-        if (!std::ifstream(nameStr.str()).good()) {
-            cv::Mat frame(cv::Size(nbColumns, nbRows), CV_8UC1);
+        if (imagesFile) {
+            // ... locate the stimulus data in the mapped file
+            MappedStimulus stimulus;
+            stimulus.file = imagesFile;
+            stimulus.offset = dataOffset + i * imageSize;
+            stimulus.rows = nbRows;
+            stimulus.cols = nbColumns;
 
-            for (unsigned int y = 0; y < nbRows; ++y) {
-                for (unsigned int x = 0; x < nbColumns; ++x) {
-                    images.read(reinterpret_cast<char*>(&buff), sizeof(buff));
-                    frame.at<unsigned char>(y, x) = buff;
-                }
-            }
+            mMappedStimuli[nameStr.str()] = stimulus;
+        }
+        // ... or generate the stimuli
+        else if (!std::ifstream(nameStr.str()).good()) {
+            cv::Mat frame(cv::Size(nbColumns, nbRows), CV_8UC1);
+            images.read(reinterpret_cast<char*>(frame.data), imageSize);
 
             if (!cv::imwrite(nameStr.str(), frame))
                 throw std::runtime_error("Unable to write image: "
                                          + nameStr.str());
         } else {
             // Skip image data (to grab labels only)
-            images.seekg(nbColumns * nbRows, images.cur);
+            images.seekg(imageSize, images.cur);
         }
 
         // ... attach the corresponding label
-        labels.read(reinterpret_cast<char*>(&buff), sizeof(buff));
-
         std::ostringstream labelStr;
-        labelStr << (unsigned int)buff;
+        labelStr << (unsigned int)labelsData[i];
 
         mStimuli.push_back(Stimulus(nameStr.str(), labelID(labelStr.str())));
         mStimuliSets(Unpartitioned).push_back(mStimuli.size() - 1);
@@ -144,3 +165,21 @@ void N2D2::IDX_Database::load(const std::string& dataPath,
         throw std::runtime_error("Data file size larger than expected: "
                                  + labelPath);
 }
+
+cv::Mat N2D2::IDX_Database::readStimulusData(StimulusID id)
+{
+    const std::map<std::string, MappedStimulus>::const_iterator it
+        = mMappedStimuli.find(mStimuli[id].name);
+
+    if (it == mMappedStimuli.end())
+        return Database::readStimulusData(id);
+
+    // Matrix header on the mapped data, without copy. The mapping is
+    // read-only: the matrix is never written, as the StimuliProvider clones
+    // it before applying any transformation.
+    return cv::Mat((*it).second.rows,
+                   (*it).second.cols,
+                   CV_8UC1,
+                   const_cast<unsigned char*>((*it).second.file->data()
+                                              + (*it).second.offset));
+}
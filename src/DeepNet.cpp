@@ -19,6 +19,15 @@
 */
 
 #include "DeepNet.hpp"
+#include "Cell/Cell_Frame.hpp"
+#include "Cell/ConvCell_Frame.hpp"
+#include "Cell/DeconvCell.hpp"
+#include "Cell/FcCell_Frame.hpp"
+#include "Cell/LRNCell.hpp"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 N2D2::DeepNet::RangeStats::RangeStats()
     : minVal(0.0), maxVal(0.0), moments(3, 0.0)
@@ -26,6 +35,23 @@ N2D2::DeepNet::RangeStats::RangeStats()
     // ctor
 }
 
+N2D2::DeepNet::MemoryPlan::MemoryPlan()
+    : nbSlots(0), nbPlannedCells(0), initialBytes(0), plannedBytes(0)
+{
+    // ctor
+}
+
+N2D2::DeepNet::CheckpointPlan::CheckpointPlan()
+    : nbCheckpoints(0),
+      nbRecomputedCells(0),
+      initialBytes(0),
+      peakBytes(0),
+      forwardConnections(0),
+      recomputedConnections(0)
+{
+    // ctor
+}
+
 double N2D2::DeepNet::RangeStats::mean() const
 {
     return (moments[1] / moments[0]);
@@ -67,6 +93,10 @@ N2D2::DeepNet::DeepNet(Network& net)
       mLayers(1, std::vector<std::string>(1, "env")),
       mSignalsDiscretization(0),
       mFreeParametersDiscretization(0),
+      mChannelBlock(1),
+      mConcurrentCells(true),
+      mCellsFused(false),
+      mQuantized(false),
       mFreeParametersDiscretized(false),
       mStreamIdx(0),
       mStreamTestIdx(0)
@@ -409,6 +439,856 @@ void N2D2::DeepNet::initialize()
             mCells[(*itCell)]->initialize();
         }
     }
+
+    if (mChannelBlock > 1)
+        applyChannelBlock();
+}
+
+void N2D2::DeepNet::applyChannelBlock()
+{
+    if (mChannelBlock != 8 && mChannelBlock != 16) {
+        std::stringstream msgStr;
+        msgStr << "DeepNet::applyChannelBlock(): channel block must be 1 "
+                  "(disabled), 8 or 16 (got " << mChannelBlock << ")";
+
+        throw std::runtime_error(msgStr.str());
+    }
+
+    // The targets read the outputs of their cell in the plain layout
+    std::set<std::string> targetCells;
+
+    for (std::vector<std::shared_ptr<Target> >::const_iterator itTargets
+         = mTargets.begin(),
+         itTargetsEnd = mTargets.end();
+         itTargets != itTargetsEnd;
+         ++itTargets) {
+        targetCells.insert((*itTargets)->getCell()->getName());
+    }
+
+    std::vector<std::string> blockedCells;
+
+    for (std::map<std::string, std::shared_ptr<Cell> >::const_iterator itCells
+         = mCells.begin(),
+         itCellsEnd = mCells.end();
+         itCells != itCellsEnd;
+         ++itCells) {
+        const std::shared_ptr<Cell_Frame> cellFrame
+            = std::dynamic_pointer_cast<Cell_Frame>((*itCells).second);
+
+        if (!cellFrame || !cellFrame->isChannelBlockable()
+            || targetCells.find((*itCells).first) != targetCells.end())
+            continue;
+
+        // The outputs are blocked only if every child cell can consume them,
+        // so that no conversion is needed between blocked cells
+        bool blockable = false;
+
+        for (std::multimap<std::string, std::string>::const_iterator itParent
+             = mParentLayers.begin(),
+             itParentEnd = mParentLayers.end();
+             itParent != itParentEnd;
+             ++itParent) {
+            if ((*itParent).second != (*itCells).first)
+                continue;
+
+            const std::shared_ptr<Cell_Frame> childFrame
+                = std::dynamic_pointer_cast
+                  <Cell_Frame>((*mCells.find((*itParent).first)).second);
+
+            if (!childFrame || !childFrame->isChannelBlockable()) {
+                blockable = false;
+                break;
+            }
+
+            blockable = true;
+        }
+
+        if (blockable) {
+            cellFrame->setChannelBlock(mChannelBlock);
+            blockedCells.push_back((*itCells).first);
+        }
+    }
+
+    std::cout << "Channel-blocked layout (" << mChannelBlock
+              << " channels) for cells:";
+
+    for (std::vector<std::string>::const_iterator it = blockedCells.begin(),
+                                                  itEnd = blockedCells.end();
+         it != itEnd;
+         ++it)
+        std::cout << " " << (*it);
+
+    std::cout << std::endl;
+}
+
+unsigned int N2D2::DeepNet::fuseCells()
+{
+    std::set<std::string> targetCells;
+
+    for (std::vector<std::shared_ptr<Target> >::const_iterator itTargets
+         = mTargets.begin(),
+         itTargetsEnd = mTargets.end();
+         itTargets != itTargetsEnd;
+         ++itTargets) {
+        targetCells.insert((*itTargets)->getCell()->getName());
+    }
+
+    unsigned int nbFused = 0;
+
+    for (unsigned int l = 1; l < mLayers.size(); ++l) {
+        // Copy, as the layer is modified in the loop
+        const std::vector<std::string> layer = mLayers[l];
+
+        for (std::vector<std::string>::const_iterator itCell = layer.begin(),
+                                                      itCellEnd = layer.end();
+             itCell != itCellEnd;
+             ++itCell) {
+            const std::shared_ptr<Cell> cell = (*mCells.find(*itCell)).second;
+            const std::shared_ptr<BatchNormCell> bnCell
+                = std::dynamic_pointer_cast<BatchNormCell>(cell);
+            const std::shared_ptr<Cell_Frame> bnFrame
+                = std::dynamic_pointer_cast<Cell_Frame>(cell);
+
+            if (!bnCell || !bnFrame
+                || targetCells.find(*itCell) != targetCells.end())
+                continue;
+
+            const std::vector<std::shared_ptr<Cell> > parents
+                = getParentCells(*itCell);
+
+            if (parents.size() != 1 || !parents[0])
+                continue;
+
+            const std::string convName = parents[0]->getName();
+            const std::shared_ptr<ConvCell> convCell
+                = std::dynamic_pointer_cast<ConvCell>(parents[0]);
+            const std::shared_ptr<Cell_Frame> convFrame
+                = std::dynamic_pointer_cast<Cell_Frame>(parents[0]);
+
+            // The convolution outputs must be the BatchNorm inputs only, in
+            // the same layout as the BatchNorm outputs, and without
+            // activation or sub-sampling in between
+            if (!convCell || !convFrame || convFrame->getActivation()
+                || convCell->getSubSampleX() != 1
+                || convCell->getSubSampleY() != 1
+                || targetCells.find(convName) != targetCells.end()
+                || convFrame->getOutputs().channelBlock()
+                   != bnFrame->getOutputs().channelBlock())
+                continue;
+
+            bool fusable = true;
+
+            for (std::multimap<std::string, std::string>::const_iterator
+                 itParent = mParentLayers.begin(),
+                 itParentEnd = mParentLayers.end();
+                 itParent != itParentEnd;
+                 ++itParent) {
+                if (((*itParent).second == convName
+                     && (*itParent).first != (*itCell))
+                    || ((*itParent).second == (*itCell)
+                        && !std::dynamic_pointer_cast<Cell_Frame>(
+                               (*mCells.find((*itParent).first)).second))) {
+                    fusable = false;
+                    break;
+                }
+            }
+
+            if (!fusable)
+                continue;
+
+            // BatchNorm in inference: y = scale * (x - mean) / sqrt(var + eps)
+            // + bias
+            const unsigned int nbOutputs = convCell->getNbOutputs();
+            const double epsilon = bnCell->getParameter<double>("Epsilon");
+            std::vector<Float_T> scale(nbOutputs);
+            std::vector<Float_T> shift(nbOutputs);
+
+            for (unsigned int output = 0; output < nbOutputs; ++output) {
+                scale[output] = bnCell->getScale(output, 0, 0)
+                    / std::sqrt(bnCell->getVariance(output, 0, 0) + epsilon);
+                shift[output] = bnCell->getBias(output, 0, 0)
+                    - scale[output] * bnCell->getMean(output, 0, 0);
+            }
+
+            convCell->foldScaleShift(scale, shift);
+            convFrame->setActivation(bnFrame->getActivation());
+
+            // The children of the BatchNorm now read the convolution outputs
+            for (std::multimap<std::string, std::string>::iterator itParent
+                 = mParentLayers.begin(),
+                 itParentEnd = mParentLayers.end();
+                 itParent != itParentEnd;
+                 ++itParent) {
+                if ((*itParent).second != (*itCell))
+                    continue;
+
+                std::dynamic_pointer_cast<Cell_Frame>(
+                    (*mCells.find((*itParent).first)).second)
+                    ->replaceInput(bnFrame->getOutputs(),
+                                   convFrame->getOutputs(),
+                                   bnFrame->getDiffInputs(),
+                                   convFrame->getDiffInputs());
+                (*itParent).second = convName;
+            }
+
+            mParentLayers.erase(*itCell);
+            mLayers[l].erase(
+                std::find(mLayers[l].begin(), mLayers[l].end(), *itCell));
+            mCells.erase(*itCell);
+            ++nbFused;
+        }
+    }
+
+    mLayers.erase(std::remove_if(mLayers.begin(),
+                                 mLayers.end(),
+                                 std::mem_fun_ref(
+                                     &std::vector<std::string>::empty)),
+                  mLayers.end());
+
+    if (nbFused > 0)
+        mCellsFused = true;
+
+    return nbFused;
+}
+
+unsigned int N2D2::DeepNet::quantize(const std::map
+                                     <std::string, Quantization::Histogram>&
+                                     outputsHistogram,
+                                     unsigned int nbBits,
+                                     Quantization::Calibration calibration)
+{
+    std::set<std::string> targetCells;
+
+    for (std::vector<std::shared_ptr<Target> >::const_iterator itTargets
+         = mTargets.begin(),
+         itTargetsEnd = mTargets.end();
+         itTargets != itTargetsEnd;
+         ++itTargets) {
+        targetCells.insert((*itTargets)->getCell()->getName());
+    }
+
+    unsigned int nbQuantized = 0;
+
+    for (unsigned int l = 1; l < mLayers.size(); ++l) {
+        for (std::vector<std::string>::const_iterator itCell
+             = mLayers[l].begin(),
+             itCellEnd = mLayers[l].end();
+             itCell != itCellEnd;
+             ++itCell) {
+            const std::shared_ptr<Cell> cell = (*mCells.find(*itCell)).second;
+            const std::shared_ptr<ConvCell_Frame> convFrame
+                = std::dynamic_pointer_cast<ConvCell_Frame>(cell);
+            const std::shared_ptr<FcCell_Frame> fcFrame
+                = std::dynamic_pointer_cast<FcCell_Frame>(cell);
+
+            if (!convFrame && !fcFrame)
+                continue;
+
+            // No integer kernel for these convolutions, they stay in
+            // floating point
+            if (convFrame && (convFrame->getSubSampleX() > 1
+                              || convFrame->getSubSampleY() > 1
+                              || convFrame->getOutputs().channelBlock() > 1))
+                continue;
+
+            // The integer kernels read their inputs in the plain layout
+            const std::vector<std::shared_ptr<Cell> > parentCells
+                = getParentCells(*itCell);
+            bool blockedInputs = false;
+
+            for (std::vector<std::shared_ptr<Cell> >::const_iterator itParent
+                 = parentCells.begin(),
+                 itParentEnd = parentCells.end();
+                 itParent != itParentEnd;
+                 ++itParent) {
+                const std::shared_ptr<Cell_Frame> parentFrame
+                    = std::dynamic_pointer_cast<Cell_Frame>(*itParent);
+
+                if (parentFrame
+                    && parentFrame->getOutputs().channelBlock() > 1) {
+                    blockedInputs = true;
+                    break;
+                }
+            }
+
+            if (blockedInputs)
+                continue;
+
+            // The inputs of a cell share a single scale, covering all its
+            // parents
+            double inputsThreshold = 0.0;
+            bool inputsSigned = false;
+
+            std::pair<std::multimap<std::string, std::string>::const_iterator,
+                      std::multimap<std::string, std::string>::const_iterator>
+            parents = mParentLayers.equal_range(*itCell);
+
+            for (std::multimap<std::string, std::string>::const_iterator
+                 itParent = parents.first;
+                 itParent != parents.second;
+                 ++itParent) {
+                const std::map<std::string, Quantization::Histogram>
+                    ::const_iterator itHistogram
+                    = outputsHistogram.find((*itParent).second);
+
+                if (itHistogram == outputsHistogram.end())
+                    throw std::runtime_error("DeepNet::quantize(): missing "
+                                             "histogram for cell "
+                                             + (*itParent).second);
+
+                inputsThreshold = std::max(inputsThreshold,
+                    (*itHistogram).second.calibrate(calibration, nbBits));
+                inputsSigned = inputsSigned
+                               || (*itHistogram).second.isSigned();
+            }
+
+            const std::map<std::string, Quantization::Histogram>
+                ::const_iterator itHistogram = outputsHistogram.find(*itCell);
+
+            if (itHistogram == outputsHistogram.end())
+                throw std::runtime_error("DeepNet::quantize(): missing "
+                                         "histogram for cell " + (*itCell));
+
+            // The outputs of a target cell are never clipped, as they are
+            // compared against each other to estimate the label
+            const double outputsThreshold = (*itHistogram).second.calibrate(
+                (targetCells.find(*itCell) != targetCells.end())
+                    ? Quantization::MaxAbs : calibration,
+                nbBits);
+            const bool outputsSigned = (*itHistogram).second.isSigned();
+
+            if (!(inputsThreshold > 0.0) || !(outputsThreshold > 0.0)) {
+                std::cout << Utils::cwarning << "Null signals for cell "
+                          << (*itCell) << ", not quantized" << Utils::cdef
+                          << std::endl;
+                continue;
+            }
+
+            const Quantization::Signals inputs(inputsThreshold
+                / Quantization::maxValue(nbBits, inputsSigned), inputsSigned);
+            const Quantization::Signals outputs(outputsThreshold
+                / Quantization::maxValue(nbBits, outputsSigned), outputsSigned);
+
+            if (convFrame)
+                convFrame->setQuantization(nbBits, inputs, outputs);
+            else
+                fcFrame->setQuantization(nbBits, inputs, outputs);
+
+            ++nbQuantized;
+        }
+    }
+
+    if (nbQuantized > 0)
+        mQuantized = true;
+
+    return nbQuantized;
+}
+
+N2D2::DeepNet::MemoryPlan N2D2::DeepNet::planMemory()
+{
+    if (!mPlannedOutputs.empty())
+        throw std::runtime_error("DeepNet::planMemory(): the memory is "
+                                 "already planned");
+
+    // The network is not learned anymore: no recomputation
+    for (unsigned int l = 1; l < mLayers.size(); ++l)
+        allocateRecomputed(l);
+
+    mRecomputedCells.clear();
+    mCheckpoints.clear();
+
+    // The outputs of these cells are read after test(), they keep their own
+    // buffer
+    const std::set<std::string> keptCells = getObservedCells();
+
+    std::map<std::string, unsigned int> cellLayer;
+    std::map<std::string, unsigned int> lastLayer;
+    getOutputsLifetime(cellLayer, lastLayer);
+
+    MemoryPlan plan;
+    // Last layer using each slot
+    std::vector<unsigned int> slotLastLayer;
+    std::vector<std::size_t> slotCapacity;
+
+    for (unsigned int l = 1; l < mLayers.size(); ++l) {
+        for (std::vector<std::string>::const_iterator itCell
+             = mLayers[l].begin(),
+             itCellEnd = mLayers[l].end();
+             itCell != itCellEnd;
+             ++itCell) {
+            const std::shared_ptr<Cell_Frame> cellFrame
+                = std::dynamic_pointer_cast<Cell_Frame>(
+                    (*mCells.find(*itCell)).second);
+
+            if (!cellFrame)
+                continue;
+
+            Tensor4d<Float_T>& outputs = cellFrame->getOutputs();
+            Tensor4d<Float_T>& diffInputs = cellFrame->getDiffInputs();
+            const std::size_t size = outputs.size();
+
+            plan.initialBytes += (size + diffInputs.size()) * sizeof(Float_T);
+
+            // No gradient in inference
+            Tensor4d<Float_T>::data_type().swap(diffInputs.data());
+
+            if (keptCells.find(*itCell) != keptCells.end()) {
+                plan.plannedBytes += size * sizeof(Float_T);
+                continue;
+            }
+
+            // Best fit among the free slots, or the largest free slot (which
+            // grows) if none is large enough
+            int bestSlot = -1;
+
+            for (unsigned int slot = 0; slot < slotLastLayer.size(); ++slot) {
+                if (slotLastLayer[slot] >= l)
+                    continue;
+
+                if (bestSlot < 0)
+                    bestSlot = slot;
+                else {
+                    const std::size_t bestCapacity = slotCapacity[bestSlot];
+                    const std::size_t capacity = slotCapacity[slot];
+
+                    if ((capacity >= size
+                         && (bestCapacity < size || capacity < bestCapacity))
+                        || (bestCapacity < size && capacity > bestCapacity))
+                        bestSlot = slot;
+                }
+            }
+
+            if (bestSlot < 0) {
+                bestSlot = slotLastLayer.size();
+                slotLastLayer.push_back(0);
+                slotCapacity.push_back(0);
+            }
+
+            slotLastLayer[bestSlot] = lastLayer[*itCell];
+            slotCapacity[bestSlot] = std::max(slotCapacity[bestSlot], size);
+
+            PlannedOutputs plannedOutputs;
+            plannedOutputs.slot = bestSlot;
+            plannedOutputs.lastLayer = lastLayer[*itCell];
+            plannedOutputs.size = size;
+            mPlannedOutputs.insert(std::make_pair(*itCell, plannedOutputs));
+
+            // The outputs are only backed by their slot from now
+            Tensor4d<Float_T>::data_type().swap(outputs.data());
+        }
+    }
+
+    mMemorySlots.resize(slotCapacity.size());
+
+    for (unsigned int slot = 0; slot < slotCapacity.size(); ++slot) {
+        mMemorySlots[slot].reserve(slotCapacity[slot]);
+        plan.plannedBytes += slotCapacity[slot] * sizeof(Float_T);
+    }
+
+    // Give the released buffers back to the system
+    MemoryPool::releaseCached();
+
+    plan.nbSlots = mMemorySlots.size();
+    plan.nbPlannedCells = mPlannedOutputs.size();
+    return plan;
+}
+
+N2D2::DeepNet::CheckpointPlan
+N2D2::DeepNet::planCheckpoints(std::size_t memoryBudget)
+{
+    if (mCellsFused || mQuantized || !mPlannedOutputs.empty())
+        throw std::runtime_error("DeepNet::planCheckpoints(): the network "
+                                 "was optimized for inference, it cannot be "
+                                 "learned");
+
+    // Outputs released by the previous plan
+    for (unsigned int l = 1; l < mLayers.size(); ++l)
+        allocateRecomputed(l);
+
+    mRecomputedCells.clear();
+    mCheckpoints.clear();
+
+    const unsigned int nbLayers = mLayers.size();
+    CheckpointPlan plan;
+
+    if (nbLayers < 2)
+        return plan;
+
+    // The outputs of these cells are read outside of the back-propagation
+    const std::set<std::string> observedCells = getObservedCells();
+
+    std::map<std::string, unsigned int> cellLayer;
+    std::map<std::string, unsigned int> lastLayer;
+    getOutputsLifetime(cellLayer, lastLayer);
+
+    // Cells whose propagation has no side effect (no random mask, no moving
+    // average), which can be run twice in a row. The Fc cells with
+    // DropConnect draw a new mask at each propagation and are excluded below.
+    std::set<std::string> recomputableTypes;
+    recomputableTypes.insert(ConvCell::Type);
+    recomputableTypes.insert(DeconvCell::Type);
+    recomputableTypes.insert(FcCell::Type);
+    recomputableTypes.insert(LRNCell::Type);
+    recomputableTypes.insert(PoolCell::Type);
+    recomputableTypes.insert(SoftmaxCell::Type);
+
+    std::vector<std::string> candidates;
+    std::vector<std::size_t> candidateBytes;
+    std::vector<unsigned long long int> candidateConnections;
+    // Outputs of the candidates of each layer
+    std::vector<std::size_t> layerBytes(nbLayers, 0);
+    std::size_t keptBytes = 0;
+
+    for (unsigned int l = 1; l < nbLayers; ++l) {
+        for (std::vector<std::string>::const_iterator itCell
+             = mLayers[l].begin(),
+             itCellEnd = mLayers[l].end();
+             itCell != itCellEnd;
+             ++itCell) {
+            const std::shared_ptr<Cell> cell = (*mCells.find(*itCell)).second;
+            const std::shared_ptr<Cell_Frame> cellFrame
+                = std::dynamic_pointer_cast<Cell_Frame>(cell);
+
+            if (!cellFrame)
+                continue;
+
+            const Tensor4d<Float_T>& outputs = cellFrame->getOutputs();
+            // Includes the padding of the channel-blocked layout
+            const std::size_t bytes = outputs.size() * sizeof(Float_T);
+
+            Cell::Stats stats;
+            cell->getStats(stats);
+            const unsigned long long int connections
+                = stats.nbConnections * outputs.dimB();
+
+            plan.initialBytes += bytes;
+            plan.forwardConnections += connections;
+
+            const bool dropConnect
+                = (cell->getType() == FcCell::Type
+                   && cell->isParameter("DropConnect")
+                   && cell->getParameter<double>("DropConnect") < 1.0);
+
+            // The last layer is always a checkpoint
+            if (l < nbLayers - 1
+                && recomputableTypes.find(cell->getType())
+                   != recomputableTypes.end()
+                && !dropConnect
+                && observedCells.find(*itCell) == observedCells.end())
+            {
+                candidates.push_back(*itCell);
+                candidateBytes.push_back(bytes);
+                candidateConnections.push_back(connections);
+                layerBytes[l] += bytes;
+            }
+            else
+                keptBytes += bytes;
+        }
+    }
+
+    // Greedy segmentation: a layer becomes a checkpoint when the outputs
+    // accumulated since the previous one exceed a threshold. Every sum of
+    // consecutive layers is tried as threshold, 0 meaning no recomputation.
+    std::set<std::size_t> thresholds;
+    thresholds.insert(0);
+
+    for (unsigned int first = 1; first < nbLayers - 1; ++first) {
+        std::size_t sum = 0;
+
+        for (unsigned int l = first; l < nbLayers - 1; ++l) {
+            sum += layerBytes[l];
+            thresholds.insert(sum);
+        }
+    }
+
+    std::vector<bool> bestCheckpoints;
+    std::size_t bestPeak = 0;
+    unsigned long long int bestConnections = 0;
+    bool bestFits = false;
+
+    for (std::set<std::size_t>::const_iterator itThreshold
+         = thresholds.begin(),
+         itThresholdEnd = thresholds.end();
+         itThreshold != itThresholdEnd;
+         ++itThreshold) {
+        std::vector<bool> checkpoints(nbLayers, false);
+        checkpoints[nbLayers - 1] = true;
+        std::size_t segment = 0;
+
+        for (unsigned int l = 1; l < nbLayers - 1; ++l) {
+            segment += layerBytes[l];
+
+            if (segment > (*itThreshold)) {
+                checkpoints[l] = true;
+                segment = 0;
+            }
+        }
+
+        // Checkpoint ending the segment of each layer
+        std::vector<unsigned int> segmentEnd(nbLayers, nbLayers - 1);
+
+        for (unsigned int l = nbLayers - 2; l > 0; --l)
+            segmentEnd[l] = (checkpoints[l]) ? l : segmentEnd[l + 1];
+
+        // A cell read after the end of its segment is not recomputed, as its
+        // outputs are needed before the segment is
+        std::vector<std::size_t> segmentBytes(nbLayers, 0);
+        std::size_t peak = keptBytes;
+        unsigned long long int connections = 0;
+
+        for (unsigned int c = 0; c < candidates.size(); ++c) {
+            const unsigned int layer = cellLayer[candidates[c]];
+
+            if (!checkpoints[layer]
+                && lastLayer[candidates[c]] <= segmentEnd[layer])
+            {
+                segmentBytes[segmentEnd[layer]] += candidateBytes[c];
+                connections += candidateConnections[c];
+            }
+            else
+                peak += candidateBytes[c];
+        }
+
+        peak += *std::max_element(segmentBytes.begin(), segmentBytes.end());
+
+        const bool fits = (peak <= memoryBudget);
+        // Least recomputations within the budget, or lowest peak otherwise
+        bool better;
+
+        if (bestCheckpoints.empty() || fits != bestFits)
+            better = fits || bestCheckpoints.empty();
+        else if (fits) {
+            better = (connections < bestConnections
+                      || (connections == bestConnections && peak < bestPeak));
+        }
+        else {
+            better = (peak < bestPeak
+                      || (peak == bestPeak && connections < bestConnections));
+        }
+
+        if (better) {
+            bestCheckpoints.swap(checkpoints);
+            bestPeak = peak;
+            bestConnections = connections;
+            bestFits = fits;
+        }
+    }
+
+    for (unsigned int l = 1; l < nbLayers; ++l) {
+        if (bestCheckpoints[l])
+            mCheckpoints.push_back(l);
+    }
+
+    for (unsigned int c = 0; c < candidates.size(); ++c) {
+        const unsigned int layer = cellLayer[candidates[c]];
+        const unsigned int checkpoint = *std::lower_bound(
+            mCheckpoints.begin(), mCheckpoints.end(), layer);
+
+        if (!bestCheckpoints[layer]
+            && lastLayer[candidates[c]] <= checkpoint)
+        {
+            Tensor4d<Float_T>& outputs = std::dynamic_pointer_cast
+                <Cell_Frame>((*mCells.find(candidates[c])).second)
+                ->getOutputs();
+
+            RecomputedOutputs recomputedOutputs;
+            recomputedOutputs.layer = layer;
+            recomputedOutputs.lastLayer = lastLayer[candidates[c]];
+            recomputedOutputs.size = outputs.size();
+            mRecomputedCells.insert(std::make_pair(candidates[c],
+                                                   recomputedOutputs));
+
+            // Released until the next propagation
+            Tensor4d<Float_T>::data_type().swap(outputs.data());
+        }
+    }
+
+    plan.nbCheckpoints = mCheckpoints.size();
+    plan.nbRecomputedCells = mRecomputedCells.size();
+    plan.peakBytes = bestPeak;
+    plan.recomputedConnections = bestConnections;
+    return plan;
+}
+
+std::set<std::string> N2D2::DeepNet::getObservedCells() const
+{
+    std::set<std::string> observedCells;
+
+    for (std::vector<std::shared_ptr<Target> >::const_iterator itTargets
+         = mTargets.begin(),
+         itTargetsEnd = mTargets.end();
+         itTargets != itTargetsEnd;
+         ++itTargets) {
+        observedCells.insert((*itTargets)->getCell()->getName());
+    }
+
+    for (std::map<std::string, std::shared_ptr<Monitor> >::const_iterator
+         itMonitor = mMonitors.begin(),
+         itMonitorEnd = mMonitors.end();
+         itMonitor != itMonitorEnd;
+         ++itMonitor) {
+        observedCells.insert((*itMonitor).first);
+    }
+
+    return observedCells;
+}
+
+void N2D2::DeepNet::getOutputsLifetime(
+    std::map<std::string, unsigned int>& cellLayer,
+    std::map<std::string, unsigned int>& lastLayer) const
+{
+    cellLayer.clear();
+
+    for (unsigned int l = 1; l < mLayers.size(); ++l) {
+        for (std::vector<std::string>::const_iterator itCell
+             = mLayers[l].begin(),
+             itCellEnd = mLayers[l].end();
+             itCell != itCellEnd;
+             ++itCell) {
+            cellLayer[*itCell] = l;
+        }
+    }
+
+    // Lifetime of the outputs: from the cell layer to the last layer of its
+    // children
+    lastLayer = cellLayer;
+
+    for (std::multimap<std::string, std::string>::const_iterator itParent
+         = mParentLayers.begin(),
+         itParentEnd = mParentLayers.end();
+         itParent != itParentEnd;
+         ++itParent) {
+        const std::map<std::string, unsigned int>::iterator itLast
+            = lastLayer.find((*itParent).second);
+
+        if (itLast != lastLayer.end()) {
+            (*itLast).second = std::max((*itLast).second,
+                                        cellLayer[(*itParent).first]);
+        }
+    }
+}
+
+void N2D2::DeepNet::allocateRecomputed(unsigned int layer)
+{
+    for (std::vector<std::string>::const_iterator itCell
+         = mLayers[layer].begin(),
+         itCellEnd = mLayers[layer].end();
+         itCell != itCellEnd;
+         ++itCell) {
+        const std::map<std::string, RecomputedOutputs>::const_iterator
+            itRecomputed = mRecomputedCells.find(*itCell);
+
+        if (itRecomputed == mRecomputedCells.end())
+            continue;
+
+        Tensor4d<Float_T>& outputs = std::dynamic_pointer_cast<Cell_Frame>(
+            (*mCells.find(*itCell)).second)->getOutputs();
+
+        // Size recorded by planCheckpoints(), which includes the padding of
+        // the channel-blocked layout
+        if (outputs.data().empty())
+            outputs.data().resize((*itRecomputed).second.size);
+    }
+}
+
+void N2D2::DeepNet::releaseRecomputed(unsigned int layer, bool backward)
+{
+    for (std::map<std::string, RecomputedOutputs>::const_iterator itCell
+         = mRecomputedCells.begin(),
+         itCellEnd = mRecomputedCells.end();
+         itCell != itCellEnd;
+         ++itCell) {
+        // In the forward pass, the outputs are read until the last child
+        // layer. In the backward pass, the children are back-propagated
+        // before the cell itself.
+        const unsigned int releaseLayer = (backward)
+            ? (*itCell).second.layer : (*itCell).second.lastLayer;
+
+        if (releaseLayer != layer)
+            continue;
+
+        Tensor4d<Float_T>::data_type().swap(
+            std::dynamic_pointer_cast<Cell_Frame>(
+                (*mCells.find((*itCell).first)).second)->getOutputs().data());
+    }
+}
+
+void N2D2::DeepNet::recomputeSegment(unsigned int checkpoint,
+                                     std::vector<std::pair<std::string,
+                                                           double> >* timings)
+{
+    const std::vector<unsigned int>::const_iterator itCheckpoint
+        = std::lower_bound(mCheckpoints.begin(), mCheckpoints.end(),
+                           checkpoint);
+    const unsigned int first = (itCheckpoint == mCheckpoints.begin())
+        ? 1 : (*(itCheckpoint - 1)) + 1;
+
+    for (unsigned int l = first; l < checkpoint; ++l) {
+        allocateRecomputed(l);
+
+        std::vector<Task> tasks;
+
+        for (std::vector<std::string>::const_iterator itCell
+             = mLayers[l].begin(),
+             itCellEnd = mLayers[l].end();
+             itCell != itCellEnd;
+             ++itCell) {
+            // The other cells of the layer kept their outputs
+            if (mRecomputedCells.find(*itCell) == mRecomputedCells.end())
+                continue;
+
+            if (mSignalsDiscretization > 0) {
+                std::dynamic_pointer_cast<Cell_Frame_Top>(
+                    (*mCells.find(*itCell)).second)
+                    ->discretizeSignals(mSignalsDiscretization);
+            }
+
+            tasks.push_back(Task(Task::Propagate, *itCell,
+                                 (*itCell) + "[recompute]"));
+        }
+
+        if (!tasks.empty())
+            runTasks(tasks, timings);
+    }
+}
+
+void N2D2::DeepNet::acquireOutputs(unsigned int layer)
+{
+    for (std::vector<std::string>::const_iterator itCell
+         = mLayers[layer].begin(),
+         itCellEnd = mLayers[layer].end();
+         itCell != itCellEnd;
+         ++itCell) {
+        const std::map<std::string, PlannedOutputs>::const_iterator itPlanned
+            = mPlannedOutputs.find(*itCell);
+
+        if (itPlanned == mPlannedOutputs.end())
+            continue;
+
+        // The slot capacity covers the outputs, no allocation here
+        Tensor4d<Float_T>::data_type& slot
+            = mMemorySlots[(*itPlanned).second.slot];
+        slot.resize((*itPlanned).second.size);
+
+        std::dynamic_pointer_cast<Cell_Frame>((*mCells.find(*itCell)).second)
+            ->getOutputs().data().swap(slot);
+    }
+}
+
+void N2D2::DeepNet::releaseOutputs(unsigned int layer)
+{
+    for (std::map<std::string, PlannedOutputs>::const_iterator itPlanned
+         = mPlannedOutputs.begin(),
+         itPlannedEnd = mPlannedOutputs.end();
+         itPlanned != itPlannedEnd;
+         ++itPlanned) {
+        if ((*itPlanned).second.lastLayer != layer)
+            continue;
+
+        std::dynamic_pointer_cast<Cell_Frame>(
+            (*mCells.find((*itPlanned).first)).second)
+            ->getOutputs().data().swap(mMemorySlots[(*itPlanned).second.slot]);
+    }
 }
 
 void N2D2::DeepNet::spikeCodingCompare(const std::string& dirName,
@@ -640,9 +1520,10 @@ void N2D2::DeepNet::logOutputs(const std::string& dirName,
              itCell != itCellEnd;
              ++itCell) {
             const std::shared_ptr<Cell> cell = (*mCells.find(*itCell)).second;
-            const Tensor3d<Float_T> outputs
-                = std::dynamic_pointer_cast
-                  <Cell_Frame_Top>(cell)->getOutputs()[batchPos];
+            // Read-only access, which is valid for channel-blocked tensors
+            const Tensor4d<Float_T>& cellOutputs
+                = std::dynamic_pointer_cast<Cell_Frame_Top>(cell)->getOutputs();
+            const Tensor3d<Float_T> outputs = cellOutputs[batchPos];
 
             StimuliProvider::logData(dirName + "/" + (*itCell) + ".dat",
                                      outputs);
@@ -664,9 +1545,10 @@ void N2D2::DeepNet::logDiffInputs(const std::string& dirName,
              itCell != itCellEnd;
              ++itCell) {
             const std::shared_ptr<Cell> cell = (*mCells.find(*itCell)).second;
-            const Tensor3d<Float_T> diffInputs
-                = std::dynamic_pointer_cast
-                  <Cell_Frame_Top>(cell)->getDiffInputs()[batchPos];
+            // Read-only access, which is valid for channel-blocked tensors
+            const Tensor4d<Float_T>& cellDiffInputs
+                = std::dynamic_pointer_cast<Cell_Frame_Top>(cell)->getDiffInputs();
+            const Tensor3d<Float_T> diffInputs = cellDiffInputs[batchPos];
 
             StimuliProvider::logData(dirName + "/" + (*itCell) + ".dat",
                                      diffInputs);
@@ -1178,15 +2060,29 @@ void N2D2::DeepNet::logSpikeStats(const std::string& dirName,
 
 void N2D2::DeepNet::learn(std::vector<std::pair<std::string, double> >* timings)
 {
-    const unsigned int nbLayers = mLayers.size();
+    if (mCellsFused)
+        throw std::runtime_error("DeepNet::learn(): the cells were fused for "
+                                 "inference, the network cannot be learned");
 
-    std::chrono::high_resolution_clock::time_point time1, time2;
+    if (mQuantized)
+        throw std::runtime_error("DeepNet::learn(): the cells were quantized "
+                                 "for inference, the network cannot be "
+                                 "learned");
+
+    if (!mPlannedOutputs.empty())
+        throw std::runtime_error("DeepNet::learn(): the memory was planned "
+                                 "for inference, the network cannot be "
+                                 "learned");
+
+    const unsigned int nbLayers = mLayers.size();
 
     if (timings != NULL)
         (*timings).clear();
 
     // Signal propagation
     for (unsigned int l = 1; l < nbLayers; ++l) {
+        std::vector<Task> tasks;
+
         for (std::vector<std::string>::const_iterator itCell
              = mLayers[l].begin(),
              itCellEnd = mLayers[l].end();
@@ -1199,103 +2095,107 @@ void N2D2::DeepNet::learn(std::vector<std::pair<std::string, double> >* timings)
                 throw std::runtime_error(
                     "DeepNet::learn(): learning requires Cell_Frame_Top cells");
 
+            // Discretization is done in place on the inputs, which may be
+            // shared with other cells of the layer
             if (mSignalsDiscretization > 0)
                 cellFrame->discretizeSignals(mSignalsDiscretization);
 
-            //std::cout << "propagate " << mCells[(*itCell)]->getName()
-            //    << std::endl;
-            time1 = std::chrono::high_resolution_clock::now();
-            cellFrame->propagate();
-
-            if (timings != NULL) {
-#ifdef CUDA
-                CHECK_CUDA_STATUS(cudaDeviceSynchronize());
-#endif
-                time2 = std::chrono::high_resolution_clock::now();
-                (*timings).push_back(std::make_pair(
-                    (*itCell) + "[prop]",
-                    std::chrono::duration_cast
-                    <std::chrono::duration<double> >(time2 - time1).count()));
-            }
+            tasks.push_back(Task(Task::Propagate, *itCell,
+                                 (*itCell) + "[prop]"));
         }
+
+        if (!mRecomputedCells.empty())
+            allocateRecomputed(l);
+
+        runTasks(tasks, timings);
+
+        if (!mRecomputedCells.empty())
+            releaseRecomputed(l, false);
     }
 
     // Set targets
+    std::vector<Task> targetTasks;
+
     for (std::vector<std::shared_ptr<Target> >::const_iterator itTargets
          = mTargets.begin(),
          itTargetsEnd = mTargets.end();
          itTargets != itTargetsEnd;
          ++itTargets)
     {
-        //std::cout << "process " << (*itTargets)->getName() << std::endl;
-        time1 = std::chrono::high_resolution_clock::now();
-        (*itTargets)->process(Database::Learn);
-
-        if (timings != NULL) {
-#ifdef CUDA
-            CHECK_CUDA_STATUS(cudaDeviceSynchronize());
-#endif
-            time2 = std::chrono::high_resolution_clock::now();
-            (*timings).push_back(std::make_pair(
-                (*itTargets)->getCell()->getName() + "."
-                + (*itTargets)->getType(),
-                std::chrono::duration_cast
-                <std::chrono::duration<double> >(time2 - time1).count()));
-        }
+        const std::string cellName = (*itTargets)->getCell()->getName();
+
+        Task task(Task::ProcessTarget, cellName,
+                  cellName + "." + (*itTargets)->getType());
+        task.target = (*itTargets);
+        task.set = Database::Learn;
+        task.resources.push_back(cellName);
+        targetTasks.push_back(task);
     }
 
+    runTasks(targetTasks, timings);
+
     // Error back-propagation
     for (unsigned int l = nbLayers - 1; l > 0; --l) {
+        // With checkpointing, the outputs of the segment ending at this layer
+        // are recomputed first
+        if (!mRecomputedCells.empty()
+            && std::binary_search(mCheckpoints.begin(), mCheckpoints.end(), l))
+        {
+            recomputeSegment(l, timings);
+        }
+
+        std::vector<Task> tasks;
+
         for (std::vector<std::string>::const_iterator itCell
              = mLayers[l].begin(),
              itCellEnd = mLayers[l].end();
              itCell != itCellEnd;
              ++itCell)
         {
-            //std::cout << "back-propagate " << mCells[(*itCell)]->getName()
-            //    << std::endl;
-            time1 = std::chrono::high_resolution_clock::now();
-            std::dynamic_pointer_cast
-                <Cell_Frame_Top>(mCells[(*itCell)])->backPropagate();
-
-            if (timings != NULL) {
-#ifdef CUDA
-                CHECK_CUDA_STATUS(cudaDeviceSynchronize());
-#endif
-                time2 = std::chrono::high_resolution_clock::now();
-                (*timings).push_back(std::make_pair(
-                    (*itCell) + "[back-prop]",
-                    std::chrono::duration_cast
-                    <std::chrono::duration<double> >(time2 - time1).count()));
+            Task task(Task::BackPropagate, *itCell,
+                      (*itCell) + "[back-prop]");
+
+            // The gradients of the cells sharing a parent are accumulated in
+            // its diff. inputs
+            const std::pair<std::multimap<std::string,
+                                          std::string>::const_iterator,
+                            std::multimap<std::string,
+                                          std::string>::const_iterator>
+                parents = mParentLayers.equal_range(*itCell);
+
+            for (std::multimap<std::string, std::string>::const_iterator
+                 itParent = parents.first;
+                 itParent != parents.second;
+                 ++itParent)
+            {
+                if ((*itParent).second != "env")
+                    task.resources.push_back((*itParent).second);
             }
+
+            tasks.push_back(task);
         }
+
+        runTasks(tasks, timings);
+
+        if (!mRecomputedCells.empty())
+            releaseRecomputed(l, true);
     }
 
     // Weights update
     for (unsigned int l = 1; l < nbLayers; ++l) {
+        std::vector<Task> tasks;
+
         for (std::vector<std::string>::const_iterator itCell
              = mLayers[l].begin(),
              itCellEnd = mLayers[l].end();
              itCell != itCellEnd;
              ++itCell)
         {
-            //std::cout << "update " << mCells[(*itCell)]->getName()
-            //    << std::endl;
-            time1 = std::chrono::high_resolution_clock::now();
-            std::dynamic_pointer_cast
-                <Cell_Frame_Top>(mCells[(*itCell)])->update();
-
-            if (timings != NULL) {
-#ifdef CUDA
-                CHECK_CUDA_STATUS(cudaDeviceSynchronize());
-#endif
-                time2 = std::chrono::high_resolution_clock::now();
-                (*timings).push_back(std::make_pair(
-                    (*itCell) + "[update]",
-                    std::chrono::duration_cast
-                    <std::chrono::duration<double> >(time2 - time1).count()));
-            }
+            tasks.push_back(Task(Task::Update, *itCell,
+                                 (*itCell) + "[update]"));
         }
+
+        runTasks(tasks, timings);
     }
 }
 
@@ -1324,13 +2224,13 @@ void N2D2::DeepNet::test(Database::StimuliSet set,
         mFreeParametersDiscretized = true;
     }
 
-    std::chrono::high_resolution_clock::time_point time1, time2;
-
     if (timings != NULL)
         (*timings).clear();
 
     // Signal propagation
     for (unsigned int l = 1; l < nbLayers; ++l) {
+        std::vector<Task> tasks;
+
         for (std::vector<std::string>::const_iterator itCell
              = mLayers[l].begin(),
              itCellEnd = mLayers[l].end();
@@ -1346,29 +2246,163 @@ void N2D2::DeepNet::test(Database::StimuliSet set,
             if (mSignalsDiscretization > 0)
                 cellFrame->discretizeSignals(mSignalsDiscretization);
 
-            time1 = std::chrono::high_resolution_clock::now();
-            cellFrame->propagate(true);
-
-            if (timings != NULL) {
-#ifdef CUDA
-                CHECK_CUDA_STATUS(cudaDeviceSynchronize());
-#endif
-                time2 = std::chrono::high_resolution_clock::now();
-                (*timings).push_back(std::make_pair(
-                    *itCell,
-                    std::chrono::duration_cast
-                    <std::chrono::duration<double> >(time2 - time1).count()));
-            }
+            tasks.push_back(Task(Task::Inference, *itCell, *itCell));
         }
+
+        if (!mPlannedOutputs.empty())
+            acquireOutputs(l);
+        else if (!mRecomputedCells.empty())
+            allocateRecomputed(l);
+
+        runTasks(tasks, timings);
+
+        if (!mPlannedOutputs.empty())
+            releaseOutputs(l);
     }
 
+    std::vector<Task> targetTasks;
+
     for (std::vector<std::shared_ptr<Target> >::const_iterator itTargets
          = mTargets.begin(),
          itTargetsEnd = mTargets.end();
          itTargets != itTargetsEnd;
          ++itTargets) {
+        const std::string cellName = (*itTargets)->getCell()->getName();
+
+        Task task(Task::ProcessTarget, cellName,
+                  cellName + "." + (*itTargets)->getType());
+        task.target = (*itTargets);
+        task.set = set;
+        task.resources.push_back(cellName);
+        targetTasks.push_back(task);
+    }
+
+    runTasks(targetTasks, timings);
+}
+
+N2D2::DeepNet::Task::Task(Type type_,
+                          const std::string& cell_,
+                          const std::string& name_)
+    : type(type_), cell(cell_), name(name_), set(Database::Learn)
+{
+    // ctor
+}
+
+void N2D2::DeepNet::runTasks(const std::vector<Task>& tasks,
+                             std::vector<std::pair<std::string, double> >*
+                                timings)
+{
+    std::chrono::high_resolution_clock::time_point time1, time2;
+
+    // Tasks drawing random numbers get their own stream, so that the result
+    // does not depend on the scheduling, nor on the ConcurrentCells setting
+    const unsigned long long seed = Random::mtRand();
+
+#if !defined(CUDA) && defined(_OPENMP) && _OPENMP >= 200805
+    if (mConcurrentCells && tasks.size() > 1) {
+        // Split the tasks in waves of tasks without shared resources. A task
+        // is run after all the previous tasks sharing one of its resources,
+        // so that the result is the same as with a sequential execution.
+        std::vector<unsigned int> taskWave(tasks.size(), 0);
+        unsigned int nbWaves = 1;
+
+        for (unsigned int t = 1; t < tasks.size(); ++t) {
+            for (unsigned int prev = 0; prev < t; ++prev) {
+                for (std::vector<std::string>::const_iterator it
+                     = tasks[t].resources.begin(),
+                     itEnd = tasks[t].resources.end();
+                     it != itEnd;
+                     ++it) {
+                    if (std::find(tasks[prev].resources.begin(),
+                                  tasks[prev].resources.end(),
+                                  (*it)) != tasks[prev].resources.end())
+                    {
+                        taskWave[t] = std::max(taskWave[t],
+                                               taskWave[prev] + 1);
+                        break;
+                    }
+                }
+            }
+
+            nbWaves = std::max(nbWaves, taskWave[t] + 1);
+        }
+
+        std::vector<double> elapsed(tasks.size(), 0.0);
+
+        for (unsigned int wave = 0; wave < nbWaves; ++wave) {
+            std::vector<unsigned int> waveTasks;
+
+            for (unsigned int t = 0; t < tasks.size(); ++t) {
+                if (taskWave[t] == wave)
+                    waveTasks.push_back(t);
+            }
+
+            // The threads are shared between the concurrent tasks, each task
+            // running its own parallel loops with the remaining threads
+            const int nbTasks = waveTasks.size();
+            const int maxThreads = omp_get_max_threads();
+            const int nbOuterThreads = std::min(nbTasks, maxThreads);
+            const int nbInnerThreads = std::max(1,
+                                                maxThreads / nbOuterThreads);
+            const int maxActiveLevels = omp_get_max_active_levels();
+
+            if (nbInnerThreads > 1)
+                omp_set_max_active_levels(std::max(maxActiveLevels, 2));
+
+            std::string error;
+
+#pragma omp parallel for schedule(dynamic) num_threads(nbOuterThreads)
+            for (int i = 0; i < nbTasks; ++i) {
+                const unsigned int t = waveTasks[i];
+                omp_set_num_threads(nbInnerThreads);
+                Random::ThreadStream stream(seed, t);
+
+                try {
+                    const std::chrono::high_resolution_clock::time_point
+                        taskTime1 = std::chrono::high_resolution_clock::now();
+                    runTask(tasks[t]);
+                    const std::chrono::high_resolution_clock::time_point
+                        taskTime2 = std::chrono::high_resolution_clock::now();
+
+                    elapsed[t] = std::chrono::duration_cast
+                        <std::chrono::duration<double> >(taskTime2
+                                                         - taskTime1).count();
+                }
+                catch (const std::exception& e)
+                {
+#pragma omp critical(DeepNet__runTasks)
+                    if (error.empty())
+                        error = e.what();
+                }
+            }
+
+            omp_set_max_active_levels(maxActiveLevels);
+
+            if (!error.empty())
+                throw std::runtime_error(error);
+        }
+
+        if (timings != NULL) {
+            for (unsigned int t = 0; t < tasks.size(); ++t)
+                (*timings).push_back(std::make_pair(tasks[t].name,
+                                                    elapsed[t]));
+        }
+
+        return;
+    }
+#endif
+
+    for (std::vector<Task>::const_iterator it = tasks.begin(),
+                                           itBegin = tasks.begin(),
+                                           itEnd = tasks.end();
+         it != itEnd;
+         ++it) {
         time1 = std::chrono::high_resolution_clock::now();
-        (*itTargets)->process(set);
+
+        {
+            Random::ThreadStream stream(seed, it - itBegin);
+            runTask(*it);
+        }
 
         if (timings != NULL) {
 #ifdef CUDA
@@ -1376,14 +2410,35 @@ void N2D2::DeepNet::test(Database::StimuliSet set,
 #endif
             time2 = std::chrono::high_resolution_clock::now();
             (*timings).push_back(std::make_pair(
-                (*itTargets)->getCell()->getName() + "."
-                + (*itTargets)->getType(),
+                (*it).name,
                 std::chrono::duration_cast
                 <std::chrono::duration<double> >(time2 - time1).count()));
         }
     }
 }
 
+void N2D2::DeepNet::runTask(const Task& task)
+{
+    if (task.type == Task::ProcessTarget) {
+        task.target->process(task.set);
+        return;
+    }
+
+    // mCells.find() rather than operator[], which is not thread-safe
+    const std::shared_ptr<Cell_Frame_Top> cellFrame
+        = std::dynamic_pointer_cast<Cell_Frame_Top>(
+            (*mCells.find(task.cell)).second);
+
+    if (task.type == Task::Propagate)
+        cellFrame->propagate();
+    else if (task.type == Task::Inference)
+        cellFrame->propagate(true);
+    else if (task.type == Task::BackPropagate)
+        cellFrame->backPropagate();
+    else
+        cellFrame->update();
+}
+
 void N2D2::DeepNet::cTicks(Time_T start, Time_T stop, Time_T timestep)
 {
     const unsigned int nbLayers = mLayers.size();
@@ -1569,6 +2624,11 @@ void
 N2D2::DeepNet::reportOutputsRange(std::map
                                   <std::string, RangeStats>& outputsRange) const
 {
+    // The planned outputs are released into their slot after each layer
+    if (!mPlannedOutputs.empty())
+        throw std::runtime_error("DeepNet::reportOutputsRange(): the memory "
+                                 "was planned, the outputs are not kept");
+
     for (std::vector<std::vector<std::string> >::const_iterator it
          = mLayers.begin(),
          itEnd = mLayers.end();
@@ -1595,6 +2655,42 @@ N2D2::DeepNet::reportOutputsRange(std::map
     }
 }
 
+void N2D2::DeepNet::reportOutputsHistogram(std::map
+                                           <std::string,
+                                           Quantization::Histogram>&
+                                           outputsHistogram) const
+{
+    if (!mPlannedOutputs.empty())
+        throw std::runtime_error("DeepNet::reportOutputsHistogram(): the "
+                                 "memory was planned, the outputs are not "
+                                 "kept");
+
+    for (std::vector<std::vector<std::string> >::const_iterator it
+         = mLayers.begin(),
+         itEnd = mLayers.end();
+         it != itEnd;
+         ++it) {
+        for (std::vector<std::string>::const_iterator itCell = (*it).begin(),
+                                                      itCellEnd = (*it).end();
+             itCell != itCellEnd;
+             ++itCell) {
+            const Tensor4d<Float_T> outputs
+                = (mCells.find(*itCell) != mCells.end())
+                      ? std::dynamic_pointer_cast<Cell_Frame_Top>(
+                            (*mCells.find(*itCell)).second)->getOutputs()
+                      : mStimuliProvider->getData();
+
+            bool newInsert;
+            std::map<std::string, Quantization::Histogram>::iterator
+                itHistogram;
+            std::tie(itHistogram, newInsert) = outputsHistogram.insert(
+                std::make_pair(*itCell, Quantization::Histogram()));
+
+            (*itHistogram).second.fill(outputs);
+        }
+    }
+}
+
 void
 N2D2::DeepNet::logOutputsRange(const std::string& fileName,
                                const std::map
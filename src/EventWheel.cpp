@@ -0,0 +1,212 @@
+/*
+    (C) Copyright 2016 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include "EventWheel.hpp"
+
+#include <algorithm>
+
+#include "SpikeEvent.hpp"
+
+N2D2::EventWheel::EventWheel()
+    : mNow(0),
+      mSize(0),
+      mCurrent(false)
+{
+    // ctor
+    for (unsigned int level = 0; level < NbLevels; ++level) {
+        for (unsigned int w = 0; w < NbWords; ++w)
+            mLevels[level].used[w] = 0;
+    }
+}
+
+void N2D2::EventWheel::push(SpikeEvent* event)
+{
+    const Time_T timestamp = event->getTimestamp();
+    ++mSize;
+
+    if (mCurrent && timestamp == mNow) {
+        mCurrentEvents.push(event);
+        return;
+    }
+
+    if (timestamp < mNow)
+        rewind(timestamp);
+
+    insert(event);
+}
+
+N2D2::SpikeEvent* N2D2::EventWheel::top()
+{
+    if (!mCurrent)
+        advance();
+
+    return mCurrentEvents.top();
+}
+
+void N2D2::EventWheel::pop()
+{
+    if (!mCurrent)
+        advance();
+
+    mCurrentEvents.pop();
+    --mSize;
+
+    if (mCurrentEvents.empty())
+        mCurrent = false;
+}
+
+void N2D2::EventWheel::insert(SpikeEvent* event)
+{
+    const Time_T timestamp = event->getTimestamp();
+
+    // Level = most significant byte where the timestamp differs from mNow
+    Time_T diff = (timestamp ^ mNow);
+    unsigned int level = 0;
+
+    while (diff >= NbSlots) {
+        diff >>= 8;
+        ++level;
+    }
+
+    const unsigned int slot = (timestamp >> (8 * level)) & (NbSlots - 1);
+
+    mLevels[level].slots[slot].push_back(event);
+    mLevels[level].used[slot / 64] |= (1ULL << (slot % 64));
+}
+
+bool N2D2::EventWheel::advance()
+{
+    unsigned int level = 0;
+
+    while (level < NbLevels) {
+        Level& lvl = mLevels[level];
+        const int slot = findSlot(lvl.used, (mNow >> (8 * level))
+                                            & (NbSlots - 1));
+
+        if (slot < 0) {
+            ++level;
+            continue;
+        }
+
+        std::vector<SpikeEvent*>& events = lvl.slots[slot];
+        lvl.used[slot / 64] &= ~(1ULL << (slot % 64));
+
+        if (level == 0) {
+            // Single timestamp slot: it becomes the current timestamp
+            mNow = (mNow & ~((Time_T)NbSlots - 1)) | slot;
+
+            for (std::vector<SpikeEvent*>::const_iterator it = events.begin(),
+                                                          itEnd = events.end();
+                 it != itEnd;
+                 ++it)
+                mCurrentEvents.push(*it);
+
+            events.clear();
+            mCurrent = true;
+            return true;
+        }
+
+        // Cascade the slot to the lower levels, relative to its earliest event
+        std::vector<SpikeEvent*> cascade;
+        cascade.swap(events);
+
+        Time_T minTimestamp = cascade[0]->getTimestamp();
+
+        for (std::vector<SpikeEvent*>::const_iterator it = cascade.begin() + 1,
+                                                      itEnd = cascade.end();
+             it != itEnd;
+             ++it)
+            minTimestamp = std::min(minTimestamp, (*it)->getTimestamp());
+
+        mNow = minTimestamp;
+
+        for (std::vector<SpikeEvent*>::const_iterator it = cascade.begin(),
+                                                      itEnd = cascade.end();
+             it != itEnd;
+             ++it)
+            insert(*it);
+
+        // Give the storage back to the slot
+        cascade.clear();
+        events.swap(cascade);
+        level = 0;
+    }
+
+    return false;
+}
+
+void N2D2::EventWheel::rewind(Time_T timestamp)
+{
+    std::vector<SpikeEvent*> events;
+    events.reserve(mSize);
+
+    while (!mCurrentEvents.empty()) {
+        events.push_back(mCurrentEvents.top());
+        mCurrentEvents.pop();
+    }
+
+    mCurrent = false;
+
+    for (unsigned int level = 0; level < NbLevels; ++level) {
+        for (unsigned int slot = 0; slot < NbSlots; ++slot) {
+            std::vector<SpikeEvent*>& slotEvents = mLevels[level].slots[slot];
+            events.insert(events.end(), slotEvents.begin(), slotEvents.end());
+            slotEvents.clear();
+        }
+
+        for (unsigned int w = 0; w < NbWords; ++w)
+            mLevels[level].used[w] = 0;
+    }
+
+    mNow = timestamp;
+
+    for (std::vector<SpikeEvent*>::const_iterator it = events.begin(),
+                                                  itEnd = events.end();
+         it != itEnd;
+         ++it)
+        insert(*it);
+}
+
+int N2D2::EventWheel::findSlot(const unsigned long long* used,
+                               unsigned int from)
+{
+    unsigned int w = from / 64;
+    unsigned long long bits = used[w] & (~0ULL << (from % 64));
+
+    while (true) {
+        if (bits != 0) {
+#if defined(__GNUC__)
+            return w * 64 + __builtin_ctzll(bits);
+#else
+            unsigned int bit = 0;
+
+            while (!(bits & (1ULL << bit)))
+                ++bit;
+
+            return w * 64 + bit;
+#endif
+        }
+
+        if (++w == NbWords)
+            return -1;
+
+        bits = used[w];
+    }
+}
@@ -26,6 +26,10 @@ N2D2::Registrar<N2D2::BatchNormCellExport>
 N2D2::CPP_BatchNormCellExport::mRegistrar(
     "CPP", N2D2::CPP_BatchNormCellExport::generate);
 
+N2D2::Registrar<N2D2::CPP_CellExport>
+N2D2::CPP_BatchNormCellExport::mRegistrarType(
+    BatchNormCell::Type, N2D2::CPP_BatchNormCellExport::getInstance);
+
 void N2D2::CPP_BatchNormCellExport::generate(BatchNormCell& cell,
                                              const std::string& dirName)
 {
@@ -181,3 +185,46 @@ void N2D2::CPP_BatchNormCellExport::generateHeaderScale(BatchNormCell& cell,
     header << "};\n\n";
 }
 
+std::unique_ptr<N2D2::CPP_BatchNormCellExport>
+N2D2::CPP_BatchNormCellExport::getInstance(Cell& /*cell*/)
+{
+    return std::unique_ptr<CPP_BatchNormCellExport>(new CPP_BatchNormCellExport);
+}
+
+void N2D2::CPP_BatchNormCellExport::generateCellData(Cell& cell,
+                                                     std::ofstream& prog)
+{
+    const std::string identifier = Utils::CIdentifier(cell.getName());
+    const std::string prefix = Utils::upperCase(identifier);
+
+    prog << "static const std::vector<float> " << identifier
+         << "_scales_folded\n"
+            "    = batchnormcell_scales(" << prefix << "_NB_OUTPUTS, "
+         << identifier << "_scales, " << identifier << "_variances,\n"
+            "        " << prefix << "_EPSILON);\n"
+            "static const std::vector<float> " << identifier
+         << "_biases_folded\n"
+            "    = batchnormcell_biases(" << prefix << "_NB_OUTPUTS, "
+         << identifier << "_biases, " << identifier << "_means,\n"
+            "        &" << identifier << "_scales_folded[0]);\n";
+}
+
+void N2D2::CPP_BatchNormCellExport::generateCellFunction(Cell& cell,
+                                                         const std::string
+                                                         & inputName,
+                                                         const std::string
+                                                         & outputName,
+                                                         std::ofstream& prog)
+{
+    const std::string identifier = Utils::CIdentifier(cell.getName());
+    const std::string prefix = Utils::upperCase(identifier);
+
+    prog << "            batchnormcell_propagate<" << prefix
+         << "_ACTIVATION>(" << prefix << "_NB_OUTPUTS,\n"
+            "                " << prefix << "_OUTPUTS_HEIGHT, "
+         << prefix << "_OUTPUTS_WIDTH,\n"
+            "                " << inputName << ",\n"
+            "                &" << identifier << "_scales_folded[0], &"
+         << identifier << "_biases_folded[0],\n"
+            "                " << outputName << ");\n";
+}
@@ -53,3 +53,17 @@ void N2D2::CPP_CellExport::generateHeaderEnd(Cell& cell, std::ofstream& header)
     header.close();
 }
 
+
+void N2D2::CPP_CellExport::generateOutputFunction(Cell& cell,
+                                                  const std::string& inputName,
+                                                  const std::string& outputName,
+                                                  std::ofstream& prog)
+{
+    const std::string prefix = Utils::upperCase(Utils::CIdentifier(
+                                                            cell.getName()));
+
+    prog << "            output_generation(" << prefix << "_NB_OUTPUTS, "
+         << prefix << "_OUTPUTS_HEIGHT, "
+         << prefix << "_OUTPUTS_WIDTH,\n"
+            "                " << inputName << ", " << outputName << ");\n";
+}
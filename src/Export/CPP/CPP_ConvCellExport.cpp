@@ -23,6 +23,10 @@
 N2D2::Registrar<N2D2::ConvCellExport>
 N2D2::CPP_ConvCellExport::mRegistrar("CPP", N2D2::CPP_ConvCellExport::generate);
 
+N2D2::Registrar<N2D2::CPP_CellExport>
+N2D2::CPP_ConvCellExport::mRegistrarType(
+    ConvCell::Type, N2D2::CPP_ConvCellExport::getInstance);
+
 void N2D2::CPP_ConvCellExport::generate(ConvCell& cell,
                                         const std::string& dirName)
 {
@@ -264,3 +268,60 @@ void N2D2::CPP_ConvCellExport::generateHeaderWeightsValues(ConvCell& cell,
 
     header << "};\n\n";
 }
+
+std::unique_ptr<N2D2::CPP_ConvCellExport>
+N2D2::CPP_ConvCellExport::getInstance(Cell& /*cell*/)
+{
+    return std::unique_ptr<CPP_ConvCellExport>(new CPP_ConvCellExport);
+}
+
+void N2D2::CPP_ConvCellExport::generateCellData(Cell& cell,
+                                                std::ofstream& prog)
+{
+    const ConvCell& convCell = dynamic_cast<const ConvCell&>(cell);
+
+    if (convCell.getSubSampleX() != 1 || convCell.getSubSampleY() != 1) {
+        throw std::runtime_error("Sub-sampling is not supported by the CPP "
+                                 "export for cell " + cell.getName());
+    }
+
+    const std::string identifier = Utils::CIdentifier(cell.getName());
+    const std::string prefix = Utils::upperCase(identifier);
+
+    prog << "static const std::vector<WDATA_T> " << identifier
+         << "_weights_hwc\n"
+            "    = convcell_weights(" << prefix << "_NB_CHANNELS, "
+         << prefix << "_NB_OUTPUTS,\n"
+            "        " << prefix << "_KERNEL_HEIGHT, "
+         << prefix << "_KERNEL_WIDTH, "
+         << identifier << "_weights);\n";
+}
+
+void N2D2::CPP_ConvCellExport::generateCellFunction(Cell& cell,
+                                                    const std::string
+                                                    & inputName,
+                                                    const std::string
+                                                    & outputName,
+                                                    std::ofstream& prog)
+{
+    const std::string identifier = Utils::CIdentifier(cell.getName());
+    const std::string prefix = Utils::upperCase(identifier);
+
+    prog << "            convcell_propagate<" << prefix << "_ACTIVATION>("
+         << prefix << "_NB_CHANNELS,\n"
+            "                " << prefix << "_CHANNELS_HEIGHT, "
+         << prefix << "_CHANNELS_WIDTH,\n"
+            "                " << prefix << "_PADDING_Y, "
+         << prefix << "_PADDING_X,\n"
+            "                " << prefix << "_STRIDE_Y, "
+         << prefix << "_STRIDE_X,\n"
+            "                " << inputName << ",\n"
+            "                " << prefix << "_NB_OUTPUTS, "
+         << prefix << "_OUTPUTS_HEIGHT, "
+         << prefix << "_OUTPUTS_WIDTH,\n"
+            "                " << prefix << "_KERNEL_HEIGHT, "
+         << prefix << "_KERNEL_WIDTH,\n"
+            "                &" << identifier << "_biases[0], &"
+         << identifier << "_weights_hwc[0],\n"
+            "                " << outputName << ");\n";
+}
@@ -25,6 +25,15 @@ N2D2::CPP_DeepNetExport::mRegistrar("CPP", N2D2::CPP_DeepNetExport::generate);
 
 void N2D2::CPP_DeepNetExport::generate(DeepNet& deepNet,
                                        const std::string& dirName)
+{
+    generateCommon(deepNet, dirName);
+
+    generateDeepNetHeader(deepNet, dirName + "/include/network.hpp");
+    generateDeepNetProgram(deepNet, dirName + "/src/network.cpp");
+}
+
+void N2D2::CPP_DeepNetExport::generateCommon(DeepNet& deepNet,
+                                             const std::string& dirName)
 {
     Utils::createDirectories(dirName + "/include");
     Utils::createDirectories(dirName + "/src");
@@ -162,3 +171,204 @@ void N2D2::CPP_DeepNetExport::generateHeaderEnd(DeepNet& /*deepNet*/,
               "#endif" << std::endl;
     header.close();
 }
+
+void N2D2::CPP_DeepNetExport::generateDeepNetHeader(DeepNet& deepNet,
+                                                    const std::string
+                                                    & fileName)
+{
+    std::ofstream header(fileName.c_str());
+
+    if (!header.good())
+        throw std::runtime_error("Could not create CPP network file: "
+                                 + fileName);
+
+    generateHeaderBegin(deepNet, header, fileName);
+    generateHeaderIncludes(deepNet, "", header);
+
+    header << "\n"
+              "#if ENV_DATA_UNSIGNED\n"
+              "typedef UDATA_T ENV_DATA_T;\n"
+              "#else\n"
+              "typedef DATA_T ENV_DATA_T;\n"
+              "#endif\n"
+              "\n"
+              "// The stimuli of the batch are processed in parallel with "
+              "OpenMP\n"
+              "void network(const ENV_DATA_T* in_data, uint32_t* out_data, "
+              "unsigned int batchSize);\n";
+
+    generateHeaderEnd(deepNet, header);
+}
+
+void N2D2::CPP_DeepNetExport::generateDeepNetProgram(DeepNet& deepNet,
+                                                     const std::string
+                                                     & fileName)
+{
+    std::ofstream prog(fileName.c_str());
+
+    if (!prog.good())
+        throw std::runtime_error("Could not create CPP network file: "
+                                 + fileName);
+
+    // Append date & time to the file.
+    const time_t now = std::time(0);
+    tm* localNow = std::localtime(&now);
+
+    prog << "// N2D2 auto-generated file.\n"
+            "// @ " << std::asctime(localNow)
+         << "\n" // std::asctime() already appends end of line
+            "#include \"network.hpp\"\n"
+            "\n";
+
+    generateProgramData(deepNet, prog);
+    generateProgramFunction(deepNet, prog);
+}
+
+void N2D2::CPP_DeepNetExport::generateProgramData(DeepNet& deepNet,
+                                                  std::ofstream& prog)
+{
+    const std::vector<std::vector<std::string> >& layers = deepNet.getLayers();
+
+    for (std::vector<std::vector<std::string> >::const_iterator itLayer
+         = layers.begin() + 1,
+         itLayerEnd = layers.end();
+         itLayer != itLayerEnd;
+         ++itLayer) {
+        for (std::vector<std::string>::const_iterator it = (*itLayer).begin(),
+                                                      itEnd = (*itLayer).end();
+             it != itEnd;
+             ++it) {
+            Cell& cell = *deepNet.getCell(*it);
+            CPP_CellExport::getInstance(cell)->generateCellData(cell, prog);
+        }
+    }
+
+    prog << "\n";
+}
+
+void N2D2::CPP_DeepNetExport::generateProgramFunction(DeepNet& deepNet,
+                                                      std::ofstream& prog)
+{
+    const std::vector<std::vector<std::string> >& layers = deepNet.getLayers();
+
+    prog << "void network(const ENV_DATA_T* in_data, uint32_t* out_data, "
+            "unsigned int batchSize)\n"
+            "{\n"
+            "#pragma omp parallel\n"
+            "    {\n"
+            "        // Per-thread buffers, in HWC order\n"
+            "        std::vector<ENV_DATA_T> env_buffer(ENV_BUFFER_SIZE);\n";
+
+    for (std::vector<std::vector<std::string> >::const_iterator itLayer
+         = layers.begin() + 1,
+         itLayerEnd = layers.end();
+         itLayer != itLayerEnd;
+         ++itLayer) {
+        for (std::vector<std::string>::const_iterator it = (*itLayer).begin(),
+                                                      itEnd = (*itLayer).end();
+             it != itEnd;
+             ++it) {
+            const std::shared_ptr<Cell> cell = deepNet.getCell(*it);
+            const std::string identifier
+                = Utils::CIdentifier(cell->getName());
+            const std::vector<std::shared_ptr<Cell> > parentCells
+                = deepNet.getParentCells(*it);
+
+            prog << "        std::vector<DATA_T> " << identifier
+                 << "_output(" << Utils::upperCase(identifier)
+                 << "_OUTPUTS_SIZE);\n";
+
+            if (parentCells.size() > 1) {
+                prog << "        std::vector<DATA_T> " << identifier
+                     << "_input(" << Utils::upperCase(identifier)
+                     << "_CHANNELS_SIZE);\n";
+            }
+        }
+    }
+
+    prog << "\n"
+            "#pragma omp for schedule(dynamic)\n"
+            "        for (int batchPos = 0; batchPos < (int)batchSize; "
+            "++batchPos) {\n"
+            "            chw_to_hwc(ENV_NB_OUTPUTS, ENV_SIZE_Y, ENV_SIZE_X,\n"
+            "                in_data + batchPos * ENV_BUFFER_SIZE, "
+            "&env_buffer[0]);\n";
+
+    for (std::vector<std::vector<std::string> >::const_iterator itLayer
+         = layers.begin() + 1,
+         itLayerEnd = layers.end();
+         itLayer != itLayerEnd;
+         ++itLayer) {
+        prog << "\n"
+                "            // LAYER (" << std::distance(layers.begin(),
+                                                         itLayer) << ")\n";
+
+        for (std::vector<std::string>::const_iterator it = (*itLayer).begin(),
+                                                      itEnd = (*itLayer).end();
+             it != itEnd;
+             ++it) {
+            Cell& cell = *deepNet.getCell(*it);
+            const std::string identifier = Utils::CIdentifier(cell.getName());
+            const std::vector<std::shared_ptr<Cell> > parentCells
+                = deepNet.getParentCells(*it);
+            std::string inputName;
+
+            if (parentCells.size() > 1) {
+                // Concatenate the parent outputs along the channels
+                unsigned int channelOffset = 0;
+
+                for (std::vector<std::shared_ptr<Cell> >::const_iterator
+                     itParent = parentCells.begin(),
+                     itParentEnd = parentCells.end();
+                     itParent != itParentEnd;
+                     ++itParent) {
+                    if (!(*itParent)) {
+                        throw std::runtime_error("Concatenation of the "
+                            "environment is not supported by the CPP export "
+                            "for cell " + cell.getName());
+                    }
+
+                    const std::string parentIdentifier
+                        = Utils::CIdentifier((*itParent)->getName());
+                    const std::string parentPrefix
+                        = Utils::upperCase(parentIdentifier);
+
+                    prog << "            concat_channels(" << parentPrefix
+                         << "_OUTPUTS_HEIGHT * " << parentPrefix
+                         << "_OUTPUTS_WIDTH,\n"
+                            "                " << parentPrefix
+                         << "_NB_OUTPUTS, &" << parentIdentifier
+                         << "_output[0],\n"
+                            "                " << channelOffset << ", "
+                         << cell.getNbChannels() << ", &" << identifier
+                         << "_input[0]);\n";
+
+                    channelOffset += (*itParent)->getNbOutputs();
+                }
+
+                inputName = "&" + identifier + "_input[0]";
+            }
+            else if (!parentCells.empty() && parentCells[0]) {
+                inputName = "&" + Utils::CIdentifier(parentCells[0]->getName())
+                            + "_output[0]";
+            }
+            else
+                inputName = "&env_buffer[0]";
+
+            CPP_CellExport::getInstance(cell)->generateCellFunction(
+                cell, inputName, "&" + identifier + "_output[0]", prog);
+        }
+    }
+
+    const std::shared_ptr<Cell> targetCell = deepNet.getTargetCell();
+
+    prog << "\n";
+    CPP_CellExport::generateOutputFunction(*targetCell,
+        "&" + Utils::CIdentifier(targetCell->getName()) + "_output[0]",
+        "out_data + batchPos * OUTPUTS_SIZE",
+        prog);
+
+    prog << "        }\n"
+            "    }\n"
+            "}\n";
+}
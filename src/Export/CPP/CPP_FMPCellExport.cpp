@@ -26,6 +26,10 @@ N2D2::Registrar<N2D2::FMPCellExport>
 N2D2::CPP_FMPCellExport::mRegistrar(
     "CPP", N2D2::CPP_FMPCellExport::generate);
 
+N2D2::Registrar<N2D2::CPP_CellExport>
+N2D2::CPP_FMPCellExport::mRegistrarType(
+    FMPCell::Type, N2D2::CPP_FMPCellExport::getInstance);
+
 void N2D2::CPP_FMPCellExport::generate(FMPCell& cell,
                                        const std::string& dirName)
 {
@@ -224,3 +228,40 @@ void N2D2::CPP_FMPCellExport::generateHeaderGrid(FMPCell& cell,
     }
 }
 
+std::unique_ptr<N2D2::CPP_FMPCellExport>
+N2D2::CPP_FMPCellExport::getInstance(Cell& /*cell*/)
+{
+    return std::unique_ptr<CPP_FMPCellExport>(new CPP_FMPCellExport);
+}
+
+void N2D2::CPP_FMPCellExport::generateCellData(Cell& cell,
+                                               std::ofstream& /*prog*/)
+{
+    if (cell.getNbOutputs() != cell.getNbChannels()) {
+        throw std::runtime_error("Only one-to-one mapping is supported by "
+                                 "the CPP export for cell " + cell.getName());
+    }
+}
+
+void N2D2::CPP_FMPCellExport::generateCellFunction(Cell& cell,
+                                                   const std::string
+                                                   & inputName,
+                                                   const std::string
+                                                   & outputName,
+                                                   std::ofstream& prog)
+{
+    const std::string identifier = Utils::CIdentifier(cell.getName());
+    const std::string prefix = Utils::upperCase(identifier);
+
+    prog << "            fmpcell_propagate<" << prefix << "_ACTIVATION>("
+         << prefix << "_NB_CHANNELS,\n"
+            "                " << prefix << "_CHANNELS_HEIGHT, "
+         << prefix << "_CHANNELS_WIDTH,\n"
+            "                " << identifier << "_gridx_flatten, "
+         << identifier << "_gridy_flatten,\n"
+            "                " << prefix << "_OVERLAPPING,\n"
+            "                " << inputName << ",\n"
+            "                " << prefix << "_OUTPUTS_HEIGHT, "
+         << prefix << "_OUTPUTS_WIDTH,\n"
+            "                " << outputName << ");\n";
+}
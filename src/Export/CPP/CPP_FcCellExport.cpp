@@ -23,6 +23,10 @@
 N2D2::Registrar<N2D2::FcCellExport>
 N2D2::CPP_FcCellExport::mRegistrar("CPP", N2D2::CPP_FcCellExport::generate);
 
+N2D2::Registrar<N2D2::CPP_CellExport>
+N2D2::CPP_FcCellExport::mRegistrarType(
+    FcCell::Type, N2D2::CPP_FcCellExport::getInstance);
+
 void N2D2::CPP_FcCellExport::generate(FcCell& cell, const std::string& dirName)
 {
     Utils::createDirectories(dirName + "/include");
@@ -233,3 +237,50 @@ void N2D2::CPP_FcCellExport::generateHeaderWeightsValues(FcCell& cell,
 
     header << "};\n\n";
 }
+
+std::unique_ptr<N2D2::CPP_FcCellExport>
+N2D2::CPP_FcCellExport::getInstance(Cell& /*cell*/)
+{
+    return std::unique_ptr<CPP_FcCellExport>(new CPP_FcCellExport);
+}
+
+void N2D2::CPP_FcCellExport::generateCellData(Cell& cell,
+                                              std::ofstream& prog)
+{
+    const std::string identifier = Utils::CIdentifier(cell.getName());
+    const std::string prefix = Utils::upperCase(identifier);
+
+    // The N2D2 weights are in CHW inputs order
+    prog << "static const std::vector<WDATA_T> " << identifier
+         << "_weights_hwc\n"
+            "    = fccell_weights(" << cell.getNbChannels() << ", "
+         << cell.getChannelsHeight() << ", "
+         << cell.getChannelsWidth() << ", " << prefix << "_NB_OUTPUTS, ";
+
+    if (mThreshold > 0.0) {
+        prog << prefix << "_NB_WEIGHTS,\n"
+                "        " << identifier << "_weights_sparse, "
+             << identifier << "_weights_offsets);\n";
+    }
+    else
+        prog << identifier << "_weights);\n";
+}
+
+void N2D2::CPP_FcCellExport::generateCellFunction(Cell& cell,
+                                                  const std::string
+                                                  & inputName,
+                                                  const std::string
+                                                  & outputName,
+                                                  std::ofstream& prog)
+{
+    const std::string identifier = Utils::CIdentifier(cell.getName());
+    const std::string prefix = Utils::upperCase(identifier);
+
+    prog << "            fccell_propagate<" << prefix << "_ACTIVATION>("
+         << prefix << "_NB_CHANNELS,\n"
+            "                " << inputName << ",\n"
+            "                " << prefix << "_NB_OUTPUTS,\n"
+            "                &" << identifier << "_biases[0], &"
+         << identifier << "_weights_hwc[0],\n"
+            "                " << outputName << ");\n";
+}
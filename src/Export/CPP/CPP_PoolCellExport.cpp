@@ -23,6 +23,10 @@
 N2D2::Registrar<N2D2::PoolCellExport>
 N2D2::CPP_PoolCellExport::mRegistrar("CPP", N2D2::CPP_PoolCellExport::generate);
 
+N2D2::Registrar<N2D2::CPP_CellExport>
+N2D2::CPP_PoolCellExport::mRegistrarType(
+    PoolCell::Type, N2D2::CPP_PoolCellExport::getInstance);
+
 void N2D2::CPP_PoolCellExport::generate(PoolCell& cell,
                                         const std::string& dirName)
 {
@@ -141,3 +145,49 @@ void N2D2::CPP_PoolCellExport::generateHeaderConnectionsValues(PoolCell& cell,
 
     header << "};\n\n";
 }
+
+std::unique_ptr<N2D2::CPP_PoolCellExport>
+N2D2::CPP_PoolCellExport::getInstance(Cell& /*cell*/)
+{
+    return std::unique_ptr<CPP_PoolCellExport>(new CPP_PoolCellExport);
+}
+
+void N2D2::CPP_PoolCellExport::generateCellData(Cell& cell,
+                                                std::ofstream& prog)
+{
+    const std::string identifier = Utils::CIdentifier(cell.getName());
+    const std::string prefix = Utils::upperCase(identifier);
+
+    prog << "static const std::vector<char> " << identifier
+         << "_mapping_flatten\n"
+            "    = poolcell_mapping(" << prefix << "_NB_CHANNELS, "
+         << prefix << "_NB_OUTPUTS, " << identifier << "_mapping);\n";
+}
+
+void N2D2::CPP_PoolCellExport::generateCellFunction(Cell& cell,
+                                                    const std::string
+                                                    & inputName,
+                                                    const std::string
+                                                    & outputName,
+                                                    std::ofstream& prog)
+{
+    const std::string identifier = Utils::CIdentifier(cell.getName());
+    const std::string prefix = Utils::upperCase(identifier);
+
+    prog << "            poolcell_propagate<" << prefix << "_ACTIVATION, "
+         << prefix << "_POOLING>(" << prefix << "_NB_CHANNELS,\n"
+            "                " << prefix << "_CHANNELS_HEIGHT, "
+         << prefix << "_CHANNELS_WIDTH,\n"
+            "                " << prefix << "_PADDING_Y, "
+         << prefix << "_PADDING_X,\n"
+            "                " << prefix << "_STRIDE_Y, "
+         << prefix << "_STRIDE_X,\n"
+            "                " << inputName << ",\n"
+            "                " << prefix << "_NB_OUTPUTS, "
+         << prefix << "_OUTPUTS_HEIGHT, "
+         << prefix << "_OUTPUTS_WIDTH,\n"
+            "                " << prefix << "_POOL_HEIGHT, "
+         << prefix << "_POOL_WIDTH,\n"
+            "                " << identifier << "_mapping_flatten,\n"
+            "                " << outputName << ");\n";
+}
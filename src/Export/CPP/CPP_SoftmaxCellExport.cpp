@@ -26,6 +26,10 @@ N2D2::Registrar<N2D2::SoftmaxCellExport>
 N2D2::CPP_SoftmaxCellExport::mRegistrar(
     "CPP", N2D2::CPP_SoftmaxCellExport::generate);
 
+N2D2::Registrar<N2D2::CPP_CellExport>
+N2D2::CPP_SoftmaxCellExport::mRegistrarType(
+    SoftmaxCell::Type, N2D2::CPP_SoftmaxCellExport::getInstance);
+
 void N2D2::CPP_SoftmaxCellExport::generate(SoftmaxCell& cell,
                                              const std::string& dirName)
 {
@@ -76,5 +80,30 @@ void N2D2::CPP_SoftmaxCellExport::generateHeaderConstants(SoftmaxCell& cell,
            << "_OUTPUTS_SIZE, " << prefix << "_CHANNELS_SIZE))\n\n";
 }
 
+std::unique_ptr<N2D2::CPP_SoftmaxCellExport>
+N2D2::CPP_SoftmaxCellExport::getInstance(Cell& /*cell*/)
+{
+    return std::unique_ptr<CPP_SoftmaxCellExport>(new CPP_SoftmaxCellExport);
+}
 
+void N2D2::CPP_SoftmaxCellExport::generateCellData(Cell& /*cell*/,
+                                                   std::ofstream& /*prog*/)
+{
+}
 
+void N2D2::CPP_SoftmaxCellExport::generateCellFunction(Cell& cell,
+                                                       const std::string
+                                                       & inputName,
+                                                       const std::string
+                                                       & outputName,
+                                                       std::ofstream& prog)
+{
+    const std::string prefix = Utils::upperCase(Utils::CIdentifier(
+                                                        cell.getName()));
+
+    prog << "            softmaxcell_propagate(" << prefix << "_NB_OUTPUTS, "
+         << prefix << "_OUTPUTS_HEIGHT, "
+         << prefix << "_OUTPUTS_WIDTH,\n"
+            "                " << inputName << ",\n"
+            "                " << outputName << ");\n";
+}
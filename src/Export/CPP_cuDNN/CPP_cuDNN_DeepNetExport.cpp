@@ -27,7 +27,7 @@ N2D2::Registrar<N2D2::DeepNetExport> N2D2::CPP_cuDNN_DeepNetExport::mRegistrar(
 void N2D2::CPP_cuDNN_DeepNetExport::generate(DeepNet& deepNet,
                                              const std::string& dirName)
 {
-    CPP_DeepNetExport::generate(deepNet, dirName);
+    CPP_DeepNetExport::generateCommon(deepNet, dirName);
 
     generateDeepNetHeader(
         deepNet, "network_cudnn", dirName + "/include/network.hpp");
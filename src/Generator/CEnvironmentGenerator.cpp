@@ -41,7 +41,7 @@ std::shared_ptr<N2D2::CEnvironment> N2D2::CEnvironmentGenerator::generate(
         database, sizeX, sizeY, nbChannels, batchSize, compositeStimuli));
     cEnv->setCachePath(cachePath);
 
-    iniConfig.setProperty("_EpochSize", database.getNbStimuli(Database::Learn));
+    setEpochSize(iniConfig, database);
 
     const std::string configSection = iniConfig.getProperty
                                       <std::string>("ConfigSection", "");
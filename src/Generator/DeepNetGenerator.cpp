@@ -21,13 +21,23 @@
 #include "Generator/DeepNetGenerator.hpp"
 
 std::shared_ptr<N2D2::DeepNet>
-N2D2::DeepNetGenerator::generate(Network& network, const std::string& fileName)
+N2D2::DeepNetGenerator::generate(Network& network,
+                                 const std::string& fileName,
+                                 const std::shared_ptr<DeepNet>& inputsNet)
 {
     IniParser iniConfig;
 
     std::cout << "Loading network configuration file " << fileName << std::endl;
     iniConfig.load(fileName);
 
+    return generate(network, iniConfig, inputsNet);
+}
+
+std::shared_ptr<N2D2::DeepNet>
+N2D2::DeepNetGenerator::generate(Network& network,
+                                 IniParser& iniConfig,
+                                 const std::shared_ptr<DeepNet>& inputsNet)
+{
     // Global parameters
     iniConfig.currentSection();
     CellGenerator::mDefaultModel = iniConfig.getProperty
@@ -74,26 +84,36 @@ N2D2::DeepNetGenerator::generate(Network& network, const std::string& fileName)
     deepNet->setFreeParametersDiscretization(
         iniConfig.getProperty
         <unsigned int>("FreeParametersDiscretization", 0U));
-
-    if (iniConfig.isSection("database"))
-        deepNet->setDatabase(
-            DatabaseGenerator::generate(iniConfig, "database"));
-    else {
-        std::cout << Utils::cwarning << "Warning: no database specified."
-                  << Utils::cdef << std::endl;
-        deepNet->setDatabase(std::make_shared<Database>());
+    deepNet->setChannelBlock(
+        iniConfig.getProperty<unsigned int>("ChannelBlock", 1U));
+    deepNet->setConcurrentCells(
+        iniConfig.getProperty<bool>("ConcurrentCells", true));
+
+    if (inputsNet) {
+        deepNet->setDatabase(inputsNet->getDatabase());
+        deepNet->setStimuliProvider(inputsNet->getStimuliProvider());
     }
+    else {
+        if (iniConfig.isSection("database"))
+            deepNet->setDatabase(
+                DatabaseGenerator::generate(iniConfig, "database"));
+        else {
+            std::cout << Utils::cwarning << "Warning: no database specified."
+                      << Utils::cdef << std::endl;
+            deepNet->setDatabase(std::make_shared<Database>());
+        }
 
-    // Set up the environment
-    if (iniConfig.isSection("cenv"))
-        deepNet->setStimuliProvider(CEnvironmentGenerator::generate(
-            *deepNet->getDatabase(), iniConfig, "cenv"));
-    else if (iniConfig.isSection("env"))
-        deepNet->setStimuliProvider(EnvironmentGenerator::generate(
-            network, *deepNet->getDatabase(), iniConfig, "env"));
-    else
-        deepNet->setStimuliProvider(StimuliProviderGenerator::generate(
-            *deepNet->getDatabase(), iniConfig, "sp"));
+        // Set up the environment
+        if (iniConfig.isSection("cenv"))
+            deepNet->setStimuliProvider(CEnvironmentGenerator::generate(
+                *deepNet->getDatabase(), iniConfig, "cenv"));
+        else if (iniConfig.isSection("env"))
+            deepNet->setStimuliProvider(EnvironmentGenerator::generate(
+                network, *deepNet->getDatabase(), iniConfig, "env"));
+        else
+            deepNet->setStimuliProvider(StimuliProviderGenerator::generate(
+                *deepNet->getDatabase(), iniConfig, "sp"));
+    }
 
     // Construct network tree
     // std::cout << "Construct network tree..." << std::endl;
@@ -49,7 +49,7 @@ N2D2::EnvironmentGenerator::generate(Network& network,
                                                      compositeStimuli));
     env->setCachePath(cachePath);
 
-    iniConfig.setProperty("_EpochSize", database.getNbStimuli(Database::Learn));
+    setEpochSize(iniConfig, database);
 
     const std::string configSection = iniConfig.getProperty
                                       <std::string>("ConfigSection", "");
@@ -36,12 +36,23 @@ std::shared_ptr<N2D2::StimuliProvider> N2D2::StimuliProviderGenerator::generate(
                                   <bool>("CompositeStimuli", false);
     const std::string cachePath = iniConfig.getProperty
                                   <std::string>("CachePath", "");
+    const bool packedCache = iniConfig.getProperty<bool>("PackedCache", false);
+    const unsigned int prefetchDepth = iniConfig.getProperty
+                                       <unsigned int>("PrefetchDepth", 0U);
+    const unsigned int prefetchWorkers = iniConfig.getProperty
+                                         <unsigned int>("PrefetchWorkers", 1U);
+    const StimuliSampler::Type sampling = iniConfig.getProperty
+        <StimuliSampler::Type>("Sampling", StimuliSampler::Uniform);
+    const unsigned int samplingWindow = iniConfig.getProperty
+                                        <unsigned int>("SamplingWindow", 1024U);
 
     std::shared_ptr<StimuliProvider> sp(new StimuliProvider(
         database, sizeX, sizeY, nbChannels, batchSize, compositeStimuli));
-    sp->setCachePath(cachePath);
+    sp->setCachePath(cachePath, packedCache);
+    sp->setPrefetch(prefetchDepth, prefetchWorkers);
+    sp->setSampling(sampling, samplingWindow);
 
-    iniConfig.setProperty("_EpochSize", database.getNbStimuli(Database::Learn));
+    setEpochSize(iniConfig, database);
 
     const std::string configSection = iniConfig.getProperty
                                       <std::string>("ConfigSection", "");
@@ -53,6 +64,13 @@ std::shared_ptr<N2D2::StimuliProvider> N2D2::StimuliProviderGenerator::generate(
     return sp;
 }
 
+void N2D2::StimuliProviderGenerator::setEpochSize(IniParser& iniConfig,
+                                                  Database& database)
+{
+    iniConfig.setProperty("_EpochSize",
+        std::max(1U, database.getNbStimuli(Database::Learn)));
+}
+
 void
 N2D2::StimuliProviderGenerator::generateSubSections(const std::shared_ptr
                                                     <N2D2::StimuliProvider>& sp,
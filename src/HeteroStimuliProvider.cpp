@@ -90,9 +90,7 @@ N2D2::Database::StimulusID
 N2D2::HeteroStimuliProvider::readRandomStimulus(Database::StimuliSet set,
                                                 unsigned int batchPos)
 {
-    Database& database = mItems[0]->getDatabase();
-    const unsigned int index
-        = Random::randUniform(0, database.getNbStimuli(set) - 1);
+    const unsigned int index = mItems[0]->getRandomIndex(set);
 
     return readStimulus(set, index, batchPos);
 }
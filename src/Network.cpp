@@ -21,6 +21,13 @@
 
 #include "Network.hpp"
 
+#include <new>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "EventWheel.hpp"
 #include "NodeNeuron.hpp"
 #include "SpikeEvent.hpp"
 #include "Xcell.hpp"
@@ -87,12 +94,17 @@ N2D2::NetworkObserver::~NetworkObserver()
     mNet.removeObserver(this);
 }
 
-N2D2::Network::Network(unsigned int seed)
-    : mInitialized(false),
+N2D2::Network::Network(unsigned int seed, Scheduler scheduler, bool parallel)
+    : mScheduler(scheduler),
+      mInitialized(false),
       mFirstEvent(0),
       mLastEvent(0),
       mStop(0),
       mDiscard(false),
+      mParallel(parallel),
+      mPartitioned(false),
+      mRunning(false),
+      mRunningAlone(false),
       mStartTime(std::chrono::high_resolution_clock::now())
 {
 // ctor
@@ -131,6 +143,9 @@ N2D2::Network::Network(unsigned int seed)
 
     seedFile << seed;
     seedFile.close();
+
+    if (mScheduler == TimingWheel)
+        mEventWheel = std::make_shared<EventWheel>();
 }
 
 bool N2D2::Network::run(Time_T stop, bool clearActivity)
@@ -149,21 +164,66 @@ bool N2D2::Network::run(Time_T stop, bool clearActivity)
         mInitialized = true;
     }
 
-    SpikeEvent* event;
-    bool stopped = false;
-
-    if (!mEvents.empty())
-        mFirstEvent = mEvents.top()->getTimestamp();
+    if (mParallel && !mPartitioned)
+        partition();
 
     mStop = stop;
     mDiscard = false;
 
-    while (!mEvents.empty()) {
-        event = mEvents.top();
+    const bool stopped = (!mPartitions.empty()) ? runPartitions()
+                                                : runEvents();
+
+    std::for_each(mObservers.begin(),
+                  mObservers.end(),
+                  std::bind(&NetworkObserver::notify,
+                            std::placeholders::_1,
+                            mLastEvent,
+                            NetworkObserver::Finalize));
+
+    return stopped;
+}
+
+void N2D2::Network::stop(Time_T stop, bool discard)
+{
+    if (mRunning) {
+        // The partitions already simulated must not have been simulated
+        // further than they would have been with this stop time
+        bool valid = mRunningAlone;
+
+        for (std::vector<Partition>::const_iterator it = mPartitions.begin(),
+                                                    itEnd = mPartitions.end();
+             it != itEnd && valid;
+             ++it)
+        {
+            if ((*it).done && ((*it).stopped
+                               || (stop > 0 && (*it).lastEvent >= stop)))
+                valid = false;
+        }
+
+        if (!valid)
+            throw std::runtime_error("Network::stop(): cannot stop the "
+                                     "parallel simulation at this point, use "
+                                     "the sequential simulation instead.");
+    }
+
+    mStop = stop;
+    mDiscard = discard;
+}
+
+bool N2D2::Network::runEvents()
+{
+    SpikeEvent* event;
+    bool stopped = false;
+
+    if (!eventsEmpty())
+        mFirstEvent = eventsTop()->getTimestamp();
+
+    while (!eventsEmpty()) {
+        event = eventsTop();
 
         if (event->isDiscarded()) {
-            mEvents.pop();
-            mEventsPool.push(event);
+            eventsPop();
+            mEventsPool.push_back(event);
             continue;
         }
 
@@ -194,28 +254,493 @@ bool N2D2::Network::run(Time_T stop, bool clearActivity)
         // courant, celui-ci pourrait se retrouver en haut de la
         // queue si bien que si on faisait dans ce cas le pop() après le
         // release(), on risque de supprimer le mauvais évènement.
-        mEvents.pop();
+        eventsPop();
         mLastEvent = event->release();
-        mEventsPool.push(event);
+        mEventsPool.push_back(event);
     }
 
     if (mDiscard) {
-        while (!mEvents.empty()) {
-            mEventsPool.push(mEvents.top());
-            mEvents.pop();
+        while (!eventsEmpty()) {
+            mEventsPool.push_back(eventsTop());
+            eventsPop();
         }
     }
 
-    std::for_each(mObservers.begin(),
-                  mObservers.end(),
-                  std::bind(&NetworkObserver::notify,
-                            std::placeholders::_1,
-                            mLastEvent,
-                            NetworkObserver::Finalize));
+    return stopped;
+}
+
+bool N2D2::Network::runPartitions()
+{
+    // Events created outside of run() are dispatched to their partition
+    while (!eventsEmpty()) {
+        SpikeEvent* event = eventsTop();
+        eventsPop();
+
+        const Node* node = (event->getDestination() != NULL)
+                               ? event->getDestination()
+                               : event->getOrigin();
+        mPartitions[mNodePartition[node->getId()]].push(event);
+    }
+
+    bool first = true;
+
+    for (std::vector<Partition>::iterator it = mPartitions.begin(),
+                                          itEnd = mPartitions.end();
+         it != itEnd;
+         ++it)
+    {
+        if (!(*it).empty()) {
+            const Time_T timestamp = (*it).top()->getTimestamp();
+
+            if (first || timestamp < mFirstEvent)
+                mFirstEvent = timestamp;
+
+            first = false;
+        }
+
+        (*it).lastEvent = mLastEvent;
+        (*it).stopped = false;
+        (*it).done = false;
+    }
+
+    for (std::vector<ActivationLog>::iterator it = mActivationLogs.begin(),
+                                              itEnd = mActivationLogs.end();
+         it != itEnd;
+         ++it)
+    {
+        (*it).initial = (*it).node->mLastActivationTime;
+        (*it).activations.clear();
+    }
+
+    // Sized here, as the number of threads may have changed since
+    // partition()
+#ifdef _OPENMP
+    mThreadPartition.assign(omp_get_max_threads(), 0);
+#else
+    mThreadPartition.assign(1, 0);
+#endif
+    mRunning = true;
+    std::string error;
+
+    for (std::vector<std::vector<unsigned int> >::const_iterator it
+         = mLevels.begin(),
+         itEnd = mLevels.end();
+         it != itEnd && error.empty();
+         ++it)
+    {
+        // The shared partition may stop the simulation, it is run alone
+        const bool shared = ((*it).front() == 0);
+
+        if (shared) {
+            mRunningAlone = true;
+
+            try {
+                runPartition(0);
+            }
+            catch (const std::exception& e)
+            {
+                error = e.what();
+            }
+
+            mRunningAlone = false;
+        }
+
+        const int nbPartitions = (*it).size();
+        const int first = (shared) ? 1 : 0;
+        // Early exit flag, as error can only be accessed in the critical
+        // section
+        int failed = (error.empty()) ? 0 : 1;
+
+#pragma omp parallel for schedule(dynamic) if (nbPartitions - first > 1)
+        for (int i = first; i < nbPartitions; ++i) {
+            int skip;
+#pragma omp atomic read
+            skip = failed;
+
+            if (skip)
+                continue;
+
+            try {
+                runPartition((*it)[i]);
+            }
+            catch (const std::exception& e)
+            {
+#pragma omp critical(Network__runPartitions)
+                error = e.what();
+
+#pragma omp atomic write
+                failed = 1;
+            }
+        }
+    }
+
+    mRunning = false;
+
+    if (!error.empty())
+        throw std::runtime_error(error);
+
+    bool stopped = false;
+
+    for (std::vector<Partition>::iterator it = mPartitions.begin(),
+                                          itEnd = mPartitions.end();
+         it != itEnd;
+         ++it)
+    {
+        Partition& partition = (*it);
+
+        mLastEvent = std::max(mLastEvent, partition.lastEvent);
+        stopped = stopped || partition.stopped;
+
+        if (mDiscard) {
+            while (!partition.empty()) {
+                partition.eventsPool.push_back(partition.top());
+                partition.pop();
+            }
+        }
+
+        for (std::unordered_map<NodeId_T, NodeEvents_T>::iterator itRecord
+             = partition.spikeRecording.begin(),
+             itRecordEnd = partition.spikeRecording.end();
+             itRecord != itRecordEnd;
+             ++itRecord)
+        {
+            NodeEvents_T& record = mSpikeRecording[(*itRecord).first];
+            record.insert(record.end(),
+                          (*itRecord).second.begin(),
+                          (*itRecord).second.end());
+        }
+
+        partition.spikeRecording.clear();
+    }
 
     return stopped;
 }
 
+void N2D2::Network::runPartition(unsigned int id)
+{
+    Partition& partition = mPartitions[id];
+    mThreadPartition[threadNum()] = id;
+
+    // Deliver the events from the partitions already simulated
+    for (std::vector<Partition>::iterator it = mPartitions.begin(),
+                                          itEnd = mPartitions.end();
+         it != itEnd;
+         ++it)
+    {
+        std::vector<SpikeEvent*>& incoming = (*it).outgoing[id];
+
+        for (std::vector<SpikeEvent*>::const_iterator itEvent
+             = incoming.begin(),
+             itEventEnd = incoming.end();
+             itEvent != itEventEnd;
+             ++itEvent)
+            partition.push(*itEvent);
+
+        incoming.clear();
+    }
+
+    while (!partition.empty()) {
+        SpikeEvent* event = partition.top();
+
+        if (event->isDiscarded()) {
+            partition.pop();
+            partition.eventsPool.push_back(event);
+            continue;
+        }
+
+        // Safety check
+        if (event->getTimestamp() < partition.lastEvent) {
+            std::ostringstream errorMsg;
+            errorMsg
+                << "Cannot go back in time! I want to deal with event at time "
+                << event->getTimestamp() << " whereas last event was at "
+                << partition.lastEvent << ", type is " << event->getType();
+            throw std::runtime_error(errorMsg.str());
+        }
+
+        if (mStop > 0 && event->getTimestamp() >= mStop) {
+            partition.stopped = true;
+            break;
+        }
+
+        partition.pop();
+        partition.current = event;
+        partition.lastEvent = event->release();
+        partition.current = NULL;
+        partition.eventsPool.push_back(event);
+    }
+
+    partition.done = true;
+}
+
+void N2D2::Network::partition()
+{
+    std::vector<Node*> nodes;
+    std::vector<Xcell*> cells;
+
+    for (std::set<NetworkObserver*>::const_iterator it = mObservers.begin(),
+                                                    itEnd = mObservers.end();
+         it != itEnd;
+         ++it)
+    {
+        if (Node* node = dynamic_cast<Node*>(*it))
+            nodes.push_back(node);
+        else if (Xcell* cell = dynamic_cast<Xcell*>(*it))
+            cells.push_back(cell);
+    }
+
+    mPartitioned = true;
+
+    if (nodes.empty())
+        return;
+
+    std::sort(nodes.begin(), nodes.end(), nodeIdLess);
+
+    // Union-find of the nodes, by node ID
+    const NodeId_T maxId = nodes.back()->getId();
+    std::vector<NodeId_T> parent(maxId + 1);
+
+    for (NodeId_T id = 0; id <= maxId; ++id)
+        parent[id] = id;
+
+    // Partition of each Xcell
+    std::vector<bool> shared(maxId + 1, true);
+
+    for (std::vector<Xcell*>::const_iterator it = cells.begin(),
+                                             itEnd = cells.end();
+         it != itEnd;
+         ++it)
+    {
+        const std::vector<NodeNeuron*>& neurons = (*it)->getNeurons();
+        bool partitionable = !neurons.empty();
+
+        for (std::vector<NodeNeuron*>::const_iterator itNeuron
+             = neurons.begin(),
+             itNeuronEnd = neurons.end();
+             itNeuron != itNeuronEnd && partitionable;
+             ++itNeuron)
+            partitionable = (*itNeuron)->isPartitionable();
+
+        if (!partitionable)
+            continue;
+
+        for (std::vector<NodeNeuron*>::const_iterator itNeuron
+             = neurons.begin(),
+             itNeuronEnd = neurons.end();
+             itNeuron != itNeuronEnd;
+             ++itNeuron)
+        {
+            shared[(*itNeuron)->getId()] = false;
+            unionSets(parent, neurons[0]->getId(), (*itNeuron)->getId());
+        }
+    }
+
+    // All the other nodes are in the shared partition, whose root is ID 0
+    std::vector<NodeId_T> ids;
+
+    for (std::vector<Node*>::const_iterator it = nodes.begin(),
+                                            itEnd = nodes.end();
+         it != itEnd;
+         ++it)
+    {
+        if (shared[(*it)->getId()]) {
+            if (ids.empty())
+                ids.push_back(0);
+
+            unionSets(parent, 0, (*it)->getId());
+        }
+
+        ids.push_back((*it)->getId());
+    }
+
+    // Coupled nodes must be in the same partition
+    for (std::vector<Node*>::const_iterator it = nodes.begin(),
+                                            itEnd = nodes.end();
+         it != itEnd;
+         ++it)
+    {
+        const std::vector<Node*>& branches = (*it)->getBranches();
+
+        for (std::vector<Node*>::const_iterator itBranch = branches.begin(),
+                                                itBranchEnd = branches.end();
+             itBranch != itBranchEnd;
+             ++itBranch)
+        {
+            if (!(*it)->isPartitionable() || !(*itBranch)->isPartitionable()
+                || (*itBranch)->getLinkDelay(*it) == 0)
+                unionSets(parent, (*it)->getId(), (*itBranch)->getId());
+        }
+
+        if (const NodeNeuron* neuron = dynamic_cast<const NodeNeuron*>(*it)) {
+            const std::vector<NodeNeuron*>& lateralBranches
+                = neuron->getLateralBranches();
+
+            for (std::vector<NodeNeuron*>::const_iterator itBranch
+                 = lateralBranches.begin(),
+                 itBranchEnd = lateralBranches.end();
+                 itBranch != itBranchEnd;
+                 ++itBranch)
+                unionSets(parent, (*it)->getId(), (*itBranch)->getId());
+        }
+    }
+
+    // Partitions forming a cycle are merged, until the partitions graph is
+    // acyclic
+    std::vector<unsigned int> partitions;
+    std::vector<std::vector<unsigned int> > graph;
+    unsigned int nbPartitions;
+
+    while (true) {
+        // Number the partitions, in the order of their lowest node ID (the
+        // shared partition, if any, is therefore partition 0)
+        std::vector<int> number(maxId + 1, -1);
+        partitions.assign(maxId + 1, 0);
+        nbPartitions = 0;
+
+        for (std::vector<NodeId_T>::const_iterator it = ids.begin(),
+                                                   itEnd = ids.end();
+             it != itEnd;
+             ++it)
+        {
+            const NodeId_T root = findSet(parent, *it);
+
+            if (number[root] < 0)
+                number[root] = nbPartitions++;
+
+            partitions[*it] = number[root];
+        }
+
+        graph.assign(nbPartitions, std::vector<unsigned int>());
+
+        for (std::vector<Node*>::const_iterator it = nodes.begin(),
+                                                itEnd = nodes.end();
+             it != itEnd;
+             ++it)
+        {
+            const unsigned int from = partitions[(*it)->getId()];
+            const std::vector<Node*>& branches = (*it)->getBranches();
+
+            for (std::vector<Node*>::const_iterator itBranch
+                 = branches.begin(),
+                 itBranchEnd = branches.end();
+                 itBranch != itBranchEnd;
+                 ++itBranch)
+            {
+                const unsigned int to = partitions[(*itBranch)->getId()];
+
+                if (to != from && std::find(graph[from].begin(),
+                                            graph[from].end(),
+                                            to) == graph[from].end())
+                    graph[from].push_back(to);
+            }
+        }
+
+        const std::vector<unsigned int> components
+            = stronglyConnectedComponents(graph);
+        std::vector<int> representative(nbPartitions, -1);
+        bool merged = false;
+
+        for (std::vector<NodeId_T>::const_iterator it = ids.begin(),
+                                                   itEnd = ids.end();
+             it != itEnd;
+             ++it)
+        {
+            const unsigned int component = components[partitions[*it]];
+
+            if (representative[component] < 0)
+                representative[component] = *it;
+            else if (findSet(parent, *it)
+                     != findSet(parent, representative[component]))
+            {
+                unionSets(parent, representative[component], *it);
+                merged = true;
+            }
+        }
+
+        if (!merged)
+            break;
+    }
+
+    if (nbPartitions < 2)
+        return;
+
+    // Levels of the partitions: length of the longest path from a source
+    std::vector<unsigned int> levels(nbPartitions, 0);
+    std::vector<unsigned int> nbInputs(nbPartitions, 0);
+    std::vector<unsigned int> ready;
+
+    for (unsigned int from = 0; from < nbPartitions; ++from) {
+        for (std::vector<unsigned int>::const_iterator it
+             = graph[from].begin(),
+             itEnd = graph[from].end();
+             it != itEnd;
+             ++it)
+            ++nbInputs[(*it)];
+    }
+
+    for (unsigned int p = 0; p < nbPartitions; ++p) {
+        if (nbInputs[p] == 0)
+            ready.push_back(p);
+    }
+
+    while (!ready.empty()) {
+        const unsigned int from = ready.back();
+        ready.pop_back();
+
+        for (std::vector<unsigned int>::const_iterator it
+             = graph[from].begin(),
+             itEnd = graph[from].end();
+             it != itEnd;
+             ++it)
+        {
+            levels[(*it)] = std::max(levels[(*it)], levels[from] + 1);
+
+            if (--nbInputs[(*it)] == 0)
+                ready.push_back(*it);
+        }
+    }
+
+    for (unsigned int p = 0; p < nbPartitions; ++p)
+        mPartitions.push_back(Partition(mScheduler, nbPartitions));
+
+    mLevels.assign(*std::max_element(levels.begin(), levels.end()) + 1,
+                   std::vector<unsigned int>());
+
+    for (unsigned int p = 0; p < nbPartitions; ++p) {
+        mPartitions[p].level = levels[p];
+        mLevels[levels[p]].push_back(p);
+    }
+
+    mNodePartition.swap(partitions);
+
+    // Log the activations of the nodes read by other partitions
+    for (std::vector<Node*>::const_iterator it = nodes.begin(),
+                                            itEnd = nodes.end();
+         it != itEnd;
+         ++it)
+    {
+        const unsigned int from = mNodePartition[(*it)->getId()];
+        const std::vector<Node*>& branches = (*it)->getBranches();
+
+        for (std::vector<Node*>::const_iterator itBranch = branches.begin(),
+                                                itBranchEnd = branches.end();
+             itBranch != itBranchEnd;
+             ++itBranch)
+        {
+            if (mNodePartition[(*itBranch)->getId()] != from) {
+                ActivationLog activationLog;
+                activationLog.node = (*it);
+                activationLog.partition = from;
+                activationLog.initial = 0;
+
+                (*it)->mActivationLog = mActivationLogs.size();
+                mActivationLogs.push_back(activationLog);
+                break;
+            }
+        }
+    }
+}
+
 void N2D2::Network::reset(Time_T timestamp)
 {
     mFirstEvent = timestamp;
@@ -269,26 +794,112 @@ N2D2::SpikeEvent* N2D2::Network::newEvent(Node* origin,
                                           Time_T timestamp,
                                           EventType_T type)
 {
-    SpikeEvent* event;
+    if (mRunning) {
+        Partition& partition
+            = mPartitions[mThreadPartition[threadNum()]];
+        const Node* node = (destination != NULL) ? destination : origin;
+        const unsigned int to = mNodePartition[node->getId()];
+
+        // The order of the simultaneous events in the partitions would no
+        // longer match the sequential order (see SpikeEvent::operator<())
+        if (partition.current != NULL
+            && timestamp == partition.current->getTimestamp())
+        {
+            throw std::runtime_error("Network::newEvent(): events without "
+                                     "delay cannot be reproduced by the "
+                                     "parallel simulation, use the sequential "
+                                     "simulation instead.");
+        }
 
-    if (mEventsPool.empty())
-        event = new SpikeEvent(origin, destination, timestamp, type);
-    else {
-        event = mEventsPool.top();
-        mEventsPool.pop();
+        SpikeEvent* event = allocateEvent(partition.eventsPool);
         event->initialize(origin, destination, timestamp, type);
+
+        if (&mPartitions[to] == &partition)
+            partition.push(event);
+        else
+            partition.outgoing[to].push_back(event);
+
+        return event;
     }
 
-    mEvents.push(event);
+    SpikeEvent* event = allocateEvent(mEventsPool);
+    event->initialize(origin, destination, timestamp, type);
+
+    if (mEventWheel)
+        mEventWheel->push(event);
+    else
+        mEvents.push(event);
+
     return event;
 }
 
+void N2D2::Network::logActivation(int log, Time_T timestamp)
+{
+    if (!mRunning)
+        return;
+
+    ActivationLog& activationLog = mActivationLogs[log];
+    const SpikeEvent* current = mPartitions[activationLog.partition].current;
+
+    Activation activation;
+    activation.timestamp = timestamp;
+    activation.origin = current->getOrigin();
+    activation.destination = current->getDestination();
+    activation.eventTimestamp = current->getTimestamp();
+    activation.eventType = current->getType();
+    activationLog.activations.push_back(activation);
+}
+
+N2D2::Time_T N2D2::Network::getActivationTime(int log,
+                                              Time_T lastActivationTime) const
+{
+    if (!mRunning)
+        return lastActivationTime;
+
+    const ActivationLog& activationLog = mActivationLogs[log];
+    const unsigned int id = mThreadPartition[threadNum()];
+
+    if (id == activationLog.partition)
+        return lastActivationTime;
+
+    // The partition of the node was simulated before: find its last
+    // activation caused by an event processed before the current one in the
+    // sequential order
+    const SpikeEvent& current = *mPartitions[id].current;
+    const std::vector<Activation>& activations = activationLog.activations;
+    std::size_t first = 0;
+    std::size_t last = activations.size();
+
+    while (first < last) {
+        const std::size_t middle = first + (last - first) / 2;
+        const Activation& activation = activations[middle];
+        const SpikeEvent event(activation.origin,
+                               activation.destination,
+                               activation.eventTimestamp,
+                               activation.eventType);
+
+        if (current < event)
+            first = middle + 1;
+        else
+            last = middle;
+    }
+
+    return (first > 0) ? activations[first - 1].timestamp
+                       : activationLog.initial;
+}
+
 N2D2::Network::~Network()
 {
     // dtor
-    while (!mEventsPool.empty()) {
-        delete mEventsPool.top();
-        mEventsPool.pop();
+    for (std::vector<SpikeEvent*>::const_iterator it = mEventsSlabs.begin(),
+                                                  itEnd = mEventsSlabs.end();
+         it != itEnd;
+         ++it)
+    {
+        for (unsigned int i = 0; i < EventsSlabSize; ++i)
+            (*it)[i].~SpikeEvent();
+
+        ::operator delete(*it);
     }
 
     const double timeElapsed
@@ -316,3 +927,208 @@ unsigned int N2D2::Network::readSeed(const std::string& fileName)
 
     return seed;
 }
+
+N2D2::SpikeEvent* N2D2::Network::allocateEvent(std::vector
+                                               <SpikeEvent*>& pool)
+{
+    if (pool.empty()) {
+        // Allocate a new slab of events
+        SpikeEvent* slab = static_cast<SpikeEvent*>(
+            ::operator new(EventsSlabSize * sizeof(SpikeEvent)));
+
+#pragma omp critical(Network__allocateEvent)
+        mEventsSlabs.push_back(slab);
+
+        pool.reserve(pool.size() + EventsSlabSize);
+
+        for (int i = EventsSlabSize - 1; i >= 0; --i) {
+            new (slab + i) SpikeEvent(NULL, NULL, 0, 0);
+            pool.push_back(slab + i);
+        }
+    }
+
+    SpikeEvent* event = pool.back();
+    pool.pop_back();
+    return event;
+}
+
+bool N2D2::Network::nodeIdLess(const Node* a, const Node* b)
+{
+    return (a->getId() < b->getId());
+}
+
+N2D2::NodeId_T N2D2::Network::findSet(std::vector<NodeId_T>& parent,
+                                      NodeId_T id)
+{
+    while (parent[id] != id) {
+        parent[id] = parent[parent[id]];
+        id = parent[id];
+    }
+
+    return id;
+}
+
+void N2D2::Network::unionSets(std::vector<NodeId_T>& parent,
+                              NodeId_T id1,
+                              NodeId_T id2)
+{
+    const NodeId_T root1 = findSet(parent, id1);
+    const NodeId_T root2 = findSet(parent, id2);
+
+    if (root1 < root2)
+        parent[root2] = root1;
+    else
+        parent[root1] = root2;
+}
+
+unsigned int N2D2::Network::threadNum()
+{
+#ifdef _OPENMP
+    return omp_get_thread_num();
+#else
+    return 0;
+#endif
+}
+
+std::vector<unsigned int> N2D2::Network::stronglyConnectedComponents(
+    const std::vector<std::vector<unsigned int> >& graph)
+{
+    // Kosaraju's algorithm, with explicit stacks
+    const unsigned int nbVertices = graph.size();
+    std::vector<std::vector<unsigned int> > transpose(nbVertices);
+
+    for (unsigned int v = 0; v < nbVertices; ++v) {
+        for (std::vector<unsigned int>::const_iterator it = graph[v].begin(),
+                                                       itEnd = graph[v].end();
+             it != itEnd;
+             ++it)
+            transpose[(*it)].push_back(v);
+    }
+
+    // Vertices by increasing finish time of a depth-first search
+    std::vector<unsigned int> order;
+    std::vector<bool> visited(nbVertices, false);
+    std::vector<std::pair<unsigned int, unsigned int> > stack;
+
+    for (unsigned int v = 0; v < nbVertices; ++v) {
+        if (visited[v])
+            continue;
+
+        visited[v] = true;
+        stack.push_back(std::make_pair(v, 0U));
+
+        while (!stack.empty()) {
+            const unsigned int vertex = stack.back().first;
+            const unsigned int next = stack.back().second;
+
+            if (next < graph[vertex].size()) {
+                ++stack.back().second;
+                const unsigned int child = graph[vertex][next];
+
+                if (!visited[child]) {
+                    visited[child] = true;
+                    stack.push_back(std::make_pair(child, 0U));
+                }
+            } else {
+                order.push_back(vertex);
+                stack.pop_back();
+            }
+        }
+    }
+
+    // Components of the transposed graph, by decreasing finish time
+    std::vector<unsigned int> components(nbVertices, nbVertices);
+    std::vector<unsigned int> pending;
+    unsigned int nbComponents = 0;
+
+    for (std::vector<unsigned int>::const_reverse_iterator it = order.rbegin(),
+                                                           itEnd = order.rend();
+         it != itEnd;
+         ++it)
+    {
+        if (components[(*it)] != nbVertices)
+            continue;
+
+        components[(*it)] = nbComponents;
+        pending.push_back(*it);
+
+        while (!pending.empty()) {
+            const unsigned int vertex = pending.back();
+            pending.pop_back();
+
+            for (std::vector<unsigned int>::const_iterator itChild
+                 = transpose[vertex].begin(),
+                 itChildEnd = transpose[vertex].end();
+                 itChild != itChildEnd;
+                 ++itChild)
+            {
+                if (components[(*itChild)] == nbVertices) {
+                    components[(*itChild)] = nbComponents;
+                    pending.push_back(*itChild);
+                }
+            }
+        }
+
+        ++nbComponents;
+    }
+
+    return components;
+}
+
+bool N2D2::Network::eventsEmpty() const
+{
+    return (mEventWheel) ? mEventWheel->empty() : mEvents.empty();
+}
+
+N2D2::SpikeEvent* N2D2::Network::eventsTop()
+{
+    return (mEventWheel) ? mEventWheel->top() : mEvents.top();
+}
+
+void N2D2::Network::eventsPop()
+{
+    if (mEventWheel)
+        mEventWheel->pop();
+    else
+        mEvents.pop();
+}
+
+N2D2::Network::Partition::Partition(Scheduler scheduler,
+                                    unsigned int nbPartitions)
+    : outgoing(nbPartitions),
+      current(NULL),
+      lastEvent(0),
+      level(0),
+      stopped(false),
+      done(false)
+{
+    // ctor
+    if (scheduler == TimingWheel)
+        eventWheel = std::make_shared<EventWheel>();
+}
+
+bool N2D2::Network::Partition::empty() const
+{
+    return (eventWheel) ? eventWheel->empty() : events.empty();
+}
+
+N2D2::SpikeEvent* N2D2::Network::Partition::top()
+{
+    return (eventWheel) ? eventWheel->top() : events.top();
+}
+
+void N2D2::Network::Partition::pop()
+{
+    if (eventWheel)
+        eventWheel->pop();
+    else
+        events.pop();
+}
+
+void N2D2::Network::Partition::push(SpikeEvent* event)
+{
+    if (eventWheel)
+        eventWheel->push(event);
+    else
+        events.push(event);
+}
@@ -31,7 +31,8 @@ N2D2::Node::Node(Network& net)
       mScale(1.0),
       mOrientation(0.0),
       mLayer(0),
-      mArea(0, 0, 0, 0)
+      mArea(0, 0, 0, 0),
+      mActivationLog(-1)
 {
     // ctor
 }
@@ -52,6 +53,9 @@ void N2D2::Node::emitSpike(Time_T timestamp, EventType_T type)
     if (mActivityRecording)
         mNet.recordSpike(mId, timestamp, type);
 
+    if (mActivationLog >= 0)
+        mNet.logActivation(mActivationLog, timestamp);
+
     mLastActivationTime = timestamp;
 
     std::for_each(mBranches.begin(),
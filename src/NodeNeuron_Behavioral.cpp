@@ -21,6 +21,8 @@
 
 #include "NodeNeuron_Behavioral.hpp"
 
+const unsigned int N2D2::NodeNeuron_Behavioral::NoInput;
+
 N2D2::NodeNeuron_Behavioral::NodeNeuron_Behavioral(Network& net)
     : NodeNeuron(net),
       // IMPORTANT: Do not change the value of the parameters here! Use
@@ -56,11 +58,80 @@ N2D2::NodeNeuron_Behavioral::NodeNeuron_Behavioral(Network& net)
       mLastSpikeTime(0),
       mEvent(NULL),
       mRefractoryEnd(0),
-      mLastStdp(0)
+      mLastStdp(0),
+      mInputIdOffset(0),
+      mLtpHead(0),
+      mLtpTail(0),
+      mLtpSize(0)
 {
     // ctor
 }
 
+void N2D2::NodeNeuron_Behavioral::addLink(Node* origin)
+{
+    NodeNeuron::addLink(origin);
+
+    // Move the new synapse to the contiguous storage
+    Synapse* synapse = mLinks[origin];
+    const Synapse_Behavioral* storage = (!mSynapses.empty()) ? &mSynapses[0]
+                                                             : NULL;
+
+    mSynapses.push_back(*static_cast<Synapse_Behavioral*>(synapse));
+    mInputs.push_back(origin);
+    delete synapse;
+
+    if (&mSynapses[0] != storage) {
+        // The storage was reallocated
+        for (unsigned int index = 0, size = mInputs.size(); index < size;
+             ++index)
+            mLinks[mInputs[index]] = &mSynapses[index];
+    } else
+        mLinks[origin] = &mSynapses.back();
+
+    mLtpMember.push_back(false);
+    mLtpPrev.push_back(0);
+    mLtpNext.push_back(0);
+
+    indexInput(origin, mInputs.size() - 1);
+}
+
+void N2D2::NodeNeuron_Behavioral::indexInput(Node* origin, unsigned int index)
+{
+    const NodeId_T id = origin->getId();
+
+    if (mInputIndexesMap.empty()) {
+        NodeId_T idMin = id;
+        NodeId_T idMax = id;
+
+        if (!mInputIndexes.empty()) {
+            idMin = std::min(id, mInputIdOffset);
+            idMax = std::max(id, (NodeId_T)(mInputIdOffset
+                                            + mInputIndexes.size() - 1));
+        }
+
+        const std::size_t range = idMax - idMin + 1;
+
+        if (range <= 2 * mInputs.size() + 64) {
+            if (!mInputIndexes.empty() && idMin < mInputIdOffset)
+                mInputIndexes.insert(
+                    mInputIndexes.begin(), mInputIdOffset - idMin, NoInput);
+
+            mInputIndexes.resize(range, NoInput);
+            mInputIdOffset = idMin;
+            mInputIndexes[id - idMin] = index;
+            return;
+        }
+
+        // The node IDs are too sparse, switch to the hash table
+        std::vector<unsigned int>().swap(mInputIndexes);
+
+        for (unsigned int i = 0; i < index; ++i)
+            mInputIndexesMap.insert(std::make_pair(mInputs[i], i));
+    }
+
+    mInputIndexesMap.insert(std::make_pair(origin, index));
+}
+
 N2D2::Synapse* N2D2::NodeNeuron_Behavioral::newSynapse() const
 {
     return new Synapse_Behavioral(mIncomingDelay.spreadNormal(0),
@@ -77,8 +148,7 @@ void N2D2::NodeNeuron_Behavioral::propagateSpike(Node* origin,
                                                  Time_T timestamp,
                                                  EventType_T type)
 {
-    const Time_T delay = static_cast
-                         <Synapse_Behavioral*>(mLinks[origin])->delay;
+    const Time_T delay = mSynapses[getInputIndex(origin)].delay;
 
     if (delay > 0)
         mNet.newEvent(origin, this, timestamp + delay, type);
@@ -86,29 +156,23 @@ void N2D2::NodeNeuron_Behavioral::propagateSpike(Node* origin,
         incomingSpike(origin, timestamp, type);
 }
 
+N2D2::Time_T N2D2::NodeNeuron_Behavioral::getLinkDelay(Node* origin) const
+{
+    const unsigned int index = getInputIndex(origin);
+    return (index != NoInput) ? mSynapses[index].delay : 0;
+}
+
 void N2D2::NodeNeuron_Behavioral::incomingSpike(Node* origin,
                                                 Time_T timestamp,
                                                 EventType_T /*type*/)
 {
-    Synapse_Behavioral* synapse = static_cast
-        <Synapse_Behavioral*>(mLinks[origin]);
+    const unsigned int index = getInputIndex(origin);
+    Synapse_Behavioral* synapse = &mSynapses[index];
     ++synapse->statsReadEvents;
 
     // LTP
-    if (mEnableStdp && mOrderStdp > 0) {
-        std::deque<Synapse_Behavioral*>::iterator it
-            = std::find(mLtpFifo.begin(), mLtpFifo.end(), synapse);
-
-        if (it == mLtpFifo.end()) {
-            mLtpFifo.push_back(synapse);
-
-            if (mLtpFifo.size() > mOrderStdp)
-                mLtpFifo.pop_front();
-        } else if (it != mLtpFifo.begin() + mLtpFifo.size() - 1) {
-            mLtpFifo.erase(it);
-            mLtpFifo.push_back(synapse);
-        }
-    }
+    if (mEnableStdp && mOrderStdp > 0)
+        updateLtpFifo(index);
 
     const Time_T dt = timestamp - mLastSpikeTime;
 
@@ -185,39 +249,25 @@ void N2D2::NodeNeuron_Behavioral::emitSpike(Time_T timestamp, EventType_T type)
     if (mEnableStdp && mAllowStdp) {
         unsigned int ltp = 0;
 
+        const unsigned int nbSynapses = mSynapses.size();
+
         if (mOrderStdp > 0) {
-            for (std::deque<Synapse_Behavioral*>::const_iterator it
-                 = mLtpFifo.begin(),
-                 itEnd = mLtpFifo.end();
-                 it != itEnd;
-                 ++it) {
-                increaseWeight((*it), (*it)->weightIncrement);
+            for (unsigned int i = 0, index = mLtpHead; i < mLtpSize;
+                 ++i, index = mLtpNext[index]) {
+                increaseWeight(&mSynapses[index],
+                               mSynapses[index].weightIncrement);
                 ++ltp;
             }
 
-            for (std::unordered_map<Node*, Synapse*>::const_iterator it
-                 = mLinks.begin(),
-                 itEnd = mLinks.end();
-                 it != itEnd;
-                 ++it) {
-                Synapse_Behavioral* synapse = static_cast
-                    <Synapse_Behavioral*>((*it).second);
-
-                if (std::find(mLtpFifo.begin(), mLtpFifo.end(), synapse)
-                    == mLtpFifo.end())
-                    decreaseWeight(synapse, synapse->weightDecrement);
+            for (unsigned int index = 0; index < nbSynapses; ++index) {
+                if (!mLtpMember[index])
+                    decreaseWeight(&mSynapses[index],
+                                   mSynapses[index].weightDecrement);
             }
         } else {
-            for (std::unordered_map<Node*, Synapse*>::const_iterator it
-                 = mLinks.begin(),
-                 itEnd = mLinks.end();
-                 it != itEnd;
-                 ++it) {
-                Synapse_Behavioral* synapse = static_cast
-                    <Synapse_Behavioral*>((*it).second);
-
-                if (stdp(synapse,
-                         (*it).first->getLastActivationTime(),
+            for (unsigned int index = 0; index < nbSynapses; ++index) {
+                if (stdp(&mSynapses[index],
+                         mInputs[index]->getLastActivationTime(),
                          timestamp))
                     ++ltp;
             }
@@ -289,7 +339,12 @@ void N2D2::NodeNeuron_Behavioral::reset(Time_T timestamp)
 
     if (mEnableStdp) {
         mLastStdp = 0;
-        mLtpFifo.clear();
+
+        for (unsigned int i = 0, index = mLtpHead; i < mLtpSize;
+             ++i, index = mLtpNext[index])
+            mLtpMember[index] = false;
+
+        mLtpSize = 0;
     }
 
     if (mStateLog.is_open())
@@ -319,6 +374,41 @@ void N2D2::NodeNeuron_Behavioral::initialize()
         mStateLog << 0.0 << " " << mIntegration << std::endl;
 }
 
+void N2D2::NodeNeuron_Behavioral::updateLtpFifo(unsigned int index)
+{
+    if (mLtpMember[index]) {
+        if (index == mLtpTail)
+            return;
+
+        // Unlink the synapse from the FIFO
+        if (index == mLtpHead)
+            mLtpHead = mLtpNext[index];
+        else
+            mLtpNext[mLtpPrev[index]] = mLtpNext[index];
+
+        mLtpPrev[mLtpNext[index]] = mLtpPrev[index];
+    } else {
+        mLtpMember[index] = true;
+        ++mLtpSize;
+    }
+
+    // Push it back
+    if (mLtpSize == 1)
+        mLtpHead = index;
+    else {
+        mLtpNext[mLtpTail] = index;
+        mLtpPrev[index] = mLtpTail;
+    }
+
+    mLtpTail = index;
+
+    if (mLtpSize > mOrderStdp) {
+        mLtpMember[mLtpHead] = false;
+        mLtpHead = mLtpNext[mLtpHead];
+        --mLtpSize;
+    }
+}
+
 bool N2D2::NodeNeuron_Behavioral::stdp(Synapse_Behavioral* synapse,
                                        Time_T preTime,
                                        Time_T postTime) const
@@ -577,3 +667,14 @@ void N2D2::NodeNeuron_Behavioral::logStatePlot()
     gnuplot.saveToFile(mStateLogFile);
     gnuplot.plot(mStateLogFile, plotCmd.str());
 }
+
+N2D2::NodeNeuron_Behavioral::~NodeNeuron_Behavioral()
+{
+    // dtor
+    // The synapses are owned by mSynapses
+    for (std::unordered_map<Node*, Synapse*>::iterator it = mLinks.begin(),
+                                                       itEnd = mLinks.end();
+         it != itEnd;
+         ++it)
+        (*it).second = NULL;
+}
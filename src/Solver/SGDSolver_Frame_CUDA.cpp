@@ -286,7 +286,7 @@ void SGDSolver_Frame_CUDA
 
         mMomentumData.synchronizeDToH();
 
-        for (std::vector<float>::const_iterator it = mMomentumData.begin();
+        for (Tensor4d<float>::const_iterator it = mMomentumData.begin();
              it != mMomentumData.end();
              ++it) {
             syn << (*it) << " ";
@@ -314,7 +314,7 @@ void SGDSolver_Frame_CUDA
 
         mMomentumData.synchronizeDToH();
 
-        for (std::vector<double>::const_iterator it = mMomentumData.begin();
+        for (Tensor4d<double>::const_iterator it = mMomentumData.begin();
              it != mMomentumData.end();
              ++it)
             syn << (*it) << " ";
@@ -290,8 +290,8 @@ void N2D2::StimuliData::generate(Database::StimuliSetMask setMask)
                 mSize.push_back(size);
 
                 // Value
-                const std::pair<std::vector<Float_T>::const_iterator,
-                                std::vector<Float_T>::const_iterator> minMaxIt
+                const std::pair<Tensor3d<Float_T>::const_iterator,
+                                Tensor3d<Float_T>::const_iterator> minMaxIt
                     = std::minmax_element(data.begin(), data.end());
                 // A new vector must be created because data.data() contains the
                 // full content of the original 4D tensor
@@ -375,8 +375,8 @@ void N2D2::StimuliData::generate(Database::StimuliSetMask setMask)
                     = (rawData) ? mProvider.readRawData(*it, index)
                                 : mProvider.getData()[0];
 
-                for (std::vector<Float_T>::const_iterator it = data.begin(),
-                                                          itEnd = data.end();
+                for (Tensor3d<Float_T>::const_iterator it = data.begin(),
+                                                       itEnd = data.end();
                      it != itEnd;
                      ++it) {
                     const double v = (*it) - mGlobalValue.mean;
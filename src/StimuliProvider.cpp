@@ -20,6 +20,8 @@
 
 #include "StimuliProvider.hpp"
 
+#include <chrono>
+
 N2D2::StimuliProvider::StimuliProvider(Database& database,
                                        unsigned int sizeX,
                                        unsigned int sizeY,
@@ -40,10 +42,19 @@ N2D2::StimuliProvider::StimuliProvider(Database& database,
       mFutureData(sizeX, sizeY, nbChannels, batchSize),
       mLabelsROI(batchSize, std::vector<std::shared_ptr<ROI> >()),
       mFutureLabelsROI(batchSize, std::vector<std::shared_ptr<ROI> >()),
-      mFuture(false)
+      mFuture(false),
+      mSampling(StimuliSampler::Uniform),
+      mSamplingWindow(1024),
+      mPrefetchDepth(0),
+      mPrefetchWorkers(1),
+      mPrefetchRunning(false),
+      mPrefetchStop(false),
+      mPrefetchSet(Database::Learn),
+      mPrefetchCounter(0)
 {
     // ctor
     Utils::createDirectories(mCachePath); // Create default cache directory
+    resetPrefetchStats();
 
     if (mCompositeStimuli) {
         mLabelsData.resize(sizeX, sizeY, 1, batchSize);
@@ -54,9 +65,52 @@ N2D2::StimuliProvider::StimuliProvider(Database& database,
     }
 }
 
+N2D2::StimuliProvider::StimuliProvider(const StimuliProvider& sp)
+    : Parameterizable(sp),
+      mDatabase(sp.mDatabase),
+      mSizeX(sp.mSizeX),
+      mSizeY(sp.mSizeY),
+      mNbChannels(sp.mNbChannels),
+      mBatchSize(sp.mBatchSize),
+      mCompositeStimuli(sp.mCompositeStimuli),
+      mCachePath(sp.mCachePath),
+      mShardCache(sp.mShardCache),
+      mTransformations(sp.mTransformations),
+      mChannelsTransformations(sp.mChannelsTransformations),
+      mBatch(sp.mBatch),
+      mFutureBatch(sp.mFutureBatch),
+      mData(sp.mData),
+      mFutureData(sp.mFutureData),
+      mLabelsData(sp.mLabelsData),
+      mFutureLabelsData(sp.mFutureLabelsData),
+      mLabelsROI(sp.mLabelsROI),
+      mFutureLabelsROI(sp.mFutureLabelsROI),
+      mFuture(sp.mFuture),
+      mSampling(sp.mSampling),
+      mSamplingWindow(sp.mSamplingWindow),
+      mNbRandomBatches(sp.mNbRandomBatches),
+      mNbBatches(sp.mNbBatches),
+      mPrefetchDepth(sp.mPrefetchDepth),
+      mPrefetchWorkers(sp.mPrefetchWorkers),
+      mPrefetchRunning(false),
+      mPrefetchStop(false),
+      mPrefetchSet(sp.mPrefetchSet),
+      mPrefetchCounter(0)
+{
+    // ctor
+    resetPrefetchStats();
+}
+
+N2D2::StimuliProvider::~StimuliProvider()
+{
+    stopPrefetch();
+}
+
 void N2D2::StimuliProvider::addChannel(const CompositeTransformation
                                        & /*transformation*/)
 {
+    stopPrefetch();
+
     if (mChannelsTransformations.empty())
         mNbChannels = 1;
     else
@@ -247,9 +301,66 @@ void N2D2::StimuliProvider::synchronize()
     }
 }
 
+void N2D2::StimuliProvider::setPrefetch(unsigned int depth,
+                                        unsigned int nbWorkers)
+{
+    if (depth > 0 && nbWorkers == 0)
+        throw std::domain_error("StimuliProvider::setPrefetch(): the number "
+                                "of workers must be > 0");
+
+    stopPrefetch();
+    mPrefetchDepth = depth;
+    mPrefetchWorkers = nbWorkers;
+}
+
+N2D2::StimuliProvider::PrefetchStats
+N2D2::StimuliProvider::getPrefetchStats() const
+{
+    std::lock_guard<std::mutex> lock(mPrefetchMutex);
+    return mPrefetchStats;
+}
+
+void N2D2::StimuliProvider::resetPrefetchStats()
+{
+    std::lock_guard<std::mutex> lock(mPrefetchMutex);
+    mPrefetchStats.nbBatches = 0;
+    mPrefetchStats.nbStalls = 0;
+    mPrefetchStats.stallTime = 0.0;
+    mPrefetchStats.cumQueueDepth = 0;
+}
+
+void N2D2::StimuliProvider::setSampling(StimuliSampler::Type sampling,
+                                        unsigned int windowSize)
+{
+    if (sampling == StimuliSampler::Window && windowSize == 0)
+        throw std::domain_error("StimuliProvider::setSampling(): the window "
+                                "size must be > 0");
+
+    // The prefetch workers draw from the samplers
+    stopPrefetch();
+    mSampling = sampling;
+    mSamplingWindow = windowSize;
+    mSamplers.clear();
+}
+
 unsigned int N2D2::StimuliProvider::getRandomIndex(Database::StimuliSet set)
 {
-    return Random::randUniform(0, mDatabase.getNbStimuli(set) - 1);
+    std::map<Database::StimuliSet, std::shared_ptr<StimuliSampler> >
+        ::iterator itSampler = mSamplers.find(set);
+
+    if (itSampler == mSamplers.end()) {
+        const std::shared_ptr<StimuliSampler> sampler = StimuliSampler::create(
+            mSampling, mDatabase, set, mSamplingWindow);
+
+        if (mSampling == StimuliSampler::Window) {
+            std::static_pointer_cast<WindowSampler>(sampler)
+                ->setShardCache(mShardCache);
+        }
+
+        itSampler = mSamplers.insert(std::make_pair(set, sampler)).first;
+    }
+
+    return (*itSampler).second->next();
 }
 
 N2D2::Database::StimulusID
@@ -262,12 +373,94 @@ void N2D2::StimuliProvider::readRandomBatch(Database::StimuliSet set)
 {
     std::vector<int>& batchRef = (mFuture) ? mFutureBatch : mBatch;
 
-    for (unsigned int batchPos = 0; batchPos < mBatchSize; ++batchPos)
-        batchRef[batchPos] = getRandomID(set);
+    if (mPrefetchDepth > 0 && mBatchSize > 0) {
+        if (!mPrefetchRunning || mPrefetchSet != set) {
+            stopPrefetch();
+            startPrefetch(set);
+        }
+
+        unsigned int slot = 0;
+        std::exception_ptr error;
+
+        {
+            std::unique_lock<std::mutex> lock(mPrefetchMutex);
+            ++mPrefetchStats.nbBatches;
+            mPrefetchStats.cumQueueDepth += mPrefetchReady.size();
+
+            // With several workers, the batches are not necessarily ready in
+            // the order they were drawn
+            const unsigned long long counter = mNbRandomBatches[set];
+            std::deque<unsigned int>::iterator itReady
+                = findPrefetchReady(counter);
+
+            if (itReady == mPrefetchReady.end() && !mPrefetchError) {
+                const std::chrono::high_resolution_clock::time_point
+                    startTime = std::chrono::high_resolution_clock::now();
+
+                while (itReady == mPrefetchReady.end() && !mPrefetchError) {
+                    mPrefetchReadyCond.wait(lock);
+                    itReady = findPrefetchReady(counter);
+                }
+
+                ++mPrefetchStats.nbStalls;
+                mPrefetchStats.stallTime
+                    += std::chrono::duration_cast
+                       <std::chrono::duration<double> >(
+                           std::chrono::high_resolution_clock::now()
+                           - startTime).count();
+            }
+
+            if (mPrefetchError)
+                error = mPrefetchError;
+            else {
+                slot = *itReady;
+                mPrefetchReady.erase(itReady);
+                ++mNbRandomBatches[set];
+            }
+        }
+
+        if (error) {
+            // The workers are restarted on the next call
+            stopPrefetch();
+            std::rethrow_exception(error);
+        }
+
+        // The previous content of the batch buffers goes back to the ring
+        batchRef.swap(mPrefetchSlots[slot].batch);
+        ((mFuture) ? mFutureData : mData).swap(mPrefetchSlots[slot].data);
+        ((mFuture) ? mFutureLabelsData : mLabelsData)
+            .swap(mPrefetchSlots[slot].labelsData);
+        ((mFuture) ? mFutureLabelsROI : mLabelsROI)
+            .swap(mPrefetchSlots[slot].labelsROI);
+
+        {
+            std::lock_guard<std::mutex> lock(mPrefetchMutex);
+            mPrefetchFree.push_back(slot);
+        }
+
+        mPrefetchFreeCond.notify_one();
+        return;
+    }
+
+    const unsigned long long seed
+        = getBatchSeed(set, true, mNbRandomBatches[set]++);
+
+    {
+        // The sampler draws from the stream following the ones of the
+        // stimuli
+        Random::ThreadStream stream(seed, mBatchSize);
+
+        for (unsigned int batchPos = 0; batchPos < mBatchSize; ++batchPos)
+            batchRef[batchPos] = getRandomID(set);
+    }
 
 #pragma omp parallel for if (mBatchSize > 1)
-    for (int batchPos = 0; batchPos < (int)mBatchSize; ++batchPos)
+    for (int batchPos = 0; batchPos < (int)mBatchSize; ++batchPos) {
+        // Each stimulus of the batch has its own random stream for the
+        // transformations, whatever the thread reading it
+        Random::ThreadStream stream(seed, batchPos);
         readStimulus(batchRef[batchPos], set, batchPos);
+    }
 }
 
 N2D2::Database::StimulusID
@@ -290,9 +483,13 @@ void N2D2::StimuliProvider::readBatch(Database::StimuliSet set,
         batchRef[batchPos]
             = mDatabase.getStimulusID(set, startIndex + batchPos);
 
+    const unsigned long long seed = getBatchSeed(set, false, mNbBatches[set]++);
+
 #pragma omp parallel for if (batchSize > 1)
-    for (int batchPos = 0; batchPos < (int)batchSize; ++batchPos)
+    for (int batchPos = 0; batchPos < (int)batchSize; ++batchPos) {
+        Random::ThreadStream stream(seed, batchPos);
         readStimulus(batchRef[batchPos], set, batchPos);
+    }
 
     std::fill(batchRef.begin() + batchSize, batchRef.end(), -1);
 }
@@ -301,24 +498,52 @@ void N2D2::StimuliProvider::readStimulus(Database::StimulusID id,
                                          Database::StimuliSet set,
                                          unsigned int batchPos)
 {
-    std::stringstream dataCacheFile, labelsCacheFile;
-    dataCacheFile << mCachePath << "/" << std::setfill('0') << std::setw(7)
-                  << id << "_data_" << set << ".bin";
-    labelsCacheFile << mCachePath << "/" << std::setfill('0') << std::setw(7)
-                    << id << "_labels_" << set << ".bin";
+    loadStimulus(id,
+                 set,
+                 batchPos,
+                 (mFuture) ? mFutureData : mData,
+                 (mFuture) ? mFutureLabelsData : mLabelsData,
+                 (mFuture) ? mFutureLabelsROI[batchPos]
+                           : mLabelsROI[batchPos]);
+}
+
+void N2D2::StimuliProvider::loadStimulus(Database::StimulusID id,
+                                         Database::StimuliSet set,
+                                         unsigned int batchPos,
+                                         Tensor4d<Float_T>& dataRef,
+                                         Tensor4d<int>& labelsRef,
+                                         std::vector
+                                         <std::shared_ptr<ROI> >& labelsROI)
+{
+    const std::string dataCacheKey = getCacheKey(id, set);
+    const std::string labelsCacheKey = getCacheKey(id, set, true);
+
+    const std::string dataCacheFile = mCachePath + "/" + dataCacheKey
+                                      + ".bin";
+    const std::string labelsCacheFile = mCachePath + "/" + labelsCacheKey
+                                        + ".bin";
 
-    std::vector<std::shared_ptr<ROI> >& labelsROI
-        = (mFuture) ? mFutureLabelsROI[batchPos] : mLabelsROI[batchPos];
     labelsROI = mDatabase.getStimulusROIs(id);
 
     std::vector<cv::Mat> rawChannelsData;
     std::vector<cv::Mat> rawChannelsLabels;
 
     // 1. Cached data
-    if (!mCachePath.empty() && std::ifstream(dataCacheFile.str()).good()) {
+    if (mShardCache && mShardCache->contains(labelsCacheKey)) {
+        // Packed cache present, the data is not copied...
+        rawChannelsData = mShardCache->read(dataCacheKey);
+        rawChannelsLabels = mShardCache->read(labelsCacheKey);
+
+        // ... unless it is about to be transformed in place
+        if (!mTransformations(set).onTheFly.empty()) {
+            rawChannelsData[0] = rawChannelsData[0].clone();
+            rawChannelsLabels[0] = rawChannelsLabels[0].clone();
+        }
+    } else if (!mShardCache && !mCachePath.empty()
+               && std::ifstream(dataCacheFile.c_str()).good()) {
         // Cache present, load the pre-processed data
-        rawChannelsData = loadDataCache(dataCacheFile.str());
-        rawChannelsLabels = loadDataCache(labelsCacheFile.str());
+        rawChannelsData = loadDataCache(dataCacheFile);
+        rawChannelsLabels = loadDataCache(labelsCacheFile);
     } else {
         // Cache not present, load the raw stimuli from the database
         cv::Mat rawData
@@ -353,9 +578,13 @@ void N2D2::StimuliProvider::readStimulus(Database::StimulusID id,
         }
 
         // Save the pre-processed data
-        if (!mCachePath.empty()) {
-            saveDataCache(dataCacheFile.str(), rawChannelsData);
-            saveDataCache(labelsCacheFile.str(), rawChannelsLabels);
+        if (mShardCache) {
+            // The labels record is written last and marks a complete entry
+            mShardCache->write(dataCacheKey, rawChannelsData);
+            mShardCache->write(labelsCacheKey, rawChannelsLabels);
+        } else if (!mCachePath.empty()) {
+            saveDataCache(dataCacheFile, rawChannelsData);
+            saveDataCache(labelsCacheFile, rawChannelsLabels);
         }
     }
 
@@ -396,9 +625,6 @@ void N2D2::StimuliProvider::readStimulus(Database::StimulusID id,
         }
     }
 
-    Tensor4d<Float_T>& dataRef = (mFuture) ? mFutureData : mData;
-    Tensor4d<int>& labelsRef = (mFuture) ? mFutureLabelsData : mLabelsData;
-
     if (mBatchSize > 0) {
         if (dataRef.dimX() != data.dimX() || dataRef.dimY() != data.dimY()
             || dataRef.dimZ() != data.dimZ()) {
@@ -505,6 +731,8 @@ void N2D2::StimuliProvider::reverseLabels(const cv::Mat& mat,
 
 void N2D2::StimuliProvider::setBatchSize(unsigned int batchSize)
 {
+    stopPrefetch();
+
     mBatchSize = batchSize;
 
     if (mBatchSize > 0) {
@@ -530,6 +758,176 @@ void N2D2::StimuliProvider::setBatchSize(unsigned int batchSize)
     }
 }
 
+unsigned long long
+N2D2::StimuliProvider::getBatchSeed(Database::StimuliSet set,
+                                    bool random,
+                                    unsigned long long counter)
+{
+    return Random::streamSeed(Random::getSeed(),
+                              Random::streamId("StimuliProvider")
+                                + 2 * set + random,
+                              counter);
+}
+
+std::deque<unsigned int>::iterator
+N2D2::StimuliProvider::findPrefetchReady(unsigned long long counter)
+{
+    std::deque<unsigned int>::iterator it = mPrefetchReady.begin();
+
+    while (it != mPrefetchReady.end()
+           && mPrefetchSlots[*it].counter != counter)
+        ++it;
+
+    return it;
+}
+
+void N2D2::StimuliProvider::startPrefetch(Database::StimuliSet set)
+{
+    mPrefetchSet = set;
+    // The batches drawn but not read by the last prefetch run get the same
+    // keys again
+    mPrefetchCounter = mNbRandomBatches[set];
+    mPrefetchStop = false;
+    mPrefetchError = std::exception_ptr();
+
+    // Buffers are allocated once, and then only swapped with the current
+    // (or future) batch
+    mPrefetchSlots.clear();
+    mPrefetchSlots.resize(mPrefetchDepth);
+
+    for (std::vector<PrefetchSlot>::iterator it = mPrefetchSlots.begin(),
+                                             itEnd = mPrefetchSlots.end();
+         it != itEnd;
+         ++it) {
+        (*it).batch.resize(mBatchSize, -1);
+        (*it).data.resize(
+            mData.dimX(), mData.dimY(), mData.dimZ(), mBatchSize);
+        (*it).labelsData.resize(mLabelsData.dimX(),
+                                mLabelsData.dimY(),
+                                mLabelsData.dimZ(),
+                                mBatchSize);
+        (*it).labelsROI.resize(mBatchSize);
+    }
+
+    mPrefetchFree.clear();
+    mPrefetchReady.clear();
+
+    for (unsigned int i = 0; i < mPrefetchDepth; ++i)
+        mPrefetchFree.push_back(i);
+
+    for (unsigned int i = 0; i < mPrefetchWorkers; ++i)
+        mPrefetchThreads.push_back(
+            std::thread(&StimuliProvider::prefetchWorker, this));
+
+    mPrefetchRunning = true;
+}
+
+void N2D2::StimuliProvider::stopPrefetch()
+{
+    if (!mPrefetchRunning)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(mPrefetchMutex);
+        mPrefetchStop = true;
+    }
+
+    mPrefetchFreeCond.notify_all();
+
+    for (std::vector<std::thread>::iterator it = mPrefetchThreads.begin(),
+                                            itEnd = mPrefetchThreads.end();
+         it != itEnd;
+         ++it)
+        (*it).join();
+
+    mPrefetchThreads.clear();
+    mPrefetchSlots.clear();
+    mPrefetchFree.clear();
+    mPrefetchReady.clear();
+    mPrefetchRunning = false;
+}
+
+void N2D2::StimuliProvider::prefetchWorker()
+{
+    while (true) {
+        unsigned int slot;
+        unsigned long long seed = 0;
+        std::exception_ptr error;
+
+        {
+            std::unique_lock<std::mutex> lock(mPrefetchMutex);
+
+            while (!mPrefetchStop && mPrefetchFree.empty())
+                mPrefetchFreeCond.wait(lock);
+
+            if (mPrefetchStop)
+                return;
+
+            slot = mPrefetchFree.front();
+            mPrefetchFree.pop_front();
+
+            // The samplers are serialized between the workers, and each
+            // batch uses the same streams as without prefetch
+            mPrefetchSlots[slot].counter = mPrefetchCounter;
+            seed = getBatchSeed(mPrefetchSet, true, mPrefetchCounter++);
+
+            try {
+                Random::ThreadStream stream(seed, mBatchSize);
+
+                for (unsigned int batchPos = 0; batchPos < mBatchSize;
+                     ++batchPos) {
+                    mPrefetchSlots[slot].batch[batchPos]
+                        = getRandomID(mPrefetchSet);
+                }
+            }
+            catch (...) {
+                error = std::current_exception();
+            }
+        }
+
+        PrefetchSlot& batch = mPrefetchSlots[slot];
+        const int batchSize = (!error) ? (int)mBatchSize : 0;
+
+        // With several workers, parallelism is already across batches
+#pragma omp parallel for if (batchSize > 1 && mPrefetchWorkers == 1)
+        for (int batchPos = 0; batchPos < batchSize; ++batchPos) {
+            Random::ThreadStream stream(seed, batchPos);
+
+            try {
+                loadStimulus(batch.batch[batchPos],
+                             mPrefetchSet,
+                             batchPos,
+                             batch.data,
+                             batch.labelsData,
+                             batch.labelsROI[batchPos]);
+            }
+            catch (...) {
+#pragma omp critical
+                error = std::current_exception();
+            }
+        }
+
+        if (error) {
+            // The error is reported by the next readRandomBatch() call
+            {
+                std::lock_guard<std::mutex> lock(mPrefetchMutex);
+                mPrefetchError = error;
+                mPrefetchFree.push_back(slot);
+            }
+
+            mPrefetchReadyCond.notify_all();
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mPrefetchMutex);
+            mPrefetchReady.push_back(slot);
+        }
+
+        mPrefetchReadyCond.notify_one();
+    }
+}
+
 N2D2::Tensor3d<N2D2::Float_T>
 N2D2::StimuliProvider::readRawData(Database::StimulusID id) const
 {
@@ -540,12 +938,31 @@ N2D2::StimuliProvider::readRawData(Database::StimulusID id) const
     return Tensor3d<Float_T>(mat64F);
 }
 
-void N2D2::StimuliProvider::setCachePath(const std::string& path)
+void N2D2::StimuliProvider::setCachePath(const std::string& path,
+                                         bool packed)
 {
+    stopPrefetch();
+
     if (!path.empty())
         Utils::createDirectories(path);
 
     mCachePath = path;
+    mShardCache = (packed && !path.empty())
+                      ? std::make_shared<ShardCache>(path)
+                      : std::shared_ptr<ShardCache>();
+
+    if (mSampling == StimuliSampler::Window) {
+        for (std::map<Database::StimuliSet,
+                      std::shared_ptr<StimuliSampler> >::iterator it
+             = mSamplers.begin(),
+             itEnd = mSamplers.end();
+             it != itEnd;
+             ++it)
+        {
+            std::static_pointer_cast<WindowSampler>((*it).second)
+                ->setShardCache(mShardCache);
+        }
+    }
 }
 
 unsigned int
@@ -580,6 +997,16 @@ N2D2::StimuliProvider::getLabelsData(unsigned int channel,
     return Tensor2d<int>(mLabelsData[batchPos][channel]);
 }
 
+std::string N2D2::StimuliProvider::getCacheKey(Database::StimulusID id,
+                                              Database::StimuliSet set,
+                                              bool labels)
+{
+    std::ostringstream cacheKey;
+    cacheKey << std::setfill('0') << std::setw(7) << id
+             << ((labels) ? "_labels_" : "_data_") << set;
+    return cacheKey.str();
+}
+
 void N2D2::StimuliProvider::logData(const std::string& fileName,
                                     const Tensor2d<Float_T>& data)
 {
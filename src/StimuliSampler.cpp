@@ -0,0 +1,167 @@
+/*
+    (C) Copyright 2016 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include "StimuliSampler.hpp"
+#include "StimuliProvider.hpp"
+
+std::shared_ptr<N2D2::StimuliSampler>
+N2D2::StimuliSampler::create(Type type,
+                             const Database& database,
+                             Database::StimuliSet set,
+                             unsigned int windowSize)
+{
+    if (type == Epoch)
+        return std::make_shared<EpochSampler>(database, set);
+    else if (type == Window)
+        return std::make_shared<WindowSampler>(database, set, windowSize);
+    else
+        return std::make_shared<UniformSampler>(database, set);
+}
+
+N2D2::StimuliSampler::StimuliSampler(const Database& database,
+                                     Database::StimuliSet set)
+    : mDatabase(database), mSet(set), mNbEpochs(0)
+{
+    // ctor
+}
+
+void N2D2::StimuliSampler::shuffle(std::vector<unsigned int>::iterator first,
+                                   std::vector<unsigned int>::iterator last)
+{
+    for (int i = (int)(last - first) - 1; i > 0; --i)
+        std::swap(*(first + i), *(first + Random::randUniform(0, i)));
+}
+
+N2D2::UniformSampler::UniformSampler(const Database& database,
+                                     Database::StimuliSet set)
+    : StimuliSampler(database, set)
+{
+    // ctor
+}
+
+unsigned int N2D2::UniformSampler::next()
+{
+    return Random::randUniform(0, mDatabase.getNbStimuli(mSet) - 1);
+}
+
+N2D2::EpochSampler::EpochSampler(const Database& database,
+                                 Database::StimuliSet set)
+    : StimuliSampler(database, set), mPos(0)
+{
+    // ctor
+}
+
+unsigned int N2D2::EpochSampler::next()
+{
+    const unsigned int nbStimuli = mDatabase.getNbStimuli(mSet);
+
+    if (nbStimuli == 0)
+        throw std::runtime_error("EpochSampler::next(): the stimuli set is "
+                                 "empty");
+
+    if (mOrder.size() != nbStimuli) {
+        // First call, or the set changed: restart the epoch
+        newEpoch(nbStimuli);
+    }
+    else if (mPos == mOrder.size()) {
+        ++mNbEpochs;
+        newEpoch(nbStimuli);
+    }
+
+    return mOrder[mPos++];
+}
+
+void N2D2::EpochSampler::newEpoch(unsigned int nbStimuli)
+{
+    mOrder.resize(nbStimuli);
+
+    for (unsigned int index = 0; index < nbStimuli; ++index)
+        mOrder[index] = index;
+
+    shuffle(mOrder.begin(), mOrder.end());
+    mPos = 0;
+}
+
+N2D2::WindowSampler::WindowSampler(const Database& database,
+                                   Database::StimuliSet set,
+                                   unsigned int windowSize)
+    : EpochSampler(database, set), mWindowSize(windowSize)
+{
+    // ctor
+    if (windowSize == 0)
+        throw std::domain_error("WindowSampler: the window size must be > 0");
+}
+
+void N2D2::WindowSampler::newEpoch(unsigned int nbStimuli)
+{
+    // Set indexes in the order of the packed cache records (shard, offset),
+    // then in stimulus ID order for the stimuli not cached yet (or for all
+    // of them without packed cache)
+    std::vector<std::tuple<unsigned int, unsigned long long,
+                           Database::StimulusID, unsigned int> > ids;
+    ids.reserve(nbStimuli);
+
+    for (unsigned int index = 0; index < nbStimuli; ++index) {
+        const Database::StimulusID id = mDatabase.getStimulusID(mSet, index);
+        unsigned int shard = std::numeric_limits<unsigned int>::max();
+        unsigned long long offset = 0;
+
+        if (mShardCache) {
+            mShardCache->locate(StimuliProvider::getCacheKey(id, mSet),
+                                shard,
+                                offset);
+        }
+
+        ids.push_back(std::make_tuple(shard, offset, id, index));
+    }
+
+    std::sort(ids.begin(), ids.end());
+
+    // Windows in random order
+    const unsigned int nbWindows = (nbStimuli + mWindowSize - 1)
+                                   / mWindowSize;
+    std::vector<unsigned int> windows(nbWindows);
+
+    for (unsigned int w = 0; w < nbWindows; ++w)
+        windows[w] = w;
+
+    shuffle(windows.begin(), windows.end());
+
+    mOrder.clear();
+    mOrder.reserve(nbStimuli);
+
+    for (std::vector<unsigned int>::const_iterator it = windows.begin(),
+                                                   itEnd = windows.end();
+         it != itEnd;
+         ++it)
+    {
+        const unsigned int begin = (*it) * mWindowSize;
+        const unsigned int end = std::min(begin + mWindowSize, nbStimuli);
+        const unsigned int offset = mOrder.size();
+
+        for (unsigned int i = begin; i < end; ++i)
+            mOrder.push_back(std::get<3>(ids[i]));
+
+        // Shuffle inside the window
+        shuffle(mOrder.begin() + offset, mOrder.end());
+    }
+
+    mPos = 0;
+}
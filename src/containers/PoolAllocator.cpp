@@ -0,0 +1,223 @@
+/*
+    (C) Copyright 2016 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include "containers/PoolAllocator.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+
+const std::size_t N2D2::MemoryPool::Alignment;
+
+N2D2::MemoryPool::MemoryPool()
+    : mPooling(true), mMaxCached(std::numeric_limits<std::size_t>::max())
+{
+    // ctor
+    mStats.nbAllocations = 0;
+    mStats.nbHeapAllocations = 0;
+    mStats.nbDeallocations = 0;
+    mStats.bytesInUse = 0;
+    mStats.bytesCached = 0;
+    mStats.peakBytes = 0;
+}
+
+N2D2::MemoryPool& N2D2::MemoryPool::instance()
+{
+    // Never destroyed, as tensors with static storage duration may release
+    // their buffer after the end of main()
+    static MemoryPool* pool = new MemoryPool();
+    return *pool;
+}
+
+std::size_t N2D2::MemoryPool::sizeClass(std::size_t size)
+{
+    if (size <= Alignment)
+        return Alignment;
+
+    // Four size classes per power of two, which bounds the overhead to 25%
+    std::size_t power = Alignment;
+
+    while (2 * power < size)
+        power *= 2;
+
+    const std::size_t step = power / 4;
+    return ((size + step - 1) / step) * step;
+}
+
+void* N2D2::MemoryPool::heapAllocate(std::size_t size)
+{
+    // The address of the unaligned block is stored just before the aligned
+    // buffer
+    void* block = std::malloc(size + Alignment + sizeof(void*));
+
+    if (block == NULL)
+        throw std::bad_alloc();
+
+    const std::uintptr_t address
+        = reinterpret_cast<std::uintptr_t>(block) + sizeof(void*);
+    void* ptr = reinterpret_cast<void*>((address + Alignment - 1)
+                                        & ~(std::uintptr_t)(Alignment - 1));
+    static_cast<void**>(ptr)[-1] = block;
+    return ptr;
+}
+
+void N2D2::MemoryPool::heapFree(void* ptr)
+{
+    std::free(static_cast<void**>(ptr)[-1]);
+}
+
+void* N2D2::MemoryPool::allocate(std::size_t size)
+{
+    MemoryPool& pool = instance();
+    const std::size_t classSize = sizeClass(size);
+
+    std::lock_guard<std::mutex> lock(pool.mLock);
+    ++pool.mStats.nbAllocations;
+    pool.mStats.bytesInUse += classSize;
+
+    std::map<std::size_t, std::vector<void*> >::iterator it
+        = pool.mFree.find(classSize);
+
+    if (it != pool.mFree.end() && !(*it).second.empty()) {
+        void* ptr = (*it).second.back();
+        (*it).second.pop_back();
+        pool.mStats.bytesCached -= classSize;
+        return ptr;
+    }
+
+    ++pool.mStats.nbHeapAllocations;
+    pool.mStats.peakBytes = std::max(pool.mStats.peakBytes,
+                                     pool.mStats.bytesInUse
+                                     + pool.mStats.bytesCached);
+    return heapAllocate(classSize);
+}
+
+void N2D2::MemoryPool::deallocate(void* ptr, std::size_t size)
+{
+    if (ptr == NULL)
+        return;
+
+    MemoryPool& pool = instance();
+    const std::size_t classSize = sizeClass(size);
+
+    std::lock_guard<std::mutex> lock(pool.mLock);
+    ++pool.mStats.nbDeallocations;
+    pool.mStats.bytesInUse -= classSize;
+
+    if (pool.mPooling && pool.mStats.bytesCached + classSize
+                         <= pool.mMaxCached) {
+        pool.mFree[classSize].push_back(ptr);
+        pool.mStats.bytesCached += classSize;
+    }
+    else
+        heapFree(ptr);
+}
+
+void N2D2::MemoryPool::setPooling(bool pooling)
+{
+    MemoryPool& pool = instance();
+
+    {
+        std::lock_guard<std::mutex> lock(pool.mLock);
+        pool.mPooling = pooling;
+    }
+
+    if (!pooling)
+        releaseCached();
+}
+
+bool N2D2::MemoryPool::isPooling()
+{
+    MemoryPool& pool = instance();
+    std::lock_guard<std::mutex> lock(pool.mLock);
+    return pool.mPooling;
+}
+
+void N2D2::MemoryPool::setMaxCached(std::size_t maxCached)
+{
+    MemoryPool& pool = instance();
+    std::lock_guard<std::mutex> lock(pool.mLock);
+    pool.mMaxCached = maxCached;
+    pool.trim();
+}
+
+std::size_t N2D2::MemoryPool::getMaxCached()
+{
+    MemoryPool& pool = instance();
+    std::lock_guard<std::mutex> lock(pool.mLock);
+    return pool.mMaxCached;
+}
+
+void N2D2::MemoryPool::trim()
+{
+    // Largest size classes first, as they free the most memory per buffer
+    std::map<std::size_t, std::vector<void*> >::reverse_iterator it
+        = mFree.rbegin();
+
+    while (mStats.bytesCached > mMaxCached && it != mFree.rend()) {
+        if ((*it).second.empty()) {
+            ++it;
+            continue;
+        }
+
+        heapFree((*it).second.back());
+        (*it).second.pop_back();
+        mStats.bytesCached -= (*it).first;
+    }
+}
+
+void N2D2::MemoryPool::releaseCached()
+{
+    MemoryPool& pool = instance();
+    std::lock_guard<std::mutex> lock(pool.mLock);
+
+    for (std::map<std::size_t, std::vector<void*> >::iterator it
+         = pool.mFree.begin(),
+         itEnd = pool.mFree.end();
+         it != itEnd;
+         ++it) {
+        for (std::vector<void*>::iterator itPtr = (*it).second.begin(),
+                                          itPtrEnd = (*it).second.end();
+             itPtr != itPtrEnd;
+             ++itPtr)
+            heapFree(*itPtr);
+    }
+
+    pool.mFree.clear();
+    pool.mStats.bytesCached = 0;
+}
+
+N2D2::MemoryPool::Stats N2D2::MemoryPool::getStats()
+{
+    MemoryPool& pool = instance();
+    std::lock_guard<std::mutex> lock(pool.mLock);
+    return pool.mStats;
+}
+
+void N2D2::MemoryPool::resetStats()
+{
+    MemoryPool& pool = instance();
+    std::lock_guard<std::mutex> lock(pool.mLock);
+    pool.mStats.nbAllocations = 0;
+    pool.mStats.nbHeapAllocations = 0;
+    pool.mStats.nbDeallocations = 0;
+    pool.mStats.peakBytes = pool.mStats.bytesInUse + pool.mStats.bytesCached;
+}
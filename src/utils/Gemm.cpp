@@ -0,0 +1,436 @@
+/*
+    (C) Copyright 2016 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include "utils/Gemm.hpp"
+#include "containers/PoolAllocator.hpp"
+
+#include <algorithm>
+#include <sstream>
+#include <vector>
+
+#if defined(OPENBLAS)
+#include <cblas.h>
+#define CBLAS
+#elif defined(MKL)
+#include <mkl.h>
+#define CBLAS
+#elif defined(BLIS)
+#include <blis.h>
+#include <cblas.h>
+#define CBLAS
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#ifndef CBLAS
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define GEMM_SSE
+#endif
+
+// Register block (micro-tile) size, chosen so that the accumulators fit in the
+// vector registers
+#ifdef __AVX__
+#define GEMM_MR 6
+#define GEMM_NR 16
+#else
+#define GEMM_MR 4
+#define GEMM_NR 8
+#endif
+// Cache block sizes: a MC x KC panel of A should fit in the L2 cache and a
+// KC x NR sliver of B in the L1 cache
+#define GEMM_MC 96
+#define GEMM_KC 256
+#define GEMM_NC 2048
+
+static inline float gemmElement(N2D2::Gemm::Transpose trans,
+                                const float* X,
+                                unsigned int ldx,
+                                unsigned int row,
+                                unsigned int col)
+{
+    return (trans == N2D2::Gemm::NoTrans) ? X[row * ldx + col]
+                                          : X[col * ldx + row];
+}
+
+/// Pack a mc x kc block of op(A) into GEMM_MR rows wide panels, zero-padded
+static void packA(N2D2::Gemm::Transpose transA,
+                  const float* A,
+                  unsigned int lda,
+                  unsigned int mc,
+                  unsigned int kc,
+                  float* packed)
+{
+    for (unsigned int i0 = 0; i0 < mc; i0 += GEMM_MR) {
+        const unsigned int mr = std::min<unsigned int>(GEMM_MR, mc - i0);
+
+        for (unsigned int p = 0; p < kc; ++p) {
+            for (unsigned int i = 0; i < mr; ++i)
+                packed[i] = gemmElement(transA, A, lda, i0 + i, p);
+
+            for (unsigned int i = mr; i < GEMM_MR; ++i)
+                packed[i] = 0.0f;
+
+            packed += GEMM_MR;
+        }
+    }
+}
+
+/// Pack a kc x nc block of op(B) into GEMM_NR columns wide panels, zero-padded
+static void packB(N2D2::Gemm::Transpose transB,
+                  const float* B,
+                  unsigned int ldb,
+                  unsigned int kc,
+                  unsigned int nc,
+                  float* packed)
+{
+    for (unsigned int j0 = 0; j0 < nc; j0 += GEMM_NR) {
+        const unsigned int nr = std::min<unsigned int>(GEMM_NR, nc - j0);
+
+        for (unsigned int p = 0; p < kc; ++p) {
+            if (transB == N2D2::Gemm::NoTrans && nr == GEMM_NR) {
+                std::copy(B + p * ldb + j0, B + p * ldb + j0 + GEMM_NR, packed);
+            } else {
+                for (unsigned int j = 0; j < nr; ++j)
+                    packed[j] = gemmElement(transB, B, ldb, p, j0 + j);
+
+                for (unsigned int j = nr; j < GEMM_NR; ++j)
+                    packed[j] = 0.0f;
+            }
+
+            packed += GEMM_NR;
+        }
+    }
+}
+
+/// Compute the GEMM_MR x GEMM_NR tile ab = a * b from packed panels
+static void microKernel(unsigned int kc,
+                        const float* a,
+                        const float* b,
+                        float* ab)
+{
+#ifdef __AVX__
+    __m256 c00 = _mm256_setzero_ps(), c01 = _mm256_setzero_ps();
+    __m256 c10 = _mm256_setzero_ps(), c11 = _mm256_setzero_ps();
+    __m256 c20 = _mm256_setzero_ps(), c21 = _mm256_setzero_ps();
+    __m256 c30 = _mm256_setzero_ps(), c31 = _mm256_setzero_ps();
+    __m256 c40 = _mm256_setzero_ps(), c41 = _mm256_setzero_ps();
+    __m256 c50 = _mm256_setzero_ps(), c51 = _mm256_setzero_ps();
+
+#ifdef __FMA__
+#define GEMM_MADD(a, b, c) _mm256_fmadd_ps(a, b, c)
+#else
+#define GEMM_MADD(a, b, c) _mm256_add_ps(_mm256_mul_ps(a, b), c)
+#endif
+
+    for (unsigned int p = 0; p < kc; ++p) {
+        const __m256 b0 = _mm256_loadu_ps(b);
+        const __m256 b1 = _mm256_loadu_ps(b + 8);
+        __m256 ai;
+
+        ai = _mm256_broadcast_ss(a + 0);
+        c00 = GEMM_MADD(ai, b0, c00);
+        c01 = GEMM_MADD(ai, b1, c01);
+        ai = _mm256_broadcast_ss(a + 1);
+        c10 = GEMM_MADD(ai, b0, c10);
+        c11 = GEMM_MADD(ai, b1, c11);
+        ai = _mm256_broadcast_ss(a + 2);
+        c20 = GEMM_MADD(ai, b0, c20);
+        c21 = GEMM_MADD(ai, b1, c21);
+        ai = _mm256_broadcast_ss(a + 3);
+        c30 = GEMM_MADD(ai, b0, c30);
+        c31 = GEMM_MADD(ai, b1, c31);
+        ai = _mm256_broadcast_ss(a + 4);
+        c40 = GEMM_MADD(ai, b0, c40);
+        c41 = GEMM_MADD(ai, b1, c41);
+        ai = _mm256_broadcast_ss(a + 5);
+        c50 = GEMM_MADD(ai, b0, c50);
+        c51 = GEMM_MADD(ai, b1, c51);
+
+        a += GEMM_MR;
+        b += GEMM_NR;
+    }
+
+#undef GEMM_MADD
+
+    _mm256_storeu_ps(ab + 0 * GEMM_NR, c00);
+    _mm256_storeu_ps(ab + 0 * GEMM_NR + 8, c01);
+    _mm256_storeu_ps(ab + 1 * GEMM_NR, c10);
+    _mm256_storeu_ps(ab + 1 * GEMM_NR + 8, c11);
+    _mm256_storeu_ps(ab + 2 * GEMM_NR, c20);
+    _mm256_storeu_ps(ab + 2 * GEMM_NR + 8, c21);
+    _mm256_storeu_ps(ab + 3 * GEMM_NR, c30);
+    _mm256_storeu_ps(ab + 3 * GEMM_NR + 8, c31);
+    _mm256_storeu_ps(ab + 4 * GEMM_NR, c40);
+    _mm256_storeu_ps(ab + 4 * GEMM_NR + 8, c41);
+    _mm256_storeu_ps(ab + 5 * GEMM_NR, c50);
+    _mm256_storeu_ps(ab + 5 * GEMM_NR + 8, c51);
+#elif defined(GEMM_SSE)
+    __m128 c00 = _mm_setzero_ps(), c01 = _mm_setzero_ps();
+    __m128 c10 = _mm_setzero_ps(), c11 = _mm_setzero_ps();
+    __m128 c20 = _mm_setzero_ps(), c21 = _mm_setzero_ps();
+    __m128 c30 = _mm_setzero_ps(), c31 = _mm_setzero_ps();
+
+    for (unsigned int p = 0; p < kc; ++p) {
+        const __m128 b0 = _mm_loadu_ps(b);
+        const __m128 b1 = _mm_loadu_ps(b + 4);
+        __m128 ai;
+
+        ai = _mm_set1_ps(a[0]);
+        c00 = _mm_add_ps(_mm_mul_ps(ai, b0), c00);
+        c01 = _mm_add_ps(_mm_mul_ps(ai, b1), c01);
+        ai = _mm_set1_ps(a[1]);
+        c10 = _mm_add_ps(_mm_mul_ps(ai, b0), c10);
+        c11 = _mm_add_ps(_mm_mul_ps(ai, b1), c11);
+        ai = _mm_set1_ps(a[2]);
+        c20 = _mm_add_ps(_mm_mul_ps(ai, b0), c20);
+        c21 = _mm_add_ps(_mm_mul_ps(ai, b1), c21);
+        ai = _mm_set1_ps(a[3]);
+        c30 = _mm_add_ps(_mm_mul_ps(ai, b0), c30);
+        c31 = _mm_add_ps(_mm_mul_ps(ai, b1), c31);
+
+        a += GEMM_MR;
+        b += GEMM_NR;
+    }
+
+    _mm_storeu_ps(ab + 0 * GEMM_NR, c00);
+    _mm_storeu_ps(ab + 0 * GEMM_NR + 4, c01);
+    _mm_storeu_ps(ab + 1 * GEMM_NR, c10);
+    _mm_storeu_ps(ab + 1 * GEMM_NR + 4, c11);
+    _mm_storeu_ps(ab + 2 * GEMM_NR, c20);
+    _mm_storeu_ps(ab + 2 * GEMM_NR + 4, c21);
+    _mm_storeu_ps(ab + 3 * GEMM_NR, c30);
+    _mm_storeu_ps(ab + 3 * GEMM_NR + 4, c31);
+#else
+    // Generic version: fixed trip count loops, auto-vectorized by the compiler
+    float c[GEMM_MR * GEMM_NR] = {0.0f};
+
+    for (unsigned int p = 0; p < kc; ++p) {
+        for (unsigned int i = 0; i < GEMM_MR; ++i) {
+            const float ai = a[i];
+
+            for (unsigned int j = 0; j < GEMM_NR; ++j)
+                c[i * GEMM_NR + j] += ai * b[j];
+        }
+
+        a += GEMM_MR;
+        b += GEMM_NR;
+    }
+
+    std::copy(c, c + GEMM_MR * GEMM_NR, ab);
+#endif
+}
+
+/// Serial blocked C += alpha * op(A) * op(B)
+static void gemmBlocked(N2D2::Gemm::Transpose transA,
+                        N2D2::Gemm::Transpose transB,
+                        unsigned int M,
+                        unsigned int N,
+                        unsigned int K,
+                        float alpha,
+                        const float* A,
+                        unsigned int lda,
+                        const float* B,
+                        unsigned int ldb,
+                        float* C,
+                        unsigned int ldc)
+{
+    const unsigned int ncMax = std::min<unsigned int>(GEMM_NC, N);
+    const unsigned int kcMax = std::min<unsigned int>(GEMM_KC, K);
+    const unsigned int mcMax = std::min<unsigned int>(GEMM_MC, M);
+
+    N2D2::PoolVector<float>::type packedA(
+        ((mcMax + GEMM_MR - 1) / GEMM_MR) * GEMM_MR * kcMax);
+    N2D2::PoolVector<float>::type packedB(
+        ((ncMax + GEMM_NR - 1) / GEMM_NR) * GEMM_NR * kcMax);
+    float ab[GEMM_MR * GEMM_NR];
+
+    for (unsigned int jc = 0; jc < N; jc += GEMM_NC) {
+        const unsigned int nc = std::min<unsigned int>(GEMM_NC, N - jc);
+
+        for (unsigned int pc = 0; pc < K; pc += GEMM_KC) {
+            const unsigned int kc = std::min<unsigned int>(GEMM_KC, K - pc);
+            const float* blockB = (transB == N2D2::Gemm::NoTrans)
+                                      ? B + pc * ldb + jc
+                                      : B + jc * ldb + pc;
+
+            packB(transB, blockB, ldb, kc, nc, &packedB[0]);
+
+            for (unsigned int ic = 0; ic < M; ic += GEMM_MC) {
+                const unsigned int mc = std::min<unsigned int>(GEMM_MC, M - ic);
+                const float* blockA = (transA == N2D2::Gemm::NoTrans)
+                                          ? A + ic * lda + pc
+                                          : A + pc * lda + ic;
+
+                packA(transA, blockA, lda, mc, kc, &packedA[0]);
+
+                for (unsigned int jr = 0; jr < nc; jr += GEMM_NR) {
+                    const unsigned int nr
+                        = std::min<unsigned int>(GEMM_NR, nc - jr);
+
+                    for (unsigned int ir = 0; ir < mc; ir += GEMM_MR) {
+                        const unsigned int mr
+                            = std::min<unsigned int>(GEMM_MR, mc - ir);
+
+                        microKernel(kc,
+                                    &packedA[ir * kc],
+                                    &packedB[jr * kc],
+                                    ab);
+
+                        float* tileC = C + (ic + ir) * ldc + jc + jr;
+
+                        for (unsigned int i = 0; i < mr; ++i) {
+                            for (unsigned int j = 0; j < nr; ++j)
+                                tileC[i * ldc + j] += alpha
+                                                      * ab[i * GEMM_NR + j];
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+#endif
+
+void N2D2::Gemm::sgemm(Transpose transA,
+                       Transpose transB,
+                       unsigned int M,
+                       unsigned int N,
+                       unsigned int K,
+                       float alpha,
+                       const float* A,
+                       unsigned int lda,
+                       const float* B,
+                       unsigned int ldb,
+                       float beta,
+                       float* C,
+                       unsigned int ldc)
+{
+    if (M == 0 || N == 0)
+        return;
+
+#ifdef CBLAS
+    cblas_sgemm(CblasRowMajor,
+                (transA == Trans) ? CblasTrans : CblasNoTrans,
+                (transB == Trans) ? CblasTrans : CblasNoTrans,
+                M,
+                N,
+                K,
+                alpha,
+                A,
+                lda,
+                B,
+                ldb,
+                beta,
+                C,
+                ldc);
+#else
+    // Split C in slices along its largest dimension, one per thread
+    const bool splitN = (N >= M);
+    const unsigned int dim = (splitN) ? N : M;
+    const unsigned int align = (splitN) ? GEMM_NR : GEMM_MR;
+
+#pragma omp parallel if (2.0 * M * N * K > 1.0e6 && dim >= 2 * align)
+    {
+#ifdef _OPENMP
+        const unsigned int nbThreads = omp_get_num_threads();
+        const unsigned int threadId = omp_get_thread_num();
+#else
+        const unsigned int nbThreads = 1;
+        const unsigned int threadId = 0;
+#endif
+        const unsigned int nbAligned = (dim + align - 1) / align;
+        const unsigned int sliceSize
+            = align * ((nbAligned + nbThreads - 1) / nbThreads);
+        const unsigned int start = std::min(threadId * sliceSize, dim);
+        const unsigned int end = std::min(start + sliceSize, dim);
+
+        if (end > start) {
+            const unsigned int sM = (splitN) ? M : end - start;
+            const unsigned int sN = (splitN) ? end - start : N;
+            const float* sA
+                = (splitN) ? A : (transA == NoTrans) ? A + start * lda
+                                                     : A + start;
+            const float* sB
+                = (!splitN) ? B : (transB == NoTrans) ? B + start
+                                                      : B + start * ldb;
+            float* sC = (splitN) ? C + start : C + start * ldc;
+
+            for (unsigned int i = 0; i < sM; ++i) {
+                float* rowC = sC + i * ldc;
+
+                if (beta == 0.0f)
+                    std::fill(rowC, rowC + sN, 0.0f);
+                else if (beta != 1.0f) {
+                    for (unsigned int j = 0; j < sN; ++j)
+                        rowC[j] *= beta;
+                }
+            }
+
+            if (K > 0 && alpha != 0.0f)
+                gemmBlocked(transA, transB, sM, sN, K, alpha, sA, lda, sB, ldb,
+                            sC, ldc);
+        }
+    }
+#endif
+}
+
+std::string N2D2::Gemm::getBackend()
+{
+    std::stringstream backend;
+
+#if defined(OPENBLAS)
+    backend << "OpenBLAS (" << openblas_get_config() << ", "
+            << openblas_get_num_threads() << " thread(s))";
+#elif defined(MKL)
+    char version[256];
+    mkl_get_version_string(version, sizeof(version));
+
+    backend << version << " (" << mkl_get_max_threads() << " thread(s))";
+#elif defined(BLIS)
+    backend << "BLIS " << bli_info_get_version_str() << " ("
+            << bli_thread_get_num_threads() << " thread(s))";
+#else
+    backend << "built-in";
+
+#if defined(__AVX__) && defined(__FMA__)
+    backend << " (AVX/FMA";
+#elif defined(__AVX__)
+    backend << " (AVX";
+#elif defined(GEMM_SSE)
+    backend << " (SSE";
+#else
+    backend << " (generic";
+#endif
+
+#ifdef _OPENMP
+    backend << ", " << omp_get_max_threads() << " thread(s))";
+#else
+    backend << ", 1 thread)";
+#endif
+#endif
+
+    return backend.str();
+}
@@ -0,0 +1,84 @@
+/*
+    (C) Copyright 2016 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include "utils/MappedFile.hpp"
+
+#include <fstream>
+#include <stdexcept>
+
+#ifndef WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+N2D2::MappedFile::MappedFile(const std::string& fileName)
+    : mFileName(fileName), mSize(0), mData(NULL), mMapping(NULL)
+{
+    std::ifstream is(fileName.c_str(), std::ios::binary);
+
+    if (!is.good())
+        throw std::runtime_error("MappedFile: could not open file: "
+                                 + fileName);
+
+    is.seekg(0, std::ios::end);
+    mSize = is.tellg();
+
+    if (mSize == 0)
+        return;
+
+#ifndef WIN32
+    is.close();
+
+    const int fd = open(fileName.c_str(), O_RDONLY);
+
+    if (fd < 0)
+        throw std::runtime_error("MappedFile: could not open file: "
+                                 + fileName);
+
+    void* data = mmap(NULL, mSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (data == MAP_FAILED)
+        throw std::runtime_error("MappedFile: could not map file: "
+                                 + fileName);
+
+    mMapping = data;
+    mData = static_cast<const unsigned char*>(data);
+#else
+    mBuffer.resize(mSize);
+    is.seekg(0, std::ios::beg);
+    is.read(reinterpret_cast<char*>(&mBuffer[0]), mSize);
+
+    if (!is.good())
+        throw std::runtime_error("MappedFile: error while reading file: "
+                                 + fileName);
+
+    mData = &mBuffer[0];
+#endif
+}
+
+N2D2::MappedFile::~MappedFile()
+{
+#ifndef WIN32
+    if (mMapping != NULL)
+        munmap(mMapping, mSize);
+#endif
+}
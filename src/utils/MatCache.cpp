@@ -0,0 +1,226 @@
+/*
+    (C) Copyright 2016 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include "utils/MatCache.hpp"
+
+#include <stdexcept>
+
+N2D2::MatCache::Shard::Shard() : budget(0)
+{
+    // ctor
+    stats.nbHits = 0;
+    stats.nbMisses = 0;
+    stats.nbInsertions = 0;
+    stats.nbEvictions = 0;
+    stats.nbEntries = 0;
+    stats.bytes = 0;
+}
+
+N2D2::MatCache::MatCache(std::size_t budget, unsigned int nbShards)
+    : mShards(nbShards), mBudget(0)
+{
+    // ctor
+    if (nbShards == 0)
+        throw std::runtime_error("MatCache: the number of shards must be > 0");
+
+    setBudget(budget);
+}
+
+bool N2D2::MatCache::get(Key key, cv::Mat& mat)
+{
+    Shard& sh = shard(key);
+    std::lock_guard<std::mutex> lock(sh.mutex);
+
+    const std::unordered_map<Key, LruList_T::iterator>::const_iterator it
+        = sh.index.find(key);
+
+    if (it == sh.index.end()) {
+        ++sh.stats.nbMisses;
+        return false;
+    }
+
+    // Move the entry to the front of the LRU list
+    sh.lru.splice(sh.lru.begin(), sh.lru, (*it).second);
+    mat = (*it).second->second;
+    ++sh.stats.nbHits;
+    return true;
+}
+
+void N2D2::MatCache::insert(Key key, const cv::Mat& mat)
+{
+    Shard& sh = shard(key);
+    const std::size_t size = matSize(mat);
+
+    std::lock_guard<std::mutex> lock(sh.mutex);
+
+    const std::unordered_map<Key, LruList_T::iterator>::iterator it
+        = sh.index.find(key);
+
+    if (it != sh.index.end()) {
+        sh.stats.bytes -= matSize((*it).second->second);
+        --sh.stats.nbEntries;
+        sh.lru.erase((*it).second);
+        sh.index.erase(it);
+    }
+
+    if (sh.budget > 0) {
+        if (size > sh.budget)
+            return;
+
+        evict(sh, sh.budget - size);
+    }
+
+    sh.lru.push_front(std::make_pair(key, mat));
+    sh.index[key] = sh.lru.begin();
+    sh.stats.bytes += size;
+    ++sh.stats.nbEntries;
+    ++sh.stats.nbInsertions;
+}
+
+void N2D2::MatCache::erase(Key key)
+{
+    Shard& sh = shard(key);
+    std::lock_guard<std::mutex> lock(sh.mutex);
+
+    const std::unordered_map<Key, LruList_T::iterator>::iterator it
+        = sh.index.find(key);
+
+    if (it != sh.index.end()) {
+        sh.stats.bytes -= matSize((*it).second->second);
+        --sh.stats.nbEntries;
+        sh.lru.erase((*it).second);
+        sh.index.erase(it);
+    }
+}
+
+void N2D2::MatCache::clear()
+{
+    for (std::vector<Shard>::iterator it = mShards.begin(),
+                                      itEnd = mShards.end();
+         it != itEnd;
+         ++it)
+    {
+        std::lock_guard<std::mutex> lock((*it).mutex);
+        (*it).lru.clear();
+        (*it).index.clear();
+        (*it).stats.nbEntries = 0;
+        (*it).stats.bytes = 0;
+    }
+}
+
+void N2D2::MatCache::setBudget(std::size_t budget)
+{
+    std::lock_guard<std::mutex> budgetLock(mBudgetMutex);
+
+    if (budget == mBudget)
+        return;
+
+    mBudget = budget;
+
+    // Round up, so that a non-zero budget never gives an unlimited shard
+    const std::size_t shardBudget = (budget + mShards.size() - 1)
+                                    / mShards.size();
+
+    for (std::vector<Shard>::iterator it = mShards.begin(),
+                                      itEnd = mShards.end();
+         it != itEnd;
+         ++it)
+    {
+        std::lock_guard<std::mutex> lock((*it).mutex);
+        (*it).budget = shardBudget;
+
+        if (shardBudget > 0)
+            evict(*it, shardBudget);
+    }
+}
+
+std::size_t N2D2::MatCache::getBudget() const
+{
+    std::lock_guard<std::mutex> budgetLock(mBudgetMutex);
+    return mBudget;
+}
+
+N2D2::MatCache::Stats N2D2::MatCache::getStats() const
+{
+    Stats stats = Stats();
+
+    for (std::vector<Shard>::const_iterator it = mShards.begin(),
+                                            itEnd = mShards.end();
+         it != itEnd;
+         ++it)
+    {
+        std::lock_guard<std::mutex> lock((*it).mutex);
+        stats.nbHits += (*it).stats.nbHits;
+        stats.nbMisses += (*it).stats.nbMisses;
+        stats.nbInsertions += (*it).stats.nbInsertions;
+        stats.nbEvictions += (*it).stats.nbEvictions;
+        stats.nbEntries += (*it).stats.nbEntries;
+        stats.bytes += (*it).stats.bytes;
+    }
+
+    return stats;
+}
+
+void N2D2::MatCache::resetStats()
+{
+    for (std::vector<Shard>::iterator it = mShards.begin(),
+                                      itEnd = mShards.end();
+         it != itEnd;
+         ++it)
+    {
+        std::lock_guard<std::mutex> lock((*it).mutex);
+        (*it).stats.nbHits = 0;
+        (*it).stats.nbMisses = 0;
+        (*it).stats.nbInsertions = 0;
+        (*it).stats.nbEvictions = 0;
+    }
+}
+
+std::size_t N2D2::MatCache::matSize(const cv::Mat& mat)
+{
+    return mat.total() * mat.elemSize();
+}
+
+N2D2::MatCache::Shard& N2D2::MatCache::shard(Key key)
+{
+    // The keys are often structured (e.g. Database uses 2*id for the data
+    // and 2*id+1 for the labels), so they are mixed (SplitMix64 finalizer)
+    // before the modulo to spread every subset evenly over the shards
+    key ^= key >> 30;
+    key *= 0xbf58476d1ce4e5b9ULL;
+    key ^= key >> 27;
+    key *= 0x94d049bb133111ebULL;
+    key ^= key >> 31;
+
+    return mShards[key % mShards.size()];
+}
+
+void N2D2::MatCache::evict(Shard& shard, std::size_t size)
+{
+    // Evict from the back of the LRU list until the shard holds at most
+    // size bytes
+    while (shard.stats.bytes > size && !shard.lru.empty()) {
+        shard.stats.bytes -= matSize(shard.lru.back().second);
+        --shard.stats.nbEntries;
+        ++shard.stats.nbEvictions;
+        shard.index.erase(shard.lru.back().first);
+        shard.lru.pop_back();
+    }
+}
@@ -0,0 +1,301 @@
+/*
+    (C) Copyright 2016 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include "utils/Quantization.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+N2D2::Quantization::Histogram::Histogram(unsigned int nbBins)
+    : mBins(nbBins, 0), mRange(0.0), mMaxAbs(0.0), mSigned(false)
+{
+    // ctor
+    if (nbBins < 2 || nbBins % 2 != 0)
+        throw std::domain_error("Histogram: the number of bins must be an "
+                                "even number >= 2");
+}
+
+void N2D2::Quantization::Histogram::operator()(double value)
+{
+    if (value < 0.0) {
+        mSigned = true;
+        value = -value;
+    }
+
+    if (value > mMaxAbs)
+        mMaxAbs = value;
+
+    if (value > mRange) {
+        if (mRange == 0.0)
+            mRange = value;
+        else {
+            const unsigned int nbBins = mBins.size();
+
+            while (value > mRange) {
+                // Double the range, merging the bins by pairs
+                for (unsigned int i = 0; i < nbBins / 2; ++i)
+                    mBins[i] = mBins[2 * i] + mBins[2 * i + 1];
+
+                std::fill(mBins.begin() + nbBins / 2, mBins.end(), 0);
+                mRange *= 2.0;
+            }
+        }
+    }
+
+    const unsigned int bin = (mRange > 0.0)
+        ? std::min((unsigned int)(value / mRange * mBins.size()),
+                   (unsigned int)mBins.size() - 1)
+        : 0;
+
+    ++mBins[bin];
+}
+
+void N2D2::Quantization::Histogram::fill(const Tensor4d<float>& data)
+{
+    for (Tensor4d<float>::const_iterator it = data.begin(), itEnd = data.end();
+         it != itEnd;
+         ++it)
+        (*this)(*it);
+}
+
+double N2D2::Quantization::Histogram::calibrate(Calibration calibration,
+                                                unsigned int nbBits) const
+{
+    if (calibration == KL && mMaxAbs > 0.0)
+        return std::min(calibrateKL(maxValue(nbBits, mSigned) + 1), mMaxAbs);
+    else
+        return mMaxAbs;
+}
+
+double N2D2::Quantization::Histogram::calibrateKL(unsigned int nbLevels) const
+{
+    const unsigned int nbBins = mBins.size();
+    const double binWidth = mRange / nbBins;
+
+    // Last non-empty bin: the threshold is never above it
+    unsigned int lastBin = nbBins;
+
+    while (lastBin > 0 && mBins[lastBin - 1] == 0)
+        --lastBin;
+
+    if (lastBin <= nbLevels)
+        return mMaxAbs;
+
+    std::vector<double> p(lastBin);
+    std::vector<double> q(lastBin);
+    double bestDivergence = std::numeric_limits<double>::max();
+    unsigned int bestThreshold = lastBin;
+
+    for (unsigned int threshold = nbLevels; threshold <= lastBin;
+         ++threshold)
+    {
+        // Reference distribution, clipped at the threshold: the outliers are
+        // accumulated in the last bin
+        std::copy(mBins.begin(), mBins.begin() + threshold, p.begin());
+
+        for (unsigned int i = threshold; i < lastBin; ++i)
+            p[threshold - 1] += mBins[i];
+
+        // Quantized distribution: the reference bins are merged in nbLevels
+        // levels, each level being spread back over its non-empty bins
+        for (unsigned int level = 0; level < nbLevels; ++level) {
+            const unsigned int start = (level * threshold) / nbLevels;
+            const unsigned int stop = ((level + 1) * threshold) / nbLevels;
+            double sum = 0.0;
+            unsigned int nbNonZero = 0;
+
+            for (unsigned int i = start; i < stop; ++i) {
+                sum += mBins[i];
+
+                if (mBins[i] > 0)
+                    ++nbNonZero;
+            }
+
+            for (unsigned int i = start; i < stop; ++i) {
+                q[i] = (mBins[i] > 0 && nbNonZero > 0) ? sum / nbNonZero
+                                                       : 0.0;
+            }
+        }
+
+        double pSum = 0.0;
+        double qSum = 0.0;
+
+        for (unsigned int i = 0; i < threshold; ++i) {
+            pSum += p[i];
+            qSum += q[i];
+        }
+
+        if (pSum == 0.0 || qSum == 0.0)
+            continue;
+
+        double divergence = 0.0;
+
+        for (unsigned int i = 0; i < threshold; ++i) {
+            if (p[i] == 0.0)
+                continue;
+
+            // The clipped outliers may land in an empty bin of q
+            const double pi = p[i] / pSum;
+            const double qi = std::max(q[i] / qSum, 1.0e-12);
+
+            divergence += pi * std::log(pi / qi);
+        }
+
+        if (divergence < bestDivergence) {
+            bestDivergence = divergence;
+            bestThreshold = threshold;
+        }
+    }
+
+    return (bestThreshold + 0.5) * binWidth;
+}
+
+void N2D2::Quantization::Histogram::log(const std::string& fileName) const
+{
+    std::ofstream data(fileName.c_str());
+
+    if (!data.good())
+        throw std::runtime_error("Could not create histogram file: "
+                                 + fileName);
+
+    const double binWidth = mRange / mBins.size();
+
+    for (unsigned int i = 0; i < mBins.size(); ++i)
+        data << (i + 0.5) * binWidth << " " << mBins[i] << "\n";
+}
+
+std::vector<float>
+N2D2::Quantization::weightsScales(const Interface<float>& weights,
+                                  unsigned int nbBits)
+{
+    if (weights.size() == 0)
+        return std::vector<float>();
+
+    const unsigned int nbOutputs = weights[0].dimB();
+    std::vector<float> maxAbs(nbOutputs, 0.0);
+
+    for (unsigned int k = 0; k < weights.size(); ++k) {
+        const Tensor4d<float>& weightsK = weights[k];
+        const unsigned int size = weightsK.size() / nbOutputs;
+
+        for (unsigned int output = 0; output < nbOutputs; ++output) {
+            for (unsigned int i = 0; i < size; ++i) {
+                maxAbs[output] = std::max(maxAbs[output],
+                    std::fabs(weightsK(i + output * size)));
+            }
+        }
+    }
+
+    std::vector<float> scales(nbOutputs);
+
+    for (unsigned int output = 0; output < nbOutputs; ++output) {
+        scales[output] = (maxAbs[output] > 0.0)
+            ? maxAbs[output] / maxValue(nbBits, true) : 1.0;
+    }
+
+    return scales;
+}
+
+void N2D2::Quantization::quantizeWeights(const Tensor4d<float>& weights,
+                                         const std::vector<float>& scales,
+                                         unsigned int nbBits,
+                                         Tensor4d<signed char>& quantized)
+{
+    if (nbBits < 2 || nbBits > 8)
+        throw std::domain_error("quantizeWeights(): the weights are quantized "
+                                "on 2 to 8 bits");
+
+    const int maxVal = maxValue(nbBits, true);
+    const unsigned int size = weights.size() / weights.dimB();
+
+    quantized.resize(
+        weights.dimX(), weights.dimY(), weights.dimZ(), weights.dimB());
+
+    for (unsigned int output = 0; output < weights.dimB(); ++output) {
+        for (unsigned int i = 0; i < size; ++i) {
+            const int value = (int)Utils::round(
+                weights(i + output * size) / scales[output]);
+
+            quantized(i + output * size)
+                = (signed char)Utils::clamp(value, -maxVal, maxVal);
+        }
+    }
+}
+
+void N2D2::Quantization::quantizeSignals(const Tensor4d<float>& signals,
+                                         const Signals& quantization,
+                                         unsigned int nbBits,
+                                         Tensor4d<short>& quantized)
+{
+    const int minVal = minValue(nbBits, quantization.isSigned);
+    const int maxVal = maxValue(nbBits, quantization.isSigned);
+    const float invScale = 1.0 / quantization.scale;
+    const int size = signals.size();
+
+    quantized.resize(
+        signals.dimX(), signals.dimY(), signals.dimZ(), signals.dimB());
+
+#pragma omp parallel for if (size > 1024)
+    for (int index = 0; index < size; ++index) {
+        const int value = (int)Utils::round(signals(index) * invScale);
+        quantized(index) = (short)Utils::clamp(value, minVal, maxVal);
+    }
+}
+
+void N2D2::Quantization::dequantize(const Tensor4d<int>& accumulators,
+                                    const std::vector<int>& bias,
+                                    float inputsScale,
+                                    const std::vector<float>& synapsesScales,
+                                    Tensor4d<float>& outputs)
+{
+    const unsigned int nbOutputs = synapsesScales.size();
+    const unsigned int planeSize = accumulators.size()
+                                   / (accumulators.dimB() * nbOutputs);
+    const int size = accumulators.size();
+
+#pragma omp parallel for if (size > 1024)
+    for (int index = 0; index < size; ++index) {
+        const unsigned int output = (index / planeSize) % nbOutputs;
+        const int value = (bias.empty()) ? accumulators(index)
+                                         : accumulators(index) + bias[output];
+
+        outputs(index) = value * inputsScale * synapsesScales[output];
+    }
+}
+
+void N2D2::Quantization::requantize(Tensor4d<float>& signals,
+                                    const Signals& quantization,
+                                    unsigned int nbBits)
+{
+    const int minVal = minValue(nbBits, quantization.isSigned);
+    const int maxVal = maxValue(nbBits, quantization.isSigned);
+    const float invScale = 1.0 / quantization.scale;
+    const int size = signals.size();
+
+#pragma omp parallel for if (size > 1024)
+    for (int index = 0; index < size; ++index) {
+        const int value = (int)Utils::round(signals(index) * invScale);
+        signals(index) = Utils::clamp(value, minVal, maxVal)
+                         * quantization.scale;
+    }
+}
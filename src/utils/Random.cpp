@@ -24,10 +24,133 @@
 // Create a length 624 array to store the state of the generator
 unsigned int N2D2::Random::_mt[624];
 unsigned int N2D2::Random::_mt_index = 0;
+unsigned int N2D2::Random::_mt_seed = 1;
+N2D2_THREAD_LOCAL N2D2::Random::Philox* N2D2::Random::_stream = NULL;
+
+N2D2::Random::Philox::Philox(unsigned long long seed,
+                             unsigned long long stream,
+                             unsigned long long counter)
+{
+    // ctor
+    Philox::seed(seed, stream, counter);
+}
+
+void N2D2::Random::Philox::seed(unsigned long long seed,
+                                unsigned long long stream,
+                                unsigned long long counter)
+{
+    mKey[0] = (unsigned int)(seed & 0xFFFFFFFF);
+    mKey[1] = (unsigned int)(seed >> 32);
+    mStream[0] = (unsigned int)(stream & 0xFFFFFFFF);
+    mStream[1] = (unsigned int)(stream >> 32);
+    mCounter = counter;
+    mBufferIndex = 4;
+    mAvailableDeviate = false;
+}
+
+double N2D2::Random::Philox::randUniform(double vmin,
+                                         double vmax,
+                                         Endpoints endpoints)
+{
+    if (vmax < vmin)
+        throw std::domain_error(
+            "Random::Philox::randUniform(): vmax must be >= vmin.");
+
+    if (endpoints == ClosedInterval) // [vmin,vmax]
+        return vmin + (double)rand() / MT_RAND_MAX * (vmax - vmin);
+    else if (endpoints == LeftHalfOpenInterval) // ]vmin,vmax] = (vmin,vmax]
+        return vmin + ((double)rand() + 1.0) / (MT_RAND_MAX + 1.0)
+                      * (vmax - vmin);
+    else if (endpoints == RightHalfOpenInterval) // [vmin,vmax[ = [vmin,vmax)
+        return vmin + (double)rand() / (MT_RAND_MAX + 1.0) * (vmax - vmin);
+    else // ]vmin,vmax[ = (vmin,vmax)
+        return vmin + ((double)rand() + 0.5) / (MT_RAND_MAX + 1.0)
+                      * (vmax - vmin);
+}
+
+double N2D2::Random::Philox::randNormal(double mean, double stdDev)
+{
+    if (stdDev < 0.0)
+        throw std::domain_error(
+            "Random::Philox::randNormal(): standard deviation must be >= 0.");
+
+    if (stdDev == 0.0)
+        return mean;
+
+    if (mAvailableDeviate) {
+        mAvailableDeviate = false;
+        return (mean + stdDev * mStoredDeviate);
+    } else {
+        // Box-Muller transform, as Random::randNormal()
+        const double u1 = randUniform(0.0, 1.0, LeftHalfOpenInterval);
+        const double u2 = randUniform(0.0, 1.0, LeftHalfOpenInterval);
+
+        const double r = std::sqrt(-2.0 * std::log(u1));
+        const double theta = 2.0 * M_PI * u2;
+
+        mStoredDeviate = r * std::sin(theta);
+        mAvailableDeviate = true;
+
+        return (mean + stdDev * (r * std::cos(theta)));
+    }
+}
+
+bool N2D2::Random::Philox::randBernoulli(double p)
+{
+    return (randUniform(0.0, 1.0, RightHalfOpenInterval) < p);
+}
+
+void N2D2::Random::Philox::generate(const unsigned int counter[4],
+                                    const unsigned int key[2],
+                                    unsigned int result[4])
+{
+    unsigned int c0 = counter[0];
+    unsigned int c1 = counter[1];
+    unsigned int c2 = counter[2];
+    unsigned int c3 = counter[3];
+    unsigned int k0 = key[0];
+    unsigned int k1 = key[1];
+
+    for (unsigned int round = 0; round < 10; ++round) {
+        if (round > 0) {
+            // Key schedule (Weyl sequence)
+            k0 += 0x9E3779B9;
+            k1 += 0xBB67AE85;
+        }
+
+        const unsigned long long p0 = 0xD2511F53ULL * c0;
+        const unsigned long long p1 = 0xCD9E8D57ULL * c2;
+
+        c0 = (unsigned int)(p1 >> 32) ^ c1 ^ k0;
+        c1 = (unsigned int)p1;
+        c2 = (unsigned int)(p0 >> 32) ^ c3 ^ k1;
+        c3 = (unsigned int)p0;
+    }
+
+    result[0] = c0;
+    result[1] = c1;
+    result[2] = c2;
+    result[3] = c3;
+}
+
+N2D2::Random::ThreadStream::ThreadStream(unsigned long long seed,
+                                         unsigned long long stream)
+    : mPhilox(seed, stream), mPrevious(_stream)
+{
+    // ctor
+    _stream = &mPhilox;
+}
+
+N2D2::Random::ThreadStream::~ThreadStream()
+{
+    // dtor
+    _stream = mPrevious;
+}
 
 // Initialize the generator from a seed
 void N2D2::Random::mtSeed(unsigned int seed)
 {
+    _mt_seed = seed;
     _mt[0] = seed;
     _mt_index = 0; // Reset also the index to always start at the same point
     // when we re-initialize the generator
@@ -37,9 +160,48 @@ void N2D2::Random::mtSeed(unsigned int seed)
                  & 0xFFFFFFFF;
 }
 
+unsigned int N2D2::Random::getSeed()
+{
+    return _mt_seed;
+}
+
+unsigned long long N2D2::Random::streamSeed(unsigned long long seed,
+                                            unsigned long long id,
+                                            unsigned long long iteration)
+{
+    const unsigned int counter[4] = {(unsigned int)(iteration & 0xFFFFFFFF),
+                                     (unsigned int)(iteration >> 32),
+                                     (unsigned int)(id & 0xFFFFFFFF),
+                                     (unsigned int)(id >> 32)};
+    const unsigned int key[2] = {(unsigned int)(seed & 0xFFFFFFFF),
+                                 (unsigned int)(seed >> 32)};
+    unsigned int result[4];
+    Philox::generate(counter, key, result);
+
+    return (result[0] | ((unsigned long long)result[1] << 32));
+}
+
+unsigned long long N2D2::Random::streamId(const std::string& name)
+{
+    unsigned long long hash = 0xCBF29CE484222325ULL;
+
+    for (std::string::const_iterator it = name.begin(), itEnd = name.end();
+         it != itEnd;
+         ++it)
+    {
+        hash ^= (unsigned char)(*it);
+        hash *= 0x100000001B3ULL;
+    }
+
+    return hash;
+}
+
 // Extract a tempered pseudorandom number based on the index-th value,
 unsigned int N2D2::Random::mtRand()
 {
+    if (_stream != NULL)
+        return _stream->rand();
+
     if (_mt_index == 0) {
         // Generate an array of 624 untempered numbers
         for (unsigned int i = 0; i < 624; ++i) {
@@ -75,6 +237,9 @@ double N2D2::Random::randNormal(double mean, double stdDev)
     if (stdDev == 0.0)
         return mean;
 
+    if (_stream != NULL)
+        return _stream->randNormal(mean, stdDev);
+
     if (availableDeviate) {
         availableDeviate = false;
         return (mean + stdDev * storedDeviate);
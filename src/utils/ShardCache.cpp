@@ -0,0 +1,401 @@
+/*
+    (C) Copyright 2016 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include "utils/ShardCache.hpp"
+#include "utils/Utils.hpp"
+
+#include <iomanip>
+#include <sstream>
+
+#ifndef WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+const char* N2D2::ShardCache::IndexFileName = "shards.idx";
+const unsigned int N2D2::ShardCache::HeaderSize;
+
+N2D2::ShardCache::ShardCache(const std::string& path,
+                             unsigned long long shardSize)
+    : mPath(path), mShardSize(shardSize), mWriteShard(0)
+{
+    // ctor
+    Utils::createDirectories(mPath);
+
+    // Shards left by a previous run are complete, they are mapped right away
+    // and new records always go to a new shard
+    while (std::ifstream(shardFileName(mShards.size()).c_str()).good()) {
+        Shard shard;
+        shard.fileName = shardFileName(mShards.size());
+        shard.size = 0;
+        shard.data = NULL;
+
+        mapShard(shard);
+        mShards.push_back(shard);
+    }
+
+    mWriteShard = mShards.size();
+    loadIndex();
+}
+
+bool N2D2::ShardCache::contains(const std::string& key) const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return (mRecords.find(key) != mRecords.end());
+}
+
+bool N2D2::ShardCache::locate(const std::string& key,
+                              unsigned int& shard,
+                              unsigned long long& offset) const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    const std::map<std::string, Record>::const_iterator it
+        = mRecords.find(key);
+
+    if (it == mRecords.end())
+        return false;
+
+    shard = (*it).second.shard;
+    offset = (*it).second.offset;
+    return true;
+}
+
+std::vector<cv::Mat> N2D2::ShardCache::read(const std::string& key) const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    const std::map<std::string, Record>::const_iterator it
+        = mRecords.find(key);
+
+    if (it == mRecords.end())
+        throw std::runtime_error("ShardCache::read(): no record \"" + key
+                                 + "\" in cache " + mPath);
+
+    const Record& record = (*it).second;
+    const Shard& shard = mShards[record.shard];
+
+    if (shard.data != NULL)
+        return parse(shard.data + record.offset, record.size);
+
+    // Shard still being written: the record is copied
+    std::ifstream is(shard.fileName.c_str(), std::ios::binary);
+    std::vector<char> buffer(record.size);
+
+    is.seekg(record.offset);
+    is.read(&buffer[0], record.size);
+
+    if (!is.good())
+        throw std::runtime_error("ShardCache::read(): error reading shard "
+                                 + shard.fileName);
+
+    std::vector<cv::Mat> data = parse(&buffer[0], record.size);
+
+    for (std::vector<cv::Mat>::iterator itMat = data.begin(),
+                                        itMatEnd = data.end();
+         itMat != itMatEnd;
+         ++itMat)
+        (*itMat) = (*itMat).clone();
+
+    return data;
+}
+
+void N2D2::ShardCache::write(const std::string& key,
+                             const std::vector<cv::Mat>& data)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    if (mRecords.find(key) != mRecords.end())
+        return;
+
+    unsigned long long recordSize = HeaderSize;
+
+    for (std::vector<cv::Mat>::const_iterator it = data.begin(),
+                                              itEnd = data.end();
+         it != itEnd;
+         ++it) {
+        recordSize += HeaderSize
+                      + alignedSize((*it).elemSize() * (*it).rows
+                                    * (*it).cols);
+    }
+
+    if (mWriteShard == mShards.size())
+        openWriteShard();
+    else if (mShards[mWriteShard].size > 0
+             && mShards[mWriteShard].size + recordSize > mShardSize) {
+        // The current shard is full: it is now complete and can be mapped
+        mWriteStream.close();
+        mapShard(mShards[mWriteShard]);
+        openWriteShard();
+    }
+
+    const char padding[HeaderSize] = {0};
+    const unsigned int header[HeaderSize / sizeof(unsigned int)]
+        = {(unsigned int)data.size(), 0, 0, 0};
+
+    mWriteStream.write(reinterpret_cast<const char*>(header), HeaderSize);
+
+    for (std::vector<cv::Mat>::const_iterator it = data.begin(),
+                                              itEnd = data.end();
+         it != itEnd;
+         ++it) {
+        const cv::Mat mat = ((*it).isContinuous()) ? (*it) : (*it).clone();
+        const int matHeader[HeaderSize / sizeof(int)]
+            = {mat.rows, mat.cols, mat.type(), 0};
+        const unsigned long long size = mat.elemSize() * mat.rows * mat.cols;
+
+        mWriteStream.write(reinterpret_cast<const char*>(matHeader),
+                           HeaderSize);
+
+        if (size > 0)
+            mWriteStream.write(reinterpret_cast<const char*>(mat.data), size);
+
+        mWriteStream.write(padding, alignedSize(size) - size);
+    }
+
+    mWriteStream.flush();
+
+    if (!mWriteStream.good())
+        throw std::runtime_error("ShardCache::write(): error writing shard "
+                                 + mShards[mWriteShard].fileName);
+
+    Record record;
+    record.shard = mWriteShard;
+    record.offset = mShards[mWriteShard].size;
+    record.size = recordSize;
+
+    mShards[mWriteShard].size += recordSize;
+
+    // The index entry is only written once the record is complete
+    const unsigned int keySize = key.size();
+    mIndexStream.write(reinterpret_cast<const char*>(&keySize),
+                       sizeof(keySize));
+    mIndexStream.write(key.data(), keySize);
+    mIndexStream.write(reinterpret_cast<const char*>(&record.shard),
+                       sizeof(record.shard));
+    mIndexStream.write(reinterpret_cast<const char*>(&record.offset),
+                       sizeof(record.offset));
+    mIndexStream.write(reinterpret_cast<const char*>(&record.size),
+                       sizeof(record.size));
+    mIndexStream.flush();
+
+    if (!mIndexStream.good())
+        throw std::runtime_error("ShardCache::write(): error writing index "
+                                 + mPath + "/" + IndexFileName);
+
+    mRecords.insert(std::make_pair(key, record));
+}
+
+unsigned int N2D2::ShardCache::getNbRecords() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mRecords.size();
+}
+
+unsigned int N2D2::ShardCache::getNbShards() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mShards.size();
+}
+
+N2D2::ShardCache::~ShardCache()
+{
+    mWriteStream.close();
+    mIndexStream.close();
+
+    for (std::vector<Shard>::iterator it = mShards.begin(),
+                                      itEnd = mShards.end();
+         it != itEnd;
+         ++it)
+        unmapShard(*it);
+}
+
+std::string N2D2::ShardCache::shardFileName(unsigned int shard) const
+{
+    std::ostringstream fileName;
+    fileName << mPath << "/shard_" << std::setfill('0') << std::setw(4)
+             << shard << ".bin";
+    return fileName.str();
+}
+
+void N2D2::ShardCache::loadIndex()
+{
+    const std::string indexFile = mPath + "/" + IndexFileName;
+    std::ifstream is(indexFile.c_str(), std::ios::binary);
+    bool valid = true;
+
+    while (is.good()) {
+        unsigned int keySize;
+
+        if (!is.read(reinterpret_cast<char*>(&keySize), sizeof(keySize)))
+            break;
+
+        std::string key(keySize, '\0');
+        Record record;
+
+        is.read(&key[0], keySize);
+        is.read(reinterpret_cast<char*>(&record.shard), sizeof(record.shard));
+        is.read(reinterpret_cast<char*>(&record.offset),
+                sizeof(record.offset));
+        is.read(reinterpret_cast<char*>(&record.size), sizeof(record.size));
+
+        if (!is.good() || record.shard >= mShards.size()
+            || record.offset + record.size > mShards[record.shard].size) {
+            // Interrupted write, the rest of the index is discarded
+            valid = false;
+            break;
+        }
+
+        mRecords.insert(std::make_pair(key, record));
+    }
+
+    is.close();
+
+    if (valid)
+        mIndexStream.open(indexFile.c_str(), std::ios::binary | std::ios::app);
+    else {
+        // Rewrite a clean index
+        mIndexStream.open(indexFile.c_str(),
+                          std::ios::binary | std::ios::trunc);
+
+        for (std::map<std::string, Record>::const_iterator it
+             = mRecords.begin(),
+             itEnd = mRecords.end();
+             it != itEnd;
+             ++it) {
+            const unsigned int keySize = (*it).first.size();
+            mIndexStream.write(reinterpret_cast<const char*>(&keySize),
+                               sizeof(keySize));
+            mIndexStream.write((*it).first.data(), keySize);
+            mIndexStream.write(
+                reinterpret_cast<const char*>(&(*it).second.shard),
+                sizeof((*it).second.shard));
+            mIndexStream.write(
+                reinterpret_cast<const char*>(&(*it).second.offset),
+                sizeof((*it).second.offset));
+            mIndexStream.write(
+                reinterpret_cast<const char*>(&(*it).second.size),
+                sizeof((*it).second.size));
+        }
+
+        mIndexStream.flush();
+    }
+
+    if (!mIndexStream.good())
+        throw std::runtime_error("ShardCache: could not open index file: "
+                                 + indexFile);
+}
+
+void N2D2::ShardCache::mapShard(Shard& shard)
+{
+    std::ifstream is(shard.fileName.c_str(), std::ios::binary);
+    is.seekg(0, std::ios::end);
+    shard.size = is.tellg();
+    is.close();
+
+#ifndef WIN32
+    if (shard.size == 0)
+        return;
+
+    const int fd = open(shard.fileName.c_str(), O_RDONLY);
+
+    if (fd < 0)
+        throw std::runtime_error("ShardCache: could not open shard: "
+                                 + shard.fileName);
+
+    // Private writable mapping: pages modified by the caller are copied and
+    // never written back to the file
+    void* data = mmap(
+        NULL, shard.size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (data == MAP_FAILED)
+        throw std::runtime_error("ShardCache: could not map shard: "
+                                 + shard.fileName);
+
+    shard.data = static_cast<char*>(data);
+#endif
+}
+
+void N2D2::ShardCache::unmapShard(Shard& shard)
+{
+#ifndef WIN32
+    if (shard.data != NULL)
+        munmap(shard.data, shard.size);
+#endif
+
+    shard.data = NULL;
+}
+
+void N2D2::ShardCache::openWriteShard()
+{
+    Shard shard;
+    shard.fileName = shardFileName(mShards.size());
+    shard.size = 0;
+    shard.data = NULL;
+
+    mWriteShard = mShards.size();
+    mShards.push_back(shard);
+    mWriteStream.open(shard.fileName.c_str(),
+                      std::ios::binary | std::ios::trunc);
+
+    if (!mWriteStream.good())
+        throw std::runtime_error("ShardCache: could not create shard: "
+                                 + shard.fileName);
+}
+
+std::vector<cv::Mat> N2D2::ShardCache::parse(char* data,
+                                             unsigned long long size)
+{
+    const unsigned int nbMats = *reinterpret_cast<unsigned int*>(data);
+    unsigned long long pos = HeaderSize;
+    std::vector<cv::Mat> mats;
+
+    for (unsigned int i = 0; i < nbMats; ++i) {
+        if (pos + HeaderSize > size)
+            throw std::runtime_error("ShardCache: corrupted record");
+
+        const int* matHeader = reinterpret_cast<int*>(data + pos);
+        pos += HeaderSize;
+
+        if (matHeader[0] == 0 || matHeader[1] == 0) {
+            mats.push_back(cv::Mat(matHeader[0], matHeader[1], matHeader[2]));
+            continue;
+        }
+
+        // Header only, the data stays in the shard
+        const cv::Mat mat(
+            matHeader[0], matHeader[1], matHeader[2], data + pos);
+        pos += alignedSize(mat.elemSize() * mat.rows * mat.cols);
+
+        if (pos > size)
+            throw std::runtime_error("ShardCache: corrupted record");
+
+        mats.push_back(mat);
+    }
+
+    return mats;
+}
+
+unsigned long long N2D2::ShardCache::alignedSize(unsigned long long size)
+{
+    return ((size + HeaderSize - 1) / HeaderSize) * HeaderSize;
+}
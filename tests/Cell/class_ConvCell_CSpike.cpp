@@ -0,0 +1,283 @@
+/*
+    (C) Copyright 2016 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include "N2D2.hpp"
+
+#include "CEnvironment.hpp"
+#include "Cell/ConvCell_CSpike.hpp"
+#include "Cell/ConvCell_Frame.hpp"
+#include "utils/UnitTest.hpp"
+
+using namespace N2D2;
+
+class ConvCell_CSpike_Test : public ConvCell_CSpike {
+public:
+    ConvCell_CSpike_Test(const std::string& name,
+                         unsigned int kernelWidth,
+                         unsigned int kernelHeight,
+                         unsigned int nbOutputs,
+                         unsigned int subSampleX,
+                         unsigned int subSampleY,
+                         unsigned int strideX,
+                         unsigned int strideY,
+                         unsigned int paddingX,
+                         unsigned int paddingY)
+        : Cell(name, nbOutputs),
+          ConvCell(name,
+                   kernelWidth,
+                   kernelHeight,
+                   nbOutputs,
+                   subSampleX,
+                   subSampleY,
+                   strideX,
+                   strideY,
+                   paddingX,
+                   paddingY),
+          ConvCell_CSpike(name,
+                          kernelWidth,
+                          kernelHeight,
+                          nbOutputs,
+                          subSampleX,
+                          subSampleY,
+                          strideX,
+                          strideY,
+                          paddingX,
+                          paddingY) {};
+
+    friend class UnitTest_ConvCell_CSpike_addInput__env;
+    friend class UnitTest_ConvCell_CSpike_tick;
+    friend class UnitTest_ConvCell_CSpike_tick_frame_check;
+};
+
+TEST_DATASET(ConvCell_CSpike,
+             addInput__env,
+             (unsigned int kernelWidth,
+              unsigned int kernelHeight,
+              unsigned int subSampleX,
+              unsigned int subSampleY,
+              unsigned int strideX,
+              unsigned int strideY,
+              unsigned int paddingX,
+              unsigned int paddingY,
+              unsigned int channelsWidth,
+              unsigned int channelsHeight),
+             std::make_tuple(3U, 3U, 1U, 1U, 1U, 1U, 0U, 0U, 24U, 24U),
+             std::make_tuple(2U, 5U, 1U, 1U, 1U, 1U, 0U, 0U, 24U, 32U),
+             std::make_tuple(3U, 3U, 2U, 2U, 1U, 1U, 0U, 0U, 32U, 24U),
+             std::make_tuple(3U, 3U, 1U, 1U, 2U, 2U, 0U, 0U, 24U, 24U),
+             std::make_tuple(3U, 3U, 1U, 1U, 1U, 1U, 2U, 2U, 24U, 32U))
+{
+    const unsigned int nbOutputs = 10;
+
+    CEnvironment env(EmptyDatabase, channelsWidth, channelsHeight, 1, 2);
+
+    ConvCell_CSpike_Test conv1("conv1",
+                               kernelWidth,
+                               kernelHeight,
+                               nbOutputs,
+                               subSampleX,
+                               subSampleY,
+                               strideX,
+                               strideY,
+                               paddingX,
+                               paddingY);
+    conv1.addInput(env);
+    conv1.initialize();
+
+    const unsigned int outputsWidth
+        = std::ceil(std::floor((channelsWidth + 2 * paddingX - kernelWidth
+                                + strideX) / (double)strideX)
+                    / (double)subSampleX);
+    const unsigned int outputsHeight
+        = std::ceil(std::floor((channelsHeight + 2 * paddingY - kernelHeight
+                                + strideY) / (double)strideY)
+                    / (double)subSampleY);
+
+    ASSERT_EQUALS(conv1.getNbChannels(), 1U);
+    ASSERT_EQUALS(conv1.getChannelsWidth(), channelsWidth);
+    ASSERT_EQUALS(conv1.getChannelsHeight(), channelsHeight);
+    ASSERT_EQUALS(conv1.getNbOutputs(), nbOutputs);
+    ASSERT_EQUALS(conv1.getOutputsWidth(), outputsWidth);
+    ASSERT_EQUALS(conv1.getOutputsHeight(), outputsHeight);
+
+    // Internal state testing
+    ASSERT_EQUALS(conv1.mInputs.dataSize(), channelsWidth * channelsHeight * 2);
+    ASSERT_EQUALS(conv1.mOutputs.size(),
+                  outputsWidth * outputsHeight * nbOutputs * 2);
+    ASSERT_EQUALS(conv1.mOutputsActivity.size(), conv1.mOutputs.size());
+    ASSERT_EQUALS(conv1.mSharedSynapses.dataSize(),
+                  kernelWidth * kernelHeight * nbOutputs);
+}
+
+TEST(ConvCell_CSpike, tick)
+{
+    CEnvironment env(EmptyDatabase, 5, 5);
+
+    ConvCell_CSpike_Test conv1("conv1", 3, 3, 1, 1, 1, 1, 1, 0, 0);
+    conv1.setParameter("NoBias", true);
+    conv1.setParameter("BipolarThreshold", false);
+    conv1.addInput(env);
+    conv1.initialize();
+
+    for (unsigned int sy = 0; sy < 3; ++sy) {
+        for (unsigned int sx = 0; sx < 3; ++sx)
+            conv1.setWeight(0, 0, sx, sy, 0.5);
+    }
+
+    conv1.reset(0);
+
+    // The central input is in the receptive field of every output
+    env.getTickData()(2, 2, 0, 0) = 1;
+
+    ASSERT_EQUALS(conv1.tick(1 * TimeNs), false);
+
+    for (unsigned int index = 0; index < 9; ++index) {
+        ASSERT_EQUALS_DELTA(conv1.mOutputsIntegration(index), 0.5, 1.0e-6);
+        ASSERT_EQUALS((int)conv1.mOutputs(index), 0);
+    }
+
+    conv1.tick(2 * TimeNs);
+
+    for (unsigned int index = 0; index < 9; ++index) {
+        ASSERT_EQUALS_DELTA(conv1.mOutputsIntegration(index), 0.0, 1.0e-6);
+        ASSERT_EQUALS((int)conv1.mOutputs(index), 1);
+        ASSERT_EQUALS(conv1.getOutputsActivity()(index), 1.0);
+    }
+
+    // A corner input is only in the receptive field of one output
+    env.getTickData()(2, 2, 0, 0) = 0;
+    env.getTickData()(0, 0, 0, 0) = -1;
+
+    conv1.tick(3 * TimeNs);
+
+    ASSERT_EQUALS_DELTA(conv1.mOutputsIntegration(0, 0, 0, 0), -0.5, 1.0e-6);
+    ASSERT_EQUALS_DELTA(conv1.mOutputsIntegration(1, 1, 0, 0), 0.0, 1.0e-6);
+
+    for (unsigned int index = 0; index < 9; ++index)
+        ASSERT_EQUALS((int)conv1.mOutputs(index), 0);
+
+    conv1.reset(0);
+
+    for (unsigned int index = 0; index < 9; ++index) {
+        ASSERT_EQUALS(conv1.mOutputsIntegration(index), 0.0);
+        ASSERT_EQUALS(conv1.getOutputsActivity()(index), 0.0);
+    }
+}
+
+TEST_DATASET(ConvCell_CSpike,
+             tick_frame_check,
+             (unsigned int kernelWidth,
+              unsigned int kernelHeight,
+              unsigned int subSampleX,
+              unsigned int subSampleY,
+              unsigned int strideX,
+              unsigned int strideY,
+              unsigned int paddingX,
+              unsigned int paddingY),
+             std::make_tuple(3U, 3U, 1U, 1U, 1U, 1U, 0U, 0U),
+             std::make_tuple(2U, 5U, 1U, 1U, 1U, 1U, 0U, 0U),
+             std::make_tuple(3U, 3U, 2U, 2U, 1U, 1U, 0U, 0U),
+             std::make_tuple(3U, 3U, 1U, 3U, 1U, 1U, 0U, 0U),
+             std::make_tuple(3U, 3U, 1U, 1U, 2U, 2U, 0U, 0U),
+             std::make_tuple(3U, 3U, 1U, 1U, 1U, 3U, 0U, 0U),
+             std::make_tuple(3U, 3U, 1U, 1U, 1U, 1U, 2U, 2U),
+             std::make_tuple(3U, 3U, 1U, 1U, 1U, 1U, 1U, 3U))
+{
+    const unsigned int nbOutputs = 4;
+    const unsigned int nbChannels = 3;
+    const unsigned int batchSize = 2;
+
+    Random::mtSeed(0);
+
+    CEnvironment env(EmptyDatabase, 11, 9, nbChannels, batchSize);
+
+    ConvCell_CSpike_Test conv1("conv1",
+                               kernelWidth,
+                               kernelHeight,
+                               nbOutputs,
+                               subSampleX,
+                               subSampleY,
+                               strideX,
+                               strideY,
+                               paddingX,
+                               paddingY);
+    // Large threshold, so that the integrations can be compared
+    conv1.setParameter("Threshold", 1.0e6);
+    conv1.setParameter("NoBias", false);
+    conv1.addInput(env);
+    conv1.initialize();
+
+    ConvCell_Frame conv2("conv2",
+                         kernelWidth,
+                         kernelHeight,
+                         nbOutputs,
+                         subSampleX,
+                         subSampleY,
+                         strideX,
+                         strideY,
+                         paddingX,
+                         paddingY,
+                         std::shared_ptr<Activation<Float_T> >());
+    conv2.setParameter("NoBias", false);
+    conv2.addInput(env);
+    conv2.initialize();
+
+    for (unsigned int output = 0; output < nbOutputs; ++output) {
+        for (unsigned int channel = 0; channel < nbChannels; ++channel) {
+            for (unsigned int sy = 0; sy < kernelHeight; ++sy) {
+                for (unsigned int sx = 0; sx < kernelWidth; ++sx)
+                    conv1.setWeight(output,
+                                    channel,
+                                    sx,
+                                    sy,
+                                    conv2.getWeight(output, channel, sx, sy));
+            }
+        }
+
+        conv1.setBias(output, conv2.getBias(output));
+    }
+
+    conv1.reset(0);
+
+    // Random spikes, except in the second channel (zero input map)
+    Tensor4d<char>& tickData = env.getTickData();
+
+    for (unsigned int index = 0; index < tickData.size(); ++index) {
+        const unsigned int channel = (index / (11 * 9)) % nbChannels;
+
+        tickData(index) = (channel != 1)
+            ? (char)Random::randUniform(-1, 1) : 0;
+        env.getData()(index) = tickData(index);
+    }
+
+    conv1.tick(1 * TimeNs);
+    conv2.propagate();
+
+    const Tensor4d<Float_T>& outputs = conv2.getOutputs();
+
+    ASSERT_EQUALS(conv1.mOutputsIntegration.size(), outputs.size());
+
+    for (unsigned int index = 0; index < outputs.size(); ++index) {
+        ASSERT_EQUALS_DELTA(
+            conv1.mOutputsIntegration(index), outputs(index), 1.0e-5);
+    }
+}
+
+RUN_TESTS()
@@ -69,6 +69,10 @@ public:
     friend class UnitTest_ConvCell_Frame_propagate_input_check;
     friend class UnitTest_ConvCell_Frame_propagate_2_input_check;
     friend class UnitTest_ConvCell_Frame_setWeight;
+    friend class UnitTest_ConvCell_Frame_propagate_gemm_check;
+    friend class UnitTest_ConvCell_Frame_propagate_winograd_check;
+    friend class UnitTest_ConvCell_Frame_propagate_blocked_check;
+    friend class UnitTest_ConvCell_Frame_propagate_quantized_check;
 };
 
 TEST_DATASET(ConvCell_Frame,
@@ -723,4 +727,516 @@ TEST_DATASET(ConvCell_Frame,
     }
 }
 
+TEST_DATASET(ConvCell_Frame,
+             propagate_gemm_check,
+             (unsigned int kernelWidth,
+              unsigned int kernelHeight,
+              unsigned int subSampleX,
+              unsigned int subSampleY,
+              unsigned int strideX,
+              unsigned int strideY,
+              unsigned int paddingX,
+              unsigned int paddingY,
+              unsigned int channelsWidth,
+              unsigned int channelsHeight,
+              bool partialMaps),
+             std::make_tuple(3U, 3U, 1U, 1U, 1U, 1U, 0U, 0U, 24U, 24U, false),
+             // 1
+             std::make_tuple(2U, 5U, 1U, 1U, 1U, 1U, 0U, 0U, 24U, 24U, false),
+             std::make_tuple(3U, 3U, 2U, 2U, 1U, 1U, 0U, 0U, 24U, 32U, false),
+             std::make_tuple(3U, 3U, 1U, 3U, 1U, 1U, 0U, 0U, 24U, 24U, false),
+             std::make_tuple(3U, 3U, 1U, 1U, 2U, 2U, 0U, 0U, 32U, 24U, false),
+             std::make_tuple(3U, 3U, 1U, 1U, 1U, 3U, 0U, 0U, 24U, 24U, false),
+             std::make_tuple(3U, 3U, 1U, 1U, 1U, 1U, 2U, 2U, 24U, 32U, false),
+             std::make_tuple(3U, 3U, 1U, 1U, 1U, 1U, 1U, 3U, 24U, 24U, false),
+             // 2
+             std::make_tuple(2U, 5U, 2U, 2U, 1U, 1U, 0U, 0U, 24U, 24U, false),
+             std::make_tuple(2U, 5U, 1U, 3U, 1U, 1U, 0U, 0U, 32U, 24U, false),
+             std::make_tuple(2U, 5U, 1U, 1U, 2U, 2U, 0U, 0U, 24U, 24U, false),
+             std::make_tuple(2U, 5U, 1U, 1U, 1U, 3U, 0U, 0U, 24U, 32U, false),
+             std::make_tuple(2U, 5U, 1U, 1U, 1U, 1U, 2U, 2U, 24U, 24U, false),
+             std::make_tuple(2U, 5U, 1U, 1U, 1U, 1U, 1U, 3U, 32U, 24U, false),
+             // 3
+             std::make_tuple(5U, 5U, 2U, 2U, 2U, 2U, 1U, 1U, 24U, 24U, false),
+             std::make_tuple(1U, 1U, 1U, 1U, 1U, 1U, 0U, 0U, 24U, 24U, false),
+             // Partial mapping
+             std::make_tuple(3U, 3U, 1U, 1U, 1U, 1U, 1U, 1U, 24U, 24U, true),
+             std::make_tuple(2U, 5U, 1U, 1U, 2U, 2U, 0U, 1U, 24U, 32U, true))
+{
+    const unsigned int nbOutputs = 7;
+    const unsigned int nbChannels = 5;
+    const unsigned int batchSize = 3;
+
+    ConvCell_Frame_Test conv1("conv1",
+                              kernelWidth,
+                              kernelHeight,
+                              nbOutputs,
+                              subSampleX,
+                              subSampleY,
+                              strideX,
+                              strideY,
+                              paddingX,
+                              paddingY,
+                              std::shared_ptr<Activation<Float_T> >());
+    ConvCell_Frame_Test conv2("conv2",
+                              kernelWidth,
+                              kernelHeight,
+                              nbOutputs,
+                              subSampleX,
+                              subSampleY,
+                              strideX,
+                              strideY,
+                              paddingX,
+                              paddingY,
+                              std::shared_ptr<Activation<Float_T> >());
+    conv1.setParameter("NoBias", false);
+    conv2.setParameter("NoBias", false);
+    conv1.setParameter("Algorithm", ConvCell_Frame::Direct);
+    conv2.setParameter("Algorithm", ConvCell_Frame::GEMM);
+
+    Tensor4d<Float_T> inputs(
+        channelsWidth, channelsHeight, nbChannels, batchSize);
+    Tensor4d<Float_T> diffOutputs1(
+        channelsWidth, channelsHeight, nbChannels, batchSize);
+    Tensor4d<Float_T> diffOutputs2(
+        channelsWidth, channelsHeight, nbChannels, batchSize);
+
+    for (unsigned int index = 0; index < inputs.size(); ++index)
+        inputs(index) = Random::randUniform(-1.0, 1.0);
+
+    conv1.addInput(inputs, diffOutputs1);
+    conv2.addInput(inputs, diffOutputs2);
+
+    if (partialMaps) {
+        for (unsigned int output = 0; output < nbOutputs; ++output) {
+            for (unsigned int channel = 0; channel < nbChannels; ++channel) {
+                conv1.mMaps(output, channel) = ((output + channel) % 3 != 0);
+                conv2.mMaps(output, channel) = conv1.mMaps(output, channel);
+            }
+        }
+    }
+
+    conv1.initialize();
+    conv2.initialize();
+
+    for (unsigned int output = 0; output < nbOutputs; ++output) {
+        for (unsigned int channel = 0; channel < nbChannels; ++channel) {
+            for (unsigned int sx = 0; sx < kernelWidth; ++sx) {
+                for (unsigned int sy = 0; sy < kernelHeight; ++sy)
+                    conv2.setWeight(output,
+                                    channel,
+                                    sx,
+                                    sy,
+                                    conv1.getWeight(output, channel, sx, sy));
+            }
+        }
+
+        conv2.setBias(output, conv1.getBias(output));
+    }
+
+    conv1.propagate();
+    conv2.propagate();
+
+    const Tensor4d<Float_T>& out1 = conv1.getOutputs();
+    const Tensor4d<Float_T>& out2 = conv2.getOutputs();
+
+    ASSERT_EQUALS(out1.size(), out2.size());
+
+    for (unsigned int index = 0; index < out1.size(); ++index) {
+        ASSERT_EQUALS_DELTA(out1(index), out2(index), 1e-4);
+    }
+
+    for (unsigned int index = 0; index < conv1.mDiffInputs.size(); ++index) {
+        conv1.mDiffInputs(index) = Random::randUniform(-1.0, 1.0);
+        conv2.mDiffInputs(index) = conv1.mDiffInputs(index);
+    }
+
+    conv1.backPropagate();
+    conv2.backPropagate();
+
+    for (unsigned int index = 0; index < diffOutputs1.size(); ++index) {
+        ASSERT_EQUALS_DELTA(diffOutputs1(index), diffOutputs2(index), 1e-4);
+    }
+
+    const Tensor4d<Float_T>& diffSynapses1 = conv1.mDiffSharedSynapses[0];
+    const Tensor4d<Float_T>& diffSynapses2 = conv2.mDiffSharedSynapses[0];
+
+    for (unsigned int index = 0; index < diffSynapses1.size(); ++index) {
+        ASSERT_EQUALS_DELTA(diffSynapses1(index), diffSynapses2(index), 1e-3);
+    }
+
+    for (unsigned int output = 0; output < nbOutputs; ++output) {
+        ASSERT_EQUALS_DELTA(
+            conv1.mDiffBias(output), conv2.mDiffBias(output), 1e-3);
+    }
+}
+
+TEST_DATASET(ConvCell_Frame,
+             propagate_winograd_check,
+             (unsigned int paddingX,
+              unsigned int paddingY,
+              unsigned int channelsWidth,
+              unsigned int channelsHeight),
+             std::make_tuple(0U, 0U, 24U, 24U),
+             std::make_tuple(1U, 1U, 24U, 24U),
+             std::make_tuple(2U, 2U, 24U, 24U),
+             std::make_tuple(1U, 0U, 13U, 11U),
+             std::make_tuple(1U, 1U, 5U, 5U),
+             std::make_tuple(0U, 2U, 3U, 4U))
+{
+    const unsigned int nbOutputs = 7;
+    const unsigned int nbChannels = 5;
+    const unsigned int batchSize = 3;
+
+    ConvCell_Frame_Test conv1("conv1",
+                              3,
+                              3,
+                              nbOutputs,
+                              1,
+                              1,
+                              1,
+                              1,
+                              paddingX,
+                              paddingY,
+                              std::shared_ptr<Activation<Float_T> >());
+    ConvCell_Frame_Test conv2("conv2",
+                              3,
+                              3,
+                              nbOutputs,
+                              1,
+                              1,
+                              1,
+                              1,
+                              paddingX,
+                              paddingY,
+                              std::shared_ptr<Activation<Float_T> >());
+    conv1.setParameter("NoBias", false);
+    conv2.setParameter("NoBias", false);
+    conv1.setParameter("Algorithm", ConvCell_Frame::Direct);
+    conv2.setParameter("Algorithm", ConvCell_Frame::Winograd);
+
+    Tensor4d<Float_T> inputs(
+        channelsWidth, channelsHeight, nbChannels, batchSize);
+    Tensor4d<Float_T> diffOutputs1(
+        channelsWidth, channelsHeight, nbChannels, batchSize);
+    Tensor4d<Float_T> diffOutputs2(
+        channelsWidth, channelsHeight, nbChannels, batchSize);
+
+    for (unsigned int index = 0; index < inputs.size(); ++index)
+        inputs(index) = Random::randUniform(-1.0, 1.0);
+
+    conv1.addInput(inputs, diffOutputs1);
+    conv2.addInput(inputs, diffOutputs2);
+    conv1.initialize();
+    conv2.initialize();
+
+    for (unsigned int output = 0; output < nbOutputs; ++output) {
+        for (unsigned int channel = 0; channel < nbChannels; ++channel) {
+            for (unsigned int sx = 0; sx < 3; ++sx) {
+                for (unsigned int sy = 0; sy < 3; ++sy)
+                    conv2.setWeight(output,
+                                    channel,
+                                    sx,
+                                    sy,
+                                    conv1.getWeight(output, channel, sx, sy));
+            }
+        }
+
+        conv2.setBias(output, conv1.getBias(output));
+    }
+
+    // The second pass checks that the cached transformed kernels are
+    // discarded when the weights are updated
+    for (unsigned int pass = 0; pass < 2; ++pass) {
+        conv1.propagate();
+        conv2.propagate();
+
+        const Tensor4d<Float_T>& out1 = conv1.getOutputs();
+        const Tensor4d<Float_T>& out2 = conv2.getOutputs();
+
+        ASSERT_EQUALS(out1.size(), out2.size());
+
+        for (unsigned int index = 0; index < out1.size(); ++index) {
+            ASSERT_EQUALS_DELTA(out1(index), out2(index), 1e-4);
+        }
+
+        for (unsigned int index = 0; index < conv1.mDiffInputs.size();
+             ++index) {
+            conv1.mDiffInputs(index) = Random::randUniform(-1.0, 1.0);
+            conv2.mDiffInputs(index) = conv1.mDiffInputs(index);
+        }
+
+        conv1.backPropagate();
+        conv2.backPropagate();
+
+        for (unsigned int index = 0; index < diffOutputs1.size(); ++index) {
+            ASSERT_EQUALS_DELTA(
+                diffOutputs1(index), diffOutputs2(index), 1e-4);
+        }
+
+        const Tensor4d<Float_T>& diffSynapses1 = conv1.mDiffSharedSynapses[0];
+        const Tensor4d<Float_T>& diffSynapses2 = conv2.mDiffSharedSynapses[0];
+
+        for (unsigned int index = 0; index < diffSynapses1.size(); ++index) {
+            ASSERT_EQUALS_DELTA(
+                diffSynapses1(index), diffSynapses2(index), 1e-3);
+        }
+
+        conv1.update();
+        conv2.update();
+    }
+}
+
+TEST_DATASET(ConvCell_Frame,
+             propagate_blocked_check,
+             (unsigned int channelBlock,
+              unsigned int nbChannels,
+              unsigned int nbOutputs,
+              unsigned int strideX,
+              unsigned int strideY,
+              unsigned int paddingX,
+              unsigned int paddingY),
+             std::make_tuple(8U, 5U, 10U, 1U, 1U, 1U, 1U),
+             std::make_tuple(8U, 8U, 8U, 1U, 1U, 0U, 0U),
+             std::make_tuple(8U, 3U, 12U, 2U, 2U, 1U, 1U),
+             std::make_tuple(16U, 5U, 17U, 1U, 1U, 2U, 2U),
+             std::make_tuple(16U, 20U, 7U, 1U, 2U, 0U, 1U))
+{
+    const unsigned int batchSize = 3;
+    const unsigned int channelsWidth = 13;
+    const unsigned int channelsHeight = 11;
+
+    ConvCell_Frame_Test conv1("conv1",
+                              3,
+                              3,
+                              nbOutputs,
+                              1,
+                              1,
+                              strideX,
+                              strideY,
+                              paddingX,
+                              paddingY,
+                              std::shared_ptr<Activation<Float_T> >());
+    ConvCell_Frame_Test conv2("conv2",
+                              3,
+                              3,
+                              nbOutputs,
+                              1,
+                              1,
+                              strideX,
+                              strideY,
+                              paddingX,
+                              paddingY,
+                              std::shared_ptr<Activation<Float_T> >());
+    conv1.setParameter("NoBias", false);
+    conv2.setParameter("NoBias", false);
+    conv1.setParameter("Algorithm", ConvCell_Frame::Direct);
+
+    Tensor4d<Float_T> inputs1(
+        channelsWidth, channelsHeight, nbChannels, batchSize);
+    Tensor4d<Float_T> inputs2(
+        channelsWidth, channelsHeight, nbChannels, batchSize);
+    Tensor4d<Float_T> diffOutputs1(
+        channelsWidth, channelsHeight, nbChannels, batchSize);
+    Tensor4d<Float_T> diffOutputs2(
+        channelsWidth, channelsHeight, nbChannels, batchSize);
+
+    for (unsigned int index = 0; index < inputs1.size(); ++index) {
+        inputs1(index) = Random::randUniform(-1.0, 1.0);
+        inputs2(index) = inputs1(index);
+    }
+
+    // conv2 receives its inputs from, and back-propagates to, a blocked cell
+    inputs2.setChannelBlock(channelBlock);
+    diffOutputs2.setChannelBlock(channelBlock);
+
+    ASSERT_EQUALS(inputs2.channelBlock(), channelBlock);
+    ASSERT_EQUALS(inputs2.dimZ(), nbChannels);
+
+    conv1.addInput(inputs1, diffOutputs1);
+    conv2.addInput(inputs2, diffOutputs2);
+    conv1.initialize();
+    conv2.initialize();
+    conv2.setChannelBlock(channelBlock);
+
+    ASSERT_EQUALS(conv2.getOutputs().channelBlock(), channelBlock);
+
+    for (unsigned int output = 0; output < nbOutputs; ++output) {
+        for (unsigned int channel = 0; channel < nbChannels; ++channel) {
+            for (unsigned int sx = 0; sx < 3; ++sx) {
+                for (unsigned int sy = 0; sy < 3; ++sy)
+                    conv2.setWeight(output,
+                                    channel,
+                                    sx,
+                                    sy,
+                                    conv1.getWeight(output, channel, sx, sy));
+            }
+        }
+
+        conv2.setBias(output, conv1.getBias(output));
+    }
+
+    conv1.propagate();
+    conv2.propagate();
+
+    const Tensor4d<Float_T>& out1 = conv1.getOutputs();
+    const Tensor4d<Float_T>& out2 = conv2.getOutputs();
+
+    for (unsigned int batchPos = 0; batchPos < batchSize; ++batchPos) {
+        for (unsigned int output = 0; output < nbOutputs; ++output) {
+            for (unsigned int oy = 0; oy < out1.dimY(); ++oy) {
+                for (unsigned int ox = 0; ox < out1.dimX(); ++ox) {
+                    ASSERT_EQUALS_DELTA(out1(ox, oy, output, batchPos),
+                                        out2(ox, oy, output, batchPos),
+                                        1e-4);
+
+                    conv1.mDiffInputs(ox, oy, output, batchPos)
+                        = Random::randUniform(-1.0, 1.0);
+                    conv2.mDiffInputs(ox, oy, output, batchPos)
+                        = conv1.mDiffInputs(ox, oy, output, batchPos);
+                }
+            }
+        }
+    }
+
+    conv1.backPropagate();
+    conv2.backPropagate();
+
+    for (unsigned int batchPos = 0; batchPos < batchSize; ++batchPos) {
+        for (unsigned int channel = 0; channel < nbChannels; ++channel) {
+            for (unsigned int iy = 0; iy < channelsHeight; ++iy) {
+                for (unsigned int ix = 0; ix < channelsWidth; ++ix) {
+                    ASSERT_EQUALS_DELTA(
+                        diffOutputs1(ix, iy, channel, batchPos),
+                        diffOutputs2(ix, iy, channel, batchPos),
+                        1e-4);
+                }
+            }
+        }
+    }
+
+    const Tensor4d<Float_T>& diffSynapses1 = conv1.mDiffSharedSynapses[0];
+    const Tensor4d<Float_T>& diffSynapses2 = conv2.mDiffSharedSynapses[0];
+
+    for (unsigned int index = 0; index < diffSynapses1.size(); ++index) {
+        ASSERT_EQUALS_DELTA(diffSynapses1(index), diffSynapses2(index), 1e-3);
+    }
+
+    for (unsigned int output = 0; output < nbOutputs; ++output) {
+        ASSERT_EQUALS_DELTA(
+            conv1.mDiffBias(output), conv2.mDiffBias(output), 1e-3);
+    }
+}
+
+TEST_DATASET(ConvCell_Frame,
+             propagate_quantized_check,
+             (unsigned int nbChannels,
+              unsigned int nbOutputs,
+              unsigned int strideX,
+              unsigned int strideY,
+              unsigned int paddingX,
+              unsigned int paddingY),
+             std::make_tuple(5U, 10U, 1U, 1U, 1U, 1U),
+             std::make_tuple(8U, 8U, 1U, 1U, 0U, 0U),
+             std::make_tuple(3U, 12U, 2U, 2U, 1U, 1U),
+             std::make_tuple(20U, 7U, 1U, 2U, 2U, 0U))
+{
+    const unsigned int batchSize = 3;
+    const unsigned int channelsWidth = 13;
+    const unsigned int channelsHeight = 11;
+    const unsigned int nbBits = 8;
+
+    ConvCell_Frame_Test conv1("conv1",
+                              3,
+                              3,
+                              nbOutputs,
+                              1,
+                              1,
+                              strideX,
+                              strideY,
+                              paddingX,
+                              paddingY,
+                              std::make_shared
+                              <RectifierActivation_Frame<Float_T> >());
+    ConvCell_Frame_Test conv2("conv2",
+                              3,
+                              3,
+                              nbOutputs,
+                              1,
+                              1,
+                              strideX,
+                              strideY,
+                              paddingX,
+                              paddingY,
+                              std::make_shared
+                              <RectifierActivation_Frame<Float_T> >());
+    conv1.setParameter("NoBias", false);
+    conv2.setParameter("NoBias", false);
+
+    Tensor4d<Float_T> inputs(
+        channelsWidth, channelsHeight, nbChannels, batchSize);
+    Tensor4d<Float_T> diffOutputs1(
+        channelsWidth, channelsHeight, nbChannels, batchSize);
+    Tensor4d<Float_T> diffOutputs2(
+        channelsWidth, channelsHeight, nbChannels, batchSize);
+
+    // Unsigned inputs, already on the quantization grid
+    const Quantization::Signals quantInputs(1.0 / 255.0, false);
+
+    for (unsigned int index = 0; index < inputs.size(); ++index)
+        inputs(index) = Utils::round(Random::randUniform(0.0, 255.0))
+                        * quantInputs.scale;
+
+    conv1.addInput(inputs, diffOutputs1);
+    conv2.addInput(inputs, diffOutputs2);
+    conv1.initialize();
+    conv2.initialize();
+
+    for (unsigned int output = 0; output < nbOutputs; ++output) {
+        for (unsigned int channel = 0; channel < nbChannels; ++channel) {
+            for (unsigned int sx = 0; sx < 3; ++sx) {
+                for (unsigned int sy = 0; sy < 3; ++sy)
+                    conv2.setWeight(output,
+                                    channel,
+                                    sx,
+                                    sy,
+                                    conv1.getWeight(output, channel, sx, sy));
+            }
+        }
+
+        conv2.setBias(output, conv1.getBias(output));
+    }
+
+    conv1.propagate();
+
+    const Tensor4d<Float_T>& out1 = conv1.getOutputs();
+    const double maxOutput = *std::max_element(out1.begin(), out1.end());
+    const Quantization::Signals quantOutputs(maxOutput / 255.0, false);
+
+    conv2.setQuantization(nbBits, quantInputs, quantOutputs);
+    conv2.propagate();
+
+    ASSERT_EQUALS(conv2.getQuantization(), nbBits);
+
+    const Tensor4d<Float_T>& out2 = conv2.getOutputs();
+
+    for (unsigned int index = 0; index < out1.size(); ++index) {
+        // The outputs are on the quantization grid, within the weights
+        // rounding error of the floating point result
+        ASSERT_EQUALS_DELTA(out2(index) / quantOutputs.scale,
+                            Utils::round(out2(index) / quantOutputs.scale),
+                            1.0e-3);
+        ASSERT_EQUALS_DELTA(out1(index), out2(index), 0.02 * maxOutput);
+    }
+
+    // Back to floating point
+    conv2.setQuantization(0);
+    conv2.propagate();
+
+    ASSERT_EQUALS(conv2.getQuantization(), 0U);
+
+    for (unsigned int index = 0; index < out1.size(); ++index)
+        ASSERT_EQUALS_DELTA(out1(index), out2(index), 1e-5);
+}
+
 RUN_TESTS()
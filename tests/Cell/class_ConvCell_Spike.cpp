@@ -0,0 +1,202 @@
+/*
+    (C) Copyright 2016 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include "N2D2.hpp"
+
+#include "Cell/ConvCell_Spike.hpp"
+#include "Environment.hpp"
+#include "Network.hpp"
+#include "utils/UnitTest.hpp"
+
+using namespace N2D2;
+
+class ConvCell_Spike_Test : public ConvCell_Spike {
+public:
+    ConvCell_Spike_Test(Network& net,
+                        const std::string& name,
+                        unsigned int kernelWidth,
+                        unsigned int kernelHeight,
+                        unsigned int nbOutputs,
+                        unsigned int strideX,
+                        unsigned int strideY,
+                        int paddingX,
+                        int paddingY)
+        : Cell(name, nbOutputs),
+          ConvCell(name,
+                   kernelWidth,
+                   kernelHeight,
+                   nbOutputs,
+                   1,
+                   1,
+                   strideX,
+                   strideY,
+                   paddingX,
+                   paddingY),
+          ConvCell_Spike(net,
+                         name,
+                         kernelWidth,
+                         kernelHeight,
+                         nbOutputs,
+                         1,
+                         1,
+                         strideX,
+                         strideY,
+                         paddingX,
+                         paddingY) {};
+
+    friend class UnitTest_ConvCell_Spike_propagateSpike_reference;
+};
+
+/**
+ * Output spike trains of a small ConvCell_Spike for random input spikes.
+ * The reference values were recorded with the previous implementation, which
+ * walked through the kernel positions for each incoming spike instead of
+ * using precomputed fan-out tables.
+*/
+TEST_DATASET(ConvCell_Spike,
+             propagateSpike_reference,
+             (unsigned int kernelWidth,
+              unsigned int kernelHeight,
+              unsigned int strideX,
+              unsigned int strideY,
+              int paddingX,
+              int paddingY,
+              bool sparseMaps,
+              unsigned int nbSpikesRef,
+              Time_T sumTimestampsRef,
+              unsigned long long sumRanksRef),
+             std::make_tuple(3U, 3U, 1U, 1U, 0, 0, false,
+                             213U, 2053840214123ULL, 37605ULL),
+             std::make_tuple(3U, 3U, 1U, 1U, 1, 1, false,
+                             252U, 2516016254532ULL, 66906ULL),
+             std::make_tuple(3U, 3U, 2U, 2U, 0, 0, false,
+                             52U, 485360052027ULL, 2325ULL),
+             std::make_tuple(4U, 3U, 2U, 3U, 2, 1, false,
+                             71U, 778514070645ULL, 4053ULL),
+             std::make_tuple(3U, 3U, 1U, 1U, 1, 1, true,
+                             134U, 1360662134671ULL, 35803ULL),
+             std::make_tuple(5U, 2U, 3U, 1U, 1, 0, true,
+                             43U, 402646042863ULL, 2698ULL))
+{
+    const unsigned int channelsWidth = 12;
+    const unsigned int channelsHeight = 10;
+    const unsigned int nbChannels = 3;
+    const unsigned int nbOutputs = 4;
+
+    Network net(1);
+    Environment env(net, EmptyDatabase, channelsWidth, channelsHeight,
+                    nbChannels);
+
+    ConvCell_Spike_Test conv1(net,
+                              "conv1",
+                              kernelWidth,
+                              kernelHeight,
+                              nbOutputs,
+                              strideX,
+                              strideY,
+                              paddingX,
+                              paddingY);
+    conv1.setParameter("Threshold", 1.0);
+    conv1.setParameter("Leak", 50 * TimeNs);
+    conv1.setParameter("Refractory", 5 * TimeNs);
+
+    Matrix<bool> mapping(nbChannels, nbOutputs, true);
+
+    if (sparseMaps) {
+        for (unsigned int channel = 0; channel < nbChannels; ++channel) {
+            for (unsigned int output = 0; output < nbOutputs; ++output)
+                mapping(channel, output) = ((output + channel) % 3 != 0);
+        }
+    }
+
+    conv1.addInput(env, 0, 0, channelsWidth, channelsHeight, mapping);
+    conv1.initialize();
+
+    for (unsigned int output = 0; output < nbOutputs; ++output) {
+        for (unsigned int channel = 0; channel < nbChannels; ++channel) {
+            for (unsigned int sy = 0; sy < kernelHeight; ++sy) {
+                for (unsigned int sx = 0; sx < kernelWidth; ++sx) {
+                    conv1.setWeight(output, channel, sx, sy,
+                        ((7 * output + 3 * channel + sx + 5 * sy) % 11 - 4.0)
+                        / 10.0);
+                }
+            }
+        }
+    }
+
+    for (unsigned int output = 0; output < nbOutputs; ++output) {
+        for (unsigned int oy = 0; oy < conv1.getOutputsHeight(); ++oy) {
+            for (unsigned int ox = 0; ox < conv1.getOutputsWidth(); ++ox)
+                conv1.getOutput(output, ox, oy)->setActivityRecording(true);
+        }
+    }
+
+    Random::mtSeed(0);
+
+    for (unsigned int s = 0; s < 2000; ++s) {
+        env.getNode(Random::randUniform(0, nbChannels - 1),
+                    Random::randUniform(0, channelsWidth - 1),
+                    Random::randUniform(0, channelsHeight - 1))
+            ->incomingSpike(NULL,
+                            (Time_T)Random::randUniform(0, 20000) * TimeNs);
+    }
+
+    net.run();
+
+    const std::unordered_map<NodeId_T, NodeEvents_T>& spikeRecording
+        = net.getSpikeRecording();
+    unsigned int nbSpikes = 0;
+    Time_T sumTimestamps = 0;
+    unsigned long long sumRanks = 0;
+    unsigned int rank = 0;
+
+    for (unsigned int output = 0; output < nbOutputs; ++output) {
+        for (unsigned int oy = 0; oy < conv1.getOutputsHeight(); ++oy) {
+            for (unsigned int ox = 0; ox < conv1.getOutputsWidth(); ++ox) {
+                const std::unordered_map<NodeId_T, NodeEvents_T>
+                    ::const_iterator itRecord = spikeRecording.find(
+                        conv1.getOutput(output, ox, oy)->getId());
+
+                ++rank;
+
+                if (itRecord == spikeRecording.end())
+                    continue;
+
+                for (NodeEvents_T::const_iterator itEvent
+                     = (*itRecord).second.begin(),
+                     itEventEnd = (*itRecord).second.end();
+                     itEvent != itEventEnd;
+                     ++itEvent)
+                {
+                    ++nbSpikes;
+                    sumTimestamps += (*itEvent).first;
+                    sumRanks += rank * (1 + (*itEvent).second);
+                }
+            }
+        }
+    }
+
+    ASSERT_TRUE(nbSpikes > 0);
+    ASSERT_EQUALS(nbSpikes, nbSpikesRef);
+    ASSERT_EQUALS(sumTimestamps, sumTimestampsRef);
+    ASSERT_EQUALS(sumRanks, sumRanksRef);
+}
+
+RUN_TESTS()
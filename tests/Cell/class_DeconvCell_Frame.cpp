@@ -0,0 +1,189 @@
+/*
+    (C) Copyright 2016 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include "N2D2.hpp"
+
+#include "Cell/DeconvCell_Frame.hpp"
+#include "utils/UnitTest.hpp"
+
+using namespace N2D2;
+
+class DeconvCell_Frame_Test : public DeconvCell_Frame {
+public:
+    DeconvCell_Frame_Test(const std::string& name,
+                          unsigned int kernelWidth,
+                          unsigned int kernelHeight,
+                          unsigned int nbOutputs,
+                          unsigned int strideX,
+                          unsigned int strideY,
+                          int paddingX,
+                          int paddingY,
+                          const std::shared_ptr<Activation<Float_T> >&
+                          activation)
+        : Cell(name, nbOutputs),
+          DeconvCell(name,
+                     kernelWidth,
+                     kernelHeight,
+                     nbOutputs,
+                     strideX,
+                     strideY,
+                     paddingX,
+                     paddingY),
+          DeconvCell_Frame(name,
+                           kernelWidth,
+                           kernelHeight,
+                           nbOutputs,
+                           strideX,
+                           strideY,
+                           paddingX,
+                           paddingY,
+                           activation) {};
+
+    friend class UnitTest_DeconvCell_Frame_propagate_gemm_check;
+};
+
+TEST_DATASET(DeconvCell_Frame,
+             propagate_gemm_check,
+             (unsigned int kernelWidth,
+              unsigned int kernelHeight,
+              unsigned int strideX,
+              unsigned int strideY,
+              int paddingX,
+              int paddingY,
+              unsigned int channelsWidth,
+              unsigned int channelsHeight,
+              bool partialMaps),
+             std::make_tuple(3U, 3U, 1U, 1U, 0, 0, 12U, 12U, false),
+             std::make_tuple(2U, 5U, 1U, 1U, 0, 0, 12U, 8U, false),
+             std::make_tuple(3U, 3U, 2U, 2U, 0, 0, 12U, 12U, false),
+             std::make_tuple(4U, 4U, 2U, 2U, 1, 1, 8U, 12U, false),
+             std::make_tuple(3U, 3U, 1U, 3U, 0, 0, 12U, 12U, false),
+             std::make_tuple(3U, 3U, 1U, 1U, 1, 2, 12U, 12U, false),
+             std::make_tuple(5U, 5U, 3U, 3U, 2, 2, 7U, 9U, false),
+             std::make_tuple(1U, 1U, 1U, 1U, 0, 0, 12U, 12U, false),
+             std::make_tuple(3U, 3U, 2U, 2U, 1, 1, 12U, 8U, true))
+{
+    const unsigned int nbOutputs = 6;
+    const unsigned int nbChannels = 4;
+    const unsigned int batchSize = 3;
+
+    DeconvCell_Frame_Test deconv1("deconv1",
+                                  kernelWidth,
+                                  kernelHeight,
+                                  nbOutputs,
+                                  strideX,
+                                  strideY,
+                                  paddingX,
+                                  paddingY,
+                                  std::shared_ptr<Activation<Float_T> >());
+    DeconvCell_Frame_Test deconv2("deconv2",
+                                  kernelWidth,
+                                  kernelHeight,
+                                  nbOutputs,
+                                  strideX,
+                                  strideY,
+                                  paddingX,
+                                  paddingY,
+                                  std::shared_ptr<Activation<Float_T> >());
+    deconv1.setParameter("NoBias", false);
+    deconv2.setParameter("NoBias", false);
+    deconv1.setParameter("Algorithm", DeconvCell_Frame::Direct);
+    deconv2.setParameter("Algorithm", DeconvCell_Frame::GEMM);
+
+    Tensor4d<Float_T> inputs(
+        channelsWidth, channelsHeight, nbChannels, batchSize);
+    Tensor4d<Float_T> diffOutputs1(
+        channelsWidth, channelsHeight, nbChannels, batchSize);
+    Tensor4d<Float_T> diffOutputs2(
+        channelsWidth, channelsHeight, nbChannels, batchSize);
+
+    for (unsigned int index = 0; index < inputs.size(); ++index)
+        inputs(index) = Random::randUniform(-1.0, 1.0);
+
+    deconv1.addInput(inputs, diffOutputs1);
+    deconv2.addInput(inputs, diffOutputs2);
+
+    if (partialMaps) {
+        for (unsigned int output = 0; output < nbOutputs; ++output) {
+            for (unsigned int channel = 0; channel < nbChannels; ++channel) {
+                deconv1.mMaps(output, channel) = ((output + channel) % 3 != 0);
+                deconv2.mMaps(output, channel) = deconv1.mMaps(output, channel);
+            }
+        }
+    }
+
+    deconv1.initialize();
+    deconv2.initialize();
+
+    for (unsigned int output = 0; output < nbOutputs; ++output) {
+        for (unsigned int channel = 0; channel < nbChannels; ++channel) {
+            for (unsigned int sx = 0; sx < kernelWidth; ++sx) {
+                for (unsigned int sy = 0; sy < kernelHeight; ++sy)
+                    deconv2.setWeight(
+                        output,
+                        channel,
+                        sx,
+                        sy,
+                        deconv1.getWeight(output, channel, sx, sy));
+            }
+        }
+
+        deconv2.setBias(output, deconv1.getBias(output));
+    }
+
+    deconv1.propagate();
+    deconv2.propagate();
+
+    const Tensor4d<Float_T>& out1 = deconv1.getOutputs();
+    const Tensor4d<Float_T>& out2 = deconv2.getOutputs();
+
+    ASSERT_EQUALS(out1.size(), out2.size());
+
+    for (unsigned int index = 0; index < out1.size(); ++index) {
+        ASSERT_EQUALS_DELTA(out1(index), out2(index), 1e-4);
+    }
+
+    for (unsigned int index = 0; index < deconv1.mDiffInputs.size();
+         ++index) {
+        deconv1.mDiffInputs(index) = Random::randUniform(-1.0, 1.0);
+        deconv2.mDiffInputs(index) = deconv1.mDiffInputs(index);
+    }
+
+    deconv1.backPropagate();
+    deconv2.backPropagate();
+
+    for (unsigned int index = 0; index < diffOutputs1.size(); ++index) {
+        ASSERT_EQUALS_DELTA(diffOutputs1(index), diffOutputs2(index), 1e-4);
+    }
+
+    const Tensor4d<Float_T>& diffSynapses1 = deconv1.mDiffSharedSynapses[0];
+    const Tensor4d<Float_T>& diffSynapses2 = deconv2.mDiffSharedSynapses[0];
+
+    for (unsigned int index = 0; index < diffSynapses1.size(); ++index) {
+        ASSERT_EQUALS_DELTA(diffSynapses1(index), diffSynapses2(index), 1e-3);
+    }
+
+    for (unsigned int output = 0; output < nbOutputs; ++output) {
+        ASSERT_EQUALS_DELTA(
+            deconv1.mDiffBias(output), deconv2.mDiffBias(output), 1e-3);
+    }
+}
+
+RUN_TESTS()
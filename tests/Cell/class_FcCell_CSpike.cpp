@@ -0,0 +1,178 @@
+/*
+    (C) Copyright 2016 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include "N2D2.hpp"
+
+#include "CEnvironment.hpp"
+#include "Cell/FcCell_CSpike.hpp"
+#include "Cell/FcCell_Frame.hpp"
+#include "utils/UnitTest.hpp"
+
+using namespace N2D2;
+
+class FcCell_CSpike_Test : public FcCell_CSpike {
+public:
+    FcCell_CSpike_Test(const std::string& name, unsigned int nbOutputs)
+        : Cell(name, nbOutputs),
+          FcCell(name, nbOutputs),
+          FcCell_CSpike(name, nbOutputs) {};
+
+    friend class UnitTest_FcCell_CSpike_addInput__env;
+    friend class UnitTest_FcCell_CSpike_tick;
+    friend class UnitTest_FcCell_CSpike_tick_frame_check;
+};
+
+TEST_DATASET(FcCell_CSpike,
+             addInput__env,
+             (unsigned int nbOutputs,
+              unsigned int channelsWidth,
+              unsigned int channelsHeight),
+             std::make_tuple(1U, 24U, 24U),
+             std::make_tuple(10U, 24U, 32U),
+             std::make_tuple(16U, 32U, 24U))
+{
+    CEnvironment env(EmptyDatabase, channelsWidth, channelsHeight, 1, 2);
+
+    FcCell_CSpike_Test fc1("fc1", nbOutputs);
+    fc1.addInput(env);
+    fc1.initialize();
+
+    ASSERT_EQUALS(fc1.getNbChannels(), 1U);
+    ASSERT_EQUALS(fc1.getChannelsWidth(), channelsWidth);
+    ASSERT_EQUALS(fc1.getChannelsHeight(), channelsHeight);
+    ASSERT_EQUALS(fc1.getNbOutputs(), nbOutputs);
+    ASSERT_EQUALS(fc1.getOutputsWidth(), 1U);
+    ASSERT_EQUALS(fc1.getOutputsHeight(), 1U);
+
+    // Internal state testing
+    ASSERT_EQUALS(fc1.mInputs.dataSize(), channelsWidth * channelsHeight * 2);
+    ASSERT_EQUALS(fc1.mOutputs.size(), nbOutputs * 2);
+    ASSERT_EQUALS(fc1.mSynapses.dataSize(),
+                  channelsWidth * channelsHeight * nbOutputs);
+}
+
+TEST(FcCell_CSpike, tick)
+{
+    CEnvironment env(EmptyDatabase, 4, 4);
+
+    FcCell_CSpike_Test fc1("fc1", 2);
+    fc1.setParameter("NoBias", true);
+    fc1.addInput(env);
+    fc1.initialize();
+
+    for (unsigned int channel = 0; channel < 16; ++channel) {
+        fc1.setWeight(0, channel, 0.25);
+        fc1.setWeight(1, channel, -0.25);
+    }
+
+    fc1.reset(0);
+
+    env.getTickData()(1, 1, 0, 0) = 1;
+    env.getTickData()(2, 3, 0, 0) = 1;
+
+    fc1.tick(1 * TimeNs);
+
+    ASSERT_EQUALS_DELTA(fc1.mOutputsIntegration(0), 0.5, 1.0e-6);
+    ASSERT_EQUALS_DELTA(fc1.mOutputsIntegration(1), -0.5, 1.0e-6);
+    ASSERT_EQUALS((int)fc1.mOutputs(0), 0);
+    ASSERT_EQUALS((int)fc1.mOutputs(1), 0);
+
+    fc1.tick(2 * TimeNs);
+
+    // Bipolar threshold: both outputs fire, with opposite signs
+    ASSERT_EQUALS_DELTA(fc1.mOutputsIntegration(0), 0.0, 1.0e-6);
+    ASSERT_EQUALS_DELTA(fc1.mOutputsIntegration(1), 0.0, 1.0e-6);
+    ASSERT_EQUALS((int)fc1.mOutputs(0), 1);
+    ASSERT_EQUALS((int)fc1.mOutputs(1), -1);
+    ASSERT_EQUALS(fc1.getOutputsActivity()(0), 1.0);
+    ASSERT_EQUALS(fc1.getOutputsActivity()(1), -1.0);
+
+    // No input spike: the integrations are unchanged
+    env.getTickData().fill(0);
+
+    fc1.tick(3 * TimeNs);
+
+    ASSERT_EQUALS((int)fc1.mOutputs(0), 0);
+    ASSERT_EQUALS((int)fc1.mOutputs(1), 0);
+    ASSERT_EQUALS(fc1.getOutputsActivity()(0), 1.0);
+    ASSERT_EQUALS(fc1.getOutputsActivity()(1), -1.0);
+}
+
+TEST_DATASET(FcCell_CSpike,
+             tick_frame_check,
+             (unsigned int nbOutputs, double density),
+             std::make_tuple(1U, 1.0),
+             std::make_tuple(5U, 0.5),
+             std::make_tuple(12U, 0.1),
+             std::make_tuple(7U, 0.0))
+{
+    const unsigned int nbChannels = 3;
+    const unsigned int batchSize = 2;
+
+    Random::mtSeed(0);
+
+    CEnvironment env(EmptyDatabase, 8, 6, nbChannels, batchSize);
+
+    FcCell_CSpike_Test fc1("fc1", nbOutputs);
+    // Large threshold, so that the integrations can be compared
+    fc1.setParameter("Threshold", 1.0e6);
+    fc1.setParameter("NoBias", false);
+    fc1.addInput(env);
+    fc1.initialize();
+
+    FcCell_Frame fc2("fc2", nbOutputs, std::shared_ptr<Activation<Float_T> >());
+    fc2.setParameter("NoBias", false);
+    fc2.addInput(env);
+    fc2.initialize();
+
+    for (unsigned int output = 0; output < nbOutputs; ++output) {
+        for (unsigned int channel = 0; channel < 8 * 6 * nbChannels;
+             ++channel)
+        {
+            fc1.setWeight(output, channel, fc2.getWeight(output, channel));
+        }
+
+        fc1.setBias(output, fc2.getBias(output));
+    }
+
+    fc1.reset(0);
+
+    Tensor4d<char>& tickData = env.getTickData();
+
+    for (unsigned int index = 0; index < tickData.size(); ++index) {
+        tickData(index) = (Random::randUniform() < density)
+            ? ((Random::randUniform() < 0.5) ? -1 : 1) : 0;
+        env.getData()(index) = tickData(index);
+    }
+
+    fc1.tick(1 * TimeNs);
+    fc2.propagate();
+
+    const Tensor4d<Float_T>& outputs = fc2.getOutputs();
+
+    ASSERT_EQUALS(fc1.mOutputsIntegration.size(), outputs.size());
+
+    for (unsigned int index = 0; index < outputs.size(); ++index) {
+        ASSERT_EQUALS_DELTA(
+            fc1.mOutputsIntegration(index), outputs(index), 1.0e-5);
+    }
+}
+
+RUN_TESTS()
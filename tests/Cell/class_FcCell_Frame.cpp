@@ -43,6 +43,8 @@ public:
     friend class UnitTest_FcCell_Frame_propagate_input_check;
     friend class UnitTest_FcCell_Frame_propagate_2_input_check;
     friend class UnitTest_FcCell_Frame_propagate_weight_check;
+    friend class UnitTest_FcCell_Frame_propagate_gemm_check;
+    friend class UnitTest_FcCell_Frame_propagate_quantized_check;
 };
 
 TEST_DATASET(FcCell_Frame,
@@ -439,8 +441,9 @@ TEST_DATASET(FcCell_Frame,
                           in.begin() + inputSize,
                           0.0f); // Warning: 0.0 leads to wrong results!
 
+    // The matrix product accumulates by blocks, not in the sequential order
     for (unsigned int output = 0; output < out.dimZ(); ++output) {
-        ASSERT_EQUALS_DELTA(out(output, 0), sum, 1e-12);
+        ASSERT_EQUALS_DELTA(out(output, 0), sum, 1e-6 * inputSize);
     }
 }
 
@@ -570,8 +573,195 @@ TEST_DATASET(FcCell_Frame,
         for (unsigned int channel = 0; channel < inputSize; ++channel)
             sum += fc1.getWeight(output, channel);
 
-        ASSERT_EQUALS_DELTA(out(output, 0), sum, 1e-12);
+        ASSERT_EQUALS_DELTA(out(output, 0), sum, 1e-6 * inputSize);
     }
 }
 
+TEST_DATASET(FcCell_Frame,
+             propagate_gemm_check,
+             (unsigned int nbOutputs,
+              unsigned int nbChannels,
+              unsigned int batchSize,
+              double dropConnect),
+             std::make_tuple(1U, 1U, 1U, 1.0),
+             std::make_tuple(3U, 7U, 2U, 1.0),
+             std::make_tuple(10U, 300U, 5U, 1.0),
+             std::make_tuple(17U, 1000U, 33U, 1.0),
+             std::make_tuple(3U, 7U, 2U, 0.5),
+             std::make_tuple(10U, 300U, 5U, 0.5),
+             std::make_tuple(17U, 1000U, 33U, 0.5))
+{
+    FcCell_Frame_Test fc1(
+        "fc1", nbOutputs, std::shared_ptr<Activation<Float_T> >());
+    fc1.setParameter("NoBias", false);
+    fc1.setParameter("DropConnect", dropConnect);
+
+    Tensor4d<Float_T> inputs(1, 1, nbChannels, batchSize);
+    Tensor4d<Float_T> diffOutputs(1, 1, nbChannels, batchSize);
+
+    for (unsigned int index = 0; index < inputs.size(); ++index)
+        inputs(index) = Random::randUniform(-1.0, 1.0);
+
+    fc1.addInput(inputs, diffOutputs);
+    fc1.initialize();
+
+    for (unsigned int output = 0; output < nbOutputs; ++output)
+        fc1.setBias(output, Random::randUniform(-1.0, 1.0));
+
+    fc1.propagate();
+
+    const Tensor4d<Float_T>& out = fc1.getOutputs();
+
+    for (unsigned int batchPos = 0; batchPos < batchSize; ++batchPos) {
+        for (unsigned int output = 0; output < nbOutputs; ++output) {
+            double sum = fc1.getBias(output);
+
+            for (unsigned int channel = 0; channel < nbChannels; ++channel) {
+                if (fc1.mDropConnectMask[0](channel, output))
+                    sum += fc1.getWeight(output, channel)
+                           * inputs(channel, batchPos);
+            }
+
+            ASSERT_EQUALS_DELTA(out(output, batchPos), sum, 1e-4);
+        }
+    }
+
+    for (unsigned int index = 0; index < fc1.mDiffInputs.size(); ++index)
+        fc1.mDiffInputs(index) = Random::randUniform(-1.0, 1.0);
+
+    fc1.backPropagate();
+
+    for (unsigned int batchPos = 0; batchPos < batchSize; ++batchPos) {
+        for (unsigned int channel = 0; channel < nbChannels; ++channel) {
+            double sum = 0.0;
+
+            for (unsigned int output = 0; output < nbOutputs; ++output) {
+                if (fc1.mDropConnectMask[0](channel, output))
+                    sum += fc1.getWeight(output, channel)
+                           * fc1.mDiffInputs(output, batchPos);
+            }
+
+            ASSERT_EQUALS_DELTA(diffOutputs(channel, batchPos), sum, 1e-4);
+        }
+    }
+
+    for (unsigned int output = 0; output < nbOutputs; ++output) {
+        double biasSum = 0.0;
+
+        for (unsigned int channel = 0; channel < nbChannels; ++channel) {
+            double sum = 0.0;
+
+            if (fc1.mDropConnectMask[0](channel, output)) {
+                for (unsigned int batchPos = 0; batchPos < batchSize;
+                     ++batchPos)
+                    sum += inputs(channel, batchPos)
+                           * fc1.mDiffInputs(output, batchPos);
+            }
+
+            ASSERT_EQUALS_DELTA(
+                fc1.mDiffSynapses[0](channel, output), sum, 1e-4);
+        }
+
+        for (unsigned int batchPos = 0; batchPos < batchSize; ++batchPos)
+            biasSum += fc1.mDiffInputs(output, batchPos);
+
+        ASSERT_EQUALS_DELTA(fc1.mDiffBias(output), biasSum, 1e-4);
+    }
+}
+
+TEST_DATASET(FcCell_Frame,
+             propagate_quantized_check,
+             (unsigned int nbOutputs,
+              unsigned int nbChannels1,
+              unsigned int nbChannels2,
+              bool signedInputs),
+             std::make_tuple(1U, 1U, 1U, false),
+             std::make_tuple(10U, 30U, 7U, false),
+             std::make_tuple(17U, 500U, 100U, false),
+             std::make_tuple(10U, 30U, 7U, true),
+             std::make_tuple(17U, 500U, 100U, true))
+{
+    const unsigned int batchSize = 3;
+    const unsigned int nbBits = 8;
+
+    FcCell_Frame_Test fc1("fc1",
+                          nbOutputs,
+                          std::make_shared
+                          <RectifierActivation_Frame<Float_T> >());
+    FcCell_Frame_Test fc2("fc2",
+                          nbOutputs,
+                          std::make_shared
+                          <RectifierActivation_Frame<Float_T> >());
+    fc1.setParameter("NoBias", false);
+    fc2.setParameter("NoBias", false);
+
+    Tensor4d<Float_T> inputs1(1, 1, nbChannels1, batchSize);
+    Tensor4d<Float_T> inputs2(1, 1, nbChannels2, batchSize);
+    Tensor4d<Float_T> diffOutputs1(1, 1, nbChannels1, batchSize);
+    Tensor4d<Float_T> diffOutputs2(1, 1, nbChannels2, batchSize);
+
+    // Inputs already on the quantization grid
+    const int maxInput = Quantization::maxValue(nbBits, signedInputs);
+    const Quantization::Signals quantInputs(1.0 / maxInput, signedInputs);
+
+    for (unsigned int index = 0; index < inputs1.size(); ++index)
+        inputs1(index) = Utils::round(Random::randUniform(
+            Quantization::minValue(nbBits, signedInputs), maxInput))
+                         * quantInputs.scale;
+
+    for (unsigned int index = 0; index < inputs2.size(); ++index)
+        inputs2(index) = Utils::round(Random::randUniform(
+            Quantization::minValue(nbBits, signedInputs), maxInput))
+                         * quantInputs.scale;
+
+    fc1.addInput(inputs1, diffOutputs1);
+    fc1.addInput(inputs2, diffOutputs2);
+    fc2.addInput(inputs1, diffOutputs1);
+    fc2.addInput(inputs2, diffOutputs2);
+    fc1.initialize();
+    fc2.initialize();
+
+    for (unsigned int output = 0; output < nbOutputs; ++output) {
+        for (unsigned int channel = 0; channel < nbChannels1 + nbChannels2;
+             ++channel)
+            fc2.setWeight(output, channel, fc1.getWeight(output, channel));
+
+        fc1.setBias(output, Random::randUniform(-0.5, 0.5));
+        fc2.setBias(output, fc1.getBias(output));
+    }
+
+    fc1.propagate();
+
+    const Tensor4d<Float_T>& out1 = fc1.getOutputs();
+    const double maxOutput = *std::max_element(out1.begin(), out1.end());
+    const Quantization::Signals quantOutputs(
+        (maxOutput > 0.0) ? maxOutput / 255.0 : 1.0 / 255.0, false);
+
+    fc2.setQuantization(nbBits, quantInputs, quantOutputs);
+    fc2.propagate();
+
+    ASSERT_EQUALS(fc2.getQuantization(), nbBits);
+
+    const Tensor4d<Float_T>& out2 = fc2.getOutputs();
+
+    for (unsigned int index = 0; index < out1.size(); ++index) {
+        // The outputs are on the quantization grid, within the weights
+        // rounding error of the floating point result
+        ASSERT_EQUALS_DELTA(out2(index) / quantOutputs.scale,
+                            Utils::round(out2(index) / quantOutputs.scale),
+                            1.0e-3);
+        ASSERT_EQUALS_DELTA(out1(index), out2(index),
+                            0.02 * 255.0 * quantOutputs.scale);
+    }
+
+    // Back to floating point
+    fc2.setQuantization(0);
+    fc2.propagate();
+
+    ASSERT_EQUALS(fc2.getQuantization(), 0U);
+
+    for (unsigned int index = 0; index < out1.size(); ++index)
+        ASSERT_EQUALS_DELTA(out1(index), out2(index), 1e-5);
+}
+
 RUN_TESTS()
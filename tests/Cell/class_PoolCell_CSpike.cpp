@@ -0,0 +1,198 @@
+/*
+    (C) Copyright 2016 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include "N2D2.hpp"
+
+#include "CEnvironment.hpp"
+#include "Cell/PoolCell_CSpike.hpp"
+#include "Cell/PoolCell_Frame.hpp"
+#include "utils/UnitTest.hpp"
+
+using namespace N2D2;
+
+class PoolCell_CSpike_Test : public PoolCell_CSpike {
+public:
+    PoolCell_CSpike_Test(const std::string& name,
+                         unsigned int poolWidth,
+                         unsigned int poolHeight,
+                         unsigned int nbOutputs,
+                         unsigned int strideX,
+                         unsigned int strideY,
+                         unsigned int paddingX,
+                         unsigned int paddingY,
+                         Pooling pooling)
+        : Cell(name, nbOutputs),
+          PoolCell(name,
+                   poolWidth,
+                   poolHeight,
+                   nbOutputs,
+                   strideX,
+                   strideY,
+                   paddingX,
+                   paddingY,
+                   pooling),
+          PoolCell_CSpike(name,
+                          poolWidth,
+                          poolHeight,
+                          nbOutputs,
+                          strideX,
+                          strideY,
+                          paddingX,
+                          paddingY,
+                          pooling) {};
+
+    friend class UnitTest_PoolCell_CSpike_tick_max;
+    friend class UnitTest_PoolCell_CSpike_tick_average_frame_check;
+};
+
+TEST(PoolCell_CSpike, tick_max)
+{
+    CEnvironment env(EmptyDatabase, 4, 4);
+
+    PoolCell_CSpike_Test pool1(
+        "pool1", 2, 2, 1, 2, 2, 0, 0, PoolCell::Max);
+    pool1.addInput(env);
+    pool1.initialize();
+    pool1.reset(0);
+
+    ASSERT_EQUALS(pool1.getOutputsWidth(), 2U);
+    ASSERT_EQUALS(pool1.getOutputsHeight(), 2U);
+
+    Tensor4d<char>& tickData = env.getTickData();
+
+    // Same activity: the first input of the pooling area is selected
+    tickData(0, 0, 0, 0) = 1;
+    tickData(1, 1, 0, 0) = 1;
+    pool1.tick(1 * TimeNs);
+
+    ASSERT_EQUALS((int)pool1.mOutputs(0, 0, 0, 0), 1);
+    ASSERT_EQUALS((int)pool1.mOutputs(1, 0, 0, 0), 0);
+    ASSERT_EQUALS((int)pool1.mOutputs(0, 1, 0, 0), 0);
+    ASSERT_EQUALS((int)pool1.mOutputs(1, 1, 0, 0), 0);
+
+    // (1, 1) becomes the most active input
+    tickData.fill(0);
+    tickData(1, 1, 0, 0) = 1;
+    pool1.tick(2 * TimeNs);
+
+    ASSERT_EQUALS((int)pool1.mOutputs(0, 0, 0, 0), 1);
+
+    // A spike from a less active input is not forwarded
+    tickData.fill(0);
+    tickData(0, 1, 0, 0) = 1;
+    pool1.tick(3 * TimeNs);
+
+    ASSERT_EQUALS((int)pool1.mOutputs(0, 0, 0, 0), 0);
+
+    // Negative spikes decrease the activity
+    tickData.fill(0);
+    tickData(1, 1, 0, 0) = -1;
+    tickData(3, 3, 0, 0) = -1;
+    pool1.tick(4 * TimeNs);
+
+    ASSERT_EQUALS((int)pool1.mOutputs(0, 0, 0, 0), 0);
+    ASSERT_EQUALS((int)pool1.mOutputs(1, 1, 0, 0), 0);
+    ASSERT_EQUALS(pool1.getOutputsActivity()(0, 0, 0, 0), 2.0);
+    ASSERT_EQUALS(pool1.getOutputsActivity()(1, 1, 0, 0), 0.0);
+
+    pool1.reset(0);
+
+    ASSERT_EQUALS(pool1.getOutputsActivity()(0, 0, 0, 0), 0.0);
+    ASSERT_EQUALS(pool1.mInputsActivity[0](1, 1, 0, 0), 0);
+}
+
+TEST_DATASET(PoolCell_CSpike,
+             tick_average_frame_check,
+             (unsigned int poolWidth,
+              unsigned int poolHeight,
+              unsigned int strideX,
+              unsigned int strideY,
+              unsigned int paddingX,
+              unsigned int paddingY),
+             std::make_tuple(2U, 2U, 2U, 2U, 0U, 0U),
+             std::make_tuple(3U, 3U, 1U, 1U, 0U, 0U),
+             std::make_tuple(3U, 2U, 2U, 1U, 0U, 0U),
+             std::make_tuple(3U, 3U, 2U, 2U, 1U, 1U),
+             std::make_tuple(2U, 3U, 1U, 2U, 1U, 2U))
+{
+    const unsigned int nbOutputs = 3;
+    const unsigned int batchSize = 2;
+
+    Random::mtSeed(0);
+
+    CEnvironment env(EmptyDatabase, 9, 7, nbOutputs, batchSize);
+
+    Matrix<bool> mapping(nbOutputs, nbOutputs);
+    mapping << "1 0 0 "
+               "0 1 1 "
+               "0 0 1";
+
+    PoolCell_CSpike_Test pool1("pool1",
+                               poolWidth,
+                               poolHeight,
+                               nbOutputs,
+                               strideX,
+                               strideY,
+                               paddingX,
+                               paddingY,
+                               PoolCell::Average);
+    // Large threshold, so that the integrations can be compared
+    pool1.setParameter("Threshold", 1.0e6);
+    pool1.addInput(env, 0, 0, 0, 0, mapping);
+    pool1.initialize();
+    pool1.reset(0);
+
+    PoolCell_Frame pool2("pool2",
+                         poolWidth,
+                         poolHeight,
+                         nbOutputs,
+                         strideX,
+                         strideY,
+                         paddingX,
+                         paddingY,
+                         PoolCell::Average);
+    pool2.addInput(env, 0, 0, 0, 0, mapping);
+    pool2.initialize();
+
+    // Random spikes, except in the first channel (zero input map)
+    Tensor4d<char>& tickData = env.getTickData();
+
+    for (unsigned int index = 0; index < tickData.size(); ++index) {
+        const unsigned int channel = (index / (9 * 7)) % nbOutputs;
+
+        tickData(index) = (channel != 0)
+            ? (char)Random::randUniform(-1, 1) : 0;
+        env.getData()(index) = tickData(index);
+    }
+
+    pool1.tick(1 * TimeNs);
+    pool2.propagate();
+
+    const Tensor4d<Float_T>& outputs = pool2.getOutputs();
+
+    ASSERT_EQUALS(pool1.mOutputsIntegration.size(), outputs.size());
+
+    for (unsigned int index = 0; index < outputs.size(); ++index) {
+        ASSERT_EQUALS_DELTA(
+            pool1.mOutputsIntegration(index), outputs(index), 1.0e-5);
+    }
+}
+
+RUN_TESTS()
@@ -69,4 +69,59 @@ TEST_DATASET(CIFAR100_Database,
     ASSERT_EQUALS(db.getNbLabels(), 100U);
 }
 
+TEST(CIFAR10_Database, loadCIFAR_memoryMapped)
+{
+    const unsigned int nbImages = 2;
+    const unsigned int imageSize = 32 * 32;
+
+    {
+        std::ofstream labels("CIFAR10_Database_loadCIFAR_memoryMapped.txt");
+        labels << "cat\ndog\n";
+
+        std::ofstream images("CIFAR10_Database_loadCIFAR_memoryMapped.bin",
+                             std::fstream::binary);
+
+        for (unsigned int i = 0; i < nbImages; ++i) {
+            std::vector<unsigned char> record(1 + 3 * imageSize);
+            record[0] = (unsigned char)(1 - i);
+
+            // Red, green and blue planes
+            for (unsigned int c = 0; c < 3; ++c) {
+                for (unsigned int p = 0; p < imageSize; ++p)
+                    record[1 + c * imageSize + p] = (unsigned char)(p + c + i);
+            }
+
+            images.write(reinterpret_cast<const char*>(&record[0]),
+                         record.size());
+        }
+    }
+
+    CIFAR10_Database db;
+    db.setParameter("MemoryMapped", true);
+    db.loadCIFAR("CIFAR10_Database_loadCIFAR_memoryMapped.bin",
+                 "CIFAR10_Database_loadCIFAR_memoryMapped.txt");
+
+    ASSERT_EQUALS(db.getNbStimuli(), nbImages);
+
+    for (unsigned int i = 0; i < nbImages; ++i) {
+        ASSERT_EQUALS(db.getLabelName(db.getStimulusLabel(i)),
+                      (i == 0) ? "dog" : "cat");
+
+        const cv::Mat data = db.getStimulusData(i);
+
+        ASSERT_EQUALS(data.type(), CV_8UC3);
+        ASSERT_EQUALS(data.rows, 32);
+        ASSERT_EQUALS(data.cols, 32);
+
+        for (unsigned int p = 0; p < imageSize; ++p) {
+            const cv::Vec3b pixel = data.at<cv::Vec3b>(p / 32, p % 32);
+
+            // Vec3b color order: blue, green, red
+            ASSERT_EQUALS(pixel[2], (unsigned char)(p + i));
+            ASSERT_EQUALS(pixel[1], (unsigned char)(p + 1 + i));
+            ASSERT_EQUALS(pixel[0], (unsigned char)(p + 2 + i));
+        }
+    }
+}
+
 RUN_TESTS()
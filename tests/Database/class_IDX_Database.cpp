@@ -0,0 +1,125 @@
+/*
+    (C) Copyright 2016 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include "N2D2.hpp"
+
+#include "Database/IDX_Database.hpp"
+#include "utils/UnitTest.hpp"
+
+using namespace N2D2;
+
+void writeIDX(const std::string& fileName,
+              const std::vector<unsigned int>& dims,
+              const std::vector<unsigned char>& data)
+{
+    std::ofstream file(fileName.c_str(), std::fstream::binary);
+    const unsigned char magicNumber[4] = {0, 0, IDX_Database::Unsigned,
+                                          (unsigned char)dims.size()};
+    file.write(reinterpret_cast<const char*>(magicNumber), 4);
+
+    for (std::vector<unsigned int>::const_iterator it = dims.begin(),
+                                                   itEnd = dims.end();
+         it != itEnd;
+         ++it) {
+        // Big endian
+        for (int shift = 24; shift >= 0; shift -= 8) {
+            const unsigned char byte = ((*it) >> shift) & 0xFF;
+            file.write(reinterpret_cast<const char*>(&byte), 1);
+        }
+    }
+
+    file.write(reinterpret_cast<const char*>(&data[0]), data.size());
+}
+
+TEST(IDX_Database, load_memoryMapped)
+{
+    const unsigned int nbImages = 3;
+    const unsigned int nbRows = 4;
+    const unsigned int nbColumns = 5;
+
+    std::vector<unsigned char> images(nbImages * nbRows * nbColumns);
+    std::vector<unsigned char> labels(nbImages);
+
+    for (unsigned int i = 0; i < images.size(); ++i)
+        images[i] = (unsigned char)i;
+
+    for (unsigned int i = 0; i < nbImages; ++i)
+        labels[i] = (unsigned char)(2 - i);
+
+    std::vector<unsigned int> dims;
+    dims.push_back(nbImages);
+    dims.push_back(nbRows);
+    dims.push_back(nbColumns);
+    writeIDX("IDX_Database_load_memoryMapped-images", dims, images);
+    writeIDX("IDX_Database_load_memoryMapped-labels",
+             std::vector<unsigned int>(1, nbImages),
+             labels);
+
+    IDX_Database db;
+    db.setParameter("MemoryMapped", true);
+    db.load("IDX_Database_load_memoryMapped-images",
+            "IDX_Database_load_memoryMapped-labels");
+
+    ASSERT_EQUALS(db.getNbStimuli(), nbImages);
+    ASSERT_EQUALS(db.getNbLabels(), nbImages);
+
+    for (unsigned int i = 0; i < nbImages; ++i) {
+        // No image file is extracted
+        ASSERT_TRUE(!std::ifstream(db.getStimulusName(i).c_str()).good());
+        ASSERT_EQUALS(db.getLabelName(db.getStimulusLabel(i)),
+                      Utils::TtoString(2 - i));
+
+        const cv::Mat data = db.getStimulusData(i);
+
+        ASSERT_EQUALS(data.type(), CV_8UC1);
+        ASSERT_EQUALS(data.rows, (int)nbRows);
+        ASSERT_EQUALS(data.cols, (int)nbColumns);
+
+        for (unsigned int y = 0; y < nbRows; ++y) {
+            for (unsigned int x = 0; x < nbColumns; ++x) {
+                ASSERT_EQUALS(data.at<unsigned char>(y, x),
+                              images[x + nbColumns * (y + nbRows * i)]);
+            }
+        }
+    }
+}
+
+TEST(IDX_Database, load_memoryMapped_truncated)
+{
+    std::vector<unsigned int> dims;
+    dims.push_back(2);
+    dims.push_back(4);
+    dims.push_back(4);
+    writeIDX("IDX_Database_load_memoryMapped_truncated-images",
+             dims,
+             std::vector<unsigned char>(4 * 4, 0));
+    writeIDX("IDX_Database_load_memoryMapped_truncated-labels",
+             std::vector<unsigned int>(1, 2),
+             std::vector<unsigned char>(2, 0));
+
+    IDX_Database db;
+    db.setParameter("MemoryMapped", true);
+
+    ASSERT_THROW(db.load("IDX_Database_load_memoryMapped_truncated-images",
+                         "IDX_Database_load_memoryMapped_truncated-labels"),
+                 std::runtime_error);
+}
+
+RUN_TESTS()
@@ -0,0 +1,316 @@
+/*
+    (C) Copyright 2014 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include <cstdlib>
+
+#include "N2D2.hpp"
+#include "Transformation/RescaleTransformation.hpp"
+#include "Transformation/NormalizeTransformation.hpp"
+#include "Transformation/ChannelExtractionTransformation.hpp"
+#include "Target/Target.hpp"
+#include "Generator/DeepNetGenerator.hpp"
+#include "Export/DeepNetExport.hpp"
+#include "Cell/ConvCell_Frame.hpp"
+#include "Cell/FcCell_Frame.hpp"
+#include "Cell/PoolCell_Frame.hpp"
+#include "Environment.hpp"
+#include "Export/CPP/CPP_DeepNetExport.hpp"
+#include "Network.hpp"
+#include "utils/UnitTest.hpp"
+#include "utils/Utils.hpp"
+
+using namespace N2D2;
+
+/**
+ * Read a floating point stimulus generated by StimuliProviderExport: PGM
+ * header, data in CHW order and one target per output.
+*/
+void readStimulus(const std::string& fileName,
+                  std::vector<float>& data,
+                  int& target)
+{
+    std::ifstream stimulus(fileName.c_str(), std::fstream::binary);
+
+    if (!stimulus.good())
+        throw std::runtime_error("Could not open file: " + fileName);
+
+    std::string format;
+    int width;
+    int height;
+    int maxValue;
+
+    if (!(stimulus >> format) || format != "P5" || !(stimulus >> width)
+        || !(stimulus >> height) || !(stimulus >> maxValue))
+        throw std::runtime_error("Error reading PGM image file: " + fileName);
+
+    stimulus.get();
+
+    data.resize(width * height);
+    stimulus.read(reinterpret_cast<char*>(&data[0]),
+                  data.size() * sizeof(data[0]));
+    stimulus.read(reinterpret_cast<char*>(&target), sizeof(target));
+
+    if (!stimulus.good())
+        throw std::runtime_error("Error while reading data file: " + fileName);
+}
+
+/**
+ * Write the 8 bits version of a floating point stimulus, as
+ * StimuliProviderExport does for a signed 8 bits export.
+*/
+void writeStimulus_int8(const std::string& fileName,
+                        unsigned int width,
+                        unsigned int height,
+                        const std::vector<float>& data,
+                        int target)
+{
+    std::ofstream stimulus(fileName.c_str(), std::fstream::binary);
+
+    if (!stimulus.good())
+        throw std::runtime_error("Could not create file: " + fileName);
+
+    stimulus << "P5\n" << width << " " << height << "\n255\n";
+
+    for (std::vector<float>::const_iterator it = data.begin(),
+                                            itEnd = data.end();
+         it != itEnd;
+         ++it) {
+        const int8_t value = (int8_t)(127.0 * (*it));
+        stimulus.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    stimulus.write(reinterpret_cast<const char*>(&target), sizeof(target));
+
+    if (!stimulus.good())
+        throw std::runtime_error("Error writing file: " + fileName);
+}
+
+double readSuccessRate(const std::string& fileName)
+{
+    std::ifstream successFile(fileName.c_str());
+
+    if (!successFile.good())
+        throw std::runtime_error("Could not open success file: " + fileName);
+
+    double successRate;
+
+    if (!(successFile >> successRate))
+        throw std::runtime_error("Could not read success file: " + fileName);
+
+    return successRate;
+}
+
+TEST(CPP_Export, generate)
+{
+    const std::string data = "DefaultModel=Frame\n"
+                             "\n"
+                             "[env]\n"
+                             "SizeX=48\n"
+                             "SizeY=48\n"
+                             "BatchSize=1\n"
+                             "\n"
+                             "[env.Transformation-1]\n"
+                             "Type=ChannelExtractionTransformation\n"
+                             "CSChannel=Gray\n"
+                             "\n"
+                             "[env.Transformation-2]\n"
+                             "Type=RescaleTransformation\n"
+                             "Width=48\n"
+                             "Height=48\n"
+                             "[env.Transformation-3]\n"
+                             "Type=NormalizeTransformation\n"
+                             "\n"
+                             "[conv1_3x3]\n"
+                             "Input=env\n"
+                             "Type=Conv\n"
+                             "KernelWidth=3\n"
+                             "KernelHeight=3\n"
+                             "NbChannels=2\n"
+                             "Stride=1\n"
+                             "ConfigSection=common.config\n"
+                             "\n"
+                             "[pool1_3x3]\n"
+                             "Input=conv1_3x3\n"
+                             "Type=Pool\n"
+                             "PoolWidth=3\n"
+                             "PoolHeight=3\n"
+                             "NbChannels=2\n"
+                             "Stride=3\n"
+                             "Pooling=Max\n"
+                             "Mapping.Size=1\n"
+                             "\n"
+                             "[conv1_5x5]\n"
+                             "Input=env\n"
+                             "Type=Conv\n"
+                             "KernelWidth=5\n"
+                             "KernelHeight=5\n"
+                             "NbChannels=2\n"
+                             "Stride=1\n"
+                             "Padding=1\n"
+                             "ConfigSection=common.config\n"
+                             "\n"
+                             "[pool1_5x5]\n"
+                             "Input=conv1_5x5\n"
+                             "Type=Pool\n"
+                             "PoolWidth=3\n"
+                             "PoolHeight=3\n"
+                             "NbChannels=2\n"
+                             "Stride=3\n"
+                             "Pooling=Max\n"
+                             "Mapping.Size=1\n"
+                             "\n"
+                             "[fc1]\n"
+                             "Input=pool1_3x3,pool1_5x5\n"
+                             "Type=Fc\n"
+                             "NbOutputs=60\n"
+                             "ConfigSection=common.config\n"
+                             "\n"
+                             "[fc2]\n"
+                             "Input=fc1\n"
+                             "Type=Fc\n"
+                             "NbOutputs=4\n"
+                             "ConfigSection=common.config\n"
+                             "\n"
+                             "[fc2.Target]\n"
+                             "TargetValue=1.0\n"
+                             "DefaultValue=-1.0\n"
+                             "\n"
+                             "[common.config]\n"
+                             "NoBias=0\n"
+                             "WeightsSolver.LearningRate=0.01\n"
+                             "Solvers.LearningRatePolicy=StepDecay\n"
+                             "Solvers.LearningRateStepSize=20000\n"
+                             "Solvers.LearningRateDecay=0.996\n"
+                             "Solvers.Clamping=1\n";
+
+    UnitTest::FileWriteContent("net_test_CPP.ini", data);
+
+    Network net;
+    std::shared_ptr<DeepNet> deepNet
+        = DeepNetGenerator::generate(net, "net_test_CPP.ini");
+
+    deepNet->initialize();
+    deepNet->importNetworkFreeParameters("tests_data/weights_test");
+
+    // Reference: DeepNet::test() on the exported stimuli
+    StimuliProvider& sp = *deepNet->getStimuliProvider();
+    const std::shared_ptr<Target> target = deepNet->getTarget();
+
+    std::string cmd = "rm -rf export_CPP_float32 export_CPP_int8";
+    ASSERT_EQUALS(system(cmd.c_str()), 0);
+
+    Utils::createDirectories("export_CPP_int8/stimuli");
+
+    double success = 0.0;
+    unsigned int total = 0;
+
+    for (unsigned int i = 0; ; ++i) {
+        std::ostringstream stimulusName;
+        stimulusName << "env" << std::setfill('0') << std::setw(4) << i
+                     << ".pgm";
+
+        const std::string fileName = "tests_data/stimuli_32f/"
+                                     + stimulusName.str();
+
+        if (!UnitTest::FileExists(fileName))
+            break;
+
+        std::vector<float> stimulusData;
+        int stimulusTarget;
+        readStimulus(fileName, stimulusData, stimulusTarget);
+
+        ASSERT_EQUALS(stimulusData.size(), sp.getData().size());
+
+        for (unsigned int index = 0; index < stimulusData.size(); ++index)
+            sp.getData()(index) = stimulusData[index];
+
+        sp.getLabelsData()(0) = stimulusTarget;
+
+        deepNet->test(Database::Test);
+
+        if (stimulusTarget < 0)
+            success += 1.0;
+        else if (target->getEstimatedLabels()(0) == stimulusTarget)
+            success += 1.0;
+
+        ++total;
+
+        writeStimulus_int8("export_CPP_int8/stimuli/" + stimulusName.str(),
+                           sp.getSizeX(),
+                           sp.getSizeY(),
+                           stimulusData,
+                           stimulusTarget);
+    }
+
+    ASSERT_TRUE(total > 0);
+
+    const double successRate = 100.0 * success / total;
+
+    // Floating point export: same results as DeepNet::test(), with and
+    // without the explicit SIMD kernels
+    DeepNetExport::mEnvDataUnsigned = false;
+    CellExport::mPrecision = static_cast<CellExport::Precision>(-32);
+
+    DeepNetExport::generate(*deepNet, "export_CPP_float32", "CPP");
+
+    cmd = "mkdir export_CPP_float32/stimuli";
+    ASSERT_EQUALS(system(cmd.c_str()), 0);
+
+    cmd = "cp -r tests_data/stimuli_32f/* export_CPP_float32/stimuli/";
+    ASSERT_EQUALS(system(cmd.c_str()), 0);
+
+    cmd = "cd export_CPP_float32/ && make OUTPUTFILE=1 NRET=1 NOSIMD=1"
+          " BIN_DIR_EXPORT_CPP=bin_nosimd"
+          " && ./bin_nosimd/n2d2_test -batch 8"
+          " && mv success_rate.txt success_rate_nosimd.txt";
+    ASSERT_EQUALS(system(cmd.c_str()), 0);
+
+    cmd = "cd export_CPP_float32/ && make OUTPUTFILE=1 NRET=1"
+          " && ./bin/n2d2_test -batch 8";
+    ASSERT_EQUALS(system(cmd.c_str()), 0);
+
+    ASSERT_EQUALS_DELTA(
+        readSuccessRate("export_CPP_float32/success_rate_nosimd.txt"),
+        successRate, 1.0e-3);
+    ASSERT_EQUALS_DELTA(
+        readSuccessRate("export_CPP_float32/success_rate.txt"),
+        successRate, 1.0e-3);
+
+    // 8 bits export: the explicit SIMD kernels give exactly the same results
+    // as the plain C++ ones
+    CellExport::mPrecision = static_cast<CellExport::Precision>(8);
+
+    DeepNetExport::generate(*deepNet, "export_CPP_int8", "CPP");
+
+    cmd = "cd export_CPP_int8/ && make OUTPUTFILE=1 NRET=1 NOSIMD=1"
+          " BIN_DIR_EXPORT_CPP=bin_nosimd"
+          " && ./bin_nosimd/n2d2_test -batch 8"
+          " && mv success_rate.txt success_rate_nosimd.txt";
+    ASSERT_EQUALS(system(cmd.c_str()), 0);
+
+    cmd = "cd export_CPP_int8/ && make OUTPUTFILE=1 NRET=1"
+          " && ./bin/n2d2_test -batch 8";
+    ASSERT_EQUALS(system(cmd.c_str()), 0);
+
+    ASSERT_EQUALS(readSuccessRate("export_CPP_int8/success_rate.txt"),
+                  readSuccessRate("export_CPP_int8/success_rate_nosimd.txt"));
+}
+
+RUN_TESTS()
@@ -151,4 +151,57 @@ TEST(DeepNetGenerator, DeepNetGenerator)
     }
 }
 
+TEST(DeepNetGenerator, generate_inputsNet)
+{
+    REQUIRED(UnitTest::DirExists(N2D2_DATA("mnist")));
+
+    const std::string data = "DefaultModel=Frame\n"
+                             "\n"
+                             "[database]\n"
+                             "Type=MNIST_IDX_Database\n"
+                             "\n"
+                             "[sp]\n"
+                             "SizeX=24\n"
+                             "SizeY=24\n"
+                             "BatchSize=12\n"
+                             "\n"
+                             "[sp.Transformation]\n"
+                             "Type=PadCropTransformation\n"
+                             "Width=24\n"
+                             "Height=24\n"
+                             "\n"
+                             "[conv1]\n"
+                             "Input=sp\n"
+                             "Type=Conv\n"
+                             "KernelWidth=4\n"
+                             "KernelHeight=4\n"
+                             "NbChannels=16\n"
+                             "Stride=2\n"
+                             "\n"
+                             "[conv1.Target]\n";
+
+    UnitTest::FileWriteContent("DeepNetGenerator_inputsNet.in", data);
+
+    Network net;
+    std::shared_ptr<DeepNet> deepNet
+        = DeepNetGenerator::generate(net, "DeepNetGenerator_inputsNet.in");
+    std::shared_ptr<DeepNet> deepNetCopy
+        = DeepNetGenerator::generate(net, "DeepNetGenerator_inputsNet.in",
+                                     deepNet);
+
+    ASSERT_TRUE(deepNetCopy != deepNet);
+    ASSERT_TRUE(deepNetCopy->getDatabase() == deepNet->getDatabase());
+    ASSERT_TRUE(deepNetCopy->getStimuliProvider()
+                == deepNet->getStimuliProvider());
+
+    const std::shared_ptr<ConvCell_Frame> conv1 = deepNet->getCell
+                                                  <ConvCell_Frame>("conv1");
+    const std::shared_ptr<ConvCell_Frame> conv1Copy = deepNetCopy->getCell
+                                                      <ConvCell_Frame>("conv1");
+    ASSERT_TRUE(conv1Copy != conv1);
+    ASSERT_EQUALS(conv1Copy->getNbOutputs(), conv1->getNbOutputs());
+    ASSERT_EQUALS(conv1Copy->getOutputsWidth(), conv1->getOutputsWidth());
+    ASSERT_EQUALS(conv1Copy->getOutputsHeight(), conv1->getOutputsHeight());
+}
+
 RUN_TESTS()
@@ -0,0 +1,81 @@
+/*
+    (C) Copyright 2016 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include "N2D2.hpp"
+
+#include "Solver/SGDSolver_Frame.hpp"
+#include "utils/UnitTest.hpp"
+
+using namespace N2D2;
+
+TEST(SGDSolver_Frame, clone_momentum)
+{
+    SGDSolver_Frame<Float_T> solver;
+    solver.setParameter("LearningRate", 0.1);
+    solver.setParameter("Momentum", 0.9);
+
+    // Cells clone their solver for each set of weights
+    std::shared_ptr<SGDSolver_Frame<Float_T> > solver1 = solver.clone();
+    std::shared_ptr<SGDSolver_Frame<Float_T> > solver2 = solver.clone();
+
+    // Reference: solvers that were never cloned
+    SGDSolver_Frame<Float_T> solverRef1;
+    solverRef1.setParameter("LearningRate", 0.1);
+    solverRef1.setParameter("Momentum", 0.9);
+    SGDSolver_Frame<Float_T> solverRef2;
+    solverRef2.setParameter("LearningRate", 0.1);
+    solverRef2.setParameter("Momentum", 0.9);
+
+    Tensor4d<Float_T> data1(3, 3, 2, 4);
+    Tensor4d<Float_T> data2(3, 3, 2, 4);
+    Tensor4d<Float_T> diffData1(3, 3, 2, 4);
+    Tensor4d<Float_T> diffData2(3, 3, 2, 4);
+
+    for (unsigned int index = 0; index < data1.size(); ++index) {
+        data1(index) = Random::randUniform(-1.0, 1.0);
+        data2(index) = Random::randUniform(-1.0, 1.0);
+    }
+
+    Tensor4d<Float_T> dataRef1(data1.dimX(), data1.dimY(), data1.dimZ(),
+                               data1.dimB());
+    Tensor4d<Float_T> dataRef2(data2.dimX(), data2.dimY(), data2.dimZ(),
+                               data2.dimB());
+    std::copy(data1.begin(), data1.end(), dataRef1.begin());
+    std::copy(data2.begin(), data2.end(), dataRef2.begin());
+
+    for (unsigned int step = 0; step < 5; ++step) {
+        for (unsigned int index = 0; index < diffData1.size(); ++index) {
+            diffData1(index) = Random::randUniform(-1.0, 1.0);
+            diffData2(index) = Random::randUniform(-1.0, 1.0);
+        }
+
+        solver1->update(&data1, &diffData1, 1);
+        solver2->update(&data2, &diffData2, 1);
+        solverRef1.update(&dataRef1, &diffData1, 1);
+        solverRef2.update(&dataRef2, &diffData2, 1);
+
+        for (unsigned int index = 0; index < data1.size(); ++index) {
+            ASSERT_EQUALS_DELTA(data1(index), dataRef1(index), 1.0e-6);
+            ASSERT_EQUALS_DELTA(data2(index), dataRef2(index), 1.0e-6);
+        }
+    }
+}
+
+RUN_TESTS()
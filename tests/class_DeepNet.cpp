@@ -20,12 +20,18 @@
 
 #include "N2D2.hpp"
 
+#include "Cell/BatchNormCell_Frame.hpp"
 #include "Cell/ConvCell_Frame.hpp"
+#include "Cell/DropoutCell_Frame.hpp"
 #include "Database/DIR_Database.hpp"
 #include "DeepNet.hpp"
 #include "Cell/FcCell_Frame.hpp"
 #include "utils/UnitTest.hpp"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 using namespace N2D2;
 
 TEST(DeepNet, DeepNet)
@@ -43,6 +49,7 @@ TEST(DeepNet, DeepNet)
     ASSERT_EQUALS(deepNet.getTargets().size(), 0U);
     ASSERT_EQUALS(deepNet.getSignalsDiscretization(), 0U);
     ASSERT_EQUALS(deepNet.getFreeParametersDiscretization(), 0U);
+    ASSERT_EQUALS(deepNet.getConcurrentCells(), true);
     ASSERT_THROW_ANY(deepNet.getTarget()->getDefaultTarget());
 }
 
@@ -108,6 +115,497 @@ TEST(DeepNet, addCell_ter)
     ASSERT_EQUALS(deepNet.getParentCells("fc")[0], convCell);
 }
 
+TEST(DeepNet, setConcurrentCells)
+{
+    Network net;
+    DeepNet deepNet(net);
+
+    deepNet.setConcurrentCells(false);
+    ASSERT_EQUALS(deepNet.getConcurrentCells(), false);
+
+    deepNet.setConcurrentCells();
+    ASSERT_EQUALS(deepNet.getConcurrentCells(), true);
+}
+
+/**
+ * Outputs and gradients of a network with two branches (a Dropout and a Conv
+ * cell sharing the same parent), for a few learn() steps and a test().
+*/
+std::vector<Float_T> branchedNetOutputs(bool concurrentCells)
+{
+    Network net;
+    DeepNet deepNet(net);
+
+    // After the Network, which seeds the generator with the current time
+    Random::mtSeed(0);
+    deepNet.setConcurrentCells(concurrentCells);
+
+    std::shared_ptr<Environment> env(new Environment(net, EmptyDatabase, 8, 8));
+    env->setBatchSize(4);
+
+    std::shared_ptr<ConvCell_Frame> conv1(new ConvCell_Frame(
+        "conv1", 3, 3, 4, 1, 1, 1, 1, 0, 0,
+        std::make_shared<RectifierActivation_Frame<Float_T> >()));
+    std::shared_ptr<DropoutCell_Frame> dropout(new DropoutCell_Frame(
+        "dropout", 4));
+    std::shared_ptr<ConvCell_Frame> conv2(new ConvCell_Frame(
+        "conv2", 3, 3, 4, 1, 1, 1, 1, 1, 1,
+        std::make_shared<RectifierActivation_Frame<Float_T> >()));
+    std::shared_ptr<FcCell_Frame> fcCell(new FcCell_Frame(
+        "fc", 10, std::shared_ptr<Activation<Float_T> >()));
+    fcCell->setParameter("DropConnect", 0.8);
+
+    conv1->addInput(*env);
+    dropout->addInput(conv1.get());
+    conv2->addInput(conv1.get());
+    fcCell->addInput(dropout.get());
+    fcCell->addInput(conv2.get());
+    conv1->initialize();
+    dropout->initialize();
+    conv2->initialize();
+    fcCell->initialize();
+
+    std::vector<std::shared_ptr<Cell> > fcParents;
+    fcParents.push_back(dropout);
+    fcParents.push_back(conv2);
+
+    deepNet.addCell(conv1, std::vector<std::shared_ptr<Cell> >(1));
+    deepNet.addCell(dropout, std::vector<std::shared_ptr<Cell> >(1, conv1));
+    deepNet.addCell(conv2, std::vector<std::shared_ptr<Cell> >(1, conv1));
+    deepNet.addCell(fcCell, fcParents);
+    deepNet.addTarget(std::make_shared<Target>("target", fcCell, env));
+
+    for (Tensor4d<Float_T>::iterator it = env->getData().begin(),
+                                     itEnd = env->getData().end();
+         it != itEnd;
+         ++it)
+        (*it) = Random::randUniform(-1.0, 1.0);
+
+    std::vector<Float_T> outputs;
+
+    for (unsigned int step = 0; step < 3; ++step) {
+        deepNet.learn();
+
+        outputs.insert(outputs.end(), fcCell->getOutputs().begin(),
+                       fcCell->getOutputs().end());
+        outputs.insert(outputs.end(), conv1->getDiffInputs().begin(),
+                       conv1->getDiffInputs().end());
+    }
+
+    deepNet.test();
+
+    outputs.insert(outputs.end(), fcCell->getOutputs().begin(),
+                   fcCell->getOutputs().end());
+    return outputs;
+}
+
+TEST(DeepNet, setConcurrentCells_branches)
+{
+#ifdef _OPENMP
+    // Several threads, so that the two branches actually run concurrently
+    const int maxThreads = omp_get_max_threads();
+    omp_set_num_threads(4);
+#endif
+
+    const std::vector<Float_T> outputsRef = branchedNetOutputs(false);
+    const std::vector<Float_T> outputs = branchedNetOutputs(true);
+
+#ifdef _OPENMP
+    omp_set_num_threads(maxThreads);
+#endif
+
+    ASSERT_EQUALS(outputs.size(), outputsRef.size());
+
+    for (unsigned int i = 0; i < outputs.size(); ++i)
+        ASSERT_EQUALS(outputs[i], outputsRef[i]);
+}
+
+TEST(DeepNet, fuseCells)
+{
+    Random::mtSeed(0);
+
+    Network net;
+    DeepNet deepNet(net);
+
+    std::shared_ptr<Environment> env(new Environment(net, EmptyDatabase, 8, 8));
+    env->setBatchSize(2);
+
+    std::shared_ptr<ConvCell_Frame> convCell(new ConvCell_Frame(
+        "conv", 3, 3, 4, 1, 1, 1, 1, 0, 0,
+        std::shared_ptr<Activation<Float_T> >()));
+    std::shared_ptr<BatchNormCell_Frame> bnCell(new BatchNormCell_Frame(
+        "bn", 4, std::make_shared<RectifierActivation_Frame<Float_T> >()));
+    std::shared_ptr<FcCell_Frame> fcCell(new FcCell_Frame(
+        "fc", 10, std::shared_ptr<Activation<Float_T> >()));
+
+    convCell->addInput(*env);
+    bnCell->addInput(convCell.get());
+    fcCell->addInput(bnCell.get());
+    convCell->initialize();
+    bnCell->initialize();
+    fcCell->initialize();
+
+    deepNet.addCell(convCell, std::vector<std::shared_ptr<Cell> >(1));
+    deepNet.addCell(bnCell, std::vector<std::shared_ptr<Cell> >(1, convCell));
+    deepNet.addCell(fcCell, std::vector<std::shared_ptr<Cell> >(1, bnCell));
+
+    for (Tensor4d<Float_T>::iterator it = env->getData().begin(),
+                                     itEnd = env->getData().end();
+         it != itEnd;
+         ++it)
+        (*it) = Random::randUniform(-1.0, 1.0);
+
+    // Non-trivial BatchNorm mean and variance
+    convCell->propagate();
+    bnCell->propagate();
+
+    convCell->propagate(true);
+    bnCell->propagate(true);
+    fcCell->propagate(true);
+
+    const std::vector<Float_T> outputs(fcCell->getOutputs().begin(),
+                                       fcCell->getOutputs().end());
+
+    ASSERT_EQUALS(deepNet.fuseCells(), 1U);
+    ASSERT_EQUALS(deepNet.getLayers().size(), 3U);
+    ASSERT_EQUALS(deepNet.getLayers()[1][0], "conv");
+    ASSERT_EQUALS(deepNet.getLayers()[2][0], "fc");
+    ASSERT_EQUALS(deepNet.getCells().size(), 2U);
+    ASSERT_EQUALS(deepNet.getParentCells("fc").size(), 1U);
+    ASSERT_EQUALS(deepNet.getParentCells("fc")[0], convCell);
+
+    convCell->propagate(true);
+    fcCell->propagate(true);
+
+    for (unsigned int i = 0; i < outputs.size(); ++i)
+        ASSERT_EQUALS_DELTA(fcCell->getOutputs()(i), outputs[i], 1.0e-5);
+
+    ASSERT_THROW_ANY(deepNet.learn());
+}
+
+TEST(DeepNet, planMemory)
+{
+    Random::mtSeed(0);
+
+    Network net;
+    DeepNet deepNet(net);
+
+    std::shared_ptr<Environment> env(new Environment(net, EmptyDatabase, 8, 8));
+    env->setBatchSize(2);
+
+    std::shared_ptr<ConvCell_Frame> conv1(new ConvCell_Frame(
+        "conv1", 3, 3, 4, 1, 1, 1, 1, 0, 0,
+        std::make_shared<RectifierActivation_Frame<Float_T> >()));
+    std::shared_ptr<ConvCell_Frame> conv2(new ConvCell_Frame(
+        "conv2", 3, 3, 4, 1, 1, 1, 1, 0, 0,
+        std::make_shared<RectifierActivation_Frame<Float_T> >()));
+    std::shared_ptr<ConvCell_Frame> conv3(new ConvCell_Frame(
+        "conv3", 3, 3, 4, 1, 1, 1, 1, 0, 0,
+        std::make_shared<RectifierActivation_Frame<Float_T> >()));
+    std::shared_ptr<FcCell_Frame> fcCell(new FcCell_Frame(
+        "fc", 10, std::shared_ptr<Activation<Float_T> >()));
+
+    conv1->addInput(*env);
+    conv2->addInput(conv1.get());
+    conv3->addInput(conv2.get());
+    fcCell->addInput(conv3.get());
+    conv1->initialize();
+    conv2->initialize();
+    conv3->initialize();
+    fcCell->initialize();
+
+    deepNet.addCell(conv1, std::vector<std::shared_ptr<Cell> >(1));
+    deepNet.addCell(conv2, std::vector<std::shared_ptr<Cell> >(1, conv1));
+    deepNet.addCell(conv3, std::vector<std::shared_ptr<Cell> >(1, conv2));
+    deepNet.addCell(fcCell, std::vector<std::shared_ptr<Cell> >(1, conv3));
+    deepNet.addTarget(std::make_shared<Target>("target", fcCell, env));
+
+    for (Tensor4d<Float_T>::iterator it = env->getData().begin(),
+                                     itEnd = env->getData().end();
+         it != itEnd;
+         ++it)
+        (*it) = Random::randUniform(-1.0, 1.0);
+
+    deepNet.test();
+
+    const std::vector<Float_T> outputs(fcCell->getOutputs().begin(),
+                                       fcCell->getOutputs().end());
+
+    const DeepNet::MemoryPlan plan = deepNet.planMemory();
+
+    // conv1 and conv3 share a slot, the target outputs keep their buffer
+    ASSERT_EQUALS(plan.nbPlannedCells, 3U);
+    ASSERT_EQUALS(plan.nbSlots, 2U);
+    ASSERT_EQUALS(plan.plannedBytes,
+                  (6 * 6 * 4 + 4 * 4 * 4 + 10) * 2 * sizeof(Float_T));
+    ASSERT_EQUALS(plan.initialBytes,
+                  2 * (6 * 6 * 4 + 4 * 4 * 4 + 2 * 2 * 4 + 10) * 2
+                  * sizeof(Float_T));
+    ASSERT_EQUALS(conv1->getDiffInputs().size(), 0U);
+    ASSERT_EQUALS(fcCell->getDiffInputs().size(), 0U);
+
+    deepNet.test();
+
+    ASSERT_EQUALS(conv1->getOutputs().size(), 0U);
+    ASSERT_EQUALS(fcCell->getOutputs().size(), outputs.size());
+
+    for (unsigned int i = 0; i < outputs.size(); ++i)
+        ASSERT_EQUALS_DELTA(fcCell->getOutputs()(i), outputs[i], 1.0e-6);
+
+    ASSERT_THROW_ANY(deepNet.planMemory());
+    ASSERT_THROW_ANY(deepNet.learn());
+
+    // The planned outputs are not kept after test()
+    std::map<std::string, DeepNet::RangeStats> outputsRange;
+    ASSERT_THROW_ANY(deepNet.reportOutputsRange(outputsRange));
+
+    std::map<std::string, Quantization::Histogram> outputsHistogram;
+    ASSERT_THROW_ANY(deepNet.reportOutputsHistogram(outputsHistogram));
+}
+
+TEST_DATASET(DeepNet,
+             quantize,
+             (unsigned int channelBlock, unsigned int nbQuantizedRef),
+             std::make_tuple(1U, 3U),
+             std::make_tuple(8U, 1U))
+{
+    Network net;
+    DeepNet deepNet(net);
+
+    // After the Network, which seeds the generator with the current time
+    Random::mtSeed(0);
+
+    std::shared_ptr<Environment> env(new Environment(net, EmptyDatabase, 8, 8));
+    env->setBatchSize(2);
+
+    std::shared_ptr<ConvCell_Frame> conv1(new ConvCell_Frame(
+        "conv1", 3, 3, 8, 1, 1, 1, 1, 0, 0,
+        std::make_shared<RectifierActivation_Frame<Float_T> >()));
+    std::shared_ptr<ConvCell_Frame> conv2(new ConvCell_Frame(
+        "conv2", 3, 3, 8, 1, 1, 1, 1, 0, 0,
+        std::make_shared<RectifierActivation_Frame<Float_T> >()));
+    std::shared_ptr<FcCell_Frame> fcCell(new FcCell_Frame(
+        "fc", 10, std::shared_ptr<Activation<Float_T> >()));
+
+    conv1->addInput(*env);
+    conv2->addInput(conv1.get());
+    fcCell->addInput(conv2.get());
+
+    deepNet.setStimuliProvider(env);
+    deepNet.addCell(conv1, std::vector<std::shared_ptr<Cell> >(1));
+    deepNet.addCell(conv2, std::vector<std::shared_ptr<Cell> >(1, conv1));
+    deepNet.addCell(fcCell, std::vector<std::shared_ptr<Cell> >(1, conv2));
+    deepNet.addTarget(std::make_shared<Target>("target", fcCell, env));
+
+    // With a channel block, conv1 has blocked outputs and conv2 blocked
+    // inputs: only fc has an integer kernel
+    deepNet.setChannelBlock(channelBlock);
+    deepNet.initialize();
+
+    for (Tensor4d<Float_T>::iterator it = env->getData().begin(),
+                                     itEnd = env->getData().end();
+         it != itEnd;
+         ++it)
+        (*it) = Random::randUniform(-1.0, 1.0);
+
+    deepNet.test();
+
+    const std::vector<Float_T> outputs(fcCell->getOutputs().begin(),
+                                       fcCell->getOutputs().end());
+
+    std::map<std::string, Quantization::Histogram> outputsHistogram;
+    deepNet.reportOutputsHistogram(outputsHistogram);
+
+    ASSERT_EQUALS(deepNet.quantize(outputsHistogram, 8, Quantization::MaxAbs),
+                  nbQuantizedRef);
+    ASSERT_EQUALS(conv1->getQuantization(), (channelBlock > 1) ? 0U : 8U);
+    ASSERT_EQUALS(conv2->getQuantization(), (channelBlock > 1) ? 0U : 8U);
+    ASSERT_EQUALS(fcCell->getQuantization(), 8U);
+
+    deepNet.test();
+
+    const double maxAbsOutput = outputsHistogram["fc"].getMaxAbs();
+
+    for (unsigned int i = 0; i < outputs.size(); ++i) {
+        ASSERT_EQUALS_DELTA(fcCell->getOutputs()(i), outputs[i],
+                            0.05 * maxAbsOutput);
+    }
+}
+
+TEST(DeepNet, planCheckpoints)
+{
+    Random::mtSeed(0);
+
+    Network net;
+    DeepNet deepNet(net);
+
+    std::shared_ptr<Environment> env(new Environment(net, EmptyDatabase, 8, 8));
+    env->setBatchSize(2);
+
+    std::shared_ptr<ConvCell_Frame> conv1(new ConvCell_Frame(
+        "conv1", 3, 3, 4, 1, 1, 1, 1, 0, 0,
+        std::make_shared<RectifierActivation_Frame<Float_T> >()));
+    std::shared_ptr<ConvCell_Frame> conv2(new ConvCell_Frame(
+        "conv2", 3, 3, 4, 1, 1, 1, 1, 0, 0,
+        std::make_shared<RectifierActivation_Frame<Float_T> >()));
+    std::shared_ptr<ConvCell_Frame> conv3(new ConvCell_Frame(
+        "conv3", 3, 3, 4, 1, 1, 1, 1, 0, 0,
+        std::make_shared<RectifierActivation_Frame<Float_T> >()));
+    std::shared_ptr<FcCell_Frame> fcCell(new FcCell_Frame(
+        "fc", 10, std::shared_ptr<Activation<Float_T> >()));
+
+    conv1->addInput(*env);
+    conv2->addInput(conv1.get());
+    conv3->addInput(conv2.get());
+    fcCell->addInput(conv3.get());
+
+    // The weights do not change, so that both learn() see the same network
+    conv1->getWeightsSolver()->setParameter("LearningRate", 0.0);
+    conv1->getBiasSolver()->setParameter("LearningRate", 0.0);
+    conv2->getWeightsSolver()->setParameter("LearningRate", 0.0);
+    conv2->getBiasSolver()->setParameter("LearningRate", 0.0);
+    conv3->getWeightsSolver()->setParameter("LearningRate", 0.0);
+    conv3->getBiasSolver()->setParameter("LearningRate", 0.0);
+    fcCell->getWeightsSolver()->setParameter("LearningRate", 0.0);
+    fcCell->getBiasSolver()->setParameter("LearningRate", 0.0);
+
+    conv1->initialize();
+    conv2->initialize();
+    conv3->initialize();
+    fcCell->initialize();
+
+    deepNet.addCell(conv1, std::vector<std::shared_ptr<Cell> >(1));
+    deepNet.addCell(conv2, std::vector<std::shared_ptr<Cell> >(1, conv1));
+    deepNet.addCell(conv3, std::vector<std::shared_ptr<Cell> >(1, conv2));
+    deepNet.addCell(fcCell, std::vector<std::shared_ptr<Cell> >(1, conv3));
+    deepNet.addTarget(std::make_shared<Target>("target", fcCell, env));
+
+    for (Tensor4d<Float_T>::iterator it = env->getData().begin(),
+                                     itEnd = env->getData().end();
+         it != itEnd;
+         ++it)
+        (*it) = Random::randUniform(-1.0, 1.0);
+
+    const std::size_t outputsBytes
+        = (6 * 6 * 4 + 4 * 4 * 4 + 2 * 2 * 4 + 10) * 2 * sizeof(Float_T);
+
+    // Enough memory: no recomputation
+    DeepNet::CheckpointPlan plan = deepNet.planCheckpoints(outputsBytes);
+
+    ASSERT_EQUALS(plan.nbRecomputedCells, 0U);
+    ASSERT_EQUALS(plan.initialBytes, outputsBytes);
+    ASSERT_EQUALS(plan.peakBytes, outputsBytes);
+    ASSERT_EQUALS(plan.recomputedConnections, 0U);
+
+    deepNet.learn();
+
+    const std::vector<Float_T> diffInputs(conv1->getDiffInputs().begin(),
+                                          conv1->getDiffInputs().end());
+
+    ASSERT_EQUALS(std::count(diffInputs.begin(), diffInputs.end(),
+                             (Float_T)0.0) < (int)diffInputs.size(),
+                  true);
+
+    // conv2 is the checkpoint: conv1 and conv3 are recomputed, in two
+    // segments
+    plan = deepNet.planCheckpoints(0);
+
+    ASSERT_EQUALS(plan.nbCheckpoints, 2U);
+    ASSERT_EQUALS(plan.nbRecomputedCells, 2U);
+    ASSERT_EQUALS(plan.peakBytes,
+                  (6 * 6 * 4 + 4 * 4 * 4 + 10) * 2 * sizeof(Float_T));
+    ASSERT_EQUALS(plan.recomputedConnections,
+                  (6 * 6 * 4 * 3 * 3 + 2 * 2 * 4 * 3 * 3 * 4) * 2U);
+    ASSERT_EQUALS(conv1->getOutputs().size(), 0U);
+
+    deepNet.learn();
+
+    ASSERT_EQUALS(conv1->getOutputs().size(), 0U);
+    ASSERT_EQUALS(conv2->getOutputs().size(), 4 * 4 * 4 * 2U);
+
+    for (unsigned int i = 0; i < diffInputs.size(); ++i)
+        ASSERT_EQUALS_DELTA(conv1->getDiffInputs()(i), diffInputs[i], 1.0e-6);
+
+    deepNet.test();
+
+    ASSERT_EQUALS(conv1->getOutputs().size(), 6 * 6 * 4 * 2U);
+}
+
+TEST(DeepNet, planCheckpoints_bis)
+{
+    Network net;
+    DeepNet deepNet(net);
+
+    // After the Network, which seeds the generator with the current time
+    Random::mtSeed(0);
+
+    std::shared_ptr<Environment> env(new Environment(net, EmptyDatabase, 8, 8));
+    env->setBatchSize(2);
+
+    std::shared_ptr<ConvCell_Frame> conv1(new ConvCell_Frame(
+        "conv1", 3, 3, 4, 1, 1, 1, 1, 0, 0,
+        std::make_shared<RectifierActivation_Frame<Float_T> >()));
+    std::shared_ptr<ConvCell_Frame> conv2(new ConvCell_Frame(
+        "conv2", 3, 3, 4, 1, 1, 1, 1, 0, 0,
+        std::make_shared<RectifierActivation_Frame<Float_T> >()));
+    std::shared_ptr<ConvCell_Frame> conv3(new ConvCell_Frame(
+        "conv3", 3, 3, 4, 1, 1, 1, 1, 0, 0,
+        std::make_shared<RectifierActivation_Frame<Float_T> >()));
+    std::shared_ptr<FcCell_Frame> fc1(new FcCell_Frame(
+        "fc1", 16, std::make_shared<RectifierActivation_Frame<Float_T> >()));
+    std::shared_ptr<FcCell_Frame> fc2(new FcCell_Frame(
+        "fc2", 10, std::shared_ptr<Activation<Float_T> >()));
+
+    fc1->setParameter("DropConnect", 0.5);
+
+    conv1->addInput(*env);
+    conv2->addInput(conv1.get());
+    conv3->addInput(conv2.get());
+    fc1->addInput(conv3.get());
+    fc2->addInput(fc1.get());
+
+    deepNet.setStimuliProvider(env);
+    deepNet.addCell(conv1, std::vector<std::shared_ptr<Cell> >(1));
+    deepNet.addCell(conv2, std::vector<std::shared_ptr<Cell> >(1, conv1));
+    deepNet.addCell(conv3, std::vector<std::shared_ptr<Cell> >(1, conv2));
+    deepNet.addCell(fc1, std::vector<std::shared_ptr<Cell> >(1, conv3));
+    deepNet.addCell(fc2, std::vector<std::shared_ptr<Cell> >(1, fc1));
+    deepNet.addTarget(std::make_shared<Target>("target", fc2, env));
+
+    // conv1 and conv2 have blocked outputs: their 4 channels are padded to 8
+    deepNet.setChannelBlock(8);
+    deepNet.initialize();
+
+    ASSERT_EQUALS(conv1->getOutputs().size(), 6 * 6 * 8 * 2U);
+
+    for (Tensor4d<Float_T>::iterator it = env->getData().begin(),
+                                     itEnd = env->getData().end();
+         it != itEnd;
+         ++it)
+        (*it) = Random::randUniform(-1.0, 1.0);
+
+    // conv2 is the checkpoint: conv1 and conv3 are recomputed. fc1 draws a
+    // new DropConnect mask at each propagation: it is never recomputed.
+    const DeepNet::CheckpointPlan plan = deepNet.planCheckpoints(0);
+
+    ASSERT_EQUALS(plan.initialBytes,
+                  (6 * 6 * 8 + 4 * 4 * 8 + 2 * 2 * 4 + 16 + 10) * 2
+                  * sizeof(Float_T));
+    ASSERT_EQUALS(plan.nbCheckpoints, 2U);
+    ASSERT_EQUALS(plan.nbRecomputedCells, 2U);
+    ASSERT_EQUALS(conv1->getOutputs().size(), 0U);
+    ASSERT_EQUALS(fc1->getOutputs().size(), 16 * 2U);
+
+    deepNet.learn();
+
+    ASSERT_EQUALS(conv1->getOutputs().size(), 0U);
+    ASSERT_EQUALS(fc1->getOutputs().size(), 16 * 2U);
+
+    deepNet.test();
+
+    ASSERT_EQUALS(conv1->getOutputs().size(), 6 * 6 * 8 * 2U);
+}
+
 TEST(DeepNet, setDatabase)
 {
     Network net;
@@ -0,0 +1,138 @@
+/*
+    (C) Copyright 2016 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include "N2D2.hpp"
+
+#include "EventWheel.hpp"
+#include "NodeEnv.hpp"
+#include "SpikeEvent.hpp"
+#include "utils/UnitTest.hpp"
+
+using namespace N2D2;
+
+TEST_DATASET(EventWheel,
+             order,
+             (Time_T maxDelay),
+             std::make_tuple(10ULL),
+             std::make_tuple(1000ULL),
+             std::make_tuple(1000000000000ULL))
+{
+    Network net(1);
+    NodeEnv dest(net, 1.0, 0.0, 0);
+    std::vector<NodeEnv*> origins;
+
+    for (unsigned int i = 0; i < 10; ++i)
+        origins.push_back(new NodeEnv(net, 1.0, 0.0, i));
+
+    std::vector<SpikeEvent*> events;
+    std::priority_queue
+        <SpikeEvent*, std::vector<SpikeEvent*>, Utils::PtrLess<SpikeEvent*> >
+    heap;
+    EventWheel wheel;
+
+    for (unsigned int i = 0; i < 1000; ++i) {
+        const Time_T timestamp
+            = (Time_T)Random::randUniform(0.0, (double)maxDelay);
+        events.push_back(new SpikeEvent(origins[Random::randUniform(0, 9)],
+                                        Random::randBernoulli() ? &dest : NULL,
+                                        timestamp,
+                                        0));
+        heap.push(events.back());
+        wheel.push(events.back());
+    }
+
+    ASSERT_EQUALS(wheel.size(), 1000U);
+
+    unsigned int nbEvents = 0;
+
+    while (!heap.empty()) {
+        ASSERT_TRUE(!wheel.empty());
+
+        SpikeEvent* heapEvent = heap.top();
+        SpikeEvent* wheelEvent = wheel.top();
+        heap.pop();
+        wheel.pop();
+
+        ASSERT_EQUALS(wheelEvent->getTimestamp(), heapEvent->getTimestamp());
+        // Same order for simultaneous events
+        ASSERT_TRUE(wheelEvent->getDestination()
+                    == heapEvent->getDestination());
+        ASSERT_TRUE(wheelEvent->getOrigin() == heapEvent->getOrigin());
+
+        // New events while processing, including at the current timestamp
+        if (nbEvents < 2000) {
+            // 1/3 of the new events are at the current timestamp
+            const Time_T timestamp = heapEvent->getTimestamp()
+                + Random::randUniform(0, 2)
+                  * (Time_T)Random::randUniform(0.0, (double)maxDelay);
+            events.push_back(
+                new SpikeEvent(origins[Random::randUniform(0, 9)],
+                               Random::randBernoulli() ? &dest : NULL,
+                               timestamp,
+                               0));
+            heap.push(events.back());
+            wheel.push(events.back());
+        }
+
+        ++nbEvents;
+    }
+
+    ASSERT_TRUE(wheel.empty());
+    ASSERT_EQUALS(nbEvents, 3000U);
+
+    std::for_each(events.begin(), events.end(), Utils::Delete());
+    std::for_each(origins.begin(), origins.end(), Utils::Delete());
+}
+
+TEST(EventWheel, rewind)
+{
+    Network net(1);
+    NodeEnv dest(net, 1.0, 0.0, 0);
+    NodeEnv origin(net, 1.0, 0.0, 1);
+
+    SpikeEvent event1(&origin, &dest, 1000000, 0);
+    SpikeEvent event2(&origin, &dest, 2000, 0);
+    SpikeEvent event3(&origin, NULL, 2000, 0);
+    SpikeEvent event4(&origin, &dest, 300, 0);
+
+    EventWheel wheel;
+    wheel.push(&event1);
+
+    ASSERT_TRUE(wheel.top() == &event1);
+
+    // Earlier events than the current wheel time
+    wheel.push(&event2);
+    wheel.push(&event3);
+
+    ASSERT_TRUE(wheel.top() == &event2);
+    wheel.pop();
+
+    wheel.push(&event4);
+
+    ASSERT_TRUE(wheel.top() == &event4);
+    wheel.pop();
+    ASSERT_TRUE(wheel.top() == &event3);
+    wheel.pop();
+    ASSERT_TRUE(wheel.top() == &event1);
+    wheel.pop();
+    ASSERT_TRUE(wheel.empty());
+}
+
+RUN_TESTS()
@@ -0,0 +1,188 @@
+/*
+    (C) Copyright 2016 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include "N2D2.hpp"
+
+#include "Network.hpp"
+#include "NodeEnv.hpp"
+#include "Xcell.hpp"
+#include "utils/UnitTest.hpp"
+
+using namespace N2D2;
+
+class Network_Test {
+public:
+    Network_Test(Network::Scheduler scheduler, bool parallel)
+        : net(1, scheduler, parallel)
+    {
+        for (unsigned int i = 0; i < 32; ++i)
+            env.push_back(new NodeEnv(net, 1.0, 0.0, i));
+
+        // 4 Xcells on the input, 2 Xcells on the outputs of the 4 first ones
+        // and 1 Xcell on the outputs of the 2 previous ones
+        for (unsigned int i = 0; i < 7; ++i) {
+            cells.push_back(new Xcell(net));
+            cells.back()->populate<NodeNeuron_Behavioral>(8);
+            cells.back()->setNeuronsParameter("Threshold", 300.0);
+            cells.back()->setNeuronsParameter("InhibitRefractory",
+                                              10 * TimeNs);
+            cells.back()->setActivityRecording(true);
+
+            // These parameters are spread at the first run, in the order of
+            // the Network observers, which depends on the memory addresses
+            cells.back()->setNeuronsParameterSpread<Time_T>("EmitDelay", 0.0);
+            cells.back()->setNeuronsParameterSpread<double>("Threshold", 0.0);
+            cells.back()->setNeuronsParameterSpread<Time_T>("StdpLtp", 0.0);
+            cells.back()->setNeuronsParameterSpread<Time_T>("Leak", 0.0);
+            cells.back()->setNeuronsParameterSpread<Time_T>("Refractory", 0.0);
+            cells.back()->setNeuronsParameterSpread
+                <Time_T>("InhibitRefractory", 0.0);
+        }
+
+        for (unsigned int i = 0; i < 32; ++i)
+            cells[i / 8]->addInput(env[i]);
+
+        cells[4]->addInput(*cells[0]);
+        cells[4]->addInput(*cells[1]);
+        cells[5]->addInput(*cells[2]);
+        cells[5]->addInput(*cells[3]);
+        cells[6]->addInput(*cells[4]);
+        cells[6]->addInput(*cells[5]);
+    }
+
+    void run(Time_T start, Time_T stop = 0)
+    {
+        for (unsigned int s = 0; s < 5000; ++s) {
+            env[Random::randUniform(0, 31)]->incomingSpike(
+                NULL,
+                start + (Time_T)Random::randUniform(0, 100000) * TimeNs);
+        }
+
+        net.run(stop);
+    }
+
+    /// Spike recording by node rank in the network
+    std::vector<NodeEvents_T> getSpikeRecording()
+    {
+        const std::unordered_map<NodeId_T, NodeEvents_T>& spikeRecording
+            = net.getSpikeRecording();
+        const NodeId_T firstId = env[0]->getId();
+        std::vector<NodeEvents_T> recording;
+
+        for (std::unordered_map<NodeId_T, NodeEvents_T>::const_iterator it
+             = spikeRecording.begin(),
+             itEnd = spikeRecording.end();
+             it != itEnd;
+             ++it)
+        {
+            const unsigned int rank = (*it).first - firstId;
+
+            if (rank >= recording.size())
+                recording.resize(rank + 1);
+
+            recording[rank] = (*it).second;
+        }
+
+        return recording;
+    }
+
+    ~Network_Test()
+    {
+        std::for_each(cells.begin(), cells.end(), Utils::Delete());
+        std::for_each(env.begin(), env.end(), Utils::Delete());
+    }
+
+    Network net;
+    std::vector<NodeEnv*> env;
+    std::vector<Xcell*> cells;
+};
+
+TEST_DATASET(Network,
+             parallel,
+             (Network::Scheduler scheduler, Time_T stop),
+             std::make_tuple(Network::PriorityQueue, 0ULL),
+             std::make_tuple(Network::TimingWheel, 0ULL),
+             std::make_tuple(Network::PriorityQueue, 50000 * TimeNs),
+             std::make_tuple(Network::TimingWheel, 50000 * TimeNs))
+{
+    std::vector<NodeEvents_T> recording;
+    Time_T lastEvent;
+    unsigned int nbSpikes = 0;
+
+    {
+        Network_Test test(scheduler, false);
+        test.run(0, stop);
+        test.run(200000 * TimeNs);
+
+        recording = test.getSpikeRecording();
+        lastEvent = test.net.getLastEvent();
+
+        ASSERT_EQUALS(test.net.getNbPartitions(), 0U);
+    }
+
+    for (std::vector<NodeEvents_T>::const_iterator it = recording.begin(),
+                                                   itEnd = recording.end();
+         it != itEnd;
+         ++it)
+        nbSpikes += (*it).size();
+
+    ASSERT_TRUE(nbSpikes > 0);
+
+    Network_Test test(scheduler, true);
+    test.run(0, stop);
+    test.run(200000 * TimeNs);
+
+    // The shared partition (with the environment) and one partition by Xcell
+    ASSERT_EQUALS(test.net.getNbPartitions(), 8U);
+    ASSERT_EQUALS(test.net.getLastEvent(), lastEvent);
+    ASSERT_TRUE(test.getSpikeRecording() == recording);
+}
+
+TEST(Network, parallel_merge)
+{
+    Network net(1, Network::PriorityQueue, true);
+    std::vector<NodeEnv*> env;
+
+    for (unsigned int i = 0; i < 8; ++i)
+        env.push_back(new NodeEnv(net, 1.0, 0.0, i));
+
+    Xcell cell1(net), cell2(net), cell3(net);
+    cell1.populate<NodeNeuron_Behavioral>(4);
+    cell2.populate<NodeNeuron_Behavioral>(4);
+    cell3.populate<NodeNeuron_Behavioral>(4);
+
+    for (unsigned int i = 0; i < 8; ++i) {
+        cell1.addInput(env[i]);
+        cell3.addInput(env[i]);
+    }
+
+    // Cycle between cell1 and cell2
+    cell2.addInput(cell1);
+    cell1.addInput(cell2);
+
+    net.run();
+
+    // The shared partition, cell1 + cell2 and cell3
+    ASSERT_EQUALS(net.getNbPartitions(), 3U);
+
+    std::for_each(env.begin(), env.end(), Utils::Delete());
+}
+
+RUN_TESTS()
@@ -0,0 +1,134 @@
+/*
+    (C) Copyright 2016 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include "N2D2.hpp"
+
+#include "Network.hpp"
+#include "NodeEnv.hpp"
+#include "NodeNeuron_Behavioral.hpp"
+#include "Xcell.hpp"
+#include "utils/UnitTest.hpp"
+
+using namespace N2D2;
+
+class NodeNeuron_Behavioral_Test : public NodeNeuron_Behavioral {
+public:
+    NodeNeuron_Behavioral_Test(Network& net) : NodeNeuron_Behavioral(net)
+    {
+    }
+
+    Weight_T getWeight(Node* origin) const
+    {
+        return static_cast<Synapse_Behavioral*>(mLinks.at(origin))->weight;
+    }
+};
+
+/**
+ * Spike recording and final weights of a 16 inputs x 4 neurons Xcell,
+ * trained with STDP for a fixed seed, with the sequential engine. The
+ * reference values were recorded with the previous implementation, which
+ * stored the synapses in an unordered_map and the LTP FIFO in a deque.
+*/
+TEST_DATASET(NodeNeuron_Behavioral,
+             stdp_reference,
+             (unsigned int orderStdp,
+              unsigned int nbSpikesRef,
+              Time_T sumTimestampsRef,
+              double sumWeightsRef),
+             std::make_tuple(0U, 255U, 12407684755000ULL, 2261.8900866394565),
+             std::make_tuple(1U, 91U, 3412270191000ULL, 548.05513134126807),
+             std::make_tuple(3U, 207U, 9928613907000ULL, 1680.2634295009766),
+             std::make_tuple(8U, 383U, 19003977683000ULL, 3242.0904003277296))
+{
+    Network net(1);
+    std::vector<NodeEnv*> env;
+
+    for (unsigned int i = 0; i < 16; ++i)
+        env.push_back(new NodeEnv(net, 1.0, 0.0, i));
+
+    Xcell cell(net);
+    cell.populate<NodeNeuron_Behavioral_Test>(4);
+    cell.setNeuronsParameter("Threshold", 1000.0);
+    cell.setNeuronsParameter("StdpLtp", 200 * TimeNs);
+    cell.setNeuronsParameter("InhibitRefractory", 10 * TimeNs);
+    cell.setNeuronsParameter("OrderStdp", orderStdp);
+    cell.setActivityRecording(true);
+
+    // No random spread: the spreads are drawn in the order of the Network
+    // observers, which depends on the memory addresses
+    cell.setNeuronsParameterSpread<Time_T>("IncomingDelay", 0.0);
+    cell.setNeuronsParameterSpread<Weight_T>("WeightsMin", 0.0);
+    cell.setNeuronsParameterSpread<Weight_T>("WeightsMax", 0.0);
+    cell.setNeuronsParameterSpread<Weight_T>("WeightsInit", 0.0);
+    cell.setNeuronsParameterSpread<Weight_T>("WeightIncrement", 0.0);
+    cell.setNeuronsParameterSpread<Weight_T>("WeightDecrement", 0.0);
+    cell.setNeuronsParameterSpread<Time_T>("EmitDelay", 0.0);
+
+    for (unsigned int i = 0; i < 16; ++i)
+        cell.addInput(env[i]);
+
+    for (unsigned int s = 0; s < 2000; ++s) {
+        env[Random::randUniform(0, 15)]->incomingSpike(
+            NULL, (Time_T)Random::randUniform(0, 100000) * TimeNs);
+    }
+
+    net.run();
+
+    const std::unordered_map<NodeId_T, NodeEvents_T>& spikeRecording
+        = net.getSpikeRecording();
+    unsigned int nbSpikes = 0;
+    Time_T sumTimestamps = 0;
+    double sumWeights = 0.0;
+
+    for (std::vector<NodeNeuron*>::const_iterator it
+         = cell.getNeurons().begin(),
+         itEnd = cell.getNeurons().end();
+         it != itEnd;
+         ++it)
+    {
+        const std::unordered_map<NodeId_T, NodeEvents_T>::const_iterator
+            itRecord = spikeRecording.find((*it)->getId());
+
+        if (itRecord != spikeRecording.end()) {
+            nbSpikes += (*itRecord).second.size();
+
+            for (NodeEvents_T::const_iterator itEvent
+                 = (*itRecord).second.begin(),
+                 itEventEnd = (*itRecord).second.end();
+                 itEvent != itEventEnd;
+                 ++itEvent)
+                sumTimestamps += (*itEvent).first;
+        }
+
+        for (unsigned int i = 0; i < 16; ++i) {
+            sumWeights += static_cast<NodeNeuron_Behavioral_Test*>(*it)
+                              ->getWeight(env[i]);
+        }
+    }
+
+    ASSERT_TRUE(nbSpikes > 0);
+    ASSERT_EQUALS(nbSpikes, nbSpikesRef);
+    ASSERT_EQUALS(sumTimestamps, sumTimestampsRef);
+    ASSERT_EQUALS_DELTA(sumWeights, sumWeightsRef, 1.0e-9);
+
+    std::for_each(env.begin(), env.end(), Utils::Delete());
+}
+
+RUN_TESTS()
@@ -18,6 +18,7 @@
     knowledge of the CeCILL-C license and that you accept its terms.
 */
 
+#include "Cell/DropoutCell_Frame.hpp"
 #include "Database/DIR_Database.hpp"
 #include "Database/MNIST_IDX_Database.hpp"
 #include "N2D2.hpp"
@@ -28,6 +29,10 @@
 #include "Transformation/RescaleTransformation.hpp"
 #include "utils/UnitTest.hpp"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 using namespace N2D2;
 
 TEST_DATASET(StimuliProvider,
@@ -319,6 +324,222 @@ TEST(StimuliProvider, readRandomBatch_bis)
     sp.readRandomBatch(Database::Test);
 }
 
+TEST_DATASET(StimuliProvider,
+             readRandomBatch_prefetch,
+             (unsigned int depth, unsigned int nbWorkers),
+             std::make_tuple(1U, 1U),
+             std::make_tuple(4U, 1U),
+             std::make_tuple(4U, 3U))
+{
+    REQUIRED(UnitTest::DirExists(N2D2_DATA("mnist")));
+
+    Random::mtSeed(0);
+
+    MNIST_IDX_Database database;
+    database.load(N2D2_DATA("mnist"));
+
+    StimuliProvider sp(database, 28, 28, 1, 8, false);
+    sp.setCachePath();
+    sp.setPrefetch(depth, nbWorkers);
+
+    StimuliProvider spRef(database, 28, 28, 1, 8, false);
+    spRef.setCachePath();
+
+    for (unsigned int i = 0; i < 10; ++i) {
+        sp.readRandomBatch(Database::Test);
+
+        const Tensor4d<Float_T>& data = sp.getData();
+
+        ASSERT_EQUALS(data.dimX(), 28U);
+        ASSERT_EQUALS(data.dimY(), 28U);
+        ASSERT_EQUALS(data.dimZ(), 1U);
+        ASSERT_EQUALS(data.dimB(), 8U);
+
+        // The prefetched batch must match a direct read of the same stimuli
+        for (unsigned int batchPos = 0; batchPos < 8; ++batchPos) {
+            spRef.readStimulus(sp.getBatch()[batchPos], Database::Test);
+
+            for (unsigned int index = 0; index < 28 * 28; ++index) {
+                ASSERT_EQUALS(data(index, batchPos),
+                              spRef.getData()(index, 0));
+            }
+
+            ASSERT_EQUALS(sp.getLabelsData()(0, batchPos),
+                          spRef.getLabelsData()(0, 0));
+        }
+    }
+
+    const StimuliProvider::PrefetchStats stats = sp.getPrefetchStats();
+
+    ASSERT_EQUALS(stats.nbBatches, 10U);
+    ASSERT_TRUE(stats.nbStalls <= 10U);
+    ASSERT_TRUE(stats.cumQueueDepth <= 10U * depth);
+}
+
+class StimuliProvider_Database : public Database {
+public:
+    StimuliProvider_Database(unsigned int nbStimuli) : mNbStimuli(nbStimuli)
+    {
+    }
+
+    void load(const std::string& /*dataPath*/,
+              const std::string& /*labelPath*/ = "",
+              bool /*extractROIs*/ = false)
+    {
+        for (unsigned int i = 0; i < mNbStimuli; ++i) {
+            std::stringstream name;
+            name << "stimulus_" << i;
+
+            std::stringstream label;
+            label << "label_" << (i % 4);
+
+            mStimuli.push_back(Stimulus(name.str(), labelID(label.str())));
+            mStimuliSets(Unpartitioned).push_back(mStimuli.size() - 1);
+        }
+    }
+
+protected:
+    cv::Mat readStimulusData(StimulusID id)
+    {
+        return cv::Mat(8, 8, CV_32F, cv::Scalar(id));
+    }
+
+private:
+    unsigned int mNbStimuli;
+};
+
+/**
+ * Outputs of a Dropout cell fed by a StimuliProvider, for a few random
+ * batches, with the given prefetch depth and number of threads.
+*/
+std::vector<Float_T> dropoutOutputs(Database& database,
+                                    unsigned int depth,
+                                    unsigned int nbWorkers,
+                                    int nbThreads)
+{
+#ifdef _OPENMP
+    const int maxThreads = omp_get_max_threads();
+    omp_set_num_threads(nbThreads);
+#endif
+
+    Random::mtSeed(0);
+
+    StimuliProvider sp(database, 8, 8, 1, 16, false);
+    sp.setCachePath();
+    sp.setPrefetch(depth, nbWorkers);
+
+    DropoutCell_Frame dropout("dropout", 1);
+    Tensor4d<Float_T> diffOutputs(8, 8, 1, 16);
+    dropout.addInput(sp.getData(), diffOutputs);
+    dropout.initialize();
+
+    std::vector<Float_T> outputs;
+
+    for (unsigned int i = 0; i < 10; ++i) {
+        sp.readRandomBatch(Database::Learn);
+
+        // The main thread draws from the global generator while the
+        // prefetch workers run
+        Random::mtRand();
+
+        dropout.propagate();
+
+        const Tensor4d<Float_T>& data = dropout.getOutputs();
+        outputs.insert(outputs.end(), data.begin(), data.end());
+    }
+
+#ifdef _OPENMP
+    omp_set_num_threads(maxThreads);
+#else
+    (void)nbThreads;
+#endif
+
+    return outputs;
+}
+
+TEST_DATASET(StimuliProvider,
+             readRandomBatch_dropout,
+             (unsigned int depth, unsigned int nbWorkers, int nbThreads),
+             std::make_tuple(0U, 1U, 4),
+             std::make_tuple(1U, 1U, 1),
+             std::make_tuple(4U, 1U, 2),
+             std::make_tuple(4U, 3U, 4))
+{
+    StimuliProvider_Database database(100);
+    database.load("");
+    database.partitionStimuli(1.0, 0.0, 0.0);
+
+    const std::vector<Float_T> outputsRef = dropoutOutputs(database, 0, 1, 1);
+    const std::vector<Float_T> outputs
+        = dropoutOutputs(database, depth, nbWorkers, nbThreads);
+
+    ASSERT_EQUALS(outputs.size(), outputsRef.size());
+
+    // Same stimuli and same masks, whatever the number of threads and the
+    // prefetch depth
+    for (unsigned int index = 0; index < outputs.size(); ++index) {
+        ASSERT_EQUALS(outputs[index], outputsRef[index]);
+    }
+}
+
+/**
+ * A copy (as done by HeteroStimuliProvider) of a provider whose prefetch
+ * workers are running has the same data, and starts its own workers.
+*/
+TEST_DATASET(StimuliProvider,
+             StimuliProvider_copy,
+             (unsigned int depth, unsigned int nbWorkers),
+             std::make_tuple(0U, 1U),
+             std::make_tuple(1U, 1U),
+             std::make_tuple(4U, 2U))
+{
+    StimuliProvider_Database database(100);
+    database.load("");
+    database.partitionStimuli(1.0, 0.0, 0.0);
+
+    Random::mtSeed(0);
+
+    StimuliProvider sp(database, 8, 8, 1, 4, false);
+    sp.setCachePath();
+    sp.setPrefetch(depth, nbWorkers);
+    sp.readRandomBatch(Database::Learn);
+
+    {
+        StimuliProvider spCopy(sp);
+
+        ASSERT_EQUALS(spCopy.getPrefetchDepth(), depth);
+        ASSERT_EQUALS(spCopy.getBatch().size(), 4U);
+
+        for (unsigned int batchPos = 0; batchPos < 4; ++batchPos) {
+            ASSERT_EQUALS(spCopy.getBatch()[batchPos],
+                          sp.getBatch()[batchPos]);
+
+            for (unsigned int index = 0; index < 8 * 8; ++index) {
+                ASSERT_EQUALS(spCopy.getData()(index, batchPos),
+                              sp.getData()(index, batchPos));
+            }
+        }
+
+        for (unsigned int i = 0; i < 3; ++i) {
+            spCopy.readRandomBatch(Database::Learn);
+
+            // Each stimulus is filled with its ID
+            for (unsigned int batchPos = 0; batchPos < 4; ++batchPos) {
+                ASSERT_EQUALS(spCopy.getData()(0, batchPos),
+                              (Float_T)spCopy.getBatch()[batchPos]);
+            }
+        }
+    }
+
+    // The original is not affected by the copy workers
+    sp.readRandomBatch(Database::Learn);
+
+    for (unsigned int batchPos = 0; batchPos < 4; ++batchPos) {
+        ASSERT_EQUALS(sp.getData()(0, batchPos),
+                      (Float_T)sp.getBatch()[batchPos]);
+    }
+}
+
 TEST(StimuliProvider, streamStimulus)
 {
     StimuliProvider sp(EmptyDatabase, 28, 28, 1, 2, false);
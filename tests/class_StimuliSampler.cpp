@@ -0,0 +1,221 @@
+/*
+    (C) Copyright 2016 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include "N2D2.hpp"
+
+#include "StimuliProvider.hpp"
+#include "StimuliSampler.hpp"
+#include "utils/UnitTest.hpp"
+#include "utils/Utils.hpp"
+
+using namespace N2D2;
+
+class StimuliSampler_Database : public Database {
+public:
+    StimuliSampler_Database(unsigned int nbStimuli) : mNbStimuli(nbStimuli)
+    {
+    }
+
+    void load(const std::string& /*dataPath*/,
+              const std::string& /*labelPath*/ = "",
+              bool /*extractROIs*/ = false)
+    {
+        for (unsigned int i = 0; i < mNbStimuli; ++i) {
+            std::stringstream name;
+            name << "stimulus_" << i;
+
+            mStimuli.push_back(Stimulus(name.str(), -1));
+            mStimuliSets(Unpartitioned).push_back(mStimuli.size() - 1);
+        }
+    }
+
+private:
+    unsigned int mNbStimuli;
+};
+
+TEST(StimuliSampler, Uniform)
+{
+    StimuliSampler_Database database(100);
+    database.load("");
+    database.partitionStimuli(1.0, 0.0, 0.0);
+
+    const std::shared_ptr<StimuliSampler> sampler
+        = StimuliSampler::create(StimuliSampler::Uniform,
+                                 database, Database::Learn);
+
+    ASSERT_EQUALS(sampler->getType(), StimuliSampler::Uniform);
+
+    for (unsigned int i = 0; i < 1000; ++i)
+        ASSERT_TRUE(sampler->next() < 100U);
+
+    ASSERT_EQUALS(sampler->getNbEpochs(), 0U);
+}
+
+TEST(StimuliSampler, Epoch)
+{
+    Random::mtSeed(0);
+
+    StimuliSampler_Database database(100);
+    database.load("");
+    database.partitionStimuli(1.0, 0.0, 0.0);
+
+    const std::shared_ptr<StimuliSampler> sampler
+        = StimuliSampler::create(StimuliSampler::Epoch,
+                                 database, Database::Learn);
+
+    std::vector<unsigned int> order[2];
+
+    for (unsigned int epoch = 0; epoch < 2; ++epoch) {
+        std::vector<bool> drawn(100, false);
+
+        for (unsigned int i = 0; i < 100; ++i) {
+            const unsigned int index = sampler->next();
+
+            ASSERT_TRUE(index < 100U);
+            // Each stimulus is drawn once per epoch
+            ASSERT_TRUE(!drawn[index]);
+            drawn[index] = true;
+            order[epoch].push_back(index);
+        }
+    }
+
+    ASSERT_EQUALS(sampler->getNbEpochs(), 1U);
+    ASSERT_TRUE(order[0] != order[1]);
+}
+
+TEST_DATASET(StimuliSampler,
+             Window,
+             (unsigned int nbStimuli, unsigned int windowSize),
+             std::make_tuple(100U, 10U),
+             std::make_tuple(100U, 30U),
+             std::make_tuple(7U, 10U))
+{
+    Random::mtSeed(0);
+
+    StimuliSampler_Database database(nbStimuli);
+    database.load("");
+    database.partitionStimuli(1.0, 0.0, 0.0);
+
+    const std::shared_ptr<StimuliSampler> sampler
+        = StimuliSampler::create(StimuliSampler::Window,
+                                 database, Database::Learn, windowSize);
+
+    ASSERT_EQUALS(sampler->getType(), StimuliSampler::Window);
+
+    std::vector<bool> drawn(nbStimuli, false);
+    unsigned int nbWindowChanges = 0;
+    unsigned int prevWindow = 0;
+
+    for (unsigned int i = 0; i < nbStimuli; ++i) {
+        const unsigned int index = sampler->next();
+
+        ASSERT_TRUE(index < nbStimuli);
+        ASSERT_TRUE(!drawn[index]);
+        drawn[index] = true;
+
+        const unsigned int window
+            = database.getStimulusID(Database::Learn, index) / windowSize;
+
+        if (i > 0 && window != prevWindow)
+            ++nbWindowChanges;
+
+        prevWindow = window;
+    }
+
+    // Each window is read without interruption
+    const unsigned int nbWindows = (nbStimuli + windowSize - 1) / windowSize;
+    ASSERT_EQUALS(nbWindowChanges, nbWindows - 1);
+    ASSERT_EQUALS(sampler->getNbEpochs(), 0U);
+}
+
+TEST(StimuliSampler, Window__shardCache)
+{
+    Random::mtSeed(0);
+
+    const unsigned int nbStimuli = 100;
+    const unsigned int windowSize = 10;
+
+    StimuliSampler_Database database(nbStimuli);
+    database.load("");
+    database.partitionStimuli(1.0, 0.0, 0.0);
+
+    Utils::createDirectories("StimuliSampler_Window__shardCache");
+    std::remove("StimuliSampler_Window__shardCache/shards.idx");
+    std::remove("StimuliSampler_Window__shardCache/shard_0000.bin");
+
+    // Records written in a different order than the stimulus IDs, as when
+    // the cache is filled by a previous randomly ordered epoch. The last 10
+    // stimuli are not cached.
+    std::vector<Database::StimulusID> recordOrder;
+
+    for (unsigned int index = 0; index < nbStimuli; ++index)
+        recordOrder.push_back(database.getStimulusID(Database::Learn, index));
+
+    std::sort(recordOrder.begin(), recordOrder.end());
+    std::rotate(recordOrder.begin(), recordOrder.begin() + 5,
+                recordOrder.end() - 10);
+
+    const std::shared_ptr<ShardCache> shardCache
+        = std::make_shared<ShardCache>("StimuliSampler_Window__shardCache");
+    std::map<Database::StimulusID, unsigned int> recordPos;
+
+    for (unsigned int pos = 0; pos < nbStimuli - 10; ++pos) {
+        shardCache->write(
+            StimuliProvider::getCacheKey(recordOrder[pos], Database::Learn),
+            std::vector<cv::Mat>(1, cv::Mat(4, 4, CV_8UC1, cv::Scalar(pos))));
+        recordPos[recordOrder[pos]] = pos;
+    }
+
+    for (unsigned int pos = nbStimuli - 10; pos < nbStimuli; ++pos)
+        recordPos[recordOrder[pos]] = pos;
+
+    const std::shared_ptr<StimuliSampler> sampler
+        = StimuliSampler::create(StimuliSampler::Window,
+                                 database, Database::Learn, windowSize);
+    std::static_pointer_cast<WindowSampler>(sampler)
+        ->setShardCache(shardCache);
+
+    std::vector<bool> drawn(nbStimuli, false);
+    unsigned int nbWindowChanges = 0;
+    unsigned int prevWindow = 0;
+
+    for (unsigned int i = 0; i < nbStimuli; ++i) {
+        const unsigned int index = sampler->next();
+
+        ASSERT_TRUE(index < nbStimuli);
+        ASSERT_TRUE(!drawn[index]);
+        drawn[index] = true;
+
+        // Windows of consecutive records, then of consecutive IDs for the
+        // stimuli not cached
+        const unsigned int window
+            = recordPos[database.getStimulusID(Database::Learn, index)]
+              / windowSize;
+
+        if (i > 0 && window != prevWindow)
+            ++nbWindowChanges;
+
+        prevWindow = window;
+    }
+
+    ASSERT_EQUALS(nbWindowChanges, nbStimuli / windowSize - 1);
+}
+
+RUN_TESTS()
@@ -0,0 +1,216 @@
+/*
+    (C) Copyright 2016 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include "N2D2.hpp"
+
+#include "Cell/ConvCell_Frame.hpp"
+#include "Cell/FcCell_Frame.hpp"
+#include "containers/PoolAllocator.hpp"
+#include "containers/Tensor4d.hpp"
+#include "utils/UnitTest.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+
+using namespace N2D2;
+
+// Count the allocations that bypass the pool
+static unsigned int nbNewCalls = 0;
+
+void* operator new(std::size_t size)
+{
+    ++nbNewCalls;
+    void* ptr = std::malloc(size);
+
+    if (ptr == NULL)
+        throw std::bad_alloc();
+
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+TEST_DATASET(MemoryPool,
+             allocate,
+             (std::size_t size),
+             std::make_tuple(1U),
+             std::make_tuple(64U),
+             std::make_tuple(100U),
+             std::make_tuple(4096U),
+             std::make_tuple(1000000U))
+{
+    void* ptr = MemoryPool::allocate(size);
+
+    ASSERT_TRUE(ptr != NULL);
+    ASSERT_EQUALS(reinterpret_cast<std::uintptr_t>(ptr)
+                  % MemoryPool::Alignment, 0U);
+
+    MemoryPool::deallocate(ptr, size);
+}
+
+TEST(MemoryPool, reuse)
+{
+    MemoryPool::releaseCached();
+    MemoryPool::resetStats();
+
+    void* ptr = MemoryPool::allocate(1000);
+    MemoryPool::deallocate(ptr, 1000);
+
+    ASSERT_EQUALS(MemoryPool::getStats().nbHeapAllocations, 1U);
+    ASSERT_TRUE(MemoryPool::getStats().bytesCached >= 1000U);
+
+    // Same size class: the cached buffer must be handed out again
+    void* ptrReuse = MemoryPool::allocate(990);
+
+    ASSERT_EQUALS(ptrReuse, ptr);
+    ASSERT_EQUALS(MemoryPool::getStats().nbAllocations, 2U);
+    ASSERT_EQUALS(MemoryPool::getStats().nbHeapAllocations, 1U);
+
+    MemoryPool::deallocate(ptrReuse, 990);
+}
+
+TEST(MemoryPool, setPooling)
+{
+    MemoryPool::setPooling(false);
+
+    ASSERT_TRUE(!MemoryPool::isPooling());
+
+    void* ptr = MemoryPool::allocate(256);
+    MemoryPool::deallocate(ptr, 256);
+
+    ASSERT_EQUALS(MemoryPool::getStats().bytesCached, 0U);
+
+    MemoryPool::setPooling(true);
+}
+
+TEST(MemoryPool, setMaxCached)
+{
+    MemoryPool::releaseCached();
+
+    void* ptr1 = MemoryPool::allocate(1024);
+    void* ptr2 = MemoryPool::allocate(4096);
+    MemoryPool::deallocate(ptr1, 1024);
+    MemoryPool::deallocate(ptr2, 4096);
+
+    ASSERT_EQUALS(MemoryPool::getStats().bytesCached, 1024U + 4096U);
+
+    // The largest buffer is trimmed first
+    MemoryPool::setMaxCached(2048);
+
+    ASSERT_EQUALS(MemoryPool::getMaxCached(), 2048U);
+    ASSERT_EQUALS(MemoryPool::getStats().bytesCached, 1024U);
+
+    // Released buffers beyond the limit go back to the heap
+    void* ptr3 = MemoryPool::allocate(4096);
+    MemoryPool::deallocate(ptr3, 4096);
+
+    ASSERT_EQUALS(MemoryPool::getStats().bytesCached, 1024U);
+
+    MemoryPool::setMaxCached(std::numeric_limits<std::size_t>::max());
+    MemoryPool::releaseCached();
+}
+
+TEST(PoolAllocator, Tensor4d)
+{
+    MemoryPool::releaseCached();
+
+    for (unsigned int batch = 0; batch < 3; ++batch) {
+        if (batch == 1)
+            MemoryPool::resetStats();
+
+        Tensor4d<float> inputs(24, 24, 3, 8, 1.0);
+        Tensor4d<float> outputs(12, 12, 16, 8, 0.0);
+
+        ASSERT_EQUALS(reinterpret_cast<std::uintptr_t>(&inputs(0))
+                      % MemoryPool::Alignment, 0U);
+        ASSERT_EQUALS(reinterpret_cast<std::uintptr_t>(&outputs(0))
+                      % MemoryPool::Alignment, 0U);
+    }
+
+    // After the first iteration, the tensors are entirely served by the pool
+    ASSERT_EQUALS(MemoryPool::getStats().nbAllocations, 4U);
+    ASSERT_EQUALS(MemoryPool::getStats().nbHeapAllocations, 0U);
+}
+
+TEST_DATASET(PoolAllocator,
+             Cell_Frame,
+             (ConvCell_Frame::Algorithm algo),
+             std::make_tuple(ConvCell_Frame::Direct),
+             std::make_tuple(ConvCell_Frame::GEMM),
+             std::make_tuple(ConvCell_Frame::Winograd))
+{
+    Random::mtSeed(0);
+
+    Tensor4d<Float_T> inputs(12, 12, 3, 2);
+    Tensor4d<Float_T> diffOutputs(12, 12, 3, 2);
+
+    for (unsigned int index = 0; index < inputs.size(); ++index)
+        inputs(index) = Random::randUniform(-1.0, 1.0);
+
+    ConvCell_Frame conv1("conv1",
+                         3,
+                         3,
+                         8,
+                         1,
+                         1,
+                         1,
+                         1,
+                         0,
+                         0,
+                         std::shared_ptr<Activation<Float_T> >());
+    conv1.setParameter("Algorithm", algo);
+    conv1.addInput(inputs, diffOutputs);
+
+    FcCell_Frame fc1("fc1", 10, std::shared_ptr<Activation<Float_T> >());
+    fc1.addInput(&conv1);
+
+    conv1.initialize();
+    fc1.initialize();
+
+    MemoryPool::releaseCached();
+
+    for (unsigned int batch = 0; batch < 3; ++batch) {
+        // The first batch fills the pool, including with the per-batch
+        // scratch buffers of the kernels
+        if (batch == 1) {
+            MemoryPool::resetStats();
+            nbNewCalls = 0;
+        }
+
+        conv1.propagate();
+        fc1.propagate();
+        fc1.backPropagate();
+        conv1.backPropagate();
+        fc1.update();
+        conv1.update();
+    }
+
+    const unsigned int nbSystemAllocations = nbNewCalls;
+
+    ASSERT_TRUE(MemoryPool::getStats().nbAllocations > 0U);
+    ASSERT_EQUALS(MemoryPool::getStats().nbHeapAllocations, 0U);
+    ASSERT_EQUALS(nbSystemAllocations, 0U);
+}
+
+RUN_TESTS()
@@ -136,4 +136,64 @@ TEST(Tensor4d, clear)
     ASSERT_TRUE(A.empty());
 }
 
+TEST_DATASET(Tensor4d,
+             setChannelBlock,
+             (unsigned int dimX,
+              unsigned int dimY,
+              unsigned int dimZ,
+              unsigned int dimB,
+              unsigned int channelBlock),
+             std::make_tuple(3U, 2U, 8U, 2U, 8U),
+             std::make_tuple(3U, 4U, 5U, 3U, 8U),
+             std::make_tuple(5U, 1U, 17U, 2U, 16U),
+             std::make_tuple(1U, 1U, 3U, 1U, 16U))
+{
+    Tensor4d<int> tensor(dimX, dimY, dimZ, dimB);
+
+    for (unsigned int index = 0; index < tensor.size(); ++index)
+        tensor(index) = index;
+
+    tensor.setChannelBlock(channelBlock);
+
+    const unsigned int nbBlocks = (dimZ + channelBlock - 1) / channelBlock;
+    const Tensor4d<int>& constTensor = tensor;
+
+    ASSERT_EQUALS(tensor.channelBlock(), channelBlock);
+    ASSERT_EQUALS(tensor.pixelStride(), channelBlock);
+    ASSERT_EQUALS(tensor.dimZ(), dimZ);
+    ASSERT_EQUALS(tensor.size(), dimX * dimY * nbBlocks * channelBlock * dimB);
+
+    for (unsigned int b = 0; b < dimB; ++b) {
+        for (unsigned int k = 0; k < dimZ; ++k) {
+            const unsigned int offset = tensor.channelOffset(k, b);
+
+            for (unsigned int j = 0; j < dimY; ++j) {
+                for (unsigned int i = 0; i < dimX; ++i) {
+                    const int value = i + j * dimX + k * dimX * dimY
+                                      + b * dimX * dimY * dimZ;
+
+                    ASSERT_EQUALS(tensor(i, j, k, b), value);
+                    ASSERT_EQUALS(tensor.at(i, j, k, b), value);
+                    ASSERT_EQUALS(
+                        tensor(offset + (i + j * dimX) * channelBlock), value);
+                }
+            }
+
+            ASSERT_EQUALS(constTensor[b](0, 0, k), tensor(0, 0, k, b));
+        }
+
+        // The frame of a blocked tensor cannot be written through operator[]
+        ASSERT_THROW_ANY(tensor[b]);
+    }
+
+    tensor.setChannelBlock(1);
+
+    ASSERT_EQUALS(tensor.channelBlock(), 1U);
+    ASSERT_EQUALS(tensor.size(), dimX * dimY * dimZ * dimB);
+
+    for (unsigned int index = 0; index < tensor.size(); ++index) {
+        ASSERT_EQUALS(tensor(index), (int)index);
+    }
+}
+
 RUN_TESTS()
@@ -0,0 +1,138 @@
+/*
+    (C) Copyright 2014 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+
+#include "utils/MatCache.hpp"
+#include "utils/UnitTest.hpp"
+
+using namespace N2D2;
+
+TEST(MatCache, get_insert)
+{
+    MatCache cache;
+
+    cv::Mat mat;
+    ASSERT_TRUE(!cache.get(0, mat));
+
+    const cv::Mat data(4, 4, CV_32FC1, cv::Scalar(1.0));
+    cache.insert(0, data);
+
+    ASSERT_TRUE(cache.get(0, mat));
+    ASSERT_TRUE(mat.data == data.data);
+    ASSERT_TRUE(!cache.get(1, mat));
+
+    MatCache::Stats stats = cache.getStats();
+    ASSERT_EQUALS(stats.nbHits, 1ULL);
+    ASSERT_EQUALS(stats.nbMisses, 2ULL);
+    ASSERT_EQUALS(stats.nbInsertions, 1ULL);
+    ASSERT_EQUALS(stats.nbEvictions, 0ULL);
+    ASSERT_EQUALS(stats.nbEntries, 1U);
+    ASSERT_EQUALS(stats.bytes, 4U * 4U * sizeof(float));
+
+    // Replace an entry
+    cache.insert(0, cv::Mat(2, 2, CV_8UC1, cv::Scalar(3)));
+    stats = cache.getStats();
+    ASSERT_EQUALS(stats.nbEntries, 1U);
+    ASSERT_EQUALS(stats.bytes, 4U);
+
+    cache.resetStats();
+    stats = cache.getStats();
+    ASSERT_EQUALS(stats.nbHits, 0ULL);
+    ASSERT_EQUALS(stats.nbEntries, 1U);
+
+    cache.clear();
+    ASSERT_TRUE(!cache.get(0, mat));
+    ASSERT_EQUALS(cache.getStats().bytes, 0U);
+}
+
+TEST(MatCache, eviction)
+{
+    // A single shard, room for 3 matrices of 100 bytes
+    MatCache cache(300, 1);
+
+    for (unsigned int key = 0; key < 3; ++key)
+        cache.insert(key, cv::Mat(10, 10, CV_8UC1, cv::Scalar(key)));
+
+    cv::Mat mat;
+    // Use key 0, key 1 becomes the least recently used
+    ASSERT_TRUE(cache.get(0, mat));
+
+    cache.insert(3, cv::Mat(10, 10, CV_8UC1, cv::Scalar(3)));
+
+    ASSERT_TRUE(cache.get(0, mat));
+    ASSERT_TRUE(!cache.get(1, mat));
+    ASSERT_TRUE(cache.get(2, mat));
+    ASSERT_TRUE(cache.get(3, mat));
+
+    MatCache::Stats stats = cache.getStats();
+    ASSERT_EQUALS(stats.nbEvictions, 1ULL);
+    ASSERT_EQUALS(stats.nbEntries, 3U);
+    ASSERT_EQUALS(stats.bytes, 300U);
+
+    // Too large to be cached
+    cache.insert(4, cv::Mat(20, 20, CV_8UC1, cv::Scalar(4)));
+    ASSERT_TRUE(!cache.get(4, mat));
+    ASSERT_EQUALS(cache.getStats().nbEntries, 3U);
+
+    // Reducing the budget evicts the least recently used entries
+    cache.setBudget(100);
+    ASSERT_EQUALS(cache.getBudget(), 100U);
+    ASSERT_TRUE(cache.get(3, mat));
+    ASSERT_TRUE(!cache.get(0, mat));
+    ASSERT_TRUE(!cache.get(2, mat));
+
+    stats = cache.getStats();
+    ASSERT_EQUALS(stats.nbEvictions, 3ULL);
+    ASSERT_EQUALS(stats.nbEntries, 1U);
+}
+
+TEST(MatCache, shards)
+{
+    MatCache cache(16 * 1000, 16);
+
+    ASSERT_EQUALS(cache.getNbShards(), 16U);
+
+#pragma omp parallel for
+    for (int key = 0; key < 1000; ++key)
+        cache.insert(key, cv::Mat(10, 10, CV_8UC1, cv::Scalar(1)));
+
+    // Each shard can hold 10 matrices
+    const MatCache::Stats stats = cache.getStats();
+    ASSERT_EQUALS(stats.nbInsertions, 1000ULL);
+    ASSERT_EQUALS(stats.nbEntries, 160U);
+    ASSERT_EQUALS(stats.nbEvictions, 840ULL);
+    ASSERT_TRUE(stats.bytes <= cache.getBudget());
+}
+
+TEST(MatCache, shards_data_only)
+{
+    MatCache cache(16 * 1000, 16);
+
+    // Keys used by Database for the stimuli data only (the labels use the
+    // odd keys), which must still fill every shard
+    for (unsigned int id = 0; id < 1000; ++id)
+        cache.insert(2ULL * id, cv::Mat(10, 10, CV_8UC1, cv::Scalar(1)));
+
+    const MatCache::Stats stats = cache.getStats();
+    ASSERT_EQUALS(stats.nbEntries, 160U);
+    ASSERT_EQUALS(stats.bytes, cache.getBudget());
+}
+
+RUN_TESTS()
@@ -0,0 +1,130 @@
+/*
+    (C) Copyright 2014 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include "utils/ShardCache.hpp"
+#include "utils/UnitTest.hpp"
+#include "utils/Utils.hpp"
+
+#include <iomanip>
+
+using namespace N2D2;
+
+TEST(ShardCache, write_read)
+{
+    Utils::createDirectories("ShardCache_write_read");
+    std::remove("ShardCache_write_read/shards.idx");
+    std::remove("ShardCache_write_read/shard_0000.bin");
+    std::remove("ShardCache_write_read/shard_0001.bin");
+
+    std::vector<cv::Mat> data;
+    data.push_back(cv::Mat(7, 5, CV_32FC1, cv::Scalar(0.5)));
+    data.push_back(cv::Mat(3, 9, CV_8UC1, cv::Scalar(12)));
+    data.push_back(cv::Mat());
+
+    {
+        ShardCache cache("ShardCache_write_read");
+
+        ASSERT_EQUALS(cache.getNbRecords(), 0U);
+        ASSERT_TRUE(!cache.contains("rec"));
+
+        cache.write("rec", data);
+
+        ASSERT_TRUE(cache.contains("rec"));
+        ASSERT_EQUALS(cache.getNbRecords(), 1U);
+
+        // Read back from the shard being written
+        const std::vector<cv::Mat> data2 = cache.read("rec");
+
+        ASSERT_EQUALS(data2.size(), 3U);
+        ASSERT_EQUALS(data2[0].rows, 7);
+        ASSERT_EQUALS(data2[0].cols, 5);
+        ASSERT_EQUALS(data2[0].type(), CV_32FC1);
+        ASSERT_EQUALS(data2[0].at<float>(6, 4), 0.5f);
+        ASSERT_EQUALS(data2[1].type(), CV_8UC1);
+        ASSERT_EQUALS(data2[1].at<unsigned char>(2, 8), 12);
+        ASSERT_TRUE(data2[2].empty());
+    }
+
+    // Re-open: the shard is now memory-mapped
+    ShardCache cache("ShardCache_write_read");
+
+    ASSERT_EQUALS(cache.getNbRecords(), 1U);
+    ASSERT_TRUE(cache.contains("rec"));
+
+    const std::vector<cv::Mat> data3 = cache.read("rec");
+
+    ASSERT_EQUALS(data3.size(), 3U);
+    ASSERT_EQUALS(data3[0].rows, 7);
+    ASSERT_EQUALS(data3[0].cols, 5);
+    ASSERT_EQUALS(data3[0].at<float>(0, 0), 0.5f);
+    ASSERT_EQUALS(data3[1].at<unsigned char>(0, 0), 12);
+    ASSERT_EQUALS((unsigned long)data3[0].data % 16, 0UL);
+
+    // No copy: the data points to the mapped shard
+    ASSERT_TRUE(cache.read("rec")[0].data == data3[0].data);
+}
+
+TEST(ShardCache, shardSize)
+{
+    Utils::createDirectories("ShardCache_shardSize");
+
+    for (unsigned int shard = 0; shard < 8; ++shard) {
+        std::ostringstream fileName;
+        fileName << "ShardCache_shardSize/shard_" << std::setfill('0')
+                 << std::setw(4) << shard << ".bin";
+        std::remove(fileName.str().c_str());
+    }
+
+    std::remove("ShardCache_shardSize/shards.idx");
+
+    {
+        // Each record is 16 + 16 + 100*4 bytes: 2 records per shard
+        ShardCache cache("ShardCache_shardSize", 1000);
+
+        for (unsigned int i = 0; i < 5; ++i) {
+            std::ostringstream key;
+            key << i;
+
+            cache.write(key.str(),
+                        std::vector<cv::Mat>(
+                            1, cv::Mat(10, 10, CV_32FC1, cv::Scalar(i))));
+        }
+
+        ASSERT_EQUALS(cache.getNbRecords(), 5U);
+        ASSERT_EQUALS(cache.getNbShards(), 3U);
+
+        for (unsigned int i = 0; i < 5; ++i) {
+            std::ostringstream key;
+            key << i;
+
+            ASSERT_EQUALS(cache.read(key.str())[0].at<float>(9, 9),
+                          (float)i);
+        }
+    }
+
+    ShardCache cache("ShardCache_shardSize", 1000);
+
+    ASSERT_EQUALS(cache.getNbRecords(), 5U);
+    ASSERT_EQUALS(cache.getNbShards(), 3U);
+    ASSERT_EQUALS(cache.read("4")[0].at<float>(5, 5), 4.0f);
+    ASSERT_THROW_ANY(cache.read("5"));
+}
+
+RUN_TESTS()
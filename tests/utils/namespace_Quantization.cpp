@@ -0,0 +1,156 @@
+/*
+    (C) Copyright 2016 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include "utils/Quantization.hpp"
+#include "utils/Random.hpp"
+#include "utils/UnitTest.hpp"
+
+using namespace N2D2;
+
+TEST_DATASET(Quantization,
+             maxValue,
+             (unsigned int nbBits, bool isSigned, int maxVal, int minVal),
+             std::make_tuple(8U, true, 127, -127),
+             std::make_tuple(8U, false, 255, 0),
+             std::make_tuple(4U, true, 7, -7),
+             std::make_tuple(2U, false, 3, 0))
+{
+    ASSERT_EQUALS(Quantization::maxValue(nbBits, isSigned), maxVal);
+    ASSERT_EQUALS(Quantization::minValue(nbBits, isSigned), minVal);
+}
+
+TEST(Quantization, Histogram)
+{
+    Random::mtSeed(0);
+
+    Quantization::Histogram histogram;
+
+    for (unsigned int i = 0; i < 100000; ++i)
+        histogram(Random::randNormal(0.0, 1.0));
+
+    ASSERT_EQUALS(histogram.isSigned(), true);
+    ASSERT_EQUALS(histogram.calibrate(Quantization::MaxAbs, 8),
+                  histogram.getMaxAbs());
+
+    const double maxAbs = histogram.getMaxAbs();
+
+    // A single outlier sets the maximum, but not the KL threshold
+    histogram(-10.0 * maxAbs);
+
+    ASSERT_EQUALS(histogram.getMaxAbs(), 10.0 * maxAbs);
+
+    const double threshold8 = histogram.calibrate(Quantization::KL, 8);
+    const double threshold4 = histogram.calibrate(Quantization::KL, 4);
+
+    ASSERT_TRUE(threshold8 > 2.0);
+    ASSERT_TRUE(threshold8 < 1.1 * maxAbs);
+    ASSERT_TRUE(threshold4 <= threshold8);
+}
+
+TEST(Quantization, Histogram_unsigned)
+{
+    Quantization::Histogram histogram(16);
+
+    for (unsigned int i = 0; i <= 100; ++i)
+        histogram(i / 100.0);
+
+    ASSERT_EQUALS(histogram.isSigned(), false);
+    ASSERT_EQUALS(histogram.getMaxAbs(), 1.0);
+    // Fewer bins than quantization levels: no clipping
+    ASSERT_EQUALS(histogram.calibrate(Quantization::KL, 8), 1.0);
+}
+
+TEST_DATASET(Quantization,
+             quantizeWeights,
+             (unsigned int nbBits),
+             std::make_tuple(8U),
+             std::make_tuple(4U),
+             std::make_tuple(2U))
+{
+    Random::mtSeed(0);
+
+    Tensor4d<float> weights(3, 3, 4, 5);
+
+    for (unsigned int index = 0; index < weights.size(); ++index) {
+        // Each output has its own range
+        weights(index) = Random::randUniform(-1.0, 1.0)
+                         * (1 + index / (weights.size() / weights.dimB()));
+    }
+
+    Interface<float> weightsInterface;
+    weightsInterface.push_back(&weights);
+
+    const std::vector<float> scales
+        = Quantization::weightsScales(weightsInterface, nbBits);
+
+    ASSERT_EQUALS(scales.size(), weights.dimB());
+
+    Tensor4d<signed char> quantized;
+    Quantization::quantizeWeights(weights, scales, nbBits, quantized);
+
+    ASSERT_EQUALS(quantized.size(), weights.size());
+
+    const int maxVal = Quantization::maxValue(nbBits, true);
+    const unsigned int size = weights.size() / weights.dimB();
+    std::vector<int> maxQuantized(weights.dimB(), 0);
+
+    for (unsigned int index = 0; index < weights.size(); ++index) {
+        const unsigned int output = index / size;
+
+        ASSERT_TRUE(std::abs((int)quantized(index)) <= maxVal);
+        ASSERT_EQUALS_DELTA(quantized(index) * scales[output],
+                            weights(index),
+                            0.5 * scales[output] + 1.0e-6);
+
+        maxQuantized[output] = std::max(maxQuantized[output],
+                                        std::abs((int)quantized(index)));
+    }
+
+    // The full range is used for each output
+    for (unsigned int output = 0; output < weights.dimB(); ++output)
+        ASSERT_EQUALS(maxQuantized[output], maxVal);
+}
+
+TEST(Quantization, requantize)
+{
+    Tensor4d<float> signals(4, 1, 1, 1);
+    signals(0) = -1.0;
+    signals(1) = 0.26;
+    signals(2) = 0.74;
+    signals(3) = 5.0;
+
+    const Quantization::Signals quantization(0.5, false);
+    Tensor4d<short> quantized;
+    Quantization::quantizeSignals(signals, quantization, 2, quantized);
+
+    ASSERT_EQUALS(quantized(0), 0);
+    ASSERT_EQUALS(quantized(1), 1);
+    ASSERT_EQUALS(quantized(2), 1);
+    ASSERT_EQUALS(quantized(3), 3);
+
+    Quantization::requantize(signals, quantization, 2);
+
+    ASSERT_EQUALS(signals(0), 0.0);
+    ASSERT_EQUALS(signals(1), 0.5);
+    ASSERT_EQUALS(signals(2), 0.5);
+    ASSERT_EQUALS(signals(3), 1.5);
+}
+
+RUN_TESTS()
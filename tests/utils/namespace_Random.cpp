@@ -18,6 +18,13 @@
     knowledge of the CeCILL-C license and that you accept its terms.
 */
 
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "containers/Tensor4d.hpp"
 #include "utils/Random.hpp"
 #include "utils/UnitTest.hpp"
 
@@ -70,4 +77,126 @@ TEST(Random, mtRand)
         ASSERT_EQUALS(Random::mtRand(), mtRand_0xFFFFFFFF[i]);
 }
 
+TEST(Random, Philox_generate)
+{
+    // Known-answer tests of the Random123 library
+    const unsigned int counter_0[] = {0, 0, 0, 0};
+    const unsigned int key_0[] = {0, 0};
+    const unsigned int result_0[]
+        = {0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8};
+
+    const unsigned int counter_1[]
+        = {0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff};
+    const unsigned int key_1[] = {0xffffffff, 0xffffffff};
+    const unsigned int result_1[]
+        = {0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd};
+
+    const unsigned int counter_2[]
+        = {0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344};
+    const unsigned int key_2[] = {0xa4093822, 0x299f31d0};
+    const unsigned int result_2[]
+        = {0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1};
+
+    unsigned int result[4];
+
+    Random::Philox::generate(counter_0, key_0, result);
+
+    for (unsigned int i = 0; i < 4; ++i)
+        ASSERT_EQUALS(result[i], result_0[i]);
+
+    Random::Philox::generate(counter_1, key_1, result);
+
+    for (unsigned int i = 0; i < 4; ++i)
+        ASSERT_EQUALS(result[i], result_1[i]);
+
+    Random::Philox::generate(counter_2, key_2, result);
+
+    for (unsigned int i = 0; i < 4; ++i)
+        ASSERT_EQUALS(result[i], result_2[i]);
+}
+
+TEST(Random, Philox_counter)
+{
+    Random::Philox philox(42, 3);
+    std::vector<unsigned int> values;
+
+    for (unsigned int i = 0; i < 40; ++i)
+        values.push_back(philox.rand());
+
+    // Jump directly to the 6th block of 4 numbers
+    Random::Philox philoxSkip(42, 3, 6);
+
+    for (unsigned int i = 24; i < 40; ++i)
+        ASSERT_EQUALS(philoxSkip.rand(), values[i]);
+
+    // Different streams differ
+    Random::Philox philoxStream(42, 4);
+    unsigned int nbEquals = 0;
+
+    for (unsigned int i = 0; i < 40; ++i)
+        nbEquals += (philoxStream.rand() == values[i]);
+
+    ASSERT_EQUALS(nbEquals, 0U);
+}
+
+TEST(Random, ThreadStream)
+{
+    Random::mtSeed(1);
+
+    {
+        Random::ThreadStream stream(42, 3);
+        Random::Philox philox(42, 3);
+
+        for (unsigned int i = 0; i < 10; ++i)
+            ASSERT_EQUALS(Random::mtRand(), philox.rand());
+
+        ASSERT_EQUALS(Random::randNormal(1.0, 2.0),
+                      philox.randNormal(1.0, 2.0));
+    }
+
+    // The global generator is back, untouched
+    ASSERT_EQUALS(Random::mtRand(), 1791095845U);
+    ASSERT_EQUALS(Random::mtRand(), 4282876139U);
+}
+
+TEST(Random, fillBernoulli)
+{
+    Tensor4d<char> data(100, 10, 10, 1);
+    std::vector<char> dataRef(data.size());
+    Random::Philox philox;
+
+    for (unsigned int index = 0; index < dataRef.size(); ++index) {
+        if (index % Random::FillBlockSize == 0)
+            philox.seed(7, 1, index);
+
+        dataRef[index] = philox.randBernoulli(0.3);
+    }
+
+#ifdef _OPENMP
+    const int nbThreads = omp_get_max_threads();
+
+    for (int threads = 1; threads <= 4; ++threads) {
+        omp_set_num_threads(threads);
+#else
+    {
+#endif
+        data.fill(0);
+        Random::fillBernoulli(data, 0.3, 7, 1);
+
+        for (unsigned int index = 0; index < data.size(); ++index)
+            ASSERT_EQUALS((int)data(index), (int)dataRef[index]);
+    }
+
+#ifdef _OPENMP
+    omp_set_num_threads(nbThreads);
+#endif
+
+    unsigned int nbOnes = 0;
+
+    for (unsigned int index = 0; index < data.size(); ++index)
+        nbOnes += data(index);
+
+    ASSERT_EQUALS_DELTA(nbOnes / (double)data.size(), 0.3, 0.02);
+}
+
 RUN_TESTS()